@@ -0,0 +1,47 @@
+# Shared by the data generation scripts (generate_kernel_data.cmake,
+# generate_asset_data.cmake)
+
+# Convert a hex string to C array format (16 bytes per line)
+function(hex_to_c_array HEX_DATA OUT_VAR)
+    string(LENGTH "${HEX_DATA}" HEX_LENGTH)
+    set(C_ARRAY_DATA "")
+    set(BYTES_PER_LINE 16)
+    set(BYTE_COUNT 0)
+    
+    if(HEX_LENGTH GREATER 0)
+        math(EXPR NUM_BYTES "${HEX_LENGTH} / 2")
+        
+        # Process each byte
+        foreach(i RANGE 0 ${NUM_BYTES})
+            math(EXPR BYTE_INDEX "${i} * 2")
+            if(BYTE_INDEX LESS HEX_LENGTH)
+                string(SUBSTRING ${HEX_DATA} ${BYTE_INDEX} 2 HEX_BYTE)
+                
+                # Add newline and indentation every 16 bytes
+                math(EXPR LINE_POS "${BYTE_COUNT} % ${BYTES_PER_LINE}")
+                if(LINE_POS EQUAL 0)
+                    if(BYTE_COUNT GREATER 0)
+                        string(APPEND C_ARRAY_DATA "\n")
+                    endif()
+                    string(APPEND C_ARRAY_DATA "    ")
+                endif()
+                
+                # Add the byte
+                string(APPEND C_ARRAY_DATA "0x${HEX_BYTE}")
+                
+                # Add comma if not the last byte
+                math(EXPR NEXT_BYTE "${BYTE_COUNT} + 1")
+                if(NEXT_BYTE LESS NUM_BYTES)
+                    string(APPEND C_ARRAY_DATA ", ")
+                endif()
+                
+                math(EXPR BYTE_COUNT "${BYTE_COUNT} + 1")
+            endif()
+        endforeach()
+    else()
+        # Empty image - add a single zero byte to make valid C array
+        set(C_ARRAY_DATA "    0x00")
+    endif()
+    
+    set(${OUT_VAR} "${C_ARRAY_DATA}" PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""
+Compress kernel.bin into a raw LZ4 block for the MIA boot ROM.
+
+Usage: compress_kernel.py <input> <output> [--window N]
+
+The output is a plain LZ4 block (no frame header), decoded on the MIA by
+src/rom_emulation/kernel_lz4.c. Match offsets are limited to the decoder's
+ring size (KERNEL_RING_SIZE in src/rom_emulation/rom_emulator.h).
+"""
+
+import argparse
+import sys
+
+MIN_MATCH = 4
+LAST_LITERALS = 5       # The last 5 bytes are always literals
+MF_LIMIT = 12           # The last match must start 12 bytes before the end
+HASH_BITS = 14
+MAX_CHAIN = 64
+
+
+def write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def emit_sequence(out, literals, offset, match_length):
+    lit_len = len(literals)
+    token = min(lit_len, 15) << 4
+    if match_length is not None:
+        token |= min(match_length - MIN_MATCH, 15)
+    out.append(token)
+    if lit_len >= 15:
+        write_length(out, lit_len - 15)
+    out += literals
+    if match_length is not None:
+        out += offset.to_bytes(2, 'little')
+        if match_length - MIN_MATCH >= 15:
+            write_length(out, match_length - MIN_MATCH - 15)
+
+
+def compress(data, window):
+    out = bytearray()
+    n = len(data)
+    head = {}
+    prev = [-1] * n
+    anchor = 0
+    i = 0
+    match_end = n - LAST_LITERALS
+
+    def insert(pos):
+        key = bytes(data[pos:pos + MIN_MATCH])
+        prev[pos] = head.get(key, -1)
+        head[key] = pos
+
+    while i + MF_LIMIT <= n:
+        key = bytes(data[i:i + MIN_MATCH])
+        best_len = 0
+        best_off = 0
+        cand = head.get(key, -1)
+        chain = 0
+        while cand >= 0 and i - cand <= window and chain < MAX_CHAIN:
+            length = 0
+            while i + length < match_end and data[cand + length] == data[i + length]:
+                length += 1
+            if length > best_len:
+                best_len = length
+                best_off = i - cand
+            cand = prev[cand]
+            chain += 1
+        insert(i)
+
+        if best_len < MIN_MATCH:
+            i += 1
+            continue
+
+        emit_sequence(out, data[anchor:i], best_off, best_len)
+        for pos in range(i + 1, min(i + best_len, n - MIN_MATCH + 1)):
+            insert(pos)
+        i += best_len
+        anchor = i
+
+    emit_sequence(out, data[anchor:], 0, None)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('input')
+    parser.add_argument('output')
+    parser.add_argument('--window', type=int, default=8192,
+                        help='maximum match offset (decoder ring size)')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    if not data:
+        compressed = bytearray()
+    else:
+        compressed = compress(data, min(args.window, 65535))
+
+    with open(args.output, 'wb') as f:
+        f.write(compressed)
+
+    ratio = (100.0 * len(compressed) / len(data)) if data else 0.0
+    print(f"Compressed kernel: {len(data)} -> {len(compressed)} bytes ({ratio:.1f}%)")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
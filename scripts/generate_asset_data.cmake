@@ -0,0 +1,90 @@
+# CMake script to embed the flash asset files as one C array
+# Usage: cmake -DASSET_DATA_FILE=asset_data.c -DASSET_INC_FILE=assets.inc
+#              -DASSET_BASE=0xC00000 -DASSET_MAX_SIZE=0x400000
+#              -DASSET_FILES="font.bin|tiles.bin" -P generate_asset_data.cmake
+# Assets are placed in list order, each starting on a 4-byte boundary so
+# block copies out of them move whole words. ASSET_INC_FILE gets the MIA
+# address and size of each, as assembler equates for the 6502 program.
+
+if(NOT ASSET_DATA_FILE OR NOT ASSET_INC_FILE)
+    message(FATAL_ERROR "ASSET_DATA_FILE and ASSET_INC_FILE must be specified")
+endif()
+
+if(NOT ASSET_BASE OR NOT ASSET_MAX_SIZE)
+    message(FATAL_ERROR "ASSET_BASE and ASSET_MAX_SIZE must be specified")
+endif()
+
+include(${CMAKE_CURRENT_LIST_DIR}/c_array.cmake)
+
+# MIA address as a 6502 assembler hex literal ($C00000)
+function(mia_address OFFSET OUT_VAR)
+    math(EXPR ADDRESS "${ASSET_BASE} + ${OFFSET}" OUTPUT_FORMAT HEXADECIMAL)
+    string(SUBSTRING ${ADDRESS} 2 -1 ADDRESS)
+    string(TOUPPER ${ADDRESS} ADDRESS)
+    string(LENGTH ${ADDRESS} ADDRESS_LENGTH)
+    while(ADDRESS_LENGTH LESS 6)
+        set(ADDRESS "0${ADDRESS}")
+        math(EXPR ADDRESS_LENGTH "${ADDRESS_LENGTH} + 1")
+    endwhile()
+    set(${OUT_VAR} "$${ADDRESS}" PARENT_SCOPE)
+endfunction()
+
+# Concatenate the assets, padding each to a word
+set(ASSET_HEX "")
+set(ASSET_SIZE 0)
+set(ASSET_COMMENTS "")
+set(ASSET_EQUATES "")
+if(ASSET_FILES)
+    string(REPLACE "|" ";" ASSET_LIST "${ASSET_FILES}")
+    foreach(ASSET_FILE ${ASSET_LIST})
+        if(NOT EXISTS "${ASSET_FILE}")
+            message(FATAL_ERROR "Asset ${ASSET_FILE} not found")
+        endif()
+        file(READ ${ASSET_FILE} FILE_HEX HEX)
+        file(SIZE ${ASSET_FILE} FILE_SIZE)
+        get_filename_component(FILE_NAME ${ASSET_FILE} NAME_WE)
+        string(TOUPPER ${FILE_NAME} SYMBOL)
+        string(MAKE_C_IDENTIFIER ${SYMBOL} SYMBOL)
+        
+        mia_address(${ASSET_SIZE} ADDRESS)
+        string(APPEND ASSET_COMMENTS "//   ${ADDRESS}  ${FILE_NAME} (${FILE_SIZE} bytes)\n")
+        string(APPEND ASSET_EQUATES "ASSET_${SYMBOL} = ${ADDRESS}\n")
+        string(APPEND ASSET_EQUATES "ASSET_${SYMBOL}_SIZE = ${FILE_SIZE}\n")
+        
+        string(APPEND ASSET_HEX "${FILE_HEX}")
+        math(EXPR ASSET_SIZE "${ASSET_SIZE} + ${FILE_SIZE}")
+        math(EXPR PAD "(4 - ${ASSET_SIZE} % 4) % 4")
+        if(PAD GREATER 0)
+            foreach(i RANGE 1 ${PAD})
+                string(APPEND ASSET_HEX "00")
+            endforeach()
+            math(EXPR ASSET_SIZE "${ASSET_SIZE} + ${PAD}")
+        endif()
+    endforeach()
+endif()
+
+if(ASSET_SIZE GREATER ASSET_MAX_SIZE)
+    message(FATAL_ERROR "Assets take ${ASSET_SIZE} bytes, the asset region holds ${ASSET_MAX_SIZE}")
+endif()
+
+hex_to_c_array("${ASSET_HEX}" C_ARRAY_DATA)
+
+# Write the C file
+file(WRITE ${ASSET_DATA_FILE} "/**\n")
+file(APPEND ${ASSET_DATA_FILE} " * Generated flash asset data\n")
+file(APPEND ${ASSET_DATA_FILE} " * This file is automatically generated during build - do not edit manually\n")
+file(APPEND ${ASSET_DATA_FILE} " */\n\n")
+file(APPEND ${ASSET_DATA_FILE} "#include <stdint.h>\n")
+file(APPEND ${ASSET_DATA_FILE} "#include \"asset_data.h\"\n\n")
+file(APPEND ${ASSET_DATA_FILE} "// Assets by MIA address:\n")
+file(APPEND ${ASSET_DATA_FILE} "${ASSET_COMMENTS}")
+file(APPEND ${ASSET_DATA_FILE} "const uint8_t asset_data[] __attribute__((aligned(4))) = {\n")
+file(APPEND ${ASSET_DATA_FILE} "${C_ARRAY_DATA}\n")
+file(APPEND ${ASSET_DATA_FILE} "};\n\n")
+file(APPEND ${ASSET_DATA_FILE} "const uint32_t asset_data_size = ${ASSET_SIZE};\n")
+
+# Write the assembler equates
+file(WRITE ${ASSET_INC_FILE} "; Generated flash asset addresses - do not edit manually\n")
+file(APPEND ${ASSET_INC_FILE} "${ASSET_EQUATES}")
+
+message(STATUS "Generated asset_data.c with ${ASSET_SIZE} bytes of assets")
@@ -1,5 +1,9 @@
 # CMake script to convert kernel.bin to C array
 # Usage: cmake -DKERNEL_BIN_FILE=kernel.bin -DKERNEL_DATA_FILE=kernel_data.c -P generate_kernel_data.cmake
+# Optional: -DKERNEL_LZ4_FILE=kernel.lz4 embeds the LZ4 block produced by
+# compress_kernel.py instead of the raw image
+# Optional: -DBOOT_IMAGE_FILES="a.bin|b.bin" adds raw images to the boot
+# catalog after kernel.bin
 
 if(NOT KERNEL_BIN_FILE)
     message(FATAL_ERROR "KERNEL_BIN_FILE not specified")
@@ -19,45 +23,40 @@ else()
     message(WARNING "Kernel binary file ${KERNEL_BIN_FILE} not found, generating empty kernel data")
 endif()
 
-# Convert hex string to C array format
-string(LENGTH ${KERNEL_BINARY_DATA} HEX_LENGTH)
-set(C_ARRAY_DATA "")
-set(BYTES_PER_LINE 16)
-set(BYTE_COUNT 0)
+# Uncompressed image size, then switch to the compressed block if requested
+set(KERNEL_IMAGE_SIZE ${KERNEL_SIZE})
+set(KERNEL_COMPRESSED "false")
+if(KERNEL_LZ4_FILE AND EXISTS "${KERNEL_LZ4_FILE}" AND KERNEL_IMAGE_SIZE GREATER 0)
+    file(READ ${KERNEL_LZ4_FILE} KERNEL_BINARY_DATA HEX)
+    file(SIZE ${KERNEL_LZ4_FILE} KERNEL_SIZE)
+    set(KERNEL_COMPRESSED "true")
+endif()
+
+include(${CMAKE_CURRENT_LIST_DIR}/c_array.cmake)
+
+hex_to_c_array("${KERNEL_BINARY_DATA}" C_ARRAY_DATA)
 
-if(HEX_LENGTH GREATER 0)
-    math(EXPR NUM_BYTES "${HEX_LENGTH} / 2")
-    
-    # Process each byte
-    foreach(i RANGE 0 ${NUM_BYTES})
-        math(EXPR BYTE_INDEX "${i} * 2")
-        if(BYTE_INDEX LESS HEX_LENGTH)
-            string(SUBSTRING ${KERNEL_BINARY_DATA} ${BYTE_INDEX} 2 HEX_BYTE)
-            
-            # Add newline and indentation every 16 bytes
-            math(EXPR LINE_POS "${BYTE_COUNT} % ${BYTES_PER_LINE}")
-            if(LINE_POS EQUAL 0)
-                if(BYTE_COUNT GREATER 0)
-                    string(APPEND C_ARRAY_DATA "\n")
-                endif()
-                string(APPEND C_ARRAY_DATA "    ")
-            endif()
-            
-            # Add the byte
-            string(APPEND C_ARRAY_DATA "0x${HEX_BYTE}")
-            
-            # Add comma if not the last byte
-            math(EXPR NEXT_BYTE "${BYTE_COUNT} + 1")
-            if(NEXT_BYTE LESS NUM_BYTES)
-                string(APPEND C_ARRAY_DATA ", ")
-            endif()
-            
-            math(EXPR BYTE_COUNT "${BYTE_COUNT} + 1")
+# Extra boot catalog images (raw, '|'-separated so the list survives the
+# custom command line), embedded after kernel.bin
+set(CATALOG_ARRAYS "")
+set(CATALOG_ENTRIES "    { \"kernel\", kernel_data, ${KERNEL_SIZE}, ${KERNEL_IMAGE_SIZE}, ${KERNEL_COMPRESSED} },\n")
+set(CATALOG_COUNT 1)
+if(BOOT_IMAGE_FILES)
+    string(REPLACE "|" ";" BOOT_IMAGE_LIST "${BOOT_IMAGE_FILES}")
+    foreach(IMAGE_FILE ${BOOT_IMAGE_LIST})
+        if(NOT EXISTS "${IMAGE_FILE}")
+            message(FATAL_ERROR "Boot image ${IMAGE_FILE} not found")
         endif()
+        file(READ ${IMAGE_FILE} IMAGE_HEX HEX)
+        file(SIZE ${IMAGE_FILE} IMAGE_SIZE)
+        get_filename_component(IMAGE_NAME ${IMAGE_FILE} NAME_WE)
+        hex_to_c_array("${IMAGE_HEX}" IMAGE_ARRAY)
+        
+        string(APPEND CATALOG_ARRAYS "// Boot image ${CATALOG_COUNT}: ${IMAGE_NAME} (${IMAGE_SIZE} bytes)\n")
+        string(APPEND CATALOG_ARRAYS "static const uint8_t boot_image_${CATALOG_COUNT}_data[] = {\n${IMAGE_ARRAY}\n};\n\n")
+        string(APPEND CATALOG_ENTRIES "    { \"${IMAGE_NAME}\", boot_image_${CATALOG_COUNT}_data, ${IMAGE_SIZE}, ${IMAGE_SIZE}, false },\n")
+        math(EXPR CATALOG_COUNT "${CATALOG_COUNT} + 1")
     endforeach()
-else()
-    # Empty kernel - add a single zero byte to make valid C array
-    set(C_ARRAY_DATA "    0x00")
 endif()
 
 # Write the C file header
@@ -66,7 +65,9 @@ file(APPEND ${KERNEL_DATA_FILE} " * Generated kernel data from kernel.bin\n")
 file(APPEND ${KERNEL_DATA_FILE} " * This file is automatically generated during build - do not edit manually\n")
 file(APPEND ${KERNEL_DATA_FILE} " */\n\n")
 file(APPEND ${KERNEL_DATA_FILE} "#include <stdint.h>\n")
-file(APPEND ${KERNEL_DATA_FILE} "#include <stddef.h>\n\n")
+file(APPEND ${KERNEL_DATA_FILE} "#include <stddef.h>\n")
+file(APPEND ${KERNEL_DATA_FILE} "#include <stdbool.h>\n")
+file(APPEND ${KERNEL_DATA_FILE} "#include \"kernel_data.h\"\n\n")
 
 # Write the array declaration
 file(APPEND ${KERNEL_DATA_FILE} "// Kernel binary data (${KERNEL_SIZE} bytes)\n")
@@ -74,8 +75,20 @@ file(APPEND ${KERNEL_DATA_FILE} "const uint8_t kernel_data[] = {\n")
 file(APPEND ${KERNEL_DATA_FILE} "${C_ARRAY_DATA}\n")
 file(APPEND ${KERNEL_DATA_FILE} "};\n\n")
 
-# Write the size declaration
-file(APPEND ${KERNEL_DATA_FILE} "// Kernel size\n")
-file(APPEND ${KERNEL_DATA_FILE} "const size_t kernel_data_size = ${KERNEL_SIZE};\n")
+# Write the size declarations
+file(APPEND ${KERNEL_DATA_FILE} "// Kernel size (bytes in kernel_data)\n")
+file(APPEND ${KERNEL_DATA_FILE} "const size_t kernel_data_size = ${KERNEL_SIZE};\n\n")
+file(APPEND ${KERNEL_DATA_FILE} "// Uncompressed kernel size (bytes streamed to the 6502)\n")
+file(APPEND ${KERNEL_DATA_FILE} "const size_t kernel_image_size = ${KERNEL_IMAGE_SIZE};\n\n")
+file(APPEND ${KERNEL_DATA_FILE} "// kernel_data holds an LZ4 block (see compress_kernel.py)\n")
+file(APPEND ${KERNEL_DATA_FILE} "const bool kernel_data_compressed = ${KERNEL_COMPRESSED};\n\n")
+
+# Write the boot catalog (entry 0 is kernel.bin)
+file(APPEND ${KERNEL_DATA_FILE} "${CATALOG_ARRAYS}")
+file(APPEND ${KERNEL_DATA_FILE} "// Boot catalog, selected through the reset control index\n")
+file(APPEND ${KERNEL_DATA_FILE} "const boot_image_t boot_catalog[] = {\n")
+file(APPEND ${KERNEL_DATA_FILE} "${CATALOG_ENTRIES}")
+file(APPEND ${KERNEL_DATA_FILE} "};\n\n")
+file(APPEND ${KERNEL_DATA_FILE} "const uint8_t boot_catalog_count = ${CATALOG_COUNT};\n")
 
-message(STATUS "Generated kernel_data.c with ${KERNEL_SIZE} bytes from ${KERNEL_BIN_FILE}")
\ No newline at end of file
+message(STATUS "Generated kernel_data.c with ${KERNEL_SIZE} bytes (${KERNEL_IMAGE_SIZE} uncompressed) from ${KERNEL_BIN_FILE}, ${CATALOG_COUNT} boot image(s)")
\ No newline at end of file
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+Read and write MIA memory and indexes over Wi-Fi while the 6502 runs.
+
+Usage: mia_mem.py <host> read <address> <length> [--out FILE]
+       mia_mem.py <host> write <address> <file>
+       mia_mem.py <host> index <first> [count]
+
+Talks to the remote memory service (src/network/memory_service.h) on UDP
+port 6503. Reads are a live view; writes are applied by the MIA at the next
+frame boundary and acknowledged then. Requests larger than one datagram are
+split.
+"""
+
+import argparse
+import socket
+import struct
+import sys
+
+MEMORY_PORT = 6503
+MAX_DATA = 1500 - 20 - 8 - 12   # MEMORY_SERVICE_MAX_DATA
+DESCRIPTOR_SIZE = 12
+
+READ, WRITE, INDEX_READ = 0x20, 0x21, 0x22
+REPLY = 0x80
+STATUS = {0x01: "bad request", 0x02: "out of range", 0x03: "busy"}
+
+
+class Service:
+    def __init__(self, host):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.settimeout(1.0)
+        self.addr = (host, MEMORY_PORT)
+        self.tag = 0
+
+    def request(self, kind, address, length, data=b""):
+        """Send one request (again while busy or unanswered), return the reply data"""
+        self.tag += 1
+        packet = struct.pack("<BBHII", kind, 0, length, address, self.tag) + data
+        for _ in range(20):
+            self.sock.sendto(packet, self.addr)
+            try:
+                reply = self.sock.recv(2048)
+            except socket.timeout:
+                continue
+            rtype, status, _, _, tag = struct.unpack_from("<BBHII", reply)
+            if rtype != kind | REPLY or tag != self.tag or status == 0x03:
+                continue
+            if status:
+                sys.exit("error: %s at $%06X" % (STATUS.get(status, "status 0x%02X" % status), address))
+            return reply[12:]
+        sys.exit("error: no reply from %s" % self.addr[0])
+
+    def read(self, address, length):
+        out = bytearray()
+        while len(out) < length:
+            n = min(MAX_DATA, length - len(out))
+            out += self.request(READ, address + len(out), n)
+        return bytes(out)
+
+    def write(self, address, data):
+        for offset in range(0, len(data), MAX_DATA):
+            chunk = data[offset:offset + MAX_DATA]
+            self.request(WRITE, address + offset, len(chunk), chunk)
+
+
+def hexdump(address, data):
+    for offset in range(0, len(data), 16):
+        row = data[offset:offset + 16]
+        print("%06X  %-48s %s" % (address + offset, " ".join("%02X" % b for b in row),
+                                  "".join(chr(b) if 32 <= b < 127 else "." for b in row)))
+
+
+def main():
+    number = lambda s: int(s, 0)
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("host")
+    sub = parser.add_subparsers(dest="command", required=True)
+    read = sub.add_parser("read")
+    read.add_argument("address", type=number)
+    read.add_argument("length", type=number)
+    read.add_argument("--out", help="save the bytes instead of dumping them")
+    write = sub.add_parser("write")
+    write.add_argument("address", type=number)
+    write.add_argument("file")
+    index = sub.add_parser("index")
+    index.add_argument("first", type=number)
+    index.add_argument("count", type=number, nargs="?", default=1)
+    args = parser.parse_args()
+
+    service = Service(args.host)
+    if args.command == "read":
+        data = service.read(args.address, args.length)
+        if args.out:
+            with open(args.out, "wb") as f:
+                f.write(data)
+        else:
+            hexdump(args.address, data)
+    elif args.command == "write":
+        with open(args.file, "rb") as f:
+            service.write(args.address, f.read())
+    else:
+        data = service.request(INDEX_READ, args.first, args.count)
+        for i in range(args.count):
+            d = data[i * DESCRIPTOR_SIZE:(i + 1) * DESCRIPTOR_SIZE]
+            addr, default, limit = (d[j] | d[j + 1] << 8 | d[j + 2] << 16 for j in (0, 3, 6))
+            print("%3d  addr $%06X  default $%06X  limit $%06X  step %d  flags $%02X" %
+                  (args.first + i, addr, default, limit, d[9], d[10]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
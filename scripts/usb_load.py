@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""
+Load a file into the MIA user area over the USB loader interface.
+
+Usage: usb_load.py <file> [--offset N]
+
+The offset is counted from the start of the user area (MIA address
+$013800). The MIA raises IRQ_USB_LOAD when the data is in, and the 6502
+finds its address and length in the status block at index 66. Requires
+pyusb and the MIA in USB device mode.
+"""
+
+import argparse
+import struct
+import sys
+
+import usb.core
+import usb.util
+
+VENDOR_ID = 0xCAFE
+PRODUCT_ID = 0x4001
+LOADER_INTERFACE = 2            # ITF_NUM_VENDOR in src/usb/usb_descriptors.c
+LOADER_MAGIC = 0x4C41494D       # "MIAL"
+USER_AREA_SIZE = 0x28800
+
+STATES = {0x02: "done", 0x03: "rejected"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("file")
+    parser.add_argument("--offset", type=lambda s: int(s, 0), default=0,
+                        help="destination, from the start of the user area")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as f:
+        data = f.read()
+    if not data or args.offset + len(data) > USER_AREA_SIZE:
+        sys.exit("error: %d bytes at offset 0x%X do not fit the user area" % (len(data), args.offset))
+
+    dev = usb.core.find(idVendor=VENDOR_ID, idProduct=PRODUCT_ID)
+    if dev is None:
+        sys.exit("error: MIA not found")
+
+    intf = dev.get_active_configuration()[(LOADER_INTERFACE, 0)]
+    ep_out = usb.util.find_descriptor(intf, custom_match=lambda e:
+                                      usb.util.endpoint_direction(e.bEndpointAddress) == usb.util.ENDPOINT_OUT)
+    ep_in = usb.util.find_descriptor(intf, custom_match=lambda e:
+                                     usb.util.endpoint_direction(e.bEndpointAddress) == usb.util.ENDPOINT_IN)
+
+    ep_out.write(struct.pack("<III", LOADER_MAGIC, args.offset, len(data)) + data)
+    state = ep_in.read(1, timeout=5000)[0]
+    print("%s: %d bytes at $%06X %s" % (args.file, len(data), 0x13800 + args.offset,
+                                        STATES.get(state, "state 0x%02X" % state)))
+    return 0 if state == 0x02 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -9,8 +9,11 @@
  */
 
 #include "bus_interface.h"
+#include "bus_write_queue.h"
+#include "bus_timing.h"
 #include "indexed_memory/indexed_memory.h"
 #include "irq/irq.h"
+#include "config/bus_config.h"
 #include <stddef.h>
 #include <string.h>
 
@@ -20,7 +23,386 @@
 
 // Global window state array supporting up to 8 windows (A-H)
 // Exposed for direct access - window_num is always valid (0-7) from address decoding
-window_state_t g_window_state[MAX_WINDOWS];
+BUS_HOT_DATA window_state_t g_window_state[MAX_WINDOWS];
+
+// Windows currently holding a loaded burst cursor (bit per window)
+static BUS_HOT_DATA uint8_t burst_holders;
+
+/**
+ * Configuration field selected by a window, without the auto-increment bit
+ */
+static inline uint8_t cfg_field(const window_state_t *win) {
+    return win->config_field_select & (uint8_t)~CFG_FIELD_AUTO_INCREMENT;
+}
+
+/**
+ * Step the selected field after a CFG_DATA access in auto-increment mode
+ */
+static inline void cfg_field_advance(window_state_t *win) {
+    if (win->config_field_select & CFG_FIELD_AUTO_INCREMENT) {
+        win->config_field_select = CFG_FIELD_AUTO_INCREMENT |
+            ((win->config_field_select + 1) & (uint8_t)~CFG_FIELD_AUTO_INCREMENT);
+    }
+}
+
+// ============================================================================
+// DATA_PORT Burst Cursors
+// ============================================================================
+
+/**
+ * Write every loaded burst cursor back to its index
+ * Called before anything that reads or changes index state outside the
+ * DATA_PORT path
+ */
+static void BUS_HOT_FUNC(burst_flush_all)(void) {
+    while (burst_holders) {
+        uint8_t w = (uint8_t)__builtin_ctz(burst_holders);
+        window_state_t *win = get_window_state(w);
+        indexed_memory_burst_end(&win->burst);
+        win->burst_loaded = false;
+        burst_holders &= (uint8_t)~(1u << w);
+    }
+}
+
+/**
+ * Get the burst cursor of a window, loading it on first use
+ * 
+ * @return Cursor, or NULL to use the per-access indexed memory path
+ */
+static inline indexed_memory_burst_t *burst_cursor(uint8_t window_num) {
+    window_state_t *win = get_window_state(window_num);
+    
+    if (win->burst_loaded) {
+        return &win->burst;
+    }
+    if (!win->burst_enabled) {
+        return NULL;
+    }
+    
+    // A window sharing the index would see a stale current address
+    for (uint8_t w = 0; w < MAX_WINDOWS; w++) {
+        if (w != window_num && g_window_state[w].active_index == win->active_index) {
+            return NULL;
+        }
+    }
+    
+    if (!indexed_memory_burst_begin(win->active_index, &win->burst)) {
+        return NULL;
+    }
+    win->burst_loaded = true;
+    burst_holders |= (uint8_t)(1u << window_num);
+    return &win->burst;
+}
+
+// ============================================================================
+// Bank Windows
+// ============================================================================
+
+/**
+ * MIA address of bank byte 0 of a window, also the byte its DATA_PORT shows
+ * Only this window can hold a burst cursor for its own index
+ */
+static inline uint32_t bank_base(const window_state_t *win) {
+    return win->burst_loaded ? win->burst.addr : indexed_memory_get_address(win->active_index);
+}
+
+// ============================================================================
+// Read Response Shadow
+// ============================================================================
+
+// Shadow of every readable register, indexed by local address
+// Reserved and write-only registers stay 0
+BUS_HOT_DATA uint8_t g_bus_read_shadow[256];
+
+// State generations the shadow was last rebuilt from
+static BUS_HOT_DATA uint32_t shadow_irq_generation;
+static BUS_HOT_DATA uint32_t shadow_memory_generation;
+
+#ifdef CONFIG_MIA_PSRAM
+BUS_HOT_DATA uint8_t g_bus_data_wait;
+static BUS_HOT_DATA uint8_t shadow_bank_wait;   // Same for the bank bytes
+
+/**
+ * Whether a window's DATA_PORT or bank bytes read a PSRAM page not cached
+ * yet, from the current state
+ */
+static inline bool data_port_waits(const window_state_t *win) {
+    return !win->burst_loaded && !indexed_memory_address_ready(indexed_memory_get_address(win->active_index));
+}
+
+static inline bool bank_waits(const window_state_t *win) {
+    // Pages are larger than a bank, so its ends cover it
+    uint32_t base = bank_base(win);
+    return win->bank_enabled && (!indexed_memory_address_ready(base) ||
+                                 !indexed_memory_address_ready(base + BANK_WINDOW_SIZE - 1));
+}
+
+/**
+ * PSRAM_WAIT as the shadow shows it
+ */
+static inline uint8_t shadow_wait_status(void) {
+    return (g_bus_data_wait | shadow_bank_wait) ? STATUS_PSRAM_WAIT : 0;
+}
+
+/**
+ * Record the wait state of a window and update DEVICE_STATUS with it
+ */
+static inline void shadow_set_wait(uint8_t window_num, bool data_port, bool bank) {
+    uint8_t bit = (uint8_t)(1u << window_num);
+    g_bus_data_wait = data_port ? (g_bus_data_wait | bit) : (g_bus_data_wait & ~bit);
+    shadow_bank_wait = bank ? (shadow_bank_wait | bit) : (shadow_bank_wait & ~bit);
+    g_bus_read_shadow[REG_DEVICE_STATUS] =
+        (g_bus_read_shadow[REG_DEVICE_STATUS] & ~STATUS_PSRAM_WAIT) | shadow_wait_status();
+}
+
+/**
+ * PSRAM_WAIT from the current state, for the live path
+ */
+static uint8_t live_wait_status(void) {
+    for (uint8_t w = 0; w < MAX_WINDOWS; w++) {
+        const window_state_t *win = get_window_state(w);
+        if (data_port_waits(win) || bank_waits(win)) {
+            return STATUS_PSRAM_WAIT;
+        }
+    }
+    return 0;
+}
+#else
+static inline uint8_t shadow_wait_status(void) {
+    return 0;
+}
+
+static inline uint8_t live_wait_status(void) {
+    return 0;
+}
+#endif
+
+/**
+ * Refresh shared register entries (0xF0-0xF8)
+ */
+static void BUS_HOT_FUNC(shadow_refresh_shared)(void) {
+    g_bus_read_shadow[REG_DEVICE_STATUS] = indexed_memory_get_status() | shadow_wait_status() |
+                                           (irq_is_pending() ? STATUS_IRQ_PENDING : 0);
+    g_bus_read_shadow[REG_IRQ_CAUSE_LOW] = irq_get_cause_low();
+    g_bus_read_shadow[REG_IRQ_CAUSE_HIGH] = irq_get_cause_high();
+    g_bus_read_shadow[REG_IRQ_MASK_LOW] = irq_get_mask_low();
+    g_bus_read_shadow[REG_IRQ_MASK_HIGH] = irq_get_mask_high();
+    g_bus_read_shadow[REG_IRQ_ENABLE] = irq_get_enable();
+    g_bus_read_shadow[REG_WRITE_QUEUE_OVERFLOW] = bus_write_queue_get_overflow();
+    g_bus_read_shadow[REG_WRITE_QUEUE_EARLY_READS] = bus_write_queue_get_early_reads();
+    g_bus_read_shadow[REG_TIMING_SELECT] = bus_timing_get_select();
+    g_bus_read_shadow[REG_TIMING_DATA] = bus_timing_peek();
+    g_bus_read_shadow[REG_IRQ_VECTOR] = irq_get_vector();
+    g_bus_read_shadow[REG_IRQ_VECTOR_ACK] = irq_get_vector();
+}
+
+/**
+ * DATA_PORT read value of a window
+ */
+static inline uint8_t shadow_data_port(window_state_t *win) {
+    return win->burst_loaded ? indexed_memory_burst_peek(&win->burst)
+                             : indexed_memory_peek(win->active_index);
+}
+
+/**
+ * CFG_DATA read value of a window
+ */
+static inline uint8_t shadow_cfg_data(window_state_t *win) {
+    return win->burst_loaded ? indexed_memory_burst_get_config_field(&win->burst, cfg_field(win))
+                             : indexed_memory_get_config_field(win->active_index, cfg_field(win));
+}
+
+/**
+ * Refresh the readable registers of one window
+ */
+static void BUS_HOT_FUNC(shadow_refresh_window)(uint8_t window_num) {
+    window_state_t *win = get_window_state(window_num);
+    uint8_t *regs = &g_bus_read_shadow[window_num << 4];
+    
+    regs[REG_OFFSET_IDX_SELECT] = win->active_index;
+    regs[REG_OFFSET_CFG_FIELD_SELECT] = win->config_field_select;
+    regs[REG_OFFSET_DATA_PORT] = shadow_data_port(win);
+    regs[REG_OFFSET_CFG_DATA] = shadow_cfg_data(win);
+    if (win->bank_enabled) {
+        uint32_t base = bank_base(win);
+        for (uint8_t i = 0; i < BANK_WINDOW_SIZE; i++) {
+            regs[REG_OFFSET_BANK + i] = indexed_memory_peek_address(base + i);
+        }
+    }
+#ifdef CONFIG_MIA_PSRAM
+    shadow_set_wait(window_num, data_port_waits(win), bank_waits(win));
+#endif
+}
+
+/**
+ * Refresh all windows
+ * Used after writes that may change memory or index state seen by any window
+ */
+static void BUS_HOT_FUNC(shadow_refresh_windows)(void) {
+    for (uint8_t w = 0; w < MAX_WINDOWS; w++) {
+        shadow_refresh_window(w);
+    }
+}
+
+/**
+ * Refresh the entries showing the byte at addr, after a write to it
+ * A window sees the byte only through its DATA_PORT or its bank bytes
+ */
+static void BUS_HOT_FUNC(shadow_refresh_byte)(uint32_t addr) {
+    for (uint8_t w = 0; w < MAX_WINDOWS; w++) {
+        window_state_t *win = get_window_state(w);
+        uint32_t base = bank_base(win);
+        if (base == addr) {
+            g_bus_read_shadow[(w << 4) | REG_OFFSET_DATA_PORT] = shadow_data_port(win);
+        }
+        if (win->bank_enabled && addr - base < BANK_WINDOW_SIZE) {
+            g_bus_read_shadow[(w << 4) | (REG_OFFSET_BANK + addr - base)] = indexed_memory_peek_address(addr);
+        }
+#ifdef CONFIG_MIA_PSRAM
+        // The write may have gone to a page evicted since the last rebuild
+        if (base == addr || (win->bank_enabled && addr - base < BANK_WINDOW_SIZE)) {
+            shadow_set_wait(w, data_port_waits(win), bank_waits(win));
+        }
+#endif
+    }
+}
+
+/**
+ * Refresh CFG_DATA of every window, after a write to a copy field
+ * The copy fields are shared by all indexes
+ */
+static void BUS_HOT_FUNC(shadow_refresh_cfg_data)(void) {
+    for (uint8_t w = 0; w < MAX_WINDOWS; w++) {
+        g_bus_read_shadow[(w << 4) | REG_OFFSET_CFG_DATA] = shadow_cfg_data(get_window_state(w));
+    }
+}
+
+/**
+ * Source or destination index of the copy commands (CFG_COPY_SRC_IDX or
+ * CFG_COPY_DST_IDX); the copy fields read the same through any index
+ */
+static inline uint8_t copy_index(uint8_t field) {
+    return indexed_memory_get_config_field(0, field);
+}
+
+/**
+ * Refresh only the windows that have idx selected
+ * After anything that moves or reconfigures idx without writing memory,
+ * such as a DATA_PORT read step
+ */
+static void BUS_HOT_FUNC(shadow_refresh_index)(uint8_t idx) {
+    for (uint8_t w = 0; w < MAX_WINDOWS; w++) {
+        if (g_window_state[w].active_index == idx) {
+            shadow_refresh_window(w);
+        }
+    }
+}
+
+void BUS_HOT_FUNC(bus_interface_refresh_shadow)(void) {
+    // Sample generations first so changes made while rebuilding are
+    // picked up by the next sync
+    shadow_memory_generation = indexed_memory_get_generation();
+    shadow_irq_generation = irq_get_generation();
+    
+    shadow_refresh_windows();
+    shadow_refresh_shared();
+}
+
+bool BUS_HOT_FUNC(bus_interface_shadow_stale)(void) {
+    return indexed_memory_get_generation() != shadow_memory_generation ||
+           irq_get_generation() != shadow_irq_generation;
+}
+
+void BUS_HOT_FUNC(bus_interface_sync_shadow)(void) {
+    uint32_t memory_generation = indexed_memory_get_generation();
+    uint32_t irq_generation = irq_get_generation();
+    
+    if (memory_generation != shadow_memory_generation) {
+        // Memory, indexes or status changed: rebuild everything
+        shadow_memory_generation = memory_generation;
+        shadow_irq_generation = irq_generation;
+        shadow_refresh_windows();
+        shadow_refresh_shared();
+    } else if (irq_generation != shadow_irq_generation) {
+        // Only IRQ state changed: shared registers are enough
+        shadow_irq_generation = irq_generation;
+        shadow_refresh_shared();
+    }
+}
+
+void BUS_HOT_FUNC(bus_interface_commit_read)(uint8_t local_addr) {
+    // TIMING_DATA reads advance the snapshot offset
+    if (local_addr == REG_TIMING_DATA) {
+        bus_timing_advance();
+        shadow_refresh_shared();
+        return;
+    }
+    
+    // IRQ_VECTOR_ACK reads acknowledge the cause of the vector sent, which
+    // is still in the shadow (not refreshed between peek and commit)
+    if (local_addr == REG_IRQ_VECTOR_ACK) {
+        irq_acknowledge_vector(g_bus_read_shadow[REG_IRQ_VECTOR_ACK]);
+        shadow_refresh_shared();
+        return;
+    }
+    
+    // CFG_DATA reads step the field in auto-increment mode
+    if ((local_addr & 0x80) == 0 && (local_addr & 0x0F) == REG_OFFSET_CFG_DATA) {
+        uint8_t window_num = (local_addr >> 4) & 0x07;
+        window_state_t *win = get_window_state(window_num);
+        if (win->config_field_select & CFG_FIELD_AUTO_INCREMENT) {
+            cfg_field_advance(win);
+            shadow_refresh_window(window_num);
+        }
+        return;
+    }
+    
+    // Otherwise only DATA_PORT reads have side effects (auto-step)
+    if ((local_addr & 0x80) == 0 && (local_addr & 0x0F) == REG_OFFSET_DATA_PORT) {
+        uint8_t window_num = (local_addr >> 4) & 0x07;
+        indexed_memory_burst_t *burst = burst_cursor(window_num);
+        if (burst) {
+            // No other window has a cached index selected
+            indexed_memory_burst_commit_read(burst);
+            shadow_refresh_window(window_num);
+            return;
+        }
+        uint8_t idx = get_window_state(window_num)->active_index;
+        indexed_memory_commit_read(idx);
+        shadow_refresh_index(idx);
+        return;
+    }
+    
+    // Bank reads do not step, only out-of-range addresses are reported
+    if ((local_addr & 0x80) == 0 && (local_addr & 0x0F) >= REG_OFFSET_BANK) {
+        window_state_t *win = get_window_state((local_addr >> 4) & 0x07);
+        if (win->bank_enabled) {
+            indexed_memory_read_address(bank_base(win) + (local_addr & 0x0F) - REG_OFFSET_BANK);
+        }
+    }
+}
+
+void BUS_HOT_FUNC(bus_interface_load_descriptor)(uint8_t idx, const uint8_t *desc) {
+    // A cursor written back later would undo the new configuration
+    burst_flush_all();
+    indexed_memory_set_descriptor(idx, desc);
+    shadow_refresh_index(idx);
+}
+
+void BUS_HOT_FUNC(bus_interface_commit_queued_read)(uint8_t local_addr, uint8_t data) {
+    // The shadow may have moved on since the vector was sent
+    if (local_addr == REG_IRQ_VECTOR_ACK) {
+        irq_acknowledge_vector(data);
+        shadow_refresh_shared();
+        return;
+    }
+    bus_interface_commit_read(local_addr);
+}
+
+void BUS_HOT_FUNC(bus_interface_count_early_read)(void) {
+    bus_write_queue_count_early_read();
+    g_bus_read_shadow[REG_WRITE_QUEUE_EARLY_READS] = bus_write_queue_get_early_reads();
+}
 
 // ============================================================================
 // Register Handler Functions
@@ -35,6 +417,11 @@ window_state_t g_window_state[MAX_WINDOWS];
  */
 static inline uint8_t read_data_port(uint8_t window_num) {
     window_state_t *win = get_window_state(window_num);
+    // Burst mode: pointer bump on the cached cursor
+    indexed_memory_burst_t *burst = burst_cursor(window_num);
+    if (burst) {
+        return indexed_memory_burst_read(burst);
+    }
     // Read byte from index with auto-stepping
     // this function handles auto-stepping based on index configuration
     return indexed_memory_read(win->active_index);
@@ -49,6 +436,12 @@ static inline uint8_t read_data_port(uint8_t window_num) {
  */
 static inline void write_data_port(uint8_t window_num, uint8_t data) {
     window_state_t *win = get_window_state(window_num);
+    // Burst mode: pointer bump on the cached cursor
+    indexed_memory_burst_t *burst = burst_cursor(window_num);
+    if (burst) {
+        indexed_memory_burst_write(burst, data);
+        return;
+    }
     // Write byte to index with auto-stepping
     // indexed_memory_write() handles auto-stepping based on index configuration
     indexed_memory_write(win->active_index, data);
@@ -59,7 +452,10 @@ static inline void write_data_port(uint8_t window_num, uint8_t data) {
  */
 static inline uint8_t read_cfg_data(uint8_t window_num) {
     window_state_t *win = get_window_state(window_num);
-    return indexed_memory_get_config_field(win->active_index, win->config_field_select);
+    burst_flush_all();
+    uint8_t data = indexed_memory_get_config_field(win->active_index, cfg_field(win));
+    cfg_field_advance(win);
+    return data;
 }
 
 /**
@@ -67,7 +463,9 @@ static inline uint8_t read_cfg_data(uint8_t window_num) {
  */
 static inline void write_cfg_data(uint8_t window_num, uint8_t data) {
     window_state_t *win = get_window_state(window_num);
-    indexed_memory_set_config_field(win->active_index, win->config_field_select, data);
+    burst_flush_all();
+    indexed_memory_set_config_field(win->active_index, cfg_field(win), data);
+    cfg_field_advance(win);
 }
 
 // ============================================================================
@@ -77,12 +475,20 @@ static inline void write_cfg_data(uint8_t window_num, uint8_t data) {
 void bus_interface_init(void) {
     // Initialize all window states to default values
     memset(g_window_state, 0, sizeof(g_window_state));
+    burst_holders = 0;
     
     // Set default active index for all windows to 0
     for (int i = 0; i < MAX_WINDOWS; i++) {
         g_window_state[i].active_index = 0;
         g_window_state[i].config_field_select = 0;
     }
+    
+    // Timing statistics start empty
+    bus_timing_init();
+    
+    // Build the read shadow from current state
+    memset(g_bus_read_shadow, 0, sizeof(g_bus_read_shadow));
+    bus_interface_refresh_shadow();
 }
 
 // ============================================================================
@@ -92,7 +498,7 @@ void bus_interface_init(void) {
 /**
  * Handle a READ operation from the 6502 bus 
  */
-uint8_t __attribute__((optimize("O3"))) __attribute__((hot)) bus_interface_read(uint8_t local_addr) {
+uint8_t __attribute__((optimize("O3"))) __attribute__((hot)) BUS_HOT_FUNC(bus_interface_read)(uint8_t local_addr) {
     // Decode 8-bit local address
     bool is_shared = (local_addr & 0x80) != 0;
     uint8_t window_num = (local_addr >> 4) & 0x07;
@@ -102,7 +508,8 @@ uint8_t __attribute__((optimize("O3"))) __attribute__((hot)) bus_interface_read(
     if (is_shared) {
         // Handle shared register reads
         if (local_addr == REG_DEVICE_STATUS) {
-            return indexed_memory_get_status() | (irq_is_pending() ? STATUS_IRQ_PENDING : 0);
+            return indexed_memory_get_status() | live_wait_status() |
+                   (irq_is_pending() ? STATUS_IRQ_PENDING : 0);
         } else if (local_addr == REG_IRQ_CAUSE_LOW) {
             return irq_get_cause_low();
         } else if (local_addr == REG_IRQ_CAUSE_HIGH) {
@@ -113,6 +520,20 @@ uint8_t __attribute__((optimize("O3"))) __attribute__((hot)) bus_interface_read(
             return irq_get_mask_high();
         } else if (local_addr == REG_IRQ_ENABLE) {
             return irq_get_enable();
+        } else if (local_addr == REG_WRITE_QUEUE_OVERFLOW) {
+            return bus_write_queue_get_overflow();
+        } else if (local_addr == REG_WRITE_QUEUE_EARLY_READS) {
+            return bus_write_queue_get_early_reads();
+        } else if (local_addr == REG_TIMING_SELECT) {
+            return bus_timing_get_select();
+        } else if (local_addr == REG_TIMING_DATA) {
+            uint8_t data = bus_timing_peek();
+            bus_timing_advance();
+            return data;
+        } else if (local_addr == REG_IRQ_VECTOR) {
+            return irq_get_vector();
+        } else if (local_addr == REG_IRQ_VECTOR_ACK) {
+            return irq_acknowledge_vector(irq_get_vector());
         } else {
             // Reserved shared register or write-only register
             return 0x00;
@@ -129,13 +550,16 @@ uint8_t __attribute__((optimize("O3"))) __attribute__((hot)) bus_interface_read(
         return read_cfg_data(window_num);
     } else if (reg_offset == REG_OFFSET_CFG_FIELD_SELECT) {
         return get_window_state(window_num)->config_field_select;
+    } else if (reg_offset >= REG_OFFSET_BANK && get_window_state(window_num)->bank_enabled) {
+        window_state_t *win = get_window_state(window_num);
+        return indexed_memory_read_address(bank_base(win) + reg_offset - REG_OFFSET_BANK);
     } else {
         // Reserved register offset (5-15) or write-only COMMAND register
         return 0x00;
     }
 }
 
-void bus_interface_write(uint8_t local_addr, uint8_t data) {
+void BUS_HOT_FUNC(bus_interface_write)(uint8_t local_addr, uint8_t data) {
     // Decode 8-bit local address
     bool is_shared = (local_addr & 0x80) != 0;
     uint8_t window_num = (local_addr >> 4) & 0x07;
@@ -169,14 +593,41 @@ void bus_interface_write(uint8_t local_addr, uint8_t data) {
                 irq_set_enable(data);
                 break;
                 
+            case REG_WRITE_QUEUE_OVERFLOW:
+                // Any write clears the dropped-write counter
+                bus_write_queue_clear_overflow();
+                break;
+                
+            case REG_WRITE_QUEUE_EARLY_READS:
+                // Any write clears the early READ counter
+                bus_write_queue_clear_early_reads();
+                break;
+                
+            case REG_TIMING_SELECT:
+                bus_timing_select(data);
+                break;
+                
+            case REG_TIMING_DATA:
+                // Any write clears the timing statistics
+                bus_timing_reset();
+                break;
+                
             case REG_SHARED_COMMAND:
+                // Copies and resets work on the index table
+                burst_flush_all();
                 indexed_memory_execute_shared_command(data);
+                // Copies with FLAG_COPY_ADVANCE move their indexes; the
+                // resets run later and bump the generation when done
+                shadow_refresh_index(copy_index(CFG_COPY_SRC_IDX));
+                shadow_refresh_index(copy_index(CFG_COPY_DST_IDX));
                 break;
                 
             default:
                 // Reserved shared register - ignore writes
                 break;
         }
+        
+        shadow_refresh_shared();
         return;
     }
     
@@ -184,30 +635,80 @@ void bus_interface_write(uint8_t local_addr, uint8_t data) {
     // Route to appropriate register handler based on offset
     switch (reg_offset) {
         case REG_OFFSET_IDX_SELECT:
+            burst_flush_all();
             get_window_state(window_num)->active_index = data;
+            shadow_refresh_window(window_num);
             break;
             
         case REG_OFFSET_DATA_PORT:
-            write_data_port(window_num, data);
+            {
+                window_state_t *win = get_window_state(window_num);
+                uint32_t addr = bank_base(win);
+                write_data_port(window_num, data);
+                shadow_refresh_byte(addr);
+                // The written index stepped; a cached one is selected
+                // by no other window
+                if (win->burst_loaded) {
+                    shadow_refresh_window(window_num);
+                } else {
+                    shadow_refresh_index(win->active_index);
+                }
+            }
             break;
             
         case REG_OFFSET_CFG_FIELD_SELECT:
             get_window_state(window_num)->config_field_select = data;
+            shadow_refresh_window(window_num);
             break;
             
         case REG_OFFSET_CFG_DATA:
-            write_cfg_data(window_num, data);
+            {
+                window_state_t *win = get_window_state(window_num);
+                uint8_t field = cfg_field(win);
+                write_cfg_data(window_num, data);
+                if (field > CFG_FLAGS && field < CFG_ROW_WIDTH) {
+                    shadow_refresh_cfg_data();
+                }
+                shadow_refresh_index(win->active_index);
+            }
             break;
             
         case REG_OFFSET_COMMAND:
             {
-                uint8_t idx = get_window_state(window_num)->active_index;
-                indexed_memory_execute_window_command(idx, data);
+                window_state_t *win = get_window_state(window_num);
+                burst_flush_all();
+                if (data == CMD_BURST_ENABLE) {
+                    win->burst_enabled = true;
+                } else if (data == CMD_BURST_DISABLE) {
+                    win->burst_enabled = false;
+                } else if (data == CMD_BANK_ENABLE) {
+                    win->bank_enabled = true;
+                } else if (data == CMD_BANK_DISABLE) {
+                    // Offsets +5..+15 read as reserved (0) again
+                    win->bank_enabled = false;
+                    memset(&g_bus_read_shadow[(window_num << 4) | REG_OFFSET_BANK], 0, BANK_WINDOW_SIZE);
+                } else {
+                    indexed_memory_execute_window_command(win->active_index, data);
+                    // CMD_LOAD_DESCRIPTOR steps its source index
+                    if (data == CMD_LOAD_DESCRIPTOR) {
+                        shadow_refresh_index(copy_index(CFG_COPY_SRC_IDX));
+                    }
+                    shadow_refresh_index(win->active_index);
+                }
+                shadow_refresh_window(window_num);
             }
             break;
             
         default:
-            // Reserved register offset (5-15) - ignore writes
+            // Bank window byte, otherwise a reserved offset (writes ignored)
+            {
+                window_state_t *win = get_window_state(window_num);
+                if (win->bank_enabled) {
+                    uint32_t addr = bank_base(win) + reg_offset - REG_OFFSET_BANK;
+                    indexed_memory_write_address(addr, data);
+                    shadow_refresh_byte(addr);
+                }
+            }
             break;
     }
 }
@@ -9,16 +9,19 @@
  * - Window B: 0x10-0x1F (16 registers, 0-4 active, 5-15 reserved)
  * - Window C: 0x20-0x2F (16 registers, 0-4 active, 5-15 reserved)
  * - Window D: 0x30-0x3F (16 registers, 0-4 active, 5-15 reserved)
- * - Reserved: 0x40-0x7F (future window expansion E-H)
+ * - Window E: 0x40-0x4F (16 registers, 0-4 active, 5-15 reserved)
+ * - Window F: 0x50-0x5F (16 registers, 0-4 active, 5-15 reserved)
+ * - Window G: 0x60-0x6F (16 registers, 0-4 active, 5-15 reserved)
+ * - Window H: 0x70-0x7F (16 registers, 0-4 active, 5-15 reserved)
  * - Shared:   0x80-0xFF (128 bytes, active from 0xF0-0xFF)
  * 
- * Register Layout (Windows A-D):
+ * Register Layout (Windows A-H):
  * - +0: IDX_SELECT - Select active index (0-255)
  * - +1: DATA_PORT - Read/write byte at current index address with auto-step
  * - +2: CFG_FIELD_SELECT - Select configuration field
  * - +3: CFG_DATA - Read/write selected configuration field
  * - +4: COMMAND - Issue control commands
- * - +5-15: Reserved for future use
+ * - +5-15: Bank window bytes 0-10 (CMD_BANK_ENABLE), otherwise reserved
  * 
  * Shared Register Layout (0xF0-0xFF):
  * - 0xF0: DEVICE_STATUS - Global device status
@@ -27,7 +30,14 @@
  * - 0xF3: IRQ_MASK_LOW - Interrupt mask low byte
  * - 0xF4: IRQ_MASK_HIGH - Interrupt mask high byte
  * - 0xF5: IRQ_ENABLE - Global interrupt enable
- * - 0xF6-0xFF: Reserved shared registers
+ * - 0xF6: WRITE_QUEUE_OVERFLOW - Dropped bus writes (read: count, write: clear)
+ * - 0xF7: TIMING_SELECT - Bus timing snapshot offset (write latches a snapshot)
+ * - 0xF8: TIMING_DATA - Bus timing snapshot byte (read advances, write clears)
+ * - 0xF9: IRQ_VECTOR - Jump table offset of the highest-priority pending IRQ
+ * - 0xFA: IRQ_VECTOR_ACK - Same, and a read acknowledges that IRQ
+ * - 0xFB: WRITE_QUEUE_EARLY_READS - READs answered ahead of a queued write (read: count, write: clear)
+ * - 0xFC-0xFE: Reserved shared registers
+ * - 0xFF: SHARED_COMMAND - System-wide command register
  */
 
 #ifndef BUS_INTERFACE_H
@@ -35,6 +45,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "indexed_memory/indexed_memory.h"
+#include "config/memory_config.h"
 
 // ============================================================================
 // Register Address Constants
@@ -49,6 +61,10 @@
 #define WINDOW_B_BASE           0x10    // Window B: 0x10-0x1F
 #define WINDOW_C_BASE           0x20    // Window C: 0x20-0x2F
 #define WINDOW_D_BASE           0x30    // Window D: 0x30-0x3F
+#define WINDOW_E_BASE           0x40    // Window E: 0x40-0x4F
+#define WINDOW_F_BASE           0x50    // Window F: 0x50-0x5F
+#define WINDOW_G_BASE           0x60    // Window G: 0x60-0x6F
+#define WINDOW_H_BASE           0x70    // Window H: 0x70-0x7F
 #define SHARED_BASE             0x80    // Shared registers: 0x80-0xFF
 
 // Active shared register addresses (0xF0-0xFF)
@@ -58,7 +74,13 @@
 #define REG_IRQ_MASK_LOW        0xF3    // Shared: Interrupt mask low byte
 #define REG_IRQ_MASK_HIGH       0xF4    // Shared: Interrupt mask high byte
 #define REG_IRQ_ENABLE          0xF5    // Shared: Global interrupt enable
-// 0xF6-0xFE: Reserved shared registers
+#define REG_WRITE_QUEUE_OVERFLOW 0xF6   // Shared: Dropped bus writes (saturating, write clears)
+#define REG_TIMING_SELECT       0xF7    // Shared: Bus timing snapshot offset (see bus_timing.h)
+#define REG_TIMING_DATA         0xF8    // Shared: Bus timing snapshot data
+#define REG_IRQ_VECTOR          0xF9    // Shared: IRQ_VECTOR_* of the highest-priority pending IRQ (read-only)
+#define REG_IRQ_VECTOR_ACK      0xFA    // Shared: Same, the read clears that cause
+#define REG_WRITE_QUEUE_EARLY_READS 0xFB // Shared: READs answered ahead of a queued write (saturating, write clears)
+// 0xFC-0xFE: Reserved shared registers
 #define REG_SHARED_COMMAND      0xFF    // Shared: System-wide command register
 
 // Register offsets within 16-byte window (0-15 for each window)
@@ -67,7 +89,15 @@
 #define REG_OFFSET_CFG_FIELD_SELECT 0x02
 #define REG_OFFSET_CFG_DATA         0x03
 #define REG_OFFSET_COMMAND          0x04
-// Offsets 0x05-0x0F are reserved for future use
+#define REG_OFFSET_BANK             0x05    // Bank window byte 0 (0x05-0x0F, reserved unless enabled)
+
+// Bank window: offsets REG_OFFSET_BANK + n read and write the byte at the
+// active index's current address + n, with no auto-step
+#define BANK_WINDOW_SIZE            11
+
+// CFG_FIELD_SELECT bit 7: step the selected field after every CFG_DATA
+// access, so consecutive fields load with CFG_DATA writes only
+#define CFG_FIELD_AUTO_INCREMENT    0x80
 
 // Performance optimization macros for critical path
 #define get_window_state(window_num) (&g_window_state[window_num])
@@ -85,7 +115,7 @@
  * 
  * Window number extraction:
  *   window_num = (local_addr >> 4) & 0x07
- *   Bits 4-6 determine window: 0=A, 1=B, 2=C, 3=D, 4-7=future
+ *   Bits 4-6 determine window: 0=A, 1=B, 2=C, 3=D, 4=E, 5=F, 6=G, 7=H
  * 
  * Register offset extraction:
  *   reg_offset = is_shared ? (local_addr & 0x7F) : (local_addr & 0x0F)
@@ -104,10 +134,26 @@
 /**
  * Window state structure
  * Tracks per-window state for independent operation
+ * 
+ * Burst mode (window COMMAND CMD_BURST_ENABLE/CMD_BURST_DISABLE):
+ * the first DATA_PORT access loads a burst cursor for the active index and
+ * later DATA_PORT accesses go through it. An IDX_SELECT write, CFG_DATA
+ * access or COMMAND write (on any window) or a SHARED_COMMAND write writes
+ * all cursors back. A cursor is only loaded for an index no other window has
+ * selected, so it is the single view of that index while held.
+ * 
+ * Bank mode (CMD_BANK_ENABLE/CMD_BANK_DISABLE): offsets +5..+15 read and
+ * write the BANK_WINDOW_SIZE bytes from the active index's current address
+ * (the burst cursor's, while loaded). Bank accesses never step the index;
+ * DATA_PORT accesses still do, and move the bank with them.
  */
 typedef struct {
     uint8_t active_index;           // Currently selected index (0-255) for this window
-    uint8_t config_field_select;    // Selected configuration field for this window
+    uint8_t config_field_select;    // Selected configuration field (plus CFG_FIELD_AUTO_INCREMENT)
+    bool burst_enabled;             // Burst mode requested for this window
+    bool burst_loaded;              // burst holds the active index state
+    bool bank_enabled;              // Offsets +5..+15 map onto the active index (CMD_BANK_ENABLE)
+    indexed_memory_burst_t burst;   // Cached DATA_PORT cursor
 } window_state_t;
 
 /**
@@ -117,6 +163,103 @@ typedef struct {
  */
 extern window_state_t g_window_state[MAX_WINDOWS];
 
+// ============================================================================
+// Read Response Shadow
+// ============================================================================
+
+/**
+ * Response shadow table
+ * One byte per local address holding what a READ of that register returns
+ * right now, so the bus IRQ can prepare speculative data with a single load.
+ * For DATA_PORT this is each window's prefetched next byte: it is read from
+ * mia_memory once the previous cycle is finished, so a DATA_PORT read never
+ * touches mia_memory (or waits behind DMA) inside a bus cycle.
+ * 
+ * Kept current by:
+ * - bus_interface_write(): refreshes the entries the write can affect: the
+ *   windows with the touched index selected, and the DATA_PORT and bank
+ *   bytes showing a written address
+ * - bus_interface_commit_read(): applies DATA_PORT auto-step once a cycle is
+ *   confirmed as a READ, then refreshes the stepped windows
+ * - bus_interface_sync_shadow(): rebuilds entries after changes made outside
+ *   the bus path (DMA completion, IRQs raised by Core 1, status updates)
+ * 
+ * bus_interface_read() stays the live path and does not update the shadow.
+ */
+extern uint8_t g_bus_read_shadow[256];
+
+/**
+ * Speculative read - value a READ of local_addr would return, no side effects
+ */
+static inline uint8_t bus_interface_peek(uint8_t local_addr) {
+    return g_bus_read_shadow[local_addr];
+}
+
+#ifdef CONFIG_MIA_PSRAM
+// Windows whose DATA_PORT shadow shows a PSRAM page not cached yet, one bit
+// per window, kept with the shadow entries
+extern uint8_t g_bus_data_wait;
+#endif
+
+/**
+ * Whether a READ of local_addr is a DATA_PORT read answered as not ready
+ * (PSRAM_WAIT), which must not be committed: the index stays put for the
+ * 6502 to read again. Sampled with bus_interface_peek().
+ */
+static inline bool bus_interface_peek_waits(uint8_t local_addr) {
+#ifdef CONFIG_MIA_PSRAM
+    return (local_addr & 0x8F) == REG_OFFSET_DATA_PORT && ((g_bus_data_wait >> (local_addr >> 4)) & 1);
+#else
+    (void)local_addr;
+    return false;
+#endif
+}
+
+/**
+ * Commit the side effects of a confirmed READ of local_addr
+ * bus_interface_peek() followed by this is equivalent to bus_interface_read()
+ */
+void bus_interface_commit_read(uint8_t local_addr);
+
+/**
+ * Commit a READ that waited in the bus write queue behind earlier writes
+ * 
+ * @param local_addr Address read
+ * @param data Byte sent to the 6502 (acknowledged by IRQ_VECTOR_ACK)
+ */
+void bus_interface_commit_queued_read(uint8_t local_addr, uint8_t data);
+
+/**
+ * Count a queued READ that was answered before an earlier write was applied
+ * (WRITE_QUEUE_EARLY_READS), for the write queue consumer
+ */
+void bus_interface_count_early_read(void);
+
+/**
+ * Load an index descriptor from outside the bus path, such as the remote
+ * memory service: writes back the burst cursors first and refreshes the
+ * windows with idx selected. Must run in order with the bus writes, see
+ * bus_sync_pio_load_descriptor().
+ */
+void bus_interface_load_descriptor(uint8_t idx, const uint8_t *desc);
+
+/**
+ * Refresh shadow entries if IRQ or indexed memory state changed since the
+ * last refresh. Cheap when nothing changed (two loads and compares).
+ */
+void bus_interface_sync_shadow(void);
+
+/**
+ * Check if bus_interface_sync_shadow() has anything to refresh, without
+ * refreshing it (two loads and compares)
+ */
+bool bus_interface_shadow_stale(void);
+
+/**
+ * Rebuild the whole shadow table from current state
+ */
+void bus_interface_refresh_shadow(void);
+
 // ============================================================================
 // Main Entry Points
 // ============================================================================
@@ -1,89 +1,520 @@
 /**
  * MIA Synchronous Bus Interface PIO Integration Implementation
  * 
- * Implements the C side of the hybrid PIO + C synchronous bus protocol.
+ * Implements the C side of the synchronous bus protocol. The PIO program
+ * variant (hybrid or autonomous) is selected in config/bus_config.h.
  */
 
 #include "bus_sync_pio.h"
+#include "config/bus_config.h"
+#include "config/irq_config.h"
 #include "bus_interface.h"
+#include "bus_write_queue.h"
+#include "bus_timing.h"
+#include "bus_trace.h"
 #include "indexed_memory/indexed_memory.h"
 #include "irq/irq.h"
 #include "hardware/pio.h"
 #include "hardware/gpio.h"
 #include "hardware/irq.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#include "hardware/structs/nvic.h"
+#include <stdatomic.h>
+#ifdef CONFIG_BUS_TIMING_STATS
+#include "hardware/structs/m33.h"
+#endif
 #include "pico/stdlib.h"
 
 // Include the generated PIO header
 #include "bus_sync.pio.h"
 
+#if PICO_NO_RAM_VECTOR_TABLE
+#error "The bus IRQ needs the RAM vector table: entry must not wait for flash"
+#endif
+
 // PIO instance and state machine
-static PIO pio_instance = BUS_PIO_INSTANCE;
-static uint sm = BUS_PIO_SM;
+static BUS_HOT_DATA PIO pio_instance = BUS_PIO_INSTANCE;
+static BUS_HOT_DATA uint sm = BUS_PIO_SM;
 static uint pio_offset = 0;
 
+#ifdef CONFIG_BUS_SYNC_AUTONOMOUS
+// Address of the current selected cycle
+// The autonomous PIO program pushes the address word at 200ns and, if the
+// cycle turns out to be a WRITE, a write word at 1000ns that carries only
+// the data byte, so the handler pairs it with the address seen before it
+static BUS_HOT_DATA uint8_t cycle_addr = 0;
+
+// Speculative read byte sent for cycle_addr (for the bus trace)
+static BUS_HOT_DATA uint8_t cycle_data = 0;
+
+// cycle_data was prepared while an earlier write was unapplied
+static BUS_HOT_DATA bool cycle_early = false;
+
+// cycle_data is a DATA_PORT read answered as not ready, not to be committed
+static BUS_HOT_DATA bool cycle_wait = false;
+#else
 // Track last address for WRITE operations
-// When a WRITE occurs, we store the address here so we can process
-// the data when it arrives in the RX FIFO later
-static volatile uint8_t last_write_addr = 0;
-static volatile bool write_pending = false;
+// When a WRITE occurs, we store the address here so we can pair it with
+// the write word the PIO pushes at the end of the cycle
+static BUS_HOT_DATA volatile uint8_t last_write_addr = 0;
+#endif
+
+#ifdef CONFIG_BUS_RX_DMA
+// RX ring written by the DMA channel, aligned to its size so the channel's
+// write address wraps (channel_config_set_ring)
+static uint32_t rx_ring[BUS_RX_RING_SIZE]
+    __attribute__((aligned(BUS_RX_RING_SIZE * sizeof(uint32_t))));
+static uint rx_dma_chan = 0;
+static uint32_t rx_ring_tail = 0;   // Next word to consume
+
+// Ring found full by the IRQ handler since the last
+// bus_sync_pio_check_fifo_errors()
+static BUS_HOT_DATA volatile bool rx_ring_full;
+
+/**
+ * Ring position the DMA channel writes next
+ */
+static inline uint32_t rx_ring_head(void) {
+    uint32_t write_addr = dma_hw->ch[rx_dma_chan].write_addr;
+    return ((write_addr - (uint32_t)(uintptr_t)rx_ring) / sizeof(uint32_t)) & BUS_RX_RING_MASK;
+}
+
+/**
+ * Let the DMA channel land every word the PIO has pushed so far
+ * The PIO raises the IRQ right after its push, so the DMA transfer can
+ * still be in flight when the handler starts; once the RX FIFO is empty
+ * the word has reached the ring
+ */
+static inline void bus_rx_sync(void) {
+    while (!pio_sm_is_rx_fifo_empty(pio_instance, sm)) {
+    }
+    // The next word laps the consumer
+    if (((rx_ring_head() - rx_ring_tail) & BUS_RX_RING_MASK) == BUS_RX_RING_MASK) {
+        rx_ring_full = true;
+    }
+}
+
+static inline bool bus_rx_empty(void) {
+    return rx_ring_tail == rx_ring_head();
+}
+
+static inline uint32_t bus_rx_get(void) {
+    uint32_t word = rx_ring[rx_ring_tail];
+    rx_ring_tail = (rx_ring_tail + 1) & BUS_RX_RING_MASK;
+    return word;
+}
+
+/**
+ * Attach a DMA channel to the RX DREQ, writing endlessly into the ring
+ */
+static void bus_rx_dma_init(void) {
+    rx_dma_chan = dma_claim_unused_channel(true);
+    rx_ring_tail = 0;
+    rx_ring_full = false;
+    
+    dma_channel_config c = dma_channel_get_default_config(rx_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, BUS_RX_RING_SIZE_BITS);
+    channel_config_set_dreq(&c, pio_get_dreq(pio_instance, sm, false));
+    channel_config_set_high_priority(&c, true);
+    
+    dma_channel_configure(rx_dma_chan, &c,
+                          rx_ring,                      // Write to the ring
+                          &pio_instance->rxf[sm],       // Read from RX FIFO
+                          dma_encode_endless_transfer_count(),
+                          true);                        // Start now
+}
+#else
+static inline void bus_rx_sync(void) {
+}
+
+static inline bool bus_rx_empty(void) {
+    return pio_sm_is_rx_fifo_empty(pio_instance, sm);
+}
+
+static inline uint32_t bus_rx_get(void) {
+    return pio_sm_get(pio_instance, sm);
+}
+#endif
+
+#ifdef CONFIG_BUS_TIMING_STATS
+// DWT cycle counter timestamps for bus_timing.h
+// Samples are only taken on the critical path and recorded after the
+// response has been pushed, so recording never delays the bus
+static inline uint32_t timing_now(void) {
+    return m33_hw->dwt_cyccnt;
+}
+#define TIMING_STAMP(var)           uint32_t var = timing_now()
+#define TIMING_RECORD(phase, t0, t) bus_timing_record((phase), (t) - (t0))
+#else
+#define TIMING_STAMP(var)
+#define TIMING_RECORD(phase, t0, t)
+#endif
+
+#ifdef CONFIG_BUS_TRACE
+#define BUS_TRACE(addr, data, flags) bus_trace_record(time_us_32(), (addr), (data), (flags))
+#else
+#define BUS_TRACE(addr, data, flags)
+#endif
+
+// Set while the consumer applies entries, which the bus IRQ may interrupt
+static BUS_HOT_DATA volatile bool write_busy;
+
+// Writes queued by the bus IRQ and applied by the consumer, each written by
+// one side only; a read prepared while they differ runs ahead of a write
+static BUS_HOT_DATA volatile uint32_t writes_queued;
+static BUS_HOT_DATA volatile uint32_t writes_applied;
+
+static inline bool writes_unapplied(void) {
+    return writes_queued != writes_applied;
+}
+
+// Set while the bus IRQ (and the consumer) are live, between init and deinit
+static volatile bool bus_active;
+
+#ifdef CONFIG_BUS_READ_SHADOW
+// Bus write IRQ: the write queue consumer, a spare Core 0 interrupt pended
+// by the bus IRQ for every queued entry
+static uint write_irq;
+
+// Descriptor handed to the consumer by bus_sync_pio_load_descriptor(),
+// cleared by the consumer once loaded
+static const uint8_t *volatile remote_desc;
+static uint8_t remote_idx;
+
+/**
+ * Check for writes queued or being applied
+ * The bus IRQ then leaves index and shadow state to the consumer: it answers
+ * from the shadow as it stands and queues its READ commits behind the writes
+ */
+static inline bool writes_outstanding(void) {
+    return write_busy || !bus_write_queue_is_empty();
+}
+
+static inline void wake_write_consumer(void) {
+    nvic_hw->ispr[write_irq / 32] = 1u << (write_irq % 32);
+}
+
+static inline void apply_writes_after_push(void) {
+}
+
+/**
+ * Hand a stale shadow to the consumer once the response is pushed
+ * The consumer rebuilds it at the end of every run, so with writes
+ * outstanding there is nothing to do; otherwise it is pended just for the
+ * rebuild. The bus IRQ itself never refreshes the shadow, so a prepare is
+ * always the single peek.
+ */
+static inline void resync_after_push(void) {
+    if (!writes_outstanding() && bus_interface_shadow_stale()) {
+        wake_write_consumer();
+    }
+}
+#else
+// Without the shadow the speculative read is the live bus_interface_read(),
+// which must not run next to a half-applied write: the bus IRQ handler is
+// the consumer itself and applies the queue once its response is pushed
+static inline void wake_write_consumer(void) {
+}
+
+static inline void apply_writes_after_push(void) {
+    bus_sync_pio_process_write_data();
+}
+
+static inline void resync_after_push(void) {
+}
+#endif
+
+static inline void report_queue_overflow(void) {
+    indexed_memory_set_status(STATUS_MEMORY_ERROR);
+    irq_set_bits(IRQ_MEMORY_ERROR);
+}
+
+/**
+ * Queue a WRITE taken out of the RX FIFO (producer side of the write queue)
+ * A full queue drops the write; the overflow is counted by the queue and
+ * reported like the other FIFO errors
+ */
+static inline void queue_bus_write(uint8_t addr, uint8_t data) {
+    BUS_TRACE(addr, data, BUS_TRACE_FLAG_WRITE);
+    if (bus_write_queue_push(addr, data)) {
+        writes_queued++;
+    } else {
+        report_queue_overflow();
+    }
+    wake_write_consumer();
+}
+
+#ifdef CONFIG_BUS_READ_SHADOW
+/**
+ * Apply the side effects of a confirmed READ, in bus order with the writes
+ * An early READ (data prepared ahead of an unapplied write) is counted in
+ * WRITE_QUEUE_EARLY_READS, by the consumer if it is queued
+ */
+static inline void commit_bus_read(uint8_t addr, uint8_t data, bool early) {
+    if (writes_outstanding()) {
+        if (!bus_write_queue_push_read(addr, data, early)) {
+            report_queue_overflow();
+        }
+        wake_write_consumer();
+        return;
+    }
+    if (early) {
+        bus_interface_count_early_read();
+    }
+    bus_interface_commit_read(addr);
+}
+
+/**
+ * Whether the byte just prepared for addr was answered as not ready
+ * (PSRAM_WAIT): the read is then dropped instead of committed, so the index
+ * stays on the byte for the 6502 to read again. Sampled before the
+ * consumer can rebuild the shadow
+ */
+static inline bool read_waits(uint8_t addr) {
+    return bus_interface_peek_waits(addr);
+}
+#else
+// The handler is the consumer itself, so it counts early READs directly
+static inline void commit_bus_read(uint8_t addr, uint8_t data, bool early) {
+    (void)addr;
+    (void)data;
+    if (early) {
+        bus_interface_count_early_read();
+    }
+}
+
+// The live read does not step a not ready byte
+static inline bool read_waits(uint8_t addr) {
+    (void)addr;
+    return false;
+}
+#endif
+
+#ifdef CONFIG_BUS_READ_SHADOW
+static void BUS_HOT_FUNC(bus_write_irq_handler)(void) {
+    bus_sync_pio_process_write_data();
+}
+#endif
 
 /**
  * Initialize the synchronous bus interface PIO
  */
 void bus_sync_pio_init(void) {
+    // Start with an empty write queue
+    bus_write_queue_init();
+    write_busy = false;
+    writes_queued = 0;
+    writes_applied = 0;
+#ifdef CONFIG_BUS_READ_SHADOW
+    remote_desc = NULL;
+#endif
+    
+#ifdef CONFIG_BUS_READ_SHADOW
+    // Write queue consumer below the bus IRQ, above everything else
+    write_irq = (uint)user_irq_claim_unused(true);
+    irq_set_exclusive_handler(write_irq, bus_write_irq_handler);
+    irq_set_priority(write_irq, MIA_IRQ_PRIORITY_BUS_WRITE);
+    irq_set_enabled(write_irq, true);
+#endif
+    
+#ifdef CONFIG_BUS_TRACE
+    // Trace ring starts empty, recording is switched on at runtime
+    bus_trace_init();
+#endif
+    
+#ifdef CONFIG_BUS_TIMING_STATS
+    // Enable the DWT cycle counter
+    m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+    m33_hw->dwt_cyccnt = 0;
+    m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+#endif
+    
+#ifdef CONFIG_BUS_RX_DMA
+    // Drain the RX FIFO into the ring from the first pushed word on
+    bus_rx_dma_init();
+#endif
+    
+#ifdef CONFIG_BUS_SYNC_AUTONOMOUS
+    // Load the autonomous PIO program (PIO decides READ/WRITE itself)
+    pio_offset = pio_add_program(pio_instance, &bus_sync_auto_program);
+    
+    // Initialize the PIO state machine
+    bus_sync_auto_program_init(pio_instance, sm, pio_offset);
+#else
     // Load PIO program into PIO memory
     pio_offset = pio_add_program(pio_instance, &bus_sync_program);
     
     // Initialize the PIO state machine
     bus_sync_program_init(pio_instance, sm, pio_offset);
+#endif
     
     // Set up IRQ handler for PIO IRQ 0
     // The PIO will trigger this when CS is sampled active at 200ns
+    // Alone at the highest priority: it preempts DMA completion, USB and the
+    // background work. The exclusive handler goes straight into the RAM
+    // vector table, with no shared-handler dispatch on entry
     irq_set_exclusive_handler(PIO0_IRQ_0, bus_sync_pio_irq_handler);
+    irq_set_priority(PIO0_IRQ_0, MIA_IRQ_PRIORITY_BUS);
     irq_set_enabled(PIO0_IRQ_0, true);
     
+    bus_active = true;
+    
     // Note: The PIO state machine is already started by bus_sync_program_init()
 }
 
+/**
+ * Stop the synchronous bus interface PIO and release the data bus
+ */
+void bus_sync_pio_deinit(void) {
+    bus_active = false;
+    irq_set_enabled(PIO0_IRQ_0, false);
+    irq_remove_handler(PIO0_IRQ_0, bus_sync_pio_irq_handler);
+#ifdef CONFIG_BUS_READ_SHADOW
+    irq_set_enabled(write_irq, false);
+    irq_remove_handler(write_irq, bus_write_irq_handler);
+    user_irq_unclaim(write_irq);
+#endif
+    pio_set_irq0_source_enabled(pio_instance, pis_interrupt0, false);
+    
+    // Tri-state D0-D7 (GPIO 8-15) before the state machine stops
+    pio_sm_set_enabled(pio_instance, sm, false);
+    pio_sm_set_consecutive_pindirs(pio_instance, sm, 8, 8, false);
+    pio_sm_clear_fifos(pio_instance, sm);
+    pio_interrupt_clear(pio_instance, 0);
+    
+#ifdef CONFIG_BUS_RX_DMA
+    dma_channel_abort(rx_dma_chan);
+    dma_channel_unclaim(rx_dma_chan);
+#endif
+    
+#ifdef CONFIG_BUS_SYNC_AUTONOMOUS
+    pio_remove_program(pio_instance, &bus_sync_auto_program, pio_offset);
+#else
+    pio_remove_program(pio_instance, &bus_sync_program, pio_offset);
+#endif
+}
+
+#ifdef CONFIG_BUS_SYNC_AUTONOMOUS
+/**
+ * PIO IRQ handler - autonomous variant
+ * 
+ * Called when the PIO pushes an address word (CS active at 200ns) or a write
+ * word (WRITE latched at 1000ns). The PIO samples PHI2, OE and WE itself, so
+ * this handler never waits on the bus: it answers every address word with a
+ * speculative read byte and queues every write word for the write consumer.
+ */
+void __attribute__((optimize("O3"))) BUS_HOT_FUNC(bus_sync_pio_irq_handler)(void) {
+    TIMING_STAMP(t_entry);
+    
+    // Clear the IRQ flag before draining, so a word pushed while we are
+    // running raises the IRQ again instead of being left in the FIFO
+    pio_interrupt_clear(pio_instance, BUS_PIO_IRQ);
+    bus_rx_sync();
+    
+    while (!bus_rx_empty()) {
+        uint32_t word = bus_rx_get();
+        
+        if (word & BUS_RX_TAG_MASK) {
+            if (word & BUS_RX_WRITE_FLAG) {
+                // WRITE confirmed by the PIO, data byte is in bits 15:8
+                queue_bus_write(cycle_addr, (uint8_t)(word >> 8));
+                continue;
+            }
+            
+            // READ confirmed by the PIO
+            BUS_TRACE(cycle_addr, cycle_data, BUS_TRACE_FLAG_READ);
+            // Apply auto-step now (the live read has already applied it)
+            if (!cycle_wait) {
+                commit_bus_read(cycle_addr, cycle_data, cycle_early);
+            }
+            continue;
+        }
+        
+        // New selected cycle: speculatively prepare READ data. The PIO
+        // pulls this byte at 530ns and drives it only if OE is active and
+        // WE is not.
+        cycle_addr = (uint8_t)word;
+#ifdef CONFIG_BUS_READ_SHADOW
+        uint8_t data = bus_interface_peek(cycle_addr);
+#else
+        uint8_t data = bus_interface_read(cycle_addr);
+#endif
+        TIMING_STAMP(t_prepare);
+        
+        if (pio_sm_is_tx_fifo_full(pio_instance, sm)) {
+            // TX FIFO overflow - the PIO consumes one byte per selected
+            // cycle, so this indicates C and PIO went out of step
+            indexed_memory_set_status(STATUS_MEMORY_ERROR);
+            irq_set_bits(IRQ_MEMORY_ERROR);
+            continue;
+        }
+        
+        pio_sm_put(pio_instance, sm, data);
+        TIMING_STAMP(t_push);
+        cycle_data = data;
+        cycle_early = writes_unapplied();
+        cycle_wait = read_waits(cycle_addr);
+        
+        TIMING_RECORD(BUS_TIMING_PHASE_PREPARE, t_entry, t_prepare);
+        TIMING_RECORD(BUS_TIMING_PHASE_PUSH, t_entry, t_push);
+    }
+    resync_after_push();
+    apply_writes_after_push();
+}
+#else
 /**
  * PIO IRQ handler - called when CS is sampled active at 200ns
  * 
  * This implements the speculative execution strategy to handle the timing
  * constraint that OE and WE are only valid 30ns after PHI2 rises (at 530ns).
  */
-void __attribute__((optimize("O3"))) bus_sync_pio_irq_handler(void) {
+void __attribute__((optimize("O3"))) BUS_HOT_FUNC(bus_sync_pio_irq_handler)(void) {
+    TIMING_STAMP(t_entry);
+    
     // Clear the IRQ flag
     pio_interrupt_clear(pio_instance, BUS_PIO_IRQ);
+    bus_rx_sync();
     
     // =========================================================================
     // PHASE 1: Read address and speculatively prepare READ data (200-400ns)
     // =========================================================================
     
-    // Check if RX FIFO has data available (should always be true)
-    // PIO pushes address at 60ns, we're called at 200ns
-    if (pio_sm_is_rx_fifo_empty(pio_instance, sm)) {
-        // FIFO underflow - this should never happen
-        // PIO should have pushed address before triggering IRQ
-        // This indicates a critical timing failure
-        
-        // Set error status and trigger interrupt
-        indexed_memory_set_status(STATUS_MEMORY_ERROR);
-        irq_set_bits(IRQ_MEMORY_ERROR);
-        
-        // Push NOP control byte and return
-        pio_sm_put(pio_instance, sm, BUS_CTRL_NOP);
-        return;
-    }
+    // Queue write words (pushed at 1000ns of earlier WRITE cycles) until we
+    // reach the address word of the current cycle. The PIO also raises the
+    // IRQ after each write word, so finding no address word is normal.
+    uint32_t word;
+    do {
+        if (bus_rx_empty()) {
+            // Only write words this time, no cycle to answer
+            apply_writes_after_push();
+            return;
+        }
+        word = bus_rx_get();
+        if (word & BUS_RX_WRITE_FLAG) {
+            queue_bus_write(last_write_addr, (uint8_t)(word >> 8));
+        }
+    } while (word & BUS_RX_TAG_MASK);
     
-    // Read address from RX FIFO (pushed by PIO at 60ns)
-    // This is non-blocking because PIO already pushed the address
-    uint8_t addr = pio_sm_get(pio_instance, sm);
+    // Address pushed by PIO at 200ns
+    uint8_t addr = (uint8_t)word;
     
     // Speculatively prepare READ data (assume READ operation)
-    // This takes ~150-200ns but we have 330ns available (200-530ns)
     // If this turns out to be a WRITE, we'll discard this data
+#ifdef CONFIG_BUS_READ_SHADOW
+    // Shadow lookup: constant time for every register, side effects are
+    // committed below once the cycle is confirmed as a READ. The shadow is
+    // only rebuilt by the write consumer, never here
+    uint8_t data = bus_interface_peek(addr);
+#else
+    // This takes ~150-200ns but we have 330ns available (200-530ns)
     // OPTIMIZATION: bus_interface_read() is optimized for fast execution
     uint8_t data = bus_interface_read(addr);
+#endif
+    TIMING_STAMP(t_prepare);
     
     // =========================================================================
     // PHASE 2: Wait for PHI2 to rise (400-500ns)
@@ -105,6 +536,7 @@ void __attribute__((optimize("O3"))) bus_sync_pio_irq_handler(void) {
     }
     
     // PHI2 is now HIGH (at 500ns mark)
+    TIMING_STAMP(t_phi2);
     
     // =========================================================================
     // PHASE 3: Wait 30ns for OE/WE to settle, then read them (530ns)
@@ -140,15 +572,7 @@ void __attribute__((optimize("O3"))) bus_sync_pio_irq_handler(void) {
         // This could happen if:
         // - CS was active but OE is not (unusual but possible)
         // - Timing glitch or invalid bus cycle
-        // OPTIMIZATION: Inline loop unrolling for GPIO direction setting
-        gpio_set_dir(8, GPIO_IN);
-        gpio_set_dir(9, GPIO_IN);
-        gpio_set_dir(10, GPIO_IN);
-        gpio_set_dir(11, GPIO_IN);
-        gpio_set_dir(12, GPIO_IN);
-        gpio_set_dir(13, GPIO_IN);
-        gpio_set_dir(14, GPIO_IN);
-        gpio_set_dir(15, GPIO_IN);
+        // The PIO keeps the data bus tri-stated on NOP, nothing to undo here
         
         // Check if TX FIFO has space before pushing
         if (pio_sm_is_tx_fifo_full(pio_instance, sm)) {
@@ -171,16 +595,8 @@ void __attribute__((optimize("O3"))) bus_sync_pio_irq_handler(void) {
         // This is a READ operation: R/W = HIGH (read)
         // MOST COMMON PATH - optimized for speed
         
-        // Configure data bus as outputs before PIO drives it
-        // OPTIMIZATION: Inline loop unrolling for GPIO direction setting
-        gpio_set_dir(8, GPIO_OUT);
-        gpio_set_dir(9, GPIO_OUT);
-        gpio_set_dir(10, GPIO_OUT);
-        gpio_set_dir(11, GPIO_OUT);
-        gpio_set_dir(12, GPIO_OUT);
-        gpio_set_dir(13, GPIO_OUT);
-        gpio_set_dir(14, GPIO_OUT);
-        gpio_set_dir(15, GPIO_OUT);
+        // The PIO turns the data bus around itself (out pindirs) once it
+        // has the data byte, and releases it again after tDHR
         
         // Check if TX FIFO has space for control byte + data byte
         if (pio_sm_is_tx_fifo_full(pio_instance, sm)) {
@@ -191,16 +607,7 @@ void __attribute__((optimize("O3"))) bus_sync_pio_irq_handler(void) {
             indexed_memory_set_status(STATUS_MEMORY_ERROR);
             irq_set_bits(IRQ_MEMORY_ERROR);
             
-            // Tri-state bus and abort
-            gpio_set_dir(8, GPIO_IN);
-            gpio_set_dir(9, GPIO_IN);
-            gpio_set_dir(10, GPIO_IN);
-            gpio_set_dir(11, GPIO_IN);
-            gpio_set_dir(12, GPIO_IN);
-            gpio_set_dir(13, GPIO_IN);
-            gpio_set_dir(14, GPIO_IN);
-            gpio_set_dir(15, GPIO_IN);
-            
+            // Abort - the bus has not been driven yet
             return;
         }
         
@@ -214,39 +621,29 @@ void __attribute__((optimize("O3"))) bus_sync_pio_irq_handler(void) {
             // This is a critical error - PIO is expecting data
             
             // Set error status and trigger interrupt
+            // The PIO only enables the drivers after pulling the data byte,
+            // so the bus is still tri-stated
             indexed_memory_set_status(STATUS_MEMORY_ERROR);
             irq_set_bits(IRQ_MEMORY_ERROR);
             
-            // Tri-state bus and abort
-            gpio_set_dir(8, GPIO_IN);
-            gpio_set_dir(9, GPIO_IN);
-            gpio_set_dir(10, GPIO_IN);
-            gpio_set_dir(11, GPIO_IN);
-            gpio_set_dir(12, GPIO_IN);
-            gpio_set_dir(13, GPIO_IN);
-            gpio_set_dir(14, GPIO_IN);
-            gpio_set_dir(15, GPIO_IN);
-            
             return;
         }
         
         pio_sm_put(pio_instance, sm, data);
+        BUS_TRACE(addr, data, BUS_TRACE_FLAG_READ);
+        
+        // Confirmed READ: apply DATA_PORT auto-step now that the byte is
+        // on its way to the bus. The consumer cannot have run since the
+        // prepare, so the queue state still tells if it was early, and
+        // the shadow if the byte was a not ready one
+        if (!read_waits(addr)) {
+            commit_bus_read(addr, data, writes_unapplied());
+        }
         
     } else {
         // OE is active (LOW) and WE is active (LOW)
         // This is a WRITE operation: R/W = LOW (write)
         
-        // Ensure data bus is configured as inputs
-        // OPTIMIZATION: Inline loop unrolling for GPIO direction setting
-        gpio_set_dir(8, GPIO_IN);
-        gpio_set_dir(9, GPIO_IN);
-        gpio_set_dir(10, GPIO_IN);
-        gpio_set_dir(11, GPIO_IN);
-        gpio_set_dir(12, GPIO_IN);
-        gpio_set_dir(13, GPIO_IN);
-        gpio_set_dir(14, GPIO_IN);
-        gpio_set_dir(15, GPIO_IN);
-        
         // Check if TX FIFO has space before pushing
         if (pio_sm_is_tx_fifo_full(pio_instance, sm)) {
             // TX FIFO overflow - cannot push response
@@ -258,54 +655,118 @@ void __attribute__((optimize("O3"))) bus_sync_pio_irq_handler(void) {
             return;
         }
         
-        // Store address for later processing when data arrives
+        // Store address for the write word that arrives at 1000ns
         last_write_addr = addr;
-        write_pending = true;
         
         // Discard the speculatively prepared data
         // PIO will latch the write data at 1000ns and push to RX FIFO
         pio_sm_put(pio_instance, sm, BUS_CTRL_WRITE);
     }
+    TIMING_STAMP(t_push);
+    
+    // Response is on its way, record off the critical path
+    TIMING_RECORD(BUS_TIMING_PHASE_PREPARE, t_entry, t_prepare);
+    TIMING_RECORD(BUS_TIMING_PHASE_PHI2, t_entry, t_phi2);
+    TIMING_RECORD(BUS_TIMING_PHASE_PUSH, t_entry, t_push);
+    
+    // Let the consumer pick up anything Core 1 changed while we were busy
+    resync_after_push();
+    apply_writes_after_push();
     
     // IRQ handler complete
     // PIO will now unblock from the pull instruction and continue
     // For READ: PIO will pull data and drive bus by ~560ns
     // For WRITE: PIO will wait for PHI2 to fall and latch data at 1000ns
 }
+#endif
 
 /**
- * Process WRITE data from RX FIFO
- * 
- * After a WRITE operation, the PIO pushes the latched data byte to RX FIFO.
- * This function should be called periodically to process pending WRITE data.
+ * Apply every queued entry (consumer side, the bus write IRQ)
  * 
- * OPTIMIZATION: This function is called from the main loop or a lower-priority
- * interrupt to process WRITE data without blocking the critical IRQ handler.
+ * Runs with interrupts enabled: the bus IRQ preempts it at any point, and
+ * while write_busy is set it keeps off the state being updated (see
+ * writes_outstanding()). write_busy is set before the first pop, so a READ
+ * confirmed after a write has been taken but not yet applied still queues
+ * behind it.
  * 
- * @return true if data was processed, false if FIFO was empty
+ * @return true if an entry was applied, false if the queue was empty
  */
-bool bus_sync_pio_process_write_data(void) {
-    // Check if we have a pending write operation
-    if (!write_pending) {
-        return false;  // No pending write
-    }
+bool BUS_HOT_FUNC(bus_sync_pio_process_write_data)(void) {
+    write_busy = true;
+    atomic_signal_fence(memory_order_seq_cst);
     
-    // Check if RX FIFO has data available
-    if (pio_sm_is_rx_fifo_empty(pio_instance, sm)) {
-        return false;  // Data not yet available
+    bool processed = false;
+    bus_write_t w;
+    while (bus_write_queue_pop(&w)) {
+        if (w.read) {
+            if (w.early) {
+                bus_interface_count_early_read();
+            }
+            bus_interface_commit_queued_read(w.addr, w.data);
+        } else {
+            bus_interface_write(w.addr, w.data);
+            writes_applied++;
+        }
+        processed = true;
     }
     
-    // Read data from RX FIFO (latched by PIO at PHI2 falling edge)
-    uint8_t data = pio_sm_get(pio_instance, sm);
-    
-    // Process the write using the stored address
-    // OPTIMIZATION: bus_interface_write() is called outside the critical IRQ path
-    bus_interface_write(last_write_addr, data);
+#ifdef CONFIG_BUS_READ_SHADOW
+    // Index descriptor from outside the bus path, after the writes queued
+    // before it
+    const uint8_t *desc = remote_desc;
+    if (desc) {
+        bus_interface_load_descriptor(remote_idx, desc);
+        atomic_signal_fence(memory_order_seq_cst);
+        remote_desc = NULL;
+        processed = true;
+    }
+#endif
     
-    // Clear pending flag
-    write_pending = false;
+    // State changed behind the shadow (queued copies, status, Core 1) is
+    // picked up here, the only place the shadow is rebuilt from
+    bus_interface_sync_shadow();
     
-    return true;
+    atomic_signal_fence(memory_order_seq_cst);
+    write_busy = false;
+    return processed;
+}
+
+/**
+ * Pend the consumer for a stale shadow (Core 0 thread mode)
+ */
+void bus_sync_pio_poll_shadow(void) {
+#ifdef CONFIG_BUS_READ_SHADOW
+    if (bus_active) {
+        resync_after_push();
+    }
+#endif
+}
+
+/**
+ * Load an index descriptor in order with the 6502's writes (Core 0 thread
+ * mode: background work only)
+ */
+void bus_sync_pio_load_descriptor(uint8_t idx, const uint8_t *desc) {
+    if (!bus_active) {
+        // No bus cycles to race with
+        bus_interface_load_descriptor(idx, desc);
+        return;
+    }
+#ifdef CONFIG_BUS_READ_SHADOW
+    // The consumer preempts this thread as soon as it is pended; the wait
+    // only spins while bus cycles hold it off
+    remote_idx = idx;
+    atomic_signal_fence(memory_order_seq_cst);
+    remote_desc = desc;
+    wake_write_consumer();
+    while (remote_desc) {
+    }
+#else
+    // The bus IRQ is the consumer: keep it out for this one descriptor
+    uint32_t saved = save_and_disable_interrupts();
+    bus_interface_load_descriptor(idx, desc);
+    restore_interrupts(saved);
+#endif
 }
 
 /**
@@ -328,7 +789,11 @@ bool bus_sync_pio_is_ready(void) {
  */
 void bus_sync_pio_get_stats(uint8_t *rx_level, uint8_t *tx_level, bool *stalled) {
     if (rx_level) {
+#ifdef CONFIG_BUS_RX_DMA
+        *rx_level = (uint8_t)((rx_ring_head() - rx_ring_tail) & BUS_RX_RING_MASK);
+#else
         *rx_level = pio_sm_get_rx_fifo_level(pio_instance, sm);
+#endif
     }
     
     if (tx_level) {
@@ -352,8 +817,23 @@ void bus_sync_pio_get_stats(uint8_t *rx_level, uint8_t *tx_level, bool *stalled)
 void bus_sync_pio_check_fifo_errors(bool *rx_overflow, bool *tx_underflow) {
     if (rx_overflow) {
         // RX FIFO overflow occurs when PIO tries to push but FIFO is full
-        // This would indicate C code is not consuming data fast enough
-        *rx_overflow = pio_sm_is_rx_fifo_full(pio_instance, sm);
+        // This would indicate C code is not consuming data fast enough.
+        // FDEBUG.RXSTALL latches every such push (write 1 to clear), so an
+        // overflow between two checks is not missed
+        uint32_t rx_stall = 1u << (PIO_FDEBUG_RXSTALL_LSB + sm);
+        bool stalled = (pio_instance->fdebug & rx_stall) != 0;
+        pio_instance->fdebug = rx_stall;
+#ifdef CONFIG_BUS_RX_DMA
+        // The DMA keeps the FIFO empty; the ring overflows silently once
+        // the write pointer laps the consumer, so report a full ring, now
+        // or seen by the IRQ handler since the last check
+        bool full = rx_ring_full ||
+                    ((rx_ring_head() - rx_ring_tail) & BUS_RX_RING_MASK) == BUS_RX_RING_MASK;
+        rx_ring_full = false;
+#else
+        bool full = pio_sm_is_rx_fifo_full(pio_instance, sm);
+#endif
+        *rx_overflow = stalled || full;
     }
     
     if (tx_underflow) {
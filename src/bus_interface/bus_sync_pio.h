@@ -20,8 +20,8 @@
  * TIMING POINTS (1 MHz operation, 1000ns cycle):
  * ===============================================
  *   0ns   - PHI2 falls (cycle start) - PIO detects falling edge
- *   60ns  - PIO samples address bus (40ns tADS + 50% margin)
  *   200ns - PIO samples CS (after address mapping logic settles)
+ *   200ns - PIO samples address bus (CS active only, valid since 40ns tADS)
  *   200ns - PIO triggers IRQ to notify C code
  *   200ns - C code starts, reads address, speculatively prepares READ data
  *   400ns - C code has data ready, waits for PHI2 to rise
@@ -30,7 +30,7 @@
  *   540ns - C code determines operation type
  *   550ns - C code pushes control byte (and data for READ) to TX FIFO
  *   550ns - PIO pulls control byte from TX FIFO
- *   560ns - For READ: PIO pulls data and drives bus
+ *   560ns - For READ: PIO pulls data, drives it and enables the outputs
  *   985ns - For READ: Data must be valid (425ns available from 560ns)
  *   1000ns - PHI2 falls - For READ: CPU samples data, For WRITE: PIO latches data
  *   1015ns - For READ: PIO releases bus after tDHR hold time
@@ -39,14 +39,18 @@
  * ============================
  * PIO Responsibilities:
  * - Detect PHI2 falling edge (cycle start at 0ns)
- * - Sample address at 60ns → push to RX FIFO
- * - Sample CS at 200ns → trigger IRQ if active
+ * - Sample CS at 200ns → if active, sample address → push to RX FIFO
+ *   and trigger IRQ
  * - Block waiting for control byte from C code
- * - For READ: pull data, drive bus, hold for tDHR
- * - For WRITE: latch data on PHI2 falling edge, push to RX FIFO
+ * - For READ: pull data, drive bus (out pindirs), hold for tDHR, tri-state
+ * - Own the data bus direction: C never calls gpio_set_dir on D0-D7
+ * - For WRITE: latch data on PHI2 falling edge, push write word to RX FIFO,
+ *   trigger IRQ
  * 
  * C Code Responsibilities (IRQ handler):
+ * - Queue write words left by earlier WRITE cycles (see bus_write_queue.h)
  * - Read address from RX FIFO (triggered at 200ns)
+ * - Apply queued writes so the speculative read sees them
  * - Speculatively prepare READ data (200-400ns)
  * - Wait for PHI2 to rise (poll GPIO 28)
  * - Wait 30ns for OE/WE to settle (530ns mark)
@@ -66,8 +70,9 @@
  * FIFO PROTOCOL:
  * ==============
  * RX FIFO (PIO → C):
- *   - Address byte (8 bits, pushed at 60ns)
- *   - Data byte (8 bits, pushed at 1000ns for WRITE operations only)
+ *   - Address byte (8 bits, pushed at 200ns)
+ *   - Write word 0xFFFFDDxx (pushed at 1000ns for WRITE operations only,
+ *     DD = data byte), followed by an IRQ
  * 
  * TX FIFO (C → PIO):
  *   - Control byte (0x00 = NOP, 0x01 = READ, 0x02 = WRITE)
@@ -89,6 +94,26 @@
  * - OE/WE check: ~2 cycles
  * - FIFO push: ~3 cycles
  * Total: ~45 cycles = ~340ns
+ * 
+ * AUTONOMOUS VARIANT (CONFIG_BUS_SYNC_AUTONOMOUS):
+ * ================================================
+ * Selected in config/bus_config.h. The bus_sync_auto PIO program samples
+ * PHI2, OE and WE itself and branches to drive or latch on its own. The IRQ
+ * handler no longer waits for PHI2 or reads OE/WE:
+ * - Address word (CS active, 200ns): push one speculative read byte to TX
+ * - Write word (WRITE latched, 1000ns): call bus_interface_write()
+ * - Read confirm word (READ driven, 560ns): commit read side effects
+ * The PIO consumes the read byte on every selected cycle and discards it for
+ * WRITE or OE-inactive cycles, so core 0 is idle between bus accesses.
+ * 
+ * RX DMA DRAIN (CONFIG_BUS_RX_DMA):
+ * =================================
+ * Either variant can have its RX FIFO drained by a DMA channel paced by the
+ * state machine's RX DREQ. The channel runs endlessly into a 256-word ring
+ * (channel_config_set_ring), so RX words are moved off the PIO within a few
+ * system clocks regardless of IRQ latency. The IRQ handler reads words from
+ * the ring instead of pio_sm_get(), up to the channel's write pointer, and
+ * handles everything that arrived since its last entry in one batch.
  */
 
 #ifndef BUS_SYNC_PIO_H
@@ -103,12 +128,24 @@
 #define BUS_CTRL_READ   0x01    // READ operation - PIO will drive data bus
 #define BUS_CTRL_WRITE  0x02    // WRITE operation - PIO will latch data bus
 
+// RX FIFO word tags
+// Address words are 0x000000AA, write words are 0xFFFFDDxx (DD = data byte)
+// and read confirm words (autonomous program only) are 0xFFFE0000
+#define BUS_RX_TAG_MASK     0xFFFE0000u     // Set on every non-address word
+#define BUS_RX_WRITE_FLAG   0x00010000u     // Set on write words only
+
 // GPIO pin definitions (must match bus_sync.pio)
 #define BUS_PHI2_PIN    28      // Clock signal (generated by MIA, read by PIO)
 #define BUS_CS_PIN      21      // Chip select (active low, IO0_CS)
 #define BUS_OE_PIN      19      // Output enable (active low)
 #define BUS_WE_PIN      18      // Write enable (active low, R/W = !WE)
 
+// RX ring (CONFIG_BUS_RX_DMA only)
+// Ring of RX words written by DMA, aligned to its size for channel_config_set_ring
+#define BUS_RX_RING_SIZE_BITS   10                                  // 1KB ring
+#define BUS_RX_RING_SIZE        ((1u << BUS_RX_RING_SIZE_BITS) / 4) // 256 words
+#define BUS_RX_RING_MASK        (BUS_RX_RING_SIZE - 1)
+
 // PIO configuration
 #define BUS_PIO_INSTANCE    pio0    // Use PIO 0
 #define BUS_PIO_SM          0       // Use state machine 0
@@ -128,9 +165,22 @@
  */
 void bus_sync_pio_init(void);
 
+/**
+ * Stop the synchronous bus interface PIO
+ * 
+ * Disables the IRQ handler, stops the state machine with D0-D7 tri-stated
+ * and releases the PIO program (and the RX DMA channel), so the boot ROM
+ * can take the bus for a fast reset. bus_sync_pio_init() starts it again.
+ */
+void bus_sync_pio_deinit(void);
+
 /**
  * PIO IRQ handler (called when CS is sampled active at 200ns)
  * 
+ * In autonomous mode it drains the RX FIFO instead: every address word is
+ * answered with a speculative read byte and every write word is forwarded
+ * to bus_interface_write(). The steps below describe the hybrid mode.
+ * 
  * This function implements the speculative execution strategy:
  * 1. Reads address from RX FIFO (triggered at 200ns)
  * 2. Speculatively prepares READ data (assumes READ operation)
@@ -155,15 +205,48 @@ void bus_sync_pio_init(void);
 void bus_sync_pio_irq_handler(void);
 
 /**
- * Process WRITE data from RX FIFO
+ * Apply the queued WRITEs
  * 
- * After a WRITE operation, the PIO pushes the latched data byte to RX FIFO.
- * This function should be called periodically to process pending WRITE data.
+ * The IRQ handler moves write words from the RX FIFO into the bus write
+ * queue and never applies them before a speculative read. With
+ * CONFIG_BUS_READ_SHADOW this runs in the bus write IRQ, pended by the
+ * handler after its push and preempted by the next bus cycle. READs
+ * confirmed while writes are outstanding are answered from the shadow as it
+ * was and queued behind them, so their side effects keep bus order; those
+ * prepared ahead of an unapplied write are counted in
+ * WRITE_QUEUE_EARLY_READS. Without
+ * the shadow the handler calls it itself once its response is pushed.
  * 
- * @return true if data was processed, false if FIFO was empty
+ * @return true if an entry was applied, false if the queue was empty
  */
 bool bus_sync_pio_process_write_data(void);
 
+/**
+ * Refresh the read shadow between bus cycles (Core 0 main loop)
+ * 
+ * The bus IRQ never rebuilds the shadow before a prepare: it pends the
+ * write queue consumer after its push when IRQ or indexed memory state
+ * changed. This covers changes made by Core 1 or DMA completion while the
+ * 6502 is not selecting MIA, so they need not wait for the next bus cycle.
+ * Cheap when nothing changed; a no-op without CONFIG_BUS_READ_SHADOW.
+ */
+void bus_sync_pio_poll_shadow(void);
+
+/**
+ * Load an index descriptor from Core 0 background work
+ * 
+ * Hands the descriptor to the write queue consumer (see
+ * bus_sync_pio_process_write_data()) and waits for it, so it is applied
+ * after the 6502 writes queued before it, with the burst cursors written
+ * back and the shadow refreshed, and the bus IRQ never sees it half loaded.
+ * Without the shadow the load runs with interrupts disabled instead.
+ * Before bus_sync_pio_init() it is loaded at once.
+ * 
+ * @param idx Index to configure
+ * @param desc INDEX_DESCRIPTOR_SIZE bytes, CMD_LOAD_DESCRIPTOR layout
+ */
+void bus_sync_pio_load_descriptor(uint8_t idx, const uint8_t *desc);
+
 /**
  * Check if PIO is ready for next cycle
  * Useful for debugging and diagnostics
@@ -175,7 +258,8 @@ bool bus_sync_pio_is_ready(void);
 /**
  * Get PIO statistics for debugging
  * 
- * @param rx_level Pointer to store RX FIFO level (0-8)
+ * @param rx_level Pointer to store RX FIFO level (0-8), or the number of
+ *                 unconsumed ring words with CONFIG_BUS_RX_DMA
  * @param tx_level Pointer to store TX FIFO level (0-8)
  * @param stalled Pointer to store stall status
  */
@@ -185,13 +269,19 @@ void bus_sync_pio_get_stats(uint8_t *rx_level, uint8_t *tx_level, bool *stalled)
  * Check for FIFO overflow/underflow conditions
  * 
  * This function checks for error conditions that indicate timing problems:
- * - RX overflow: PIO is pushing data faster than C can consume it
+ * - RX overflow: PIO is pushing data faster than C can consume it. Reported
+ *   if the FIFO is full now or the PIO pushed into a full FIFO since the
+ *   last call (the sticky FDEBUG.RXSTALL bit, cleared here). With
+ *   CONFIG_BUS_RX_DMA the FIFO is always drained, so this also reports a
+ *   ring that is, or was since the last call, about to be lapped by the
+ *   DMA write pointer
  * - TX underflow: PIO is pulling data faster than C can provide it
  * 
  * When FIFO errors occur, the IRQ handler automatically:
  * - Sets STATUS_MEMORY_ERROR in the device status register
  * - Triggers IRQ_MEMORY_ERROR interrupt (if enabled)
- * - Tri-states the data bus to prevent bus contention
+ * - Leaves the data bus tri-stated (the PIO only enables its drivers after
+ *   pulling the READ data byte)
  * - Aborts the current bus cycle
  * 
  * The 6502 can detect these errors by:
@@ -0,0 +1,96 @@
+/**
+ * MIA Bus Timing Statistics Implementation
+ * 
+ * Samples are recorded by the bus IRQ handler on Core 0; register access
+ * runs in the same context, so only bus_timing_dump() (Core 1) can see a
+ * sample half-recorded, which is acceptable for a diagnostic dump.
+ */
+
+#include "bus_timing.h"
+#include "config/bus_config.h"
+#include <stdio.h>
+#include <string.h>
+
+// Live statistics and the snapshot the 6502 reads from
+static bus_timing_phase_t stats[BUS_TIMING_PHASES];
+static bus_timing_phase_t snapshot[BUS_TIMING_PHASES];
+static uint8_t read_offset;
+
+static const char *const phase_names[BUS_TIMING_PHASES] = {
+    "prepare", "phi2", "push", "masked"
+};
+
+void bus_timing_init(void) {
+    bus_timing_reset();
+    memset(snapshot, 0, sizeof(snapshot));
+    read_offset = 0;
+}
+
+void BUS_HOT_FUNC(bus_timing_reset)(void) {
+    memset(stats, 0, sizeof(stats));
+    for (int p = 0; p < BUS_TIMING_PHASES; p++) {
+        stats[p].min = 0xFFFF;
+    }
+}
+
+void BUS_HOT_FUNC(bus_timing_record)(uint8_t phase, uint32_t cycles) {
+    bus_timing_phase_t *s = &stats[phase];
+    uint16_t c = cycles > 0xFFFF ? 0xFFFF : (uint16_t)cycles;
+    uint32_t bucket = cycles >> BUS_TIMING_BUCKET_SHIFT;
+    
+    if (c < s->min) {
+        s->min = c;
+    }
+    if (c > s->max) {
+        s->max = c;
+    }
+    s->count++;
+    s->histogram[bucket < BUS_TIMING_BUCKETS ? bucket : BUS_TIMING_BUCKETS - 1]++;
+}
+
+void bus_timing_get_phase(uint8_t phase, bus_timing_phase_t *out) {
+    *out = stats[phase];
+}
+
+void BUS_HOT_FUNC(bus_timing_select)(uint8_t offset) {
+    memcpy(snapshot, stats, sizeof(snapshot));
+    read_offset = offset;
+}
+
+uint8_t BUS_HOT_FUNC(bus_timing_get_select)(void) {
+    return read_offset;
+}
+
+uint8_t BUS_HOT_FUNC(bus_timing_peek)(void) {
+    if (read_offset >= sizeof(snapshot)) {
+        return 0;
+    }
+    return ((const uint8_t *)snapshot)[read_offset];
+}
+
+void BUS_HOT_FUNC(bus_timing_advance)(void) {
+    read_offset++;
+}
+
+void bus_timing_dump(uint32_t sys_hz) {
+    uint32_t mhz = sys_hz / 1000000;
+    
+    printf("[Bus] Timing statistics (cycles from IRQ entry, %lu MHz)\n", (unsigned long)mhz);
+    for (int p = 0; p < BUS_TIMING_PHASES; p++) {
+        const bus_timing_phase_t *s = &stats[p];
+        if (s->count == 0) {
+            printf("  %-8s no samples\n", phase_names[p]);
+            continue;
+        }
+        printf("  %-8s n=%lu min=%u (%lu ns) max=%u (%lu ns)\n", phase_names[p],
+               (unsigned long)s->count,
+               s->min, mhz ? (unsigned long)(s->min * 1000u / mhz) : 0ul,
+               s->max, mhz ? (unsigned long)(s->max * 1000u / mhz) : 0ul);
+        for (int b = 0; b < BUS_TIMING_BUCKETS; b++) {
+            printf("    %s%3u cycles: %lu\n", (b == BUS_TIMING_BUCKETS - 1) ? ">=" : "< ",
+                   (b == BUS_TIMING_BUCKETS - 1) ? b * BUS_TIMING_BUCKET_CYCLES
+                                                  : (b + 1) * BUS_TIMING_BUCKET_CYCLES,
+                   (unsigned long)s->histogram[b]);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * MIA Bus Timing Statistics
+ * 
+ * Per-phase cycle statistics of the bus IRQ handler, measured with the
+ * Cortex-M33 DWT cycle counter when CONFIG_BUS_TIMING_STATS is enabled
+ * (config/bus_config.h). The handler phases are measured from handler entry:
+ * 
+ * - PREPARE: speculative read data ready
+ * - PHI2:    PHI2 seen high (hybrid mode only)
+ * - PUSH:    response pushed to the TX FIFO
+ * 
+ * MASKED is measured outside the handler: the time Core 0 keeps interrupts
+ * disabled to apply a queued write, the only thing that can hold off the
+ * bus IRQ (which has the highest priority, config/irq_config.h). Worst-case
+ * entry latency is the fixed exception entry plus MASKED max.
+ * 
+ * Each phase keeps min, max, sample count and a histogram of
+ * BUS_TIMING_BUCKETS buckets, BUS_TIMING_BUCKET_CYCLES wide (the last
+ * bucket collects everything above).
+ * 
+ * The 6502 reads the statistics through two shared registers:
+ * - TIMING_SELECT (0xF7): write a byte offset to latch a snapshot of the
+ *   statistics and start reading at that offset; read returns the offset
+ * - TIMING_DATA (0xF8): read returns the snapshot byte at the offset and
+ *   advances it; any write clears the statistics
+ * 
+ * Snapshot layout, little-endian, BUS_TIMING_PHASE_BYTES per phase:
+ *   +0 min (16-bit)  +2 max (16-bit)  +4 count (32-bit)  +8 histogram (8 x 32-bit)
+ * Offsets past the last phase read as 0. Without CONFIG_BUS_TIMING_STATS
+ * the registers exist but every statistic stays 0.
+ */
+
+#ifndef BUS_TIMING_H
+#define BUS_TIMING_H
+
+#include <stdint.h>
+
+// Measured phases
+#define BUS_TIMING_PHASE_PREPARE    0
+#define BUS_TIMING_PHASE_PHI2       1
+#define BUS_TIMING_PHASE_PUSH       2
+#define BUS_TIMING_PHASE_MASKED     3
+#define BUS_TIMING_PHASES           4
+
+// Histogram: 8 buckets of 32 cycles (213ns at 150 MHz)
+#define BUS_TIMING_BUCKETS          8
+#define BUS_TIMING_BUCKET_SHIFT     5
+#define BUS_TIMING_BUCKET_CYCLES    (1u << BUS_TIMING_BUCKET_SHIFT)
+
+// Statistics of one phase (also the snapshot layout)
+typedef struct {
+    uint16_t min;                           // Fastest sample in cycles (0xFFFF until the first sample)
+    uint16_t max;                           // Slowest sample in cycles (saturates at 0xFFFF)
+    uint32_t count;                         // Number of samples
+    uint32_t histogram[BUS_TIMING_BUCKETS]; // Samples per bucket
+} bus_timing_phase_t;
+
+#define BUS_TIMING_PHASE_BYTES      ((uint8_t)sizeof(bus_timing_phase_t))
+
+/**
+ * Clear the statistics, the snapshot and the read offset
+ */
+void bus_timing_init(void);
+
+/**
+ * Clear the statistics (the snapshot is kept until the next select)
+ */
+void bus_timing_reset(void);
+
+/**
+ * Add one sample to a phase
+ * 
+ * @param phase BUS_TIMING_PHASE_*
+ * @param cycles Cycles since handler entry (MASKED: with interrupts disabled)
+ */
+void bus_timing_record(uint8_t phase, uint32_t cycles);
+
+/**
+ * Get a copy of the live statistics of a phase
+ */
+void bus_timing_get_phase(uint8_t phase, bus_timing_phase_t *out);
+
+/**
+ * Latch a snapshot and set the read offset (TIMING_SELECT write)
+ */
+void bus_timing_select(uint8_t offset);
+
+/**
+ * Get the read offset (TIMING_SELECT read)
+ */
+uint8_t bus_timing_get_select(void);
+
+/**
+ * Snapshot byte at the read offset, no side effects (TIMING_DATA read)
+ */
+uint8_t bus_timing_peek(void);
+
+/**
+ * Advance the read offset (side effect of a TIMING_DATA read)
+ */
+void bus_timing_advance(void);
+
+/**
+ * Print the statistics on the console (USB CDC)
+ * 
+ * @param sys_hz System clock in Hz, used to convert cycles to ns
+ */
+void bus_timing_dump(uint32_t sys_hz);
+
+#endif // BUS_TIMING_H
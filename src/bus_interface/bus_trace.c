@@ -0,0 +1,86 @@
+/**
+ * MIA Bus Cycle Trace Implementation
+ * 
+ * Overwriting SPSC ring. head is only written by the producer, tail only by
+ * the consumer; both run free and are masked on access. Because the
+ * producer may lap the consumer, the consumer re-checks head after copying
+ * and discards anything that may have been overwritten while it copied.
+ */
+
+#include "bus_trace.h"
+
+// Ring storage and producer state
+bus_trace_record_t g_bus_trace_ring[BUS_TRACE_SIZE];
+volatile uint32_t g_bus_trace_head;
+volatile bool g_bus_trace_enabled;
+
+// Consumer state
+static uint32_t tail;           // Next record to read
+static uint32_t dropped;        // Records lost to overwrites
+
+void bus_trace_init(void) {
+    g_bus_trace_enabled = false;
+    g_bus_trace_head = 0;
+    tail = 0;
+    dropped = 0;
+}
+
+void bus_trace_set_enabled(bool enabled) {
+    if (enabled && !g_bus_trace_enabled) {
+        // Start from an empty ring
+        tail = g_bus_trace_head;
+        dropped = 0;
+    }
+    g_bus_trace_enabled = enabled;
+}
+
+bool bus_trace_is_enabled(void) {
+    return g_bus_trace_enabled;
+}
+
+uint32_t bus_trace_read(bus_trace_record_t *out, uint32_t max) {
+    uint32_t head = g_bus_trace_head;
+    atomic_thread_fence(memory_order_acquire);
+    
+    // Skip records the producer has already overwritten, or may be
+    // overwriting now (the slot at head)
+    if (head + 1 - tail > BUS_TRACE_SIZE) {
+        dropped += head + 1 - tail - BUS_TRACE_SIZE;
+        tail = head + 1 - BUS_TRACE_SIZE;
+    }
+    
+    uint32_t n = head - tail;
+    if (n > max) {
+        n = max;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = g_bus_trace_ring[(tail + i) & BUS_TRACE_MASK];
+    }
+    
+    // Records the producer reached while we were copying may be torn,
+    // by the same rule
+    atomic_thread_fence(memory_order_acquire);
+    uint32_t overwritten = g_bus_trace_head + 1 - tail;
+    if (overwritten > BUS_TRACE_SIZE) {
+        overwritten -= BUS_TRACE_SIZE;
+        if (overwritten >= n) {
+            dropped += n;
+            tail += n;
+            return 0;
+        }
+        // Keep the part that is still intact
+        for (uint32_t i = 0; i < n - overwritten; i++) {
+            out[i] = out[i + overwritten];
+        }
+        dropped += overwritten;
+        tail += overwritten;
+        n -= overwritten;
+    }
+    
+    tail += n;
+    return n;
+}
+
+uint32_t bus_trace_get_dropped(void) {
+    return dropped;
+}
@@ -0,0 +1,116 @@
+/**
+ * MIA Bus Cycle Trace
+ * 
+ * Records every 6502 access to the MIA registers (time, address, R/W,
+ * data) into a ring in SRAM, so a misbehaving program can be replayed on
+ * the host. Compiled in with CONFIG_BUS_TRACE (config/bus_config.h) and
+ * switched on at runtime with bus_trace_set_enabled().
+ * 
+ * The bus IRQ handler on Core 0 is the only producer. A trace point is a
+ * flag test, a timer read and two stores, so it can stay in production
+ * builds. The ring never blocks the producer: when the consumer falls
+ * behind, the oldest records are overwritten and counted as dropped.
+ * 
+ * The consumer (usb_controller_process() on Core 1) streams records over
+ * the USB CDC port in bulk.
+ * 
+ * Each record is 8 bytes, little-endian:
+ *   +0 time (32-bit, microseconds; equals the PHI2 cycle count at 1 MHz)
+ *   +4 address (local 8-bit address)
+ *   +5 data
+ *   +6 flags (BUS_TRACE_FLAG_*)
+ *   +7 BUS_TRACE_SYNC (lets the host find record boundaries)
+ */
+
+#ifndef BUS_TRACE_H
+#define BUS_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Ring capacity in records (must be a power of two), 16KB
+#define BUS_TRACE_SIZE          2048
+#define BUS_TRACE_MASK          (BUS_TRACE_SIZE - 1)
+
+#if (BUS_TRACE_SIZE & BUS_TRACE_MASK) != 0
+#error "BUS_TRACE_SIZE must be a power of two"
+#endif
+
+// Record flags
+#define BUS_TRACE_FLAG_READ     0x00    // 6502 read cycle
+#define BUS_TRACE_FLAG_WRITE    0x01    // 6502 write cycle
+
+#define BUS_TRACE_SYNC          0xA5
+
+// Trace record
+typedef struct {
+    uint32_t time;          // Microsecond timestamp
+    uint8_t addr;           // 8-bit local address
+    uint8_t data;           // Data byte read or written
+    uint8_t flags;          // BUS_TRACE_FLAG_*
+    uint8_t sync;           // Always BUS_TRACE_SYNC
+} bus_trace_record_t;
+
+// Producer state, exposed so trace points can be inlined
+extern bus_trace_record_t g_bus_trace_ring[BUS_TRACE_SIZE];
+extern volatile uint32_t g_bus_trace_head;
+extern volatile bool g_bus_trace_enabled;
+
+/**
+ * Append a record (producer side, bus IRQ only)
+ * 
+ * @param time Timestamp in microseconds
+ * @param addr 8-bit local address
+ * @param data Data byte
+ * @param flags BUS_TRACE_FLAG_*
+ */
+static inline void bus_trace_record(uint32_t time, uint8_t addr, uint8_t data, uint8_t flags) {
+    if (!g_bus_trace_enabled) {
+        return;
+    }
+    
+    uint32_t h = g_bus_trace_head;
+    bus_trace_record_t *r = &g_bus_trace_ring[h & BUS_TRACE_MASK];
+    r->time = time;
+    r->addr = addr;
+    r->data = data;
+    r->flags = flags;
+    r->sync = BUS_TRACE_SYNC;
+    
+    // Record must be visible before the consumer sees the new head
+    atomic_thread_fence(memory_order_release);
+    g_bus_trace_head = h + 1;
+}
+
+/**
+ * Clear the ring and disable tracing
+ */
+void bus_trace_init(void);
+
+/**
+ * Enable or disable recording
+ * Enabling discards records left over from the previous run
+ */
+void bus_trace_set_enabled(bool enabled);
+
+/**
+ * Check if recording is enabled
+ */
+bool bus_trace_is_enabled(void);
+
+/**
+ * Take the oldest records (consumer side, single consumer)
+ * 
+ * @param out Buffer for the records
+ * @param max Maximum number of records to return
+ * @return Number of records copied
+ */
+uint32_t bus_trace_read(bus_trace_record_t *out, uint32_t max);
+
+/**
+ * Get the number of records overwritten before they were read
+ */
+uint32_t bus_trace_get_dropped(void);
+
+#endif // BUS_TRACE_H
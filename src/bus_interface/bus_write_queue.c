@@ -0,0 +1,101 @@
+/**
+ * MIA Bus Write Queue Implementation
+ * 
+ * Lock-free SPSC ring of bus writes. head is only written by the producer,
+ * tail only by the consumer; both run free and are masked on access.
+ */
+
+#include "bus_write_queue.h"
+#include "config/bus_config.h"
+#include <stdatomic.h>
+
+// Ring storage and indexes
+static BUS_HOT_DATA bus_write_t ring[BUS_WRITE_QUEUE_SIZE];
+static BUS_HOT_DATA volatile uint32_t head;             // Next slot to fill (producer)
+static BUS_HOT_DATA volatile uint32_t tail;             // Next slot to drain (consumer)
+static BUS_HOT_DATA volatile uint8_t overflow_count;    // Dropped writes (saturating)
+static BUS_HOT_DATA uint8_t early_read_count;           // Early READs (saturating, consumer only)
+
+void bus_write_queue_init(void) {
+    head = 0;
+    tail = 0;
+    overflow_count = 0;
+    early_read_count = 0;
+}
+
+static inline bool push_entry(uint8_t addr, uint8_t data, bool read, bool early) {
+    uint32_t h = head;
+    
+    if (h - tail >= BUS_WRITE_QUEUE_SIZE) {
+        // Full - drop the write and count it
+        if (overflow_count != 0xFF) {
+            overflow_count++;
+        }
+        return false;
+    }
+    
+    ring[h & BUS_WRITE_QUEUE_MASK].addr = addr;
+    ring[h & BUS_WRITE_QUEUE_MASK].data = data;
+    ring[h & BUS_WRITE_QUEUE_MASK].read = read;
+    ring[h & BUS_WRITE_QUEUE_MASK].early = early;
+    
+    // Entry must be visible before the consumer sees the new head
+    atomic_thread_fence(memory_order_release);
+    head = h + 1;
+    return true;
+}
+
+bool BUS_HOT_FUNC(bus_write_queue_push)(uint8_t addr, uint8_t data) {
+    return push_entry(addr, data, false, false);
+}
+
+bool BUS_HOT_FUNC(bus_write_queue_push_read)(uint8_t addr, uint8_t data, bool early) {
+    return push_entry(addr, data, true, early);
+}
+
+bool BUS_HOT_FUNC(bus_write_queue_pop)(bus_write_t *entry) {
+    uint32_t t = tail;
+    
+    if (t == head) {
+        return false;
+    }
+    
+    // Read the entry only after observing the head that published it
+    atomic_thread_fence(memory_order_acquire);
+    *entry = ring[t & BUS_WRITE_QUEUE_MASK];
+    
+    // Slot must be fully read before the producer can reuse it
+    atomic_thread_fence(memory_order_release);
+    tail = t + 1;
+    return true;
+}
+
+bool BUS_HOT_FUNC(bus_write_queue_is_empty)(void) {
+    return head == tail;
+}
+
+uint32_t bus_write_queue_count(void) {
+    return head - tail;
+}
+
+uint8_t BUS_HOT_FUNC(bus_write_queue_get_overflow)(void) {
+    return overflow_count;
+}
+
+void BUS_HOT_FUNC(bus_write_queue_clear_overflow)(void) {
+    overflow_count = 0;
+}
+
+void BUS_HOT_FUNC(bus_write_queue_count_early_read)(void) {
+    if (early_read_count != 0xFF) {
+        early_read_count++;
+    }
+}
+
+uint8_t BUS_HOT_FUNC(bus_write_queue_get_early_reads)(void) {
+    return early_read_count;
+}
+
+void BUS_HOT_FUNC(bus_write_queue_clear_early_reads)(void) {
+    early_read_count = 0;
+}
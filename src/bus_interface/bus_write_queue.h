@@ -0,0 +1,112 @@
+/**
+ * MIA Bus Write Queue
+ * 
+ * Single-producer/single-consumer ring of (addr, data) pairs between the bus
+ * IRQ handler, which takes WRITE words out of the PIO RX FIFO, and the
+ * consumer that applies them through bus_interface_write().
+ * 
+ * The producer and consumer only share the head/tail indexes, each written
+ * by one side, so no lock is needed. The consumer is the bus write IRQ (see
+ * bus_sync_pio_process_write_data()), which the bus IRQ preempts. READs the
+ * bus IRQ confirms while writes are still queued or being applied are
+ * queued behind them, so their side effects (auto-step) stay in bus order.
+ * 
+ * When the ring is full the entry is dropped and an 8-bit saturating
+ * overflow counter is bumped. The counter is visible to the 6502 through
+ * the shared WRITE_QUEUE_OVERFLOW register (0xF6).
+ * 
+ * A queued READ whose byte was sent while an earlier write was still
+ * unapplied is flagged early; the consumer counts those in a second
+ * saturating counter, shared register WRITE_QUEUE_EARLY_READS (0xFB).
+ */
+
+#ifndef BUS_WRITE_QUEUE_H
+#define BUS_WRITE_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Ring capacity in entries (must be a power of two)
+#define BUS_WRITE_QUEUE_SIZE    64
+#define BUS_WRITE_QUEUE_MASK    (BUS_WRITE_QUEUE_SIZE - 1)
+
+#if (BUS_WRITE_QUEUE_SIZE & BUS_WRITE_QUEUE_MASK) != 0
+#error "BUS_WRITE_QUEUE_SIZE must be a power of two"
+#endif
+
+// Queued bus write, or confirmed READ to commit
+typedef struct {
+    uint8_t addr;       // 8-bit local address
+    uint8_t data;       // Data byte from 6502 (READ: byte sent to the 6502)
+    bool read;          // READ whose side effects wait behind the writes
+    bool early;         // READ answered before an earlier write was applied
+} bus_write_t;
+
+/**
+ * Initialize the write queue (empty, counters cleared)
+ */
+void bus_write_queue_init(void);
+
+/**
+ * Append a write (producer side)
+ * 
+ * @param addr 8-bit local address
+ * @param data Data byte
+ * @return true if queued, false if the ring was full and the write was dropped
+ */
+bool bus_write_queue_push(uint8_t addr, uint8_t data);
+
+/**
+ * Append a confirmed READ (producer side)
+ * 
+ * @param addr 8-bit local address
+ * @param data Byte sent to the 6502
+ * @param early The byte was prepared while an earlier write was unapplied
+ * @return true if queued, false if the ring was full and the READ was dropped
+ */
+bool bus_write_queue_push_read(uint8_t addr, uint8_t data, bool early);
+
+/**
+ * Take the oldest write (consumer side)
+ * 
+ * @param entry Pointer to store the write
+ * @return true if an entry was returned, false if the ring was empty
+ */
+bool bus_write_queue_pop(bus_write_t *entry);
+
+/**
+ * Check if the ring is empty
+ */
+bool bus_write_queue_is_empty(void);
+
+/**
+ * Get the number of queued writes
+ */
+uint32_t bus_write_queue_count(void);
+
+/**
+ * Get the overflow counter (dropped writes, saturates at 255)
+ */
+uint8_t bus_write_queue_get_overflow(void);
+
+/**
+ * Clear the overflow counter
+ */
+void bus_write_queue_clear_overflow(void);
+
+/**
+ * Count a READ answered before an earlier write was applied (consumer side)
+ */
+void bus_write_queue_count_early_read(void);
+
+/**
+ * Get the early READ counter (saturates at 255)
+ */
+uint8_t bus_write_queue_get_early_reads(void);
+
+/**
+ * Clear the early READ counter
+ */
+void bus_write_queue_clear_early_reads(void);
+
+#endif // BUS_WRITE_QUEUE_H
@@ -0,0 +1,90 @@
+/**
+ * Bus Interface Configuration Header
+ * Build-time configuration for the synchronous bus PIO program
+ */
+
+#ifndef BUS_CONFIG_H
+#define BUS_CONFIG_H
+
+// Bus Synchronization Mode Configuration
+// Uncomment ONE of the following lines to select the bus_sync.pio variant:
+
+#define CONFIG_BUS_SYNC_HYBRID       // PIO samples address/CS, C reads OE/WE and answers with a control byte
+// #define CONFIG_BUS_SYNC_AUTONOMOUS   // PIO samples OE/WE and decides READ/WRITE itself, C only supplies the read byte
+
+// Validate configuration
+#if defined(CONFIG_BUS_SYNC_HYBRID) && defined(CONFIG_BUS_SYNC_AUTONOMOUS)
+#error "Cannot define both CONFIG_BUS_SYNC_HYBRID and CONFIG_BUS_SYNC_AUTONOMOUS"
+#endif
+
+#if !defined(CONFIG_BUS_SYNC_HYBRID) && !defined(CONFIG_BUS_SYNC_AUTONOMOUS)
+#error "Must define either CONFIG_BUS_SYNC_HYBRID or CONFIG_BUS_SYNC_AUTONOMOUS"
+#endif
+
+// Read Response Shadow
+// Speculative reads come from the g_bus_read_shadow table (a single load) and
+// DATA_PORT auto-step is committed only for confirmed READ cycles.
+// Comment out to prepare speculative data with bus_interface_read() instead.
+#define CONFIG_BUS_READ_SHADOW
+
+// RX FIFO DMA Drain
+// A DMA channel paced by the bus state machine's RX DREQ copies every RX word
+// into a power-of-two ring in SRAM, so the 4-entry RX FIFO can never overflow
+// while the IRQ handler is late. The handler consumes the ring in batches.
+// Uncomment to drain the RX FIFO with DMA instead of pio_sm_get():
+// #define CONFIG_BUS_RX_DMA
+
+// Bus Timing Statistics
+// Record DWT cycle counts at key points of the bus IRQ handler into per-phase
+// min/max/histogram statistics (TIMING_SELECT/TIMING_DATA registers and the
+// 't' key on the USB console). Adds a few cycle counter reads per bus cycle.
+// Uncomment to enable:
+// #define CONFIG_BUS_TIMING_STATS
+
+// The timing bench firmware (mia_timing_bench target) needs the statistics
+#if defined(CONFIG_MIA_TIMING_BENCH) && !defined(CONFIG_BUS_TIMING_STATS)
+#define CONFIG_BUS_TIMING_STATS
+#endif
+
+// Highest Validated PHI2 Frequency
+// The bus_sync.pio sample points are fixed delays from the PHI2 edges, set
+// for a 1 MHz cycle: CS at 200ns after PHI2 falls and OE/WE 30ns after it
+// rises. Up to 1.5 MHz PHI2 still rises after the CS sample and the read
+// byte is ready in time; at 2 MHz it rises at 250ns and leaves the hybrid
+// handler about 80ns to answer. Clock control speed codes above this
+// frequency are refused. Raise it once the timing bench passes at the new
+// speed on the board:
+#define BUS_MAX_VALIDATED_HZ    1500000
+
+// Bus Hot Path in SRAM
+// Runs the bus IRQ handler and everything a bus cycle calls from SRAM
+// (.time_critical) instead of flash through the XIP cache, and keeps the bus
+// state it touches (read shadow, windows, write queue, IRQ state) in the
+// SCRATCH_Y bank next to the Core 0 stack, away from the striped main SRAM
+// that the copy DMA and Core 1 keep busy. A bus cycle then takes the same
+// time whatever the flash cache and the DMA are doing. The index fields
+// every access uses (current address, step, flags, kernel) take half of
+// SCRATCH_X, written by Core 0 only and read now and then by Core 1 tasks
+// (the Core 1 stack is in main SRAM).
+// Comment out to run the bus path from flash:
+#define CONFIG_BUS_HOT_PATH_SRAM
+
+#ifdef CONFIG_BUS_HOT_PATH_SRAM
+#include "pico/platform.h"
+#define BUS_HOT_FUNC(func)      __not_in_flash_func(func)
+#define BUS_HOT_DATA            __scratch_y("bus_hot")
+#define BUS_INDEX_DATA          __scratch_x("bus_index")
+#else
+#define BUS_HOT_FUNC(func)      func
+#define BUS_HOT_DATA
+#define BUS_INDEX_DATA
+#endif
+
+// Bus Cycle Trace
+// Compile in trace points that log every MIA register access into an SRAM
+// ring, streamed over the USB CDC port while tracing is switched on (the
+// 'r' key on the USB console). A trace point costs a few cycles when off.
+// Uncomment to enable:
+// #define CONFIG_BUS_TRACE
+
+#endif // BUS_CONFIG_H
@@ -0,0 +1,31 @@
+/**
+ * Interrupt Configuration Header
+ * NVIC priorities of the MIA interrupts
+ *
+ * The RP2350 implements 4 priority bits: 0x00 is the highest, 0xF0 the
+ * lowest, in steps of 0x10; a lower number preempts a higher one. Each core
+ * has its own NVIC, so a priority is set by the core the interrupt runs on.
+ *
+ * The bus IRQ is alone at the top on Core 0, so no other handler can delay
+ * its entry, only code running with interrupts disabled. The bus write IRQ
+ * comes right below it, so queued 6502 writes are applied ahead of DMA
+ * bookkeeping, USB and the background work, while the bus IRQ still
+ * preempts them. Its handler is installed with
+ * irq_set_exclusive_handler() straight into the RAM vector table the SDK
+ * sets up at boot, so entry never waits for flash.
+ */
+
+#ifndef IRQ_CONFIG_H
+#define IRQ_CONFIG_H
+
+// Core 0
+#define MIA_IRQ_PRIORITY_BUS        0x00    // PIO0_IRQ_0: 6502 bus cycles (normal operation)
+#define MIA_IRQ_PRIORITY_ROM        0x00    // ROM_PIO_IRQ: boot ROM reads (boot phase, no bus IRQ yet)
+#define MIA_IRQ_PRIORITY_BUS_WRITE  0x20    // Spare IRQ pended by the bus IRQ: applies queued 6502 writes
+#define MIA_IRQ_PRIORITY_DMA        0x40    // DMA_IRQ_0: copy batch completion
+#define MIA_IRQ_PRIORITY_USB        0x80    // USBCTRL_IRQ: TinyUSB, started by USB stdio
+
+// Core 1
+#define MIA_IRQ_PRIORITY_VIDEO      0x40    // DMA_IRQ_1: local VGA scanlines
+
+#endif // IRQ_CONFIG_H
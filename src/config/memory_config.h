@@ -0,0 +1,39 @@
+/**
+ * Memory Configuration Header
+ * Build-time configuration of the MIA address space beyond the SRAM: the
+ * optional PSRAM expansion and the flash asset region
+ */
+
+#ifndef MEMORY_CONFIG_H
+#define MEMORY_CONFIG_H
+
+// PSRAM Expansion
+// QSPI PSRAM on the RP2350's second QMI chip select backs the MIA addresses
+// from $040000 (the end of the 256KB SRAM) up to $040000 + PSRAM_SIZE, so
+// indexes can stream large assets (levels, samples, fonts) held on MIA.
+// Accesses go through an SRAM page cache (indexed_memory/psram_cache.h).
+// QMI CS1 can only be GPIO 0, 8, 19 or 47, and the first three are bus pins
+// (A0, D0, OE), so this needs an RP2350B board with PSRAM on GPIO 47.
+// Uncomment to enable:
+// #define CONFIG_MIA_PSRAM
+
+#define PSRAM_CS_PIN            47          // QMI CS1
+#define PSRAM_SIZE              0x00800000  // 8MB (APS6404L); must end below MIA_ASSET_BASE
+#define PSRAM_MAX_FREQ_HZ       109000000   // QPI clock limit, from the part's datasheet
+
+// Page cache: PSRAM_CACHE_SETS x PSRAM_CACHE_WAYS pages of PSRAM_PAGE_SIZE
+// bytes in SRAM (8KB); set and way counts must be powers of two
+#define PSRAM_PAGE_SHIFT        8
+#define PSRAM_PAGE_SIZE         (1u << PSRAM_PAGE_SHIFT)
+#define PSRAM_CACHE_SETS        8
+#define PSRAM_CACHE_WAYS        4
+
+// Flash Assets
+// Files from the MIA_ASSETS build option are embedded in flash
+// (indexed_memory/asset_data.h) and read-only at these MIA addresses, for
+// indexes and as the source of block copies. Set MIA_ASSET_BASE in
+// CMakeLists.txt to the same value.
+#define MIA_ASSET_BASE          0x00C00000
+#define MIA_ASSET_MAX_SIZE      0x00400000  // Up to the 24-bit address limit
+
+#endif // MEMORY_CONFIG_H
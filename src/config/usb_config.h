@@ -9,6 +9,8 @@
 // USB Mode Configuration
 // Uncomment ONE of the following lines to select USB mode:
 
+// Host mode also needs pico_enable_stdio_usb(mia 0) in CMakeLists.txt, since
+// stdio over USB runs on the device stack
 // #define CONFIG_USB_HOST    // USB Host mode - connect USB hub with keyboard/mouse
 #define CONFIG_USB_DEVICE  // USB Device mode - connect to computer for debugging
 
@@ -36,6 +38,10 @@
 #endif
 
 // Common USB Configuration
-#define USB_KEYBOARD_BUFFER_SIZE 16  // Keyboard input buffer size (both modes)
+#define USB_KEYBOARD_BUFFER_SIZE 64  // Keyboard ring size, a power of two up to 256 (index 64)
+
+// USB loader status block (index 66), in the I/O buffer after the keyboard
+#define USB_LOADER_STATUS_OFFSET 0x80
+#define USB_LOADER_STATUS_SIZE   8
 
 #endif // USB_CONFIG_H
\ No newline at end of file
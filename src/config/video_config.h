@@ -0,0 +1,22 @@
+/**
+ * Video Output Configuration Header
+ * Build-time configuration for the local video output
+ */
+
+#ifndef VIDEO_CONFIG_H
+#define VIDEO_CONFIG_H
+
+// Local Video Output
+// Drive a VGA monitor (640x400 @ 70 Hz, the 320x200 frame pixel and line
+// doubled) from PIO 2, rendering scanlines just in time on Core 1. Needs 16
+// consecutive GPIOs for RGB565 (through a resistor DAC) plus HSYNC and
+// VSYNC, all within GPIO 16-47. The Pico 2 W only has GPIO 27 left, so this
+// is for RP2350B boards. Wi-Fi streaming is not affected.
+// Uncomment to enable:
+// #define CONFIG_VIDEO_LOCAL_OUTPUT
+
+#define VIDEO_OUTPUT_RGB_BASE_PIN   30  // R4-R0 G5-G0 B4-B0 from the top pin down
+#define VIDEO_OUTPUT_HSYNC_PIN      46
+#define VIDEO_OUTPUT_VSYNC_PIN      47
+
+#endif // VIDEO_CONFIG_H
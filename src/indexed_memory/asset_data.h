@@ -0,0 +1,20 @@
+/**
+ * Flash Asset Data Interface
+ * External declarations for the assets embedded at build time
+ *
+ * The MIA_ASSETS build option lists raw files (fonts, tilesets, lookup
+ * tables) that scripts/generate_asset_data.cmake concatenates into
+ * asset_data, each on a 4-byte boundary. It stays in flash and is mapped
+ * read-only at MIA address MIA_ASSET_BASE (config/memory_config.h); the
+ * generated assets.inc gives the 6502 program the address of each.
+ */
+
+#ifndef ASSET_DATA_H
+#define ASSET_DATA_H
+
+#include <stdint.h>
+
+extern const uint8_t asset_data[];
+extern const uint32_t asset_data_size;      // 0 without assets
+
+#endif // ASSET_DATA_H
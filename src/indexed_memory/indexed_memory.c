@@ -8,7 +8,17 @@
 #include "indexed_memory.h"
 #include "indexed_memory_dma.h"
 #include "hardware/gpio_mapping.h"
+#include "video/video_controller.h"
+#include "config/usb_config.h"
+#include "config/bus_config.h"
 #include "pico/util/queue.h"
+#include "system/background.h"
+#include "config/memory_config.h"
+#include "asset_data.h"
+#ifdef CONFIG_MIA_PSRAM
+#include "psram_cache.h"
+#endif
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -16,169 +26,445 @@
 // Always include GPIO for IRQ line control (mocked in tests)
 #include "hardware/gpio.h"
 #include "hardware/watchdog.h"
+#include "hardware/sync.h"
 
-// Inter-core command queue
-#define COMMAND_QUEUE_SIZE 8
+// Copy command queue
+// Copies waiting for the DMA engine; each time it goes idle, the Core 0
+// background work starts everything queued (up to INDEXED_MEMORY_DMA_BATCH_MAX) as one chained batch
+#define COMMAND_QUEUE_SIZE 32
 static queue_t command_queue;
+static bool command_queue_ready = false;
+
+// Copy accounting: STATUS_DMA_ACTIVE is set while queued != done
+// queued is counted by the bus write path, done by the DMA completion IRQ,
+// both on Core 0; batch_copies (queued copies that finish with the batch) is
+// written by the background work before a batch starts
+static volatile uint32_t g_copies_queued;
+static volatile uint32_t g_copies_done;
+static volatile uint32_t g_batch_copies;
+
+// Destinations of the running batch, marked dirty when it completes
+// (written by the background work before the batch starts, like batch_copies)
+static uint32_t g_batch_dst[INDEXED_MEMORY_DMA_BATCH_MAX];
+static uint16_t g_batch_len[INDEXED_MEMORY_DMA_BATCH_MAX];
+static volatile uint32_t g_batch_jobs;
+
+// Rectangle copy split into row jobs, continued by the next batch when its
+// rows do not fit (background work only)
+static copy_command_t g_rect_cmd;
+static bool g_rect_pending = false;
 
 // Forward declarations
 static void indexed_memory_reset_index(uint8_t idx);
-static void indexed_memory_copy_block(uint8_t src_idx, uint8_t dst_idx, uint16_t count);
+static void indexed_memory_queue_copy(uint8_t src_idx, uint8_t dst_idx, uint16_t count);
+static void indexed_memory_queue_fill(uint8_t dst_idx, uint16_t count, uint8_t value);
+static void indexed_memory_queue_rect(uint8_t src_idx, uint8_t dst_idx, uint16_t width, uint8_t rows);
+static bool indexed_memory_queue_command(const copy_command_t *cmd);
+static void indexed_memory_copy_advance(uint8_t idx, uint32_t amount);
+static void indexed_memory_load_descriptor(uint8_t idx, uint8_t src_idx);
 static void indexed_memory_set_address(uint8_t idx, addr_field_t field, uint32_t address);
+static void indexed_memory_select_kernel(uint8_t idx);
+static void indexed_memory_finish_deferred(void);
 
 // MIA memory layout (256KB properly allocated)
 // All addresses are logical offsets (0x000000 - 0x03FFFF) into the mia_memory array
 #define MIA_MEMORY_BASE         0x00000000  // Logical base (offset 0)
 #define MIA_INDEX_TABLE_BASE    0x00000000  // 2KB
 #define MIA_SYSTEM_AREA_BASE    0x00000800  // 16KB
-#define MIA_VIDEO_AREA_BASE     0x00004800  // 60KB
-#define MIA_USER_AREA_BASE      0x00013800  // 162KB
+#define MIA_VIDEO_AREA_BASE     INDEXED_MEMORY_VIDEO_AREA_BASE  // 60KB
+#define MIA_USER_AREA_BASE      INDEXED_MEMORY_USER_AREA_BASE  // 162KB
 #define MIA_IO_BUFFER_BASE      0x0003C000  // 16KB
-#define MIA_MEMORY_SIZE         0x00040000  // 256KB total MIA memory
+#define MIA_BOOT_CACHE_BASE     (MIA_IO_BUFFER_BASE - INDEXED_MEMORY_BOOT_CACHE_SIZE)  // Top 40KB of the user area
+#define MIA_MEMORY_SIZE         INDEXED_MEMORY_SIZE  // 256KB total MIA memory
+
+// Global system state, apart from the index fields every access uses
+static struct {
+    index_range_t ranges[256];
+    dma_config_t dma_config;
+    uint8_t status;
+} g_state;
+
+// Status bits change on both cores (USB_DATA_READY from Core 1, BUSY,
+// DMA_ACTIVE and MEMORY_ERROR on Core 0, some from interrupts), so every
+// update is one atomic read-modify-write
+static inline void status_set(uint8_t bits) {
+    __atomic_fetch_or(&g_state.status, bits, __ATOMIC_RELAXED);
+}
+
+static inline void status_clear(uint8_t bits) {
+    __atomic_fetch_and(&g_state.status, (uint8_t)~bits, __ATOMIC_RELAXED);
+}
 
-// Global system state
-static indexed_memory_state_t g_state;
+// Index fields every access uses, 2KB in a scratch bank of their own so a
+// DATA_PORT access never waits for the copy DMA or Core 1 (BUS_INDEX_DATA)
+static BUS_INDEX_DATA index_t g_indexes[256];
+_Static_assert(sizeof(index_t) == 8, "index_t is a power of two for indexing");
 
 // MIA memory array - properly allocated by linker to avoid SDK conflicts
 // All index addresses are offsets into this array
 static uint8_t mia_memory[MIA_MEMORY_SIZE] __attribute__((aligned(4)));
 
+// The video indexes point into a video_memory_t at the start of the video area
+_Static_assert(sizeof(video_memory_t) <= MIA_USER_AREA_BASE - MIA_VIDEO_AREA_BASE,
+               "video_memory_t does not fit in the video area");
+_Static_assert(MIA_USER_AREA_BASE + INDEXED_MEMORY_USER_AREA_SIZE == MIA_IO_BUFFER_BASE,
+               "The user area must end at the I/O buffer area");
+#define VIDEO_FIELD_ADDR(field) (MIA_VIDEO_AREA_BASE + offsetof(video_memory_t, field))
+
+// Video area dirty flags (see indexed_memory_mark_video_dirty)
+volatile uint8_t g_video_dirty[VIDEO_TRACKED_BLOCKS];
+_Static_assert(VIDEO_FRAME_DATA_OFFSET % VIDEO_DIRTY_BLOCK_SIZE == 0,
+               "Frame data must start on a dirty block");
+
+// State generation counter
+// Bumped whenever memory, indexes or status change outside the bus write
+// path (DMA completion, status updates, re-initialization), so the bus read
+// shadow knows its DATA_PORT/CFG_DATA/status entries must be rebuilt
+static volatile uint32_t g_generation;
+
+// Both cores bump it (status updates from Core 1), so the increment is atomic
+static inline void generation_bump(void) {
+    __atomic_fetch_add(&g_generation, 1, __ATOMIC_RELEASE);
+}
+
+// Flash assets, read-only at MIA_ASSET_BASE and up
+// Reached like the PSRAM, through the generic kernel only
+#define ASSET_ADDR(addr) ((uint32_t)((addr) - MIA_ASSET_BASE) < asset_data_size)
+#define ASSET_OFFSET(addr) ((addr) - MIA_ASSET_BASE)
+_Static_assert(MIA_ASSET_BASE >= MIA_MEMORY_SIZE && MIA_ASSET_BASE + MIA_ASSET_MAX_SIZE <= 0x01000000,
+               "The asset region must lie between the SRAM and the 24-bit address limit");
+
+#ifdef CONFIG_MIA_PSRAM
+_Static_assert(MIA_MEMORY_SIZE + PSRAM_SIZE <= MIA_ASSET_BASE, "The PSRAM must end below the asset region");
+
+// PSRAM behind the SRAM, at MIA addresses MIA_MEMORY_SIZE and up (0 = none)
+// Only the generic kernel reaches it: the fixed and forward-wrap kernels are
+// chosen for SRAM addresses only, and the forward kernel hands anything out
+// of SRAM to the generic path
+static uint32_t g_psram_size;
+#define PSRAM_ADDR(addr) ((uint32_t)((addr) - MIA_MEMORY_SIZE) < g_psram_size)
+#define PSRAM_OFFSET(addr) ((addr) - MIA_MEMORY_SIZE)
+#endif
+
+/**
+ * End of the copy source region holding addr: the SRAM, or the flash assets
+ * (read-only, so only ever a source); 0 outside both
+ */
+static inline uint32_t copy_source_end(uint32_t addr) {
+    if (ADDR_VALID(addr)) {
+        return MIA_MEMORY_SIZE;
+    }
+    return ASSET_ADDR(addr) ? MIA_ASSET_BASE + asset_data_size : 0;
+}
+
+static inline const uint8_t *copy_source(uint32_t addr) {
+    return ADDR_VALID(addr) ? &mia_memory[addr] : &asset_data[ASSET_OFFSET(addr)];
+}
+
+// Set by CMD_SYSTEM_FAST_RESET, serviced by the Core 0 background work
+static volatile bool g_fast_reset_pending;
+
+// Set by CMD_SNAPSHOT_SAVE, serviced by the Core 0 background work
+static volatile bool g_snapshot_pending;
+
+// Heavy shared command waiting for the Core 0 background work while
+// STATUS_BUSY is set (CMD_SHARED_NOP when none)
+static volatile uint8_t g_deferred_command;
+
+/**
+ * DMA completion callback - called after a copy (IRQ per copy) and when a
+ * batch completes
+ */
+static void dma_completion_callback(bool batch_done) {
+    bool all_done = false;
+    if (batch_done) {
+        for (uint32_t i = 0; i < g_batch_jobs; i++) {
+            indexed_memory_mark_video_dirty_range(g_batch_dst[i], g_batch_len[i]);
+        }
+        g_batch_jobs = 0;
+        g_copies_done += g_batch_copies;
+        g_batch_copies = 0;
+        all_done = (g_copies_done == g_copies_queued);
+    }
+    
+    // Clear DMA active status once nothing is queued or running
+    if (all_done) {
+        status_clear(STATUS_DMA_ACTIVE);
+    }
+    
+    // Destination memory changed behind the bus interface
+    generation_bump();
+    
+    // Signal completion: per copy callbacks only come with IRQ per copy, and
+    // a batch may end in the middle of a rectangle
+    if (all_done || !batch_done) {
+        irq_set_bits(IRQ_DMA_COMPLETE);
+    }
+    
+    // Start the next batch from what is still queued, between bus IRQs
+    if (batch_done) {
+        background_post(BACKGROUND_WORK_COPY);
+    }
+}
+
 /**
- * DMA completion callback - called when DMA transfer completes
+ * Move a FLAG_2D index that finished its row to the start of the next one
+ * Rows always advance by the stride; the direction flag only applies
+ * within a row
  */
-static void dma_completion_callback(void) {
-    // Clear DMA active status
-    g_state.status &= ~STATUS_DMA_ACTIVE;
+static inline uint32_t indexed_memory_row_step(uint8_t idx, uint32_t addr) {
+    index_t *index = &g_indexes[idx];
+    const index_range_t *range = &g_state.ranges[idx];
+    if (range->row_width == 0 || ++index->column < range->row_width) {
+        return addr;
+    }
     
-    // Signal completion
-    irq_set_bits(IRQ_DMA_COMPLETE);
+    index->column = 0;
+    uint32_t row = (uint32_t)range->row_width * index->step;
+    addr = (index->flags & FLAG_DIRECTION) ? addr + row : addr - row;
+    return addr + range->row_stride;
 }
 
 /**
- * Initialize the indexed memory system
+ * Advance index address by its step size - shared by read, write and commit
+ * Honours the direction, 2D and wrap-on-limit flags (only wrapping and 2D
+ * indexes look at their range)
  */
-void indexed_memory_init(void) {    
-    // Clear all state
-    memset(&g_state, 0, sizeof(g_state));
+static inline void indexed_memory_step(uint8_t idx, uint32_t addr) {
+    index_t *index = &g_indexes[idx];
+    uint8_t flags = index->flags;
+    bool backward = (flags & FLAG_DIRECTION) != 0;
     
-    // Clear MIA memory
-    memset(mia_memory, 0, MIA_MEMORY_SIZE);
+    addr = backward ? addr - index->step : addr + index->step;
+    if (flags & FLAG_2D) {
+        addr = indexed_memory_row_step(idx, addr);
+    }
     
-    // Initialize system status
-    g_state.status = STATUS_SYSTEM_READY;
+    if (flags & FLAG_WRAP_ON_LIMIT) {
+        uint32_t limit = g_state.ranges[idx].limit_addr;
+        if (backward ? addr < limit : addr >= limit) {
+            addr = g_state.ranges[idx].default_addr;
+            index->column = 0;
+        }
+    }
+    
+    index->current_addr = addr;
+}
+
+#ifdef CONFIG_MIA_PSRAM
+/**
+ * Step an index at a PSRAM address, asking for the page beyond the one it
+ * enters so a stream finds it cached by the time it gets there
+ */
+static inline void indexed_memory_psram_step(uint8_t idx, uint32_t addr) {
+    indexed_memory_step(idx, addr);
+    uint32_t next = g_indexes[idx].current_addr;
+    if ((next ^ addr) >> PSRAM_PAGE_SHIFT) {
+        next = (g_indexes[idx].flags & FLAG_DIRECTION) ? next - PSRAM_PAGE_SIZE : next + PSRAM_PAGE_SIZE;
+        if (PSRAM_ADDR(next)) {
+            psram_cache_prefetch(PSRAM_OFFSET(next));
+        }
+    }
+}
+#endif
+
+/**
+ * Choose the access kernel for an index from its flags and addresses
+ * Must be called after any change to the index outside read/write/commit
+ * 
+ * The fixed and forward-wrap kernels skip the per-access bounds check, so
+ * they are only chosen when every address they can reach is valid:
+ * - Fixed: the address never changes, so it is checked here once
+ * - Forward wrap: stepping either stays below limit (<= memory size) or
+ *   loads the default address, so current and default are checked here
+ */
+static void BUS_HOT_FUNC(indexed_memory_select_kernel)(uint8_t idx) {
+    index_t *index = &g_indexes[idx];
+    const index_range_t *range = &g_state.ranges[idx];
+    uint8_t kernel = KERNEL_GENERIC;
+    
+    if (!(index->flags & FLAG_AUTO_STEP)) {
+        if (ADDR_VALID(index->current_addr)) {
+            kernel = KERNEL_FIXED;
+        }
+    } else if (!(index->flags & (FLAG_DIRECTION | FLAG_2D))) {
+        if (!(index->flags & FLAG_WRAP_ON_LIMIT)) {
+            kernel = KERNEL_FORWARD;
+        } else if (ADDR_VALID(index->current_addr) &&
+                   ADDR_VALID(range->default_addr) &&
+                   range->limit_addr <= MIA_MEMORY_SIZE) {
+            kernel = KERNEL_FORWARD_WRAP;
+        }
+    }
+    
+    index->kernel = kernel;
+}
+
+/**
+ * Load the factory index configuration and status (memory is left as is)
+ */
+static void indexed_memory_configure_defaults(void) {
+    // Clear all state
+    memset(g_state.ranges, 0, sizeof(g_state.ranges));
+    memset(&g_state.dma_config, 0, sizeof(g_state.dma_config));
+    memset(g_indexes, 0, sizeof(g_indexes));
+    
+    // Initialize system status (copies already running keep DMA_ACTIVE, a
+    // deferred command in progress keeps BUSY)
+    status_clear((uint8_t)~STATUS_BUSY);
+    status_set(STATUS_SYSTEM_READY);
+    if (g_copies_done != g_copies_queued) {
+        status_set(STATUS_DMA_ACTIVE);
+    }
     
     // Pre-configure system indexes
     
     // Index 0: System error log
     indexed_memory_set_address(IDX_SYSTEM_ERROR, ADDR_CURRENT, MIA_SYSTEM_AREA_BASE);
     indexed_memory_set_address(IDX_SYSTEM_ERROR, ADDR_DEFAULT, MIA_SYSTEM_AREA_BASE);
-    g_state.indexes[IDX_SYSTEM_ERROR].step = 1;
-    g_state.indexes[IDX_SYSTEM_ERROR].flags = FLAG_AUTO_STEP;
+    g_indexes[IDX_SYSTEM_ERROR].step = 1;
+    g_indexes[IDX_SYSTEM_ERROR].flags = FLAG_AUTO_STEP;
     
     // Character tables (indexes 16-23) - 8 tables, shared by background and sprites
     for (int i = 0; i < 8; i++) {
         uint8_t idx = IDX_CHARACTER_START + i;
-        uint32_t addr = MIA_VIDEO_AREA_BASE + (i * 256 * 24); // 256 chars × 24 bytes each
+        uint32_t addr = VIDEO_FIELD_ADDR(character_tables) + (i * 256 * 24); // 256 chars × 24 bytes each
         indexed_memory_set_address(idx, ADDR_CURRENT, addr);
         indexed_memory_set_address(idx, ADDR_DEFAULT, addr);
         indexed_memory_set_address(idx, ADDR_LIMIT, addr + (256 * 24)); // Wrap at end of character table (6KB)
-        g_state.indexes[idx].step = 1;
-        g_state.indexes[idx].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
+        g_indexes[idx].step = 1;
+        g_indexes[idx].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
     }
     
     // Palette banks (indexes 32-47) - 16 banks, shared resource
-    uint32_t palette_base = MIA_VIDEO_AREA_BASE + (8 * 256 * 24); // After 8 char tables (48KB)
+    uint32_t palette_base = VIDEO_FIELD_ADDR(palette_banks); // After 8 char tables (48KB)
     for (int i = 0; i < 16; i++) {
         uint8_t idx = IDX_PALETTE_START + i;
         uint32_t addr = palette_base + (i * 16); // 8 colors × 2 bytes per bank
         indexed_memory_set_address(idx, ADDR_CURRENT, addr);
         indexed_memory_set_address(idx, ADDR_DEFAULT, addr);
         indexed_memory_set_address(idx, ADDR_LIMIT, addr + 16); // Wrap at end of palette bank (16 bytes)
-        g_state.indexes[idx].step = 1;
-        g_state.indexes[idx].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
+        g_indexes[idx].step = 1;
+        g_indexes[idx].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
     }
     
     // Nametables (indexes 48-51) - 4 tables for double buffering and scrolling
-    uint32_t nametable_base = palette_base + (16 * 16); // After palette banks (256 bytes)
+    uint32_t nametable_base = VIDEO_FIELD_ADDR(nametables); // After palette banks (256 bytes)
     for (int i = 0; i < 4; i++) {
         uint8_t idx = IDX_NAMETABLE_START + i;
         uint32_t addr = nametable_base + (i * 40 * 25); // 40×25 bytes per nametable
         indexed_memory_set_address(idx, ADDR_CURRENT, addr);
         indexed_memory_set_address(idx, ADDR_DEFAULT, addr);
         indexed_memory_set_address(idx, ADDR_LIMIT, addr + (40 * 25)); // Wrap at end of nametable (1000 bytes)
-        g_state.indexes[idx].step = 1;
-        g_state.indexes[idx].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
+        g_indexes[idx].step = 1;
+        g_indexes[idx].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
     }
     
     // Palette tables (indexes 52-55) - 4 tables for double buffering and scrolling
-    uint32_t palette_table_base = nametable_base + (4 * 40 * 25); // After nametables (4KB)
+    uint32_t palette_table_base = VIDEO_FIELD_ADDR(palette_tables); // After nametables (4KB)
     for (int i = 0; i < 4; i++) {
         uint8_t idx = IDX_PALETTE_TABLE_START + i;
         uint32_t addr = palette_table_base + (i * 40 * 25); // 40×25 bytes per palette table
         indexed_memory_set_address(idx, ADDR_CURRENT, addr);
         indexed_memory_set_address(idx, ADDR_DEFAULT, addr);
         indexed_memory_set_address(idx, ADDR_LIMIT, addr + (40 * 25)); // Wrap at end of palette table (1000 bytes)
-        g_state.indexes[idx].step = 1;
-        g_state.indexes[idx].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
+        g_indexes[idx].step = 1;
+        g_indexes[idx].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
     }
     
     // Sprite OAM (index 56) - 256 sprites × 4 bytes, sprites use character table graphics
-    uint32_t sprite_oam_base = palette_table_base + (4 * 40 * 25); // After palette tables (4KB)
+    uint32_t sprite_oam_base = VIDEO_FIELD_ADDR(oam); // After palette tables (4KB)
     indexed_memory_set_address(IDX_SPRITE_OAM, ADDR_CURRENT, sprite_oam_base);
     indexed_memory_set_address(IDX_SPRITE_OAM, ADDR_DEFAULT, sprite_oam_base);
     indexed_memory_set_address(IDX_SPRITE_OAM, ADDR_LIMIT, sprite_oam_base + (256 * 4)); // Wrap at end of OAM (1024 bytes)
-    g_state.indexes[IDX_SPRITE_OAM].step = 4; // Step by sprite record size (4 bytes)
-    g_state.indexes[IDX_SPRITE_OAM].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
+    g_indexes[IDX_SPRITE_OAM].step = 4; // Step by sprite record size (4 bytes)
+    g_indexes[IDX_SPRITE_OAM].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
     
     // Active frame control (index 57) - selects which buffer set (0 or 1) for video transmission
-    uint32_t active_frame_base = sprite_oam_base + (256 * 4); // After sprite OAM (1KB)
+    uint32_t active_frame_base = VIDEO_FIELD_ADDR(active_frame); // After sprite OAM (1KB)
     indexed_memory_set_address(IDX_ACTIVE_FRAME, ADDR_CURRENT, active_frame_base);
     indexed_memory_set_address(IDX_ACTIVE_FRAME, ADDR_DEFAULT, active_frame_base);
-    g_state.indexes[IDX_ACTIVE_FRAME].step = 1;
-    g_state.indexes[IDX_ACTIVE_FRAME].flags = 0; // No auto-step
+    g_indexes[IDX_ACTIVE_FRAME].step = 1;
+    g_indexes[IDX_ACTIVE_FRAME].flags = 0; // No auto-step
+    
+    // Frame rate (index 58) - target FPS for the video stream
+    uint32_t frame_rate_base = VIDEO_FIELD_ADDR(frame_rate);
+    indexed_memory_set_address(IDX_FRAME_RATE, ADDR_CURRENT, frame_rate_base);
+    indexed_memory_set_address(IDX_FRAME_RATE, ADDR_DEFAULT, frame_rate_base);
+    g_indexes[IDX_FRAME_RATE].step = 1;
+    g_indexes[IDX_FRAME_RATE].flags = 0; // No auto-step
+    
+    // Sprite collisions (index 59) - status byte then 32 bytes of collision bits
+    uint32_t sprite_status_base = VIDEO_FIELD_ADDR(sprite_status);
+    indexed_memory_set_address(IDX_SPRITE_COLLISION, ADDR_CURRENT, sprite_status_base);
+    indexed_memory_set_address(IDX_SPRITE_COLLISION, ADDR_DEFAULT, sprite_status_base);
+    indexed_memory_set_address(IDX_SPRITE_COLLISION, ADDR_LIMIT, sprite_status_base + 1 + (MAX_SPRITES / 8)); // Wrap after the collision bits
+    g_indexes[IDX_SPRITE_COLLISION].step = 1;
+    g_indexes[IDX_SPRITE_COLLISION].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
+    
+    // Scroll offset (index 60) - X low, X high, Y low, Y high
+    uint32_t scroll_base = VIDEO_FIELD_ADDR(scroll_x);
+    indexed_memory_set_address(IDX_SCROLL, ADDR_CURRENT, scroll_base);
+    indexed_memory_set_address(IDX_SCROLL, ADDR_DEFAULT, scroll_base);
+    indexed_memory_set_address(IDX_SCROLL, ADDR_LIMIT, scroll_base + 4); // Wrap after Y
+    g_indexes[IDX_SCROLL].step = 1;
+    g_indexes[IDX_SCROLL].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
     
     // USB keyboard buffer (indexes 64-79)
     uint32_t usb_base = MIA_IO_BUFFER_BASE;
     
-    // Index 64: USB keyboard circular buffer
-    indexed_memory_set_address(64, ADDR_CURRENT, usb_base);
-    indexed_memory_set_address(64, ADDR_DEFAULT, usb_base);
-    indexed_memory_set_address(64, ADDR_LIMIT, usb_base + 64); // Wrap at end of keyboard buffer (64 bytes)
-    g_state.indexes[64].step = 1;
-    g_state.indexes[64].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
+    // Index 64: USB keyboard circular buffer (the consumer side of the ring)
+    indexed_memory_set_address(IDX_USB_KEYBOARD, ADDR_CURRENT, usb_base);
+    indexed_memory_set_address(IDX_USB_KEYBOARD, ADDR_DEFAULT, usb_base);
+    indexed_memory_set_address(IDX_USB_KEYBOARD, ADDR_LIMIT, usb_base + USB_KEYBOARD_BUFFER_SIZE); // Wrap at end of keyboard buffer
+    g_indexes[IDX_USB_KEYBOARD].step = 1;
+    g_indexes[IDX_USB_KEYBOARD].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
+    
+    // Index 65: USB status (ring head, then status flags)
+    indexed_memory_set_address(IDX_USB_STATUS, ADDR_CURRENT, usb_base + USB_KEYBOARD_BUFFER_SIZE);
+    indexed_memory_set_address(IDX_USB_STATUS, ADDR_DEFAULT, usb_base + USB_KEYBOARD_BUFFER_SIZE);
+    g_indexes[IDX_USB_STATUS].step = 1;
+    g_indexes[IDX_USB_STATUS].flags = 0; // No auto-step for status
     
-    // Index 65: USB status
-    indexed_memory_set_address(65, ADDR_CURRENT, usb_base + 64);
-    indexed_memory_set_address(65, ADDR_DEFAULT, usb_base + 64);
-    g_state.indexes[65].step = 1;
-    g_state.indexes[65].flags = 0; // No auto-step for status
+    // Index 66: USB loader status block (state, address, length)
+    indexed_memory_set_address(IDX_USB_LOADER, ADDR_CURRENT, usb_base + USB_LOADER_STATUS_OFFSET);
+    indexed_memory_set_address(IDX_USB_LOADER, ADDR_DEFAULT, usb_base + USB_LOADER_STATUS_OFFSET);
+    indexed_memory_set_address(IDX_USB_LOADER, ADDR_LIMIT, usb_base + USB_LOADER_STATUS_OFFSET + USB_LOADER_STATUS_SIZE); // Wrap after the block
+    g_indexes[IDX_USB_LOADER].step = 1;
+    g_indexes[IDX_USB_LOADER].flags = FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT;
     
     // System control (indexes 80-95)
     uint32_t sysctrl_base = MIA_SYSTEM_AREA_BASE + 0x1000;
     
-    // Index 80: Clock control
-    indexed_memory_set_address(80, ADDR_CURRENT, sysctrl_base);
-    indexed_memory_set_address(80, ADDR_DEFAULT, sysctrl_base);
-    g_state.indexes[80].step = 1;
-    g_state.indexes[80].flags = 0;
+    // Index 80: Clock control (byte 0 is the PHI2 speed code)
+    indexed_memory_set_address(IDX_CLOCK_CONTROL, ADDR_CURRENT, sysctrl_base);
+    indexed_memory_set_address(IDX_CLOCK_CONTROL, ADDR_DEFAULT, sysctrl_base);
+    g_indexes[IDX_CLOCK_CONTROL].step = 1;
+    g_indexes[IDX_CLOCK_CONTROL].flags = 0;
     
-    // Index 81: Reset control
-    indexed_memory_set_address(81, ADDR_CURRENT, sysctrl_base + 16);
-    indexed_memory_set_address(81, ADDR_DEFAULT, sysctrl_base + 16);
-    g_state.indexes[81].step = 1;
-    g_state.indexes[81].flags = 0;
+    // Index 81: Reset control (byte 0 is the boot image number)
+    indexed_memory_set_address(IDX_RESET_CONTROL, ADDR_CURRENT, sysctrl_base + 16);
+    indexed_memory_set_address(IDX_RESET_CONTROL, ADDR_DEFAULT, sysctrl_base + 16);
+    g_indexes[IDX_RESET_CONTROL].step = 1;
+    g_indexes[IDX_RESET_CONTROL].flags = 0;
+    
+    // Index 82: Snapshot status (byte 0, set by the MIA)
+    indexed_memory_set_address(IDX_SNAPSHOT, ADDR_CURRENT, sysctrl_base + 32);
+    indexed_memory_set_address(IDX_SNAPSHOT, ADDR_DEFAULT, sysctrl_base + 32);
+    g_indexes[IDX_SNAPSHOT].step = 1;
+    g_indexes[IDX_SNAPSHOT].flags = 0;
     
     // Index 83: IRQ mask control low byte (enable/disable interrupt sources 0-7)
     indexed_memory_set_address(83, ADDR_CURRENT, sysctrl_base + 48);
     indexed_memory_set_address(83, ADDR_DEFAULT, sysctrl_base + 48);
-    g_state.indexes[83].step = 1;
-    g_state.indexes[83].flags = 0;
+    g_indexes[83].step = 1;
+    g_indexes[83].flags = 0;
     
     // Index 84: IRQ mask control high byte (enable/disable interrupt sources 8-15)
     indexed_memory_set_address(84, ADDR_CURRENT, sysctrl_base + 49);
     indexed_memory_set_address(84, ADDR_DEFAULT, sysctrl_base + 49);
-    g_state.indexes[84].step = 1;
-    g_state.indexes[84].flags = 0;
+    g_indexes[84].step = 1;
+    g_indexes[84].flags = 0;
     
     // User area (indexes 128-255) - 162KB of user RAM
     // All user indexes start at the base of user memory
@@ -186,19 +472,78 @@ void indexed_memory_init(void) {
     for (int i = IDX_USER_START; i <= IDX_USER_END; i++) {
         indexed_memory_set_address(i, ADDR_CURRENT, MIA_USER_AREA_BASE);
         indexed_memory_set_address(i, ADDR_DEFAULT, MIA_USER_AREA_BASE);
-        g_state.indexes[i].step = 1;
-        g_state.indexes[i].flags = FLAG_AUTO_STEP;
+        g_indexes[i].step = 1;
+        g_indexes[i].flags = FLAG_AUTO_STEP;
+    }
+    
+    // Pick access kernels for the configuration above
+    for (int i = 0; i < 256; i++) {
+        indexed_memory_select_kernel(i);
+    }
+}
+
+/**
+ * Initialize the indexed memory system
+ */
+void indexed_memory_init(void) {
+    // A factory reset can come in while a batch is running: let it land
+    // first, so nothing is copied into the cleared memory
+    while (indexed_memory_dma_is_busy()) {
     }
     
+    // Clear MIA memory, clients need all of the (cleared) video area
+    memset(mia_memory, 0, MIA_MEMORY_SIZE);
+    memset((uint8_t *)g_video_dirty, 1, sizeof(g_video_dirty));
+    
+    indexed_memory_configure_defaults();
+    g_fast_reset_pending = false;
+    
     // Initialize DMA for memory copy operations
     int dma_channel = indexed_memory_dma_init();
     indexed_memory_dma_set_completion_callback(dma_completion_callback);
     
-    // Initialize inter-core command queue
-    queue_init(&command_queue, sizeof(copy_command_t), COMMAND_QUEUE_SIZE);
+#ifdef CONFIG_MIA_PSRAM
+    // Dirty cached pages are written back first, the PSRAM keeps its data
+    g_psram_size = psram_cache_init();
+#endif
+    
+    // Initialize inter-core command queue once, a factory reset drops the
+    // copies still waiting and the rest of a rectangle split across batches
+    // (the running batch has completed above)
+    if (!command_queue_ready) {
+        queue_init(&command_queue, sizeof(copy_command_t), COMMAND_QUEUE_SIZE);
+        command_queue_ready = true;
+    } else {
+        copy_command_t dropped;
+        while (queue_try_remove(&command_queue, &dropped)) {
+            g_copies_done++;
+        }
+        if (g_rect_pending) {
+            g_rect_pending = false;
+            g_copies_done++;
+        }
+        if (g_copies_done == g_copies_queued) {
+            status_clear(STATUS_DMA_ACTIVE);
+        }
+    }
+    
+    generation_bump();
     
     printf("Indexed memory system initialized with 256 indexes\n");
     printf("DMA channel %d claimed for memory operations\n", dma_channel);
+#ifdef CONFIG_MIA_PSRAM
+    printf("PSRAM: %lu KB at MIA address $%06X\n", (unsigned long)(g_psram_size / 1024), MIA_MEMORY_SIZE);
+#endif
+}
+
+/**
+ * Restore the factory index configuration and status, keeping MIA memory
+ * Used by the fast reset path, so the boot cache and everything else the
+ * 6502 program stored survive a 6502-only reboot
+ */
+void indexed_memory_restore_defaults(void) {
+    indexed_memory_configure_defaults();
+    generation_bump();
 }
 
 /**
@@ -213,12 +558,12 @@ void indexed_memory_reset_all(void) {
 /**
  * Generic address setter - replaces three separate functions
  */
-static void indexed_memory_set_address(uint8_t idx, addr_field_t field, uint32_t address) {
+static void BUS_HOT_FUNC(indexed_memory_set_address)(uint8_t idx, addr_field_t field, uint32_t address) {
     address &= 0xFFFFFF;  // Ensure 24-bit
     switch (field) {
-        case ADDR_CURRENT: g_state.indexes[idx].current_addr = address; break;
-        case ADDR_DEFAULT: g_state.indexes[idx].default_addr = address; break;
-        case ADDR_LIMIT:   g_state.indexes[idx].limit_addr = address; break;
+        case ADDR_CURRENT: g_indexes[idx].current_addr = address; g_indexes[idx].column = 0; break;
+        case ADDR_DEFAULT: g_state.ranges[idx].default_addr = address; break;
+        case ADDR_LIMIT:   g_state.ranges[idx].limit_addr = address; break;
     }
 }
 
@@ -227,108 +572,359 @@ static void indexed_memory_set_address(uint8_t idx, addr_field_t field, uint32_t
 /**
  * Reset index to default address
  */
-void indexed_memory_reset_index(uint8_t idx) {
-    g_state.indexes[idx].current_addr = g_state.indexes[idx].default_addr;
+void BUS_HOT_FUNC(indexed_memory_reset_index)(uint8_t idx) {
+    g_indexes[idx].current_addr = g_state.ranges[idx].default_addr;
+    g_indexes[idx].column = 0;
+    indexed_memory_select_kernel(idx);
 }
 
 /**
  * Read byte from index with auto-stepping - optimized critical path
  */
-uint8_t indexed_memory_read(uint8_t idx) {
-    index_t *index = &g_state.indexes[idx];
+uint8_t BUS_HOT_FUNC(indexed_memory_read)(uint8_t idx) {
+    index_t *index = &g_indexes[idx];
     uint32_t addr = index->current_addr;
+    uint8_t data;
     
-    // Fast address validation
+    switch (index->kernel) {
+        case KERNEL_FIXED:
+            return mia_memory[addr];
+            
+        case KERNEL_FORWARD_WRAP:
+            data = mia_memory[addr];
+            addr += index->step;
+            index->current_addr = (addr >= g_state.ranges[idx].limit_addr) ? g_state.ranges[idx].default_addr : addr;
+            return data;
+            
+        case KERNEL_FORWARD:
+            if (!ADDR_VALID(addr)) {
+                break;
+            }
+            index->current_addr = addr + index->step;
+            return mia_memory[addr];
+            
+        default:
+            break;
+    }
+    
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(addr)) {
+        // A page not cached yet reads as not ready, the index stays put
+        if (psram_cache_read(PSRAM_OFFSET(addr), &data) && (index->flags & FLAG_AUTO_STEP)) {
+            indexed_memory_psram_step(idx, addr);
+        }
+        return data;
+    }
+#endif
+    if (ASSET_ADDR(addr)) {
+        data = asset_data[ASSET_OFFSET(addr)];
+        if (index->flags & FLAG_AUTO_STEP) {
+            indexed_memory_step(idx, addr);
+        }
+        return data;
+    }
+    
+    // Generic path: fast address validation
     CHECK_ADDR_OR_RETURN(addr, 0);
     
     // Read data
-    uint8_t data = mia_memory[addr];
+    data = mia_memory[addr];
     
     // Auto-step if enabled - optimized path
     if (index->flags & FLAG_AUTO_STEP) {
-        uint8_t step = index->step;
-        
-        if (index->flags & FLAG_DIRECTION) {
-            // Backward stepping
-            addr -= step;
-            if ((index->flags & FLAG_WRAP_ON_LIMIT) && addr < index->limit_addr) {
-                addr = index->default_addr;
-            }
-        } else {
-            // Forward stepping
-            addr += step;
-            if ((index->flags & FLAG_WRAP_ON_LIMIT) && addr >= index->limit_addr) {
-                addr = index->default_addr;
+        indexed_memory_step(idx, addr);
+    }
+    
+    return data;
+}
+
+/**
+ * Read byte at index address without side effects
+ * Used to prepare speculative bus reads; out-of-range addresses read as 0
+ * and are reported when the read is committed
+ */
+uint8_t BUS_HOT_FUNC(indexed_memory_peek)(uint8_t idx) {
+    uint32_t addr = g_indexes[idx].current_addr;
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(addr)) {
+        uint8_t data;
+        psram_cache_read(PSRAM_OFFSET(addr), &data);
+        return data;
+    }
+#endif
+    if (ASSET_ADDR(addr)) {
+        return asset_data[ASSET_OFFSET(addr)];
+    }
+    return ADDR_VALID(addr) ? mia_memory[addr] : 0;
+}
+
+/**
+ * Apply the side effects of a confirmed read (error report and auto-step)
+ * indexed_memory_peek() followed by this is equivalent to indexed_memory_read()
+ */
+void BUS_HOT_FUNC(indexed_memory_commit_read)(uint8_t idx) {
+    index_t *index = &g_indexes[idx];
+    uint32_t addr = index->current_addr;
+    
+    switch (index->kernel) {
+        case KERNEL_FIXED:
+            return;
+            
+        case KERNEL_FORWARD_WRAP:
+            addr += index->step;
+            index->current_addr = (addr >= g_state.ranges[idx].limit_addr) ? g_state.ranges[idx].default_addr : addr;
+            return;
+            
+        case KERNEL_FORWARD:
+            if (!ADDR_VALID(addr)) {
+                break;
             }
+            index->current_addr = addr + index->step;
+            return;
+            
+        default:
+            break;
+    }
+    
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(addr)) {
+        if (index->flags & FLAG_AUTO_STEP) {
+            indexed_memory_psram_step(idx, addr);
         }
-        
-        // Update address
-        index->current_addr = addr;
+        return;
+    }
+#endif
+    if (ASSET_ADDR(addr)) {
+        if (index->flags & FLAG_AUTO_STEP) {
+            indexed_memory_step(idx, addr);
+        }
+        return;
     }
     
-    return data;
+    CHECK_ADDR_OR_RETURN_VOID(addr);
+    
+    if (index->flags & FLAG_AUTO_STEP) {
+        indexed_memory_step(idx, addr);
+    }
 }
 
 /**
  * Write byte to index with auto-stepping
  */
-void indexed_memory_write(uint8_t idx, uint8_t data) {
-    index_t *index = &g_state.indexes[idx];
+void BUS_HOT_FUNC(indexed_memory_write)(uint8_t idx, uint8_t data) {
+    index_t *index = &g_indexes[idx];
     uint32_t addr = index->current_addr;
     
-    // Fast address validation
+    switch (index->kernel) {
+        case KERNEL_FIXED:
+            mia_memory[addr] = data;
+            indexed_memory_mark_video_dirty(addr);
+            return;
+            
+        case KERNEL_FORWARD_WRAP:
+            mia_memory[addr] = data;
+            indexed_memory_mark_video_dirty(addr);
+            addr += index->step;
+            index->current_addr = (addr >= g_state.ranges[idx].limit_addr) ? g_state.ranges[idx].default_addr : addr;
+            return;
+            
+        case KERNEL_FORWARD:
+            if (!ADDR_VALID(addr)) {
+                break;
+            }
+            mia_memory[addr] = data;
+            indexed_memory_mark_video_dirty(addr);
+            index->current_addr = addr + index->step;
+            return;
+            
+        default:
+            break;
+    }
+    
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(addr)) {
+        psram_cache_write(PSRAM_OFFSET(addr), data);
+        if (index->flags & FLAG_AUTO_STEP) {
+            indexed_memory_psram_step(idx, addr);
+        }
+        return;
+    }
+#endif
+    
+    // Generic path: fast address validation (the flash assets are
+    // read-only, so writes to them fail here too)
     CHECK_ADDR_OR_RETURN_VOID(addr);
     
     // Write data
     mia_memory[addr] = data;
+    indexed_memory_mark_video_dirty(addr);
     
     // Auto-step if enabled - same logic as read
     if (index->flags & FLAG_AUTO_STEP) {
-        uint8_t step = index->step;
-        
-        if (index->flags & FLAG_DIRECTION) {
-            addr -= step;
-            if ((index->flags & FLAG_WRAP_ON_LIMIT) && addr < index->limit_addr) {
-                addr = index->default_addr;
-            }
-        } else {
-            addr += step;
-            if ((index->flags & FLAG_WRAP_ON_LIMIT) && addr >= index->limit_addr) {
-                addr = index->default_addr;
-            }
-        }
-        
-        index->current_addr = addr;
+        indexed_memory_step(idx, addr);
+    }
+}
+
+/**
+ * Current address of an index
+ */
+uint32_t BUS_HOT_FUNC(indexed_memory_get_address)(uint8_t idx) {
+    return g_indexes[idx].current_addr;
+}
+
+/**
+ * Read byte at a MIA address, no auto-step
+ */
+uint8_t BUS_HOT_FUNC(indexed_memory_read_address)(uint32_t addr) {
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(addr)) {
+        uint8_t data;
+        psram_cache_read(PSRAM_OFFSET(addr), &data);
+        return data;
+    }
+#endif
+    if (ASSET_ADDR(addr)) {
+        return asset_data[ASSET_OFFSET(addr)];
+    }
+    CHECK_ADDR_OR_RETURN(addr, 0);
+    return mia_memory[addr];
+}
+
+/**
+ * Read byte at a MIA address without side effects (0 when out of range)
+ */
+uint8_t BUS_HOT_FUNC(indexed_memory_peek_address)(uint32_t addr) {
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(addr)) {
+        uint8_t data;
+        psram_cache_read(PSRAM_OFFSET(addr), &data);
+        return data;
+    }
+#endif
+    if (ASSET_ADDR(addr)) {
+        return asset_data[ASSET_OFFSET(addr)];
+    }
+    return ADDR_VALID(addr) ? mia_memory[addr] : 0;
+}
+
+/**
+ * Whether a read at a MIA address returns its data now
+ * Only a PSRAM page not cached yet reads as PSRAM_CACHE_NOT_READY
+ */
+bool BUS_HOT_FUNC(indexed_memory_address_ready)(uint32_t addr) {
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(addr)) {
+        return psram_cache_contains(PSRAM_OFFSET(addr));
+    }
+#endif
+    (void)addr;
+    return true;
+}
+
+/**
+ * Write byte at a MIA address, no auto-step
+ */
+void BUS_HOT_FUNC(indexed_memory_write_address)(uint32_t addr, uint8_t data) {
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(addr)) {
+        psram_cache_write(PSRAM_OFFSET(addr), data);
+        return;
+    }
+#endif
+    CHECK_ADDR_OR_RETURN_VOID(addr);
+    mia_memory[addr] = data;
+    indexed_memory_mark_video_dirty(addr);
+}
+
+/**
+ * Load a burst cursor from the index state
+ * Only forward-stepping (or non-stepping) indexes can be cached: the cursor
+ * folds auto-step, step and wrap-on-limit into a single add and compare
+ */
+bool BUS_HOT_FUNC(indexed_memory_burst_begin)(uint8_t idx, indexed_memory_burst_t *burst) {
+    index_t *index = &g_indexes[idx];
+    const index_range_t *range = &g_state.ranges[idx];
+    bool auto_step = (index->flags & FLAG_AUTO_STEP) != 0;
+    
+    if (auto_step && (index->flags & (FLAG_DIRECTION | FLAG_2D))) {
+        return false;
+    }
+#ifdef CONFIG_MIA_PSRAM
+    if (PSRAM_ADDR(index->current_addr)) {
+        return false;
+    }
+#endif
+    
+    burst->mem = mia_memory;
+    burst->addr = index->current_addr;
+    burst->end = MIA_MEMORY_SIZE;
+    burst->step = auto_step ? index->step : 0;
+    burst->limit = (auto_step && (index->flags & FLAG_WRAP_ON_LIMIT)) ? range->limit_addr : UINT32_MAX;
+    burst->wrap_addr = range->default_addr;
+    burst->idx = idx;
+    return true;
+}
+
+/**
+ * Write the cursor address back to its index
+ */
+void BUS_HOT_FUNC(indexed_memory_burst_end)(const indexed_memory_burst_t *burst) {
+    g_indexes[burst->idx].current_addr = burst->addr;
+    indexed_memory_select_kernel(burst->idx);
+}
+
+/**
+ * Report an out-of-range burst access (same as CHECK_ADDR_OR_RETURN)
+ */
+void BUS_HOT_FUNC(indexed_memory_burst_fault)(void) {
+    status_set(STATUS_MEMORY_ERROR);
+    irq_set_bits(IRQ_MEMORY_ERROR);
+}
+
+/**
+ * Get configuration field value of a cached index
+ * The current address lives in the cursor, everything else is unchanged
+ */
+uint8_t BUS_HOT_FUNC(indexed_memory_burst_get_config_field)(const indexed_memory_burst_t *burst, uint8_t field) {
+    switch (field) {
+        case CFG_ADDR_L:
+            return burst->addr & 0xFF;
+        case CFG_ADDR_M:
+            return (burst->addr >> 8) & 0xFF;
+        case CFG_ADDR_H:
+            return (burst->addr >> 16) & 0xFF;
+        default:
+            return indexed_memory_get_config_field(burst->idx, field);
     }
 }
 
 /**
  * Get configuration field value
  */
-uint8_t indexed_memory_get_config_field(uint8_t idx, uint8_t field) {
+uint8_t BUS_HOT_FUNC(indexed_memory_get_config_field)(uint8_t idx, uint8_t field) {
     switch (field) {
         case CFG_ADDR_L:
-            return g_state.indexes[idx].current_addr & 0xFF;
+            return g_indexes[idx].current_addr & 0xFF;
         case CFG_ADDR_M:
-            return (g_state.indexes[idx].current_addr >> 8) & 0xFF;
+            return (g_indexes[idx].current_addr >> 8) & 0xFF;
         case CFG_ADDR_H:
-            return (g_state.indexes[idx].current_addr >> 16) & 0xFF;
+            return (g_indexes[idx].current_addr >> 16) & 0xFF;
         case CFG_DEFAULT_L:
-            return g_state.indexes[idx].default_addr & 0xFF;
+            return g_state.ranges[idx].default_addr & 0xFF;
         case CFG_DEFAULT_M:
-            return (g_state.indexes[idx].default_addr >> 8) & 0xFF;
+            return (g_state.ranges[idx].default_addr >> 8) & 0xFF;
         case CFG_DEFAULT_H:
-            return (g_state.indexes[idx].default_addr >> 16) & 0xFF;
+            return (g_state.ranges[idx].default_addr >> 16) & 0xFF;
         case CFG_LIMIT_L:
-            return g_state.indexes[idx].limit_addr & 0xFF;
+            return g_state.ranges[idx].limit_addr & 0xFF;
         case CFG_LIMIT_M:
-            return (g_state.indexes[idx].limit_addr >> 8) & 0xFF;
+            return (g_state.ranges[idx].limit_addr >> 8) & 0xFF;
         case CFG_LIMIT_H:
-            return (g_state.indexes[idx].limit_addr >> 16) & 0xFF;
+            return (g_state.ranges[idx].limit_addr >> 16) & 0xFF;
         case CFG_STEP:
-            return g_state.indexes[idx].step;
+            return g_indexes[idx].step;
         case CFG_FLAGS:
-            return g_state.indexes[idx].flags;
+            return g_indexes[idx].flags;
         case CFG_COPY_SRC_IDX:
             return g_state.dma_config.src_idx;
         case CFG_COPY_DST_IDX:
@@ -337,6 +933,26 @@ uint8_t indexed_memory_get_config_field(uint8_t idx, uint8_t field) {
             return g_state.dma_config.count & 0xFF;
         case CFG_COPY_COUNT_H:
             return (g_state.dma_config.count >> 8) & 0xFF;
+        case CFG_COPY_MODE:
+            return g_state.dma_config.mode;
+        case CFG_FILL_VALUE:
+            return g_state.dma_config.fill_value;
+        case CFG_COPY_ROWS:
+            return g_state.dma_config.rows;
+        case CFG_COPY_SRC_PITCH_L:
+            return g_state.dma_config.src_pitch & 0xFF;
+        case CFG_COPY_SRC_PITCH_H:
+            return (g_state.dma_config.src_pitch >> 8) & 0xFF;
+        case CFG_COPY_DST_PITCH_L:
+            return g_state.dma_config.dst_pitch & 0xFF;
+        case CFG_COPY_DST_PITCH_H:
+            return (g_state.dma_config.dst_pitch >> 8) & 0xFF;
+        case CFG_ROW_WIDTH:
+            return g_state.ranges[idx].row_width;
+        case CFG_ROW_STRIDE_L:
+            return g_state.ranges[idx].row_stride & 0xFF;
+        case CFG_ROW_STRIDE_H:
+            return (g_state.ranges[idx].row_stride >> 8) & 0xFF;
         default:
             return 0;
     }
@@ -345,40 +961,40 @@ uint8_t indexed_memory_get_config_field(uint8_t idx, uint8_t field) {
 /**
  * Set configuration field value
  */
-void indexed_memory_set_config_field(uint8_t idx, uint8_t field, uint8_t value) {
+void BUS_HOT_FUNC(indexed_memory_set_config_field)(uint8_t idx, uint8_t field, uint8_t value) {
     switch (field) {
         case CFG_ADDR_L:
-            g_state.indexes[idx].current_addr = (g_state.indexes[idx].current_addr & 0xFFFF00) | value;
+            g_indexes[idx].current_addr = (g_indexes[idx].current_addr & 0xFFFF00) | value;
             break;
         case CFG_ADDR_M:
-            g_state.indexes[idx].current_addr = (g_state.indexes[idx].current_addr & 0xFF00FF) | (value << 8);
+            g_indexes[idx].current_addr = (g_indexes[idx].current_addr & 0xFF00FF) | (value << 8);
             break;
         case CFG_ADDR_H:
-            g_state.indexes[idx].current_addr = (g_state.indexes[idx].current_addr & 0x00FFFF) | (value << 16);
+            g_indexes[idx].current_addr = (g_indexes[idx].current_addr & 0x00FFFF) | (value << 16);
             break;
         case CFG_DEFAULT_L:
-            g_state.indexes[idx].default_addr = (g_state.indexes[idx].default_addr & 0xFFFF00) | value;
+            g_state.ranges[idx].default_addr = (g_state.ranges[idx].default_addr & 0xFFFF00) | value;
             break;
         case CFG_DEFAULT_M:
-            g_state.indexes[idx].default_addr = (g_state.indexes[idx].default_addr & 0xFF00FF) | (value << 8);
+            g_state.ranges[idx].default_addr = (g_state.ranges[idx].default_addr & 0xFF00FF) | (value << 8);
             break;
         case CFG_DEFAULT_H:
-            g_state.indexes[idx].default_addr = (g_state.indexes[idx].default_addr & 0x00FFFF) | (value << 16);
+            g_state.ranges[idx].default_addr = (g_state.ranges[idx].default_addr & 0x00FFFF) | (value << 16);
             break;
         case CFG_LIMIT_L:
-            g_state.indexes[idx].limit_addr = (g_state.indexes[idx].limit_addr & 0xFFFF00) | value;
+            g_state.ranges[idx].limit_addr = (g_state.ranges[idx].limit_addr & 0xFFFF00) | value;
             break;
         case CFG_LIMIT_M:
-            g_state.indexes[idx].limit_addr = (g_state.indexes[idx].limit_addr & 0xFF00FF) | (value << 8);
+            g_state.ranges[idx].limit_addr = (g_state.ranges[idx].limit_addr & 0xFF00FF) | (value << 8);
             break;
         case CFG_LIMIT_H:
-            g_state.indexes[idx].limit_addr = (g_state.indexes[idx].limit_addr & 0x00FFFF) | (value << 16);
+            g_state.ranges[idx].limit_addr = (g_state.ranges[idx].limit_addr & 0x00FFFF) | (value << 16);
             break;
         case CFG_STEP:
-            g_state.indexes[idx].step = value;
+            g_indexes[idx].step = value;
             break;
         case CFG_FLAGS:
-            g_state.indexes[idx].flags = value;
+            g_indexes[idx].flags = value;
             break;
         case CFG_COPY_SRC_IDX:
             g_state.dma_config.src_idx = value;
@@ -392,71 +1008,190 @@ void indexed_memory_set_config_field(uint8_t idx, uint8_t field, uint8_t value)
         case CFG_COPY_COUNT_H:
             g_state.dma_config.count = (g_state.dma_config.count & 0x00FF) | (value << 8);
             break;
+        case CFG_COPY_MODE:
+            g_state.dma_config.mode = value;
+            break;
+        case CFG_FILL_VALUE:
+            g_state.dma_config.fill_value = value;
+            break;
+        case CFG_COPY_ROWS:
+            g_state.dma_config.rows = value;
+            break;
+        case CFG_COPY_SRC_PITCH_L:
+            g_state.dma_config.src_pitch = (g_state.dma_config.src_pitch & 0xFF00) | value;
+            break;
+        case CFG_COPY_SRC_PITCH_H:
+            g_state.dma_config.src_pitch = (g_state.dma_config.src_pitch & 0x00FF) | (value << 8);
+            break;
+        case CFG_COPY_DST_PITCH_L:
+            g_state.dma_config.dst_pitch = (g_state.dma_config.dst_pitch & 0xFF00) | value;
+            break;
+        case CFG_COPY_DST_PITCH_H:
+            g_state.dma_config.dst_pitch = (g_state.dma_config.dst_pitch & 0x00FF) | (value << 8);
+            break;
+        case CFG_ROW_WIDTH:
+            g_state.ranges[idx].row_width = value;
+            break;
+        case CFG_ROW_STRIDE_L:
+            g_state.ranges[idx].row_stride = (g_state.ranges[idx].row_stride & 0xFF00) | value;
+            break;
+        case CFG_ROW_STRIDE_H:
+            g_state.ranges[idx].row_stride = (g_state.ranges[idx].row_stride & 0x00FF) | (value << 8);
+            break;
+    }
+    
+    // A new address or row layout starts a new row; the copy fields
+    // are shared by all indexes and leave this one alone
+    if (field <= CFG_FLAGS || field >= CFG_ROW_WIDTH) {
+        g_indexes[idx].column = 0;
     }
+    
+    // Addresses, step or flags may have changed
+    indexed_memory_select_kernel(idx);
 }
 
 /**
  * Execute window-level command
  * These commands operate on a specific index (typically the active index for a window)
  */
-void indexed_memory_execute_window_command(uint8_t idx, uint8_t cmd) {
+void BUS_HOT_FUNC(indexed_memory_execute_window_command)(uint8_t idx, uint8_t cmd) {
     switch (cmd) {
         case CMD_NOP:
             // No operation
             break;
         case CMD_RESET_INDEX:
             // Reset current address to default address
-            g_state.indexes[idx].current_addr = g_state.indexes[idx].default_addr;
+            g_indexes[idx].current_addr = g_state.ranges[idx].default_addr;
+            g_indexes[idx].column = 0;
             break;
         case CMD_SET_DEFAULT_TO_ADDR:
             // Set default address to current address
-            g_state.indexes[idx].default_addr = g_state.indexes[idx].current_addr;
+            g_state.ranges[idx].default_addr = g_indexes[idx].current_addr;
             break;
         case CMD_SET_LIMIT_TO_ADDR:
             // Set limit address to current address
-            g_state.indexes[idx].limit_addr = g_state.indexes[idx].current_addr;
+            g_state.ranges[idx].limit_addr = g_indexes[idx].current_addr;
+            break;
+        case CMD_LOAD_DESCRIPTOR:
+            // Replace the whole index configuration in one command
+            indexed_memory_load_descriptor(idx, g_state.dma_config.src_idx);
             break;
         default:
             // Unknown window command - ignore
             break;
     }
+    
+    indexed_memory_select_kernel(idx);
+}
+
+/**
+ * Replace an index configuration with the fields of a descriptor
+ */
+static void BUS_HOT_FUNC(indexed_memory_decode_descriptor)(uint8_t idx, const uint8_t *desc) {
+    index_t *index = &g_indexes[idx];
+    index_range_t *range = &g_state.ranges[idx];
+    index->current_addr = desc[0] | (desc[1] << 8) | ((uint32_t)desc[2] << 16);
+    range->default_addr = desc[3] | (desc[4] << 8) | ((uint32_t)desc[5] << 16);
+    range->limit_addr = desc[6] | (desc[7] << 8) | ((uint32_t)desc[8] << 16);
+    index->step = desc[9];
+    index->flags = desc[10];
+    index->column = 0;
+    
+    // Not in the descriptor: a loaded index steps linearly until its row
+    // fields are set again
+    range->row_width = 0;
+    range->row_stride = 0;
+}
+
+/**
+ * Write an index configuration as a descriptor (CMD_LOAD_DESCRIPTOR layout)
+ */
+void indexed_memory_get_descriptor(uint8_t idx, uint8_t *desc) {
+    for (uint8_t field = CFG_ADDR_L; field <= CFG_FLAGS; field++) {
+        desc[field] = indexed_memory_get_config_field(idx, field);
+    }
+    desc[INDEX_DESCRIPTOR_SIZE - 1] = 0;
+}
+
+/**
+ * Load an index configuration from a descriptor outside MIA memory
+ */
+void indexed_memory_set_descriptor(uint8_t idx, const uint8_t *desc) {
+    indexed_memory_decode_descriptor(idx, desc);
+    indexed_memory_select_kernel(idx);
+    generation_bump();
+}
+
+/**
+ * Load an index configuration from a descriptor in MIA memory
+ * The descriptor is read at the current address of src_idx, which then
+ * moves past it if it has FLAG_COPY_ADVANCE, so a table of descriptors can
+ * be loaded one command at a time
+ */
+static void BUS_HOT_FUNC(indexed_memory_load_descriptor)(uint8_t idx, uint8_t src_idx) {
+    uint32_t addr = g_indexes[src_idx].current_addr;
+    
+    if (addr >= MIA_MEMORY_SIZE || addr + INDEX_DESCRIPTOR_SIZE > MIA_MEMORY_SIZE) {
+        status_set(STATUS_MEMORY_ERROR);
+        irq_set_bits(IRQ_MEMORY_ERROR);
+        return;
+    }
+    
+    indexed_memory_decode_descriptor(idx, &mia_memory[addr]);
+    
+    if (src_idx != idx) {
+        indexed_memory_copy_advance(src_idx, INDEX_DESCRIPTOR_SIZE);
+    }
 }
 
 /**
  * Execute shared/system-level command
  * These commands affect the entire system, not a specific index
  */
-void indexed_memory_execute_shared_command(uint8_t cmd) {
+void BUS_HOT_FUNC(indexed_memory_execute_shared_command)(uint8_t cmd) {
     switch (cmd) {
         case CMD_SHARED_NOP:
             // No operation
             break;
         case CMD_RESET_ALL_IDX:
-            // Reset all 256 indexes to their default addresses
-            indexed_memory_reset_all();
-            break;
         case CMD_FACTORY_RESET_ALL_IDX:
-            // Factory reset: reinitialize the indexed memory subsystem
-            // This resets all indexes to factory defaults, clears IRQ state,
-            // resets DMA config, and clears all MIA memory
-            // Does NOT reset other MIA components (ROM emulator, clock, etc.)
-            irq_clear_all();
-            indexed_memory_init();
+            // Too slow for the bus path: run between bus IRQs, with
+            // STATUS_BUSY set until IRQ_COMMAND_DONE
+            // (see indexed_memory_process_deferred_command())
+            // A factory reset also resets the indexes, so it absorbs a
+            // pending CMD_RESET_ALL_IDX
+            if (cmd > g_deferred_command) {
+                g_deferred_command = cmd;
+            }
+            status_set(STATUS_BUSY);
+            background_post(BACKGROUND_WORK_COMMAND);
             break;
         case CMD_CLEAR_IRQ:
             // Clear all pending interrupts
             irq_clear_all();
             break;
         case CMD_COPY_BLOCK:
-            // Enqueue copy command for Core 1 processing
-            {
-                copy_command_t cmd = {
-                    .src_idx = g_state.dma_config.src_idx,
-                    .dst_idx = g_state.dma_config.dst_idx,
-                    .count = g_state.dma_config.count
-                };
-                queue_try_add(&command_queue, &cmd);
-            }
+            // Enqueue copy command for the DMA engine
+            indexed_memory_queue_copy(g_state.dma_config.src_idx,
+                                      g_state.dma_config.dst_idx,
+                                      g_state.dma_config.count);
+            break;
+        case CMD_FILL_BLOCK:
+            // Enqueue fill command, sharing the copy queue and its IRQs
+            indexed_memory_queue_fill(g_state.dma_config.dst_idx,
+                                      g_state.dma_config.count,
+                                      g_state.dma_config.fill_value);
+            break;
+        case CMD_COPY_RECT:
+            // Enqueue strided copy, one completion for all of its rows
+            indexed_memory_queue_rect(g_state.dma_config.src_idx,
+                                      g_state.dma_config.dst_idx,
+                                      g_state.dma_config.count,
+                                      g_state.dma_config.rows);
+            break;
+        case CMD_OAM_DMA:
+            // Enqueue a copy of a full sprite list into OAM
+            indexed_memory_queue_oam_dma(g_state.dma_config.src_idx);
             break;
         case CMD_SYSTEM_RESET:
             // Full system reset: reboot the Pico via watchdog
@@ -470,6 +1205,20 @@ void indexed_memory_execute_shared_command(uint8_t cmd) {
             // On real hardware: execution never reaches here (system reboots)
             // In tests: mock function returns and we continue normally
             break;
+        case CMD_SYSTEM_FAST_RESET:
+            // 6502-only reset: the bus interface cannot be torn down from
+            // the bus write path, so leave it to the Core 0 background work
+            // (see indexed_memory_fast_reset_requested())
+            g_fast_reset_pending = true;
+            background_post(BACKGROUND_WORK_FAST_RESET);
+            break;
+        case CMD_SNAPSHOT_SAVE:
+            // Flash writes stop the bus: saved by the Core 0 background
+            // work with the 6502 clock held (see system/snapshot.h)
+            g_snapshot_pending = true;
+            status_set(STATUS_BUSY);
+            background_post(BACKGROUND_WORK_SNAPSHOT);
+            break;
         default:
             // Unknown shared command - ignore
             break;
@@ -479,65 +1228,232 @@ void indexed_memory_execute_shared_command(uint8_t cmd) {
 
 
 /**
- * Copy block of bytes between indexes using DMA
+ * Queue a copy of bytes between indexes for the DMA engine
  * This is asynchronous - the function returns immediately and DMA runs in background
- * IRQ_DMA_COMPLETE will be triggered when transfer completes
+ * IRQ_DMA_COMPLETE will be triggered when transfer completes (or, with
+ * COPY_MODE_IRQ_BATCH, when every queued copy has completed)
  */
-void indexed_memory_copy_block(uint8_t src_idx, uint8_t dst_idx, uint16_t count) {
+static void BUS_HOT_FUNC(indexed_memory_queue_copy)(uint8_t src_idx, uint8_t dst_idx, uint16_t count) {
     if (count == 0) {
         return;
     }
     
-    uint32_t src_addr = g_state.indexes[src_idx].current_addr;
-    uint32_t dst_addr = g_state.indexes[dst_idx].current_addr;
+    uint32_t src_addr = g_indexes[src_idx].current_addr;
+    uint32_t dst_addr = g_indexes[dst_idx].current_addr;
+    uint32_t src_end = copy_source_end(src_addr);
     
     // Validate addresses
-    if (src_addr >= MIA_MEMORY_SIZE || dst_addr >= MIA_MEMORY_SIZE) {
-        g_state.status |= STATUS_MEMORY_ERROR;
+    if (src_end == 0 || dst_addr >= MIA_MEMORY_SIZE) {
+        status_set(STATUS_MEMORY_ERROR);
         irq_set_bits(IRQ_MEMORY_ERROR);
         return;
     }
     
     // Check if transfer would exceed memory bounds
-    if (src_addr + count > MIA_MEMORY_SIZE || dst_addr + count > MIA_MEMORY_SIZE) {
-        g_state.status |= STATUS_MEMORY_ERROR;
+    if (src_addr + count > src_end || dst_addr + count > MIA_MEMORY_SIZE) {
+        status_set(STATUS_MEMORY_ERROR);
         irq_set_bits(IRQ_DMA_ERROR);
         return;
     }
     
-    // Check if DMA is already active
-    if (g_state.status & STATUS_DMA_ACTIVE) {
-        // DMA already in progress - reject new transfer to avoid blocking
-        // This prevents the MIA from missing 6502 bus timing requirements
-        // The 6502 can check STATUS_DMA_ACTIVE before initiating transfers
-        // or wait for IRQ_DMA_COMPLETE interrupt
+    // Note: Indexes are used only as address pointers and are NOT modified,
+    // unless FLAG_COPY_ADVANCE moves them past the block for the next copy
+    copy_command_t cmd = {
+        .src_addr = src_addr,
+        .dst_addr = dst_addr,
+        .count = count,
+        .rows = 1,
+        .fill = false
+    };
+    if (indexed_memory_queue_command(&cmd)) {
+        indexed_memory_copy_advance(src_idx, count);
+        indexed_memory_copy_advance(dst_idx, count);
+    }
+}
+
+/**
+ * Queue a rectangular copy between indexes for the DMA engine
+ * Rows of width bytes, the next row starting src_pitch / dst_pitch bytes
+ * after the previous one. Signals IRQ_DMA_COMPLETE once, after the last row
+ */
+static void BUS_HOT_FUNC(indexed_memory_queue_rect)(uint8_t src_idx, uint8_t dst_idx, uint16_t width, uint8_t rows) {
+    if (width == 0 || rows == 0) {
+        return;
+    }
+    
+    uint32_t src_addr = g_indexes[src_idx].current_addr;
+    uint32_t dst_addr = g_indexes[dst_idx].current_addr;
+    uint32_t src_end = copy_source_end(src_addr);
+    
+    // Validate addresses
+    if (src_end == 0 || dst_addr >= MIA_MEMORY_SIZE) {
+        status_set(STATUS_MEMORY_ERROR);
+        irq_set_bits(IRQ_MEMORY_ERROR);
+        return;
+    }
+    
+    // Check if the last row would exceed memory bounds
+    uint32_t src_last = src_addr + (uint32_t)(rows - 1) * g_state.dma_config.src_pitch;
+    uint32_t dst_last = dst_addr + (uint32_t)(rows - 1) * g_state.dma_config.dst_pitch;
+    if (src_last + width > src_end || dst_last + width > MIA_MEMORY_SIZE) {
+        status_set(STATUS_MEMORY_ERROR);
         irq_set_bits(IRQ_DMA_ERROR);
         return;
     }
     
-    // Set DMA active status
-    g_state.status |= STATUS_DMA_ACTIVE;
+    copy_command_t cmd = {
+        .src_addr = src_addr,
+        .dst_addr = dst_addr,
+        .count = width,
+        .src_pitch = g_state.dma_config.src_pitch,
+        .dst_pitch = g_state.dma_config.dst_pitch,
+        .rows = rows,
+        .fill = false
+    };
+    if (indexed_memory_queue_command(&cmd)) {
+        indexed_memory_copy_advance(src_idx, (uint32_t)rows * cmd.src_pitch);
+        indexed_memory_copy_advance(dst_idx, (uint32_t)rows * cmd.dst_pitch);
+    }
+}
+
+/**
+ * Queue a copy of MAX_SPRITES sprite records from an index into sprite OAM
+ * Same queue, completion IRQs and error reporting as CMD_COPY_BLOCK; the
+ * destination is always the whole OAM, whatever IDX_SPRITE_OAM points at
+ */
+void BUS_HOT_FUNC(indexed_memory_queue_oam_dma)(uint8_t src_idx) {
+    uint32_t src_addr = g_indexes[src_idx].current_addr;
+    uint16_t count = MAX_SPRITES * BYTES_PER_SPRITE;
+    uint32_t src_end = copy_source_end(src_addr);
+    
+    // Validate address
+    if (src_end == 0) {
+        status_set(STATUS_MEMORY_ERROR);
+        irq_set_bits(IRQ_MEMORY_ERROR);
+        return;
+    }
     
-    // Start DMA transfer (asynchronous)
-    // Note: Indexes are used only as address pointers and are NOT modified
-    // The source and destination indexes remain unchanged after the copy
-    indexed_memory_dma_start_transfer(
-        &mia_memory[dst_addr],
-        &mia_memory[src_addr],
-        count
-    );
+    // Check if the source would exceed memory bounds
+    if (src_addr + count > src_end) {
+        status_set(STATUS_MEMORY_ERROR);
+        irq_set_bits(IRQ_DMA_ERROR);
+        return;
+    }
     
-    // Note: Function returns immediately, DMA continues in background
-    // IRQ_DMA_COMPLETE will be triggered when transfer finishes
-    // Indexes are NOT modified - they still point to the original addresses
+    copy_command_t cmd = {
+        .src_addr = src_addr,
+        .dst_addr = VIDEO_FIELD_ADDR(oam),
+        .count = count,
+        .rows = 1,
+        .fill = false
+    };
+    if (indexed_memory_queue_command(&cmd)) {
+        indexed_memory_copy_advance(src_idx, count);
+    }
+}
+
+/**
+ * Queue a fill of bytes at an index for the DMA engine
+ * Same queue, completion IRQs and error reporting as CMD_COPY_BLOCK
+ */
+static void BUS_HOT_FUNC(indexed_memory_queue_fill)(uint8_t dst_idx, uint16_t count, uint8_t value) {
+    if (count == 0) {
+        return;
+    }
+    
+    uint32_t dst_addr = g_indexes[dst_idx].current_addr;
+    
+    // Validate address
+    if (dst_addr >= MIA_MEMORY_SIZE) {
+        status_set(STATUS_MEMORY_ERROR);
+        irq_set_bits(IRQ_MEMORY_ERROR);
+        return;
+    }
+    
+    // Check if the fill would exceed memory bounds
+    if (dst_addr + count > MIA_MEMORY_SIZE) {
+        status_set(STATUS_MEMORY_ERROR);
+        irq_set_bits(IRQ_DMA_ERROR);
+        return;
+    }
+    
+    copy_command_t cmd = {
+        .src_addr = 0,
+        .dst_addr = dst_addr,
+        .count = count,
+        .rows = 1,
+        .fill = true,
+        .fill_value = value
+    };
+    if (indexed_memory_queue_command(&cmd)) {
+        indexed_memory_copy_advance(dst_idx, count);
+    }
+}
+
+/**
+ * Hand a validated copy or fill to the Core 0 background work
+ * Rejects it with IRQ_DMA_ERROR when the queue is full
+ * Returns true if the command was queued
+ */
+static bool BUS_HOT_FUNC(indexed_memory_queue_command)(const copy_command_t *cmd) {
+    // Account for the copy before the background work can see it in the queue
+    g_copies_queued++;
+    status_set(STATUS_DMA_ACTIVE);
+    
+    if (!queue_try_add(&command_queue, cmd)) {
+        // Queue full - reject rather than block the bus write path
+        // The 6502 can wait for IRQ_DMA_COMPLETE and issue the copy again
+        g_copies_queued--;
+        if (g_copies_done == g_copies_queued) {
+            status_clear(STATUS_DMA_ACTIVE);
+        }
+        irq_set_bits(IRQ_DMA_ERROR);
+        return false;
+    }
+    generation_bump();
+    background_post(BACKGROUND_WORK_COPY);
+    return true;
+}
+
+/**
+ * Step an index with FLAG_COPY_ADVANCE past the block a DMA command used
+ * 
+ * The addresses of a command are resolved when it is queued, so the index
+ * moves right away: the next command streams on from where this one ends
+ * even while this one is still waiting. Honours the direction and
+ * wrap-on-limit flags like a DATA_PORT step of the given size.
+ */
+static void BUS_HOT_FUNC(indexed_memory_copy_advance)(uint8_t idx, uint32_t amount) {
+    index_t *index = &g_indexes[idx];
+    const index_range_t *range = &g_state.ranges[idx];
+    if (!(index->flags & FLAG_COPY_ADVANCE)) {
+        return;
+    }
+    
+    uint32_t addr = index->current_addr;
+    if (index->flags & FLAG_DIRECTION) {
+        addr -= amount;
+        if ((index->flags & FLAG_WRAP_ON_LIMIT) && addr < range->limit_addr) {
+            addr = range->default_addr;
+        }
+    } else {
+        addr += amount;
+        if ((index->flags & FLAG_WRAP_ON_LIMIT) && addr >= range->limit_addr) {
+            addr = range->default_addr;
+        }
+    }
+    index->current_addr = addr;
+    index->column = 0;
+    indexed_memory_select_kernel(idx);
 }
 
 /**
  * Set status bits (OR operation)
  * Sets the specified status bit(s) in the status register
  */
-void indexed_memory_set_status(uint8_t status_bits) {
-    g_state.status |= status_bits;
+void BUS_HOT_FUNC(indexed_memory_set_status)(uint8_t status_bits) {
+    status_set(status_bits);
+    generation_bump();
 }
 
 /**
@@ -545,22 +1461,252 @@ void indexed_memory_set_status(uint8_t status_bits) {
  * Clears the specified status bit(s) from the status register
  */
 void indexed_memory_clear_status(uint8_t status_bits) {
-    g_state.status &= ~status_bits;
+    status_clear(status_bits);
+    generation_bump();
 }
 
 /**
  * Get status register value
  */
-uint8_t indexed_memory_get_status(void) {
-    return g_state.status;
+uint8_t BUS_HOT_FUNC(indexed_memory_get_status)(void) {
+    return __atomic_load_n(&g_state.status, __ATOMIC_RELAXED);
+}
+
+/**
+ * Get state generation counter
+ */
+uint32_t BUS_HOT_FUNC(indexed_memory_get_generation)(void) {
+    return __atomic_load_n(&g_generation, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Get a raw pointer into the I/O buffer area
+ */
+uint8_t *indexed_memory_get_io_buffer(uint32_t offset) {
+    if (offset >= INDEXED_MEMORY_IO_BUFFER_SIZE) {
+        return NULL;
+    }
+    return &mia_memory[MIA_IO_BUFFER_BASE + offset];
+}
+
+/**
+ * Get a raw pointer to length bytes of MIA memory at addr
+ */
+uint8_t *indexed_memory_get_range(uint32_t addr, uint32_t length) {
+    if (addr >= MIA_MEMORY_SIZE || length > MIA_MEMORY_SIZE - addr) {
+        return NULL;
+    }
+    return &mia_memory[addr];
+}
+
+/**
+ * Get a raw pointer to the user area
+ */
+uint8_t *indexed_memory_get_user_area(void) {
+    return &mia_memory[MIA_USER_AREA_BASE];
+}
+
+/**
+ * Note a write made outside the bus write path
+ */
+void indexed_memory_notify_write(void) {
+    generation_bump();
+}
+
+/**
+ * Get a raw pointer to the video area (a video_memory_t)
+ */
+uint8_t *indexed_memory_get_video_area(void) {
+    return &mia_memory[MIA_VIDEO_AREA_BASE];
+}
+
+/**
+ * Mark the video area blocks overlapping [addr, addr + count) as dirty
+ */
+void indexed_memory_mark_video_dirty_range(uint32_t addr, uint32_t count) {
+    uint32_t base = MIA_VIDEO_AREA_BASE;
+    uint32_t start = addr > base ? addr - base : 0;
+    uint32_t end = addr + count > base ? addr + count - base : 0;
+    if (end > VIDEO_TRACKED_SIZE) {
+        end = VIDEO_TRACKED_SIZE;
+    }
+    if (start >= end) {
+        return;
+    }
+    
+    atomic_signal_fence(memory_order_release);
+    for (uint32_t b = start >> VIDEO_DIRTY_BLOCK_SHIFT; b <= (end - 1) >> VIDEO_DIRTY_BLOCK_SHIFT; b++) {
+        g_video_dirty[b] = 1;
+    }
+}
+
+/**
+ * Move the pending dirty flags into dirty[] (Core 1)
+ * A flag is cleared before its block is read for transmission, so a write
+ * racing with this either lands in the block read or sets the flag again
+ */
+void indexed_memory_take_video_dirty(uint32_t first, uint32_t count, uint8_t *dirty) {
+    for (uint32_t b = 0; b < count; b++) {
+        if (g_video_dirty[first + b]) {
+            g_video_dirty[first + b] = 0;
+            dirty[b] = 1;
+        }
+    }
+    atomic_thread_fence(memory_order_acquire);
+}
+
+/**
+ * Get a raw pointer to the boot cache (top of the user area)
+ */
+uint8_t *indexed_memory_get_boot_cache(void) {
+    return &mia_memory[MIA_BOOT_CACHE_BASE];
+}
+
+/**
+ * Report (once) a CMD_SYSTEM_FAST_RESET issued since the last call
+ */
+bool indexed_memory_fast_reset_requested(void) {
+    if (!g_fast_reset_pending) {
+        return false;
+    }
+    g_fast_reset_pending = false;
+    return true;
+}
+
+/**
+ * Run the heavy shared command deferred by the bus write path (Core 0
+ * background work). The bus IRQ preempts it at any point, so the 6502 must
+ * not use the indexes until STATUS_BUSY clears or IRQ_COMMAND_DONE is raised.
+ */
+void indexed_memory_process_deferred_command(void) {
+    uint8_t cmd = __atomic_exchange_n(&g_deferred_command, CMD_SHARED_NOP, __ATOMIC_ACQUIRE);
+    switch (cmd) {
+        case CMD_RESET_ALL_IDX:
+            // Reset all 256 indexes to their default addresses
+            indexed_memory_reset_all();
+            break;
+        case CMD_FACTORY_RESET_ALL_IDX:
+            // Factory reset: reinitialize the indexed memory subsystem
+            // This resets all indexes to factory defaults, clears IRQ state,
+            // resets DMA config, and clears all MIA memory
+            // Does NOT reset other MIA components (ROM emulator, clock, etc.)
+            irq_clear_all();
+            indexed_memory_init();
+            break;
+        default:
+            return;
+    }
+    indexed_memory_finish_deferred();
+}
+
+/**
+ * Report (once) a CMD_SNAPSHOT_SAVE issued since the last call
+ */
+bool indexed_memory_snapshot_requested(void) {
+    if (!g_snapshot_pending) {
+        return false;
+    }
+    g_snapshot_pending = false;
+    return true;
+}
+
+/**
+ * End a snapshot save like a deferred command
+ */
+void indexed_memory_snapshot_done(void) {
+    indexed_memory_finish_deferred();
 }
 
 /**
- * Process copy commands from Core 0 (called from Core 1)
+ * Copy out the index table, DMA configuration and status
+ */
+void indexed_memory_get_state(indexed_memory_state_t *state) {
+    memcpy(state->indexes, g_indexes, sizeof(g_indexes));
+    memcpy(state->ranges, g_state.ranges, sizeof(g_state.ranges));
+    state->dma_config = g_state.dma_config;
+    state->status = __atomic_load_n(&g_state.status, __ATOMIC_RELAXED);
+}
+
+/**
+ * Load a saved index table and DMA configuration
+ * Status bits describing work in progress (BUSY, DMA_ACTIVE) stay as they
+ * are, only MEMORY_ERROR is taken from the saved status
+ */
+void indexed_memory_set_state(const indexed_memory_state_t *state) {
+    const uint8_t saved_bits = STATUS_MEMORY_ERROR;
+    
+    memcpy(g_indexes, state->indexes, sizeof(g_indexes));
+    memcpy(g_state.ranges, state->ranges, sizeof(g_state.ranges));
+    g_state.dma_config = state->dma_config;
+    status_clear(saved_bits);
+    status_set(state->status & saved_bits);
+    for (int i = 0; i < 256; i++) {
+        indexed_memory_select_kernel((uint8_t)i);
+    }
+    generation_bump();
+}
+
+/**
+ * Finish a command run by the Core 0 background work: clear STATUS_BUSY and
+ * raise IRQ_COMMAND_DONE, unless another one is still waiting
+ */
+static void indexed_memory_finish_deferred(void) {
+    // Stay busy if the bus path deferred another command meanwhile (it
+    // runs in an interrupt on this core, so interrupts off is enough)
+    uint32_t saved = save_and_disable_interrupts();
+    bool done = (g_deferred_command == CMD_SHARED_NOP) && !g_snapshot_pending;
+    if (done) {
+        status_clear(STATUS_BUSY);
+    }
+    restore_interrupts(saved);
+    
+    generation_bump();
+    if (done) {
+        irq_set_bits(IRQ_COMMAND_DONE);
+    }
+}
+
+/**
+ * Start the next DMA batch from the queued copy commands (Core 0 background work)
  */
 void indexed_memory_process_copy_command(void) {
-    copy_command_t cmd;
-    if (queue_try_remove(&command_queue, &cmd)) {
-        indexed_memory_copy_block(cmd.src_idx, cmd.dst_idx, cmd.count);
+    if (indexed_memory_dma_is_busy() || (!g_rect_pending && queue_is_empty(&command_queue))) {
+        return;
     }
+    
+    // Everything queued so far becomes one chained batch, one job per row
+    bool irq_per_copy = !(g_state.dma_config.mode & COPY_MODE_IRQ_BATCH);
+    indexed_memory_dma_job_t jobs[INDEXED_MEMORY_DMA_BATCH_MAX];
+    uint32_t count = 0;
+    uint32_t copies = 0;
+    while (count < INDEXED_MEMORY_DMA_BATCH_MAX) {
+        if (!g_rect_pending) {
+            if (!queue_try_remove(&command_queue, &g_rect_cmd)) {
+                break;
+            }
+            g_rect_pending = true;
+        }
+        
+        bool last_row = (--g_rect_cmd.rows == 0);
+        jobs[count].dst = &mia_memory[g_rect_cmd.dst_addr];
+        jobs[count].src = copy_source(g_rect_cmd.src_addr);
+        jobs[count].count = g_rect_cmd.count;
+        jobs[count].fill = g_rect_cmd.fill;
+        jobs[count].value = g_rect_cmd.fill_value;
+        jobs[count].notify = last_row && irq_per_copy;
+        g_batch_dst[count] = g_rect_cmd.dst_addr;
+        g_batch_len[count] = g_rect_cmd.count;
+        count++;
+        
+        g_rect_cmd.src_addr += g_rect_cmd.src_pitch;
+        g_rect_cmd.dst_addr += g_rect_cmd.dst_pitch;
+        if (last_row) {
+            g_rect_pending = false;
+            copies++;
+        }
+    }
+    
+    g_batch_copies = copies;
+    g_batch_jobs = count;
+    indexed_memory_dma_start_batch(jobs, count);
 }
\ No newline at end of file
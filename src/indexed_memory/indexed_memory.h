@@ -10,13 +10,22 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "irq/irq.h"
+#include "video/video_controller.h"
 
-// Inter-core command structure, used to queue DMA copy commands from Core 0 to Core 1
+// Copy command structure, queued by the bus write path for the DMA engine
+// Addresses are resolved and validated when CMD_COPY_BLOCK is issued, so the
+// 6502 can move the indexes for its next copy while this one is queued
 typedef struct {
-    uint8_t src_idx;
-    uint8_t dst_idx;
-    uint16_t count;
+    uint32_t src_addr;          // Unused for fills
+    uint32_t dst_addr;
+    uint16_t count;             // Bytes per row
+    uint16_t src_pitch;         // Row to row address steps (CMD_COPY_RECT)
+    uint16_t dst_pitch;
+    uint8_t rows;               // 1 for linear copies and fills
+    bool fill;                  // CMD_FILL_BLOCK: set count bytes to fill_value
+    uint8_t fill_value;
 } copy_command_t;
 
 // Index allocation ranges
@@ -33,12 +42,21 @@ typedef struct {
 #define IDX_PALETTE_TABLE_END   55      // 4 palette tables (52-55)
 #define IDX_SPRITE_OAM          56      // Sprite OAM (256 sprites × 4 bytes)
 #define IDX_ACTIVE_FRAME        57      // Active frame control (0 or 1 to select buffer set)
-#define IDX_VIDEO_RESERVED_START 58
+#define IDX_FRAME_RATE          58      // Target video frame rate (FPS, 0 = default)
+#define IDX_SPRITE_COLLISION    59      // Sprite status flags, then a bit per colliding sprite
+#define IDX_SCROLL              60      // Scroll X then Y, 16-bit little endian
+#define IDX_VIDEO_RESERVED_START 61
 #define IDX_VIDEO_RESERVED_END  63      // Reserved for video expansion
 #define IDX_USB_START           64
+#define IDX_USB_KEYBOARD        64      // Keyboard ring (usb/usb_keyboard.h)
+#define IDX_USB_STATUS          65      // Keyboard ring head, then USB status
+#define IDX_USB_LOADER          66      // USB loader status (usb/usb_loader.h)
 #define IDX_USB_END             79
 #define IDX_SYSCTRL_START       80
 #define IDX_SYSCTRL_END         95
+#define IDX_CLOCK_CONTROL       80      // PHI2 speed code (CLOCK_SPEED_*)
+#define IDX_RESET_CONTROL       81      // Boot catalog image booted by CMD_SYSTEM_FAST_RESET
+#define IDX_SNAPSHOT            82      // Snapshot status (SNAPSHOT_STATUS_*, system/snapshot.h)
 #define IDX_RESERVED_START      96
 #define IDX_RESERVED_END        127
 #define IDX_USER_START          128
@@ -60,11 +78,26 @@ typedef struct {
 #define CFG_COPY_DST_IDX        0x0C
 #define CFG_COPY_COUNT_L        0x0D
 #define CFG_COPY_COUNT_H        0x0E
+#define CFG_COPY_MODE           0x0F    // COPY_MODE_* bits (global, like the other copy fields)
+#define CFG_FILL_VALUE          0x10    // Byte written by CMD_FILL_BLOCK (global)
+#define CFG_COPY_ROWS           0x11    // CMD_COPY_RECT height, COPY_COUNT is the width (global)
+#define CFG_COPY_SRC_PITCH_L    0x12    // CMD_COPY_RECT source row pitch (global)
+#define CFG_COPY_SRC_PITCH_H    0x13
+#define CFG_COPY_DST_PITCH_L    0x14    // CMD_COPY_RECT destination row pitch (global)
+#define CFG_COPY_DST_PITCH_H    0x15
+#define CFG_ROW_WIDTH           0x16    // FLAG_2D: steps per row (0 = no row jumps)
+#define CFG_ROW_STRIDE_L        0x17    // FLAG_2D: distance from one row start to the next
+#define CFG_ROW_STRIDE_H        0x18
 
 // Flag bits
 #define FLAG_AUTO_STEP          0x01
 #define FLAG_DIRECTION          0x02    // 0=forward, 1=backward
 #define FLAG_WRAP_ON_LIMIT      0x04    // 0=disabled, 1=wrap to default when reaching limit
+#define FLAG_COPY_ADVANCE       0x08    // 1=DMA commands step the index past the block they used
+#define FLAG_2D                 0x10    // 1=after ROW_WIDTH steps, jump to the next row start
+
+// Copy mode bits (CFG_COPY_MODE)
+#define COPY_MODE_IRQ_BATCH     0x01    // 0=IRQ_DMA_COMPLETE per copy, 1=once all queued copies are done
 
 // Window-level command codes (executed via window COMMAND register at +0x04)
 // These commands operate on the currently selected index for that window
@@ -72,6 +105,16 @@ typedef struct {
 #define CMD_RESET_INDEX         0x01    // Reset current address to default address
 #define CMD_SET_DEFAULT_TO_ADDR 0x02    // Set default address to current address
 #define CMD_SET_LIMIT_TO_ADDR   0x03    // Set limit address to current address
+#define CMD_BURST_ENABLE        0x04    // Stream DATA_PORT through a cached burst cursor (bus interface)
+#define CMD_BURST_DISABLE       0x05    // Return the window to per-access index lookups (bus interface)
+#define CMD_LOAD_DESCRIPTOR     0x06    // Load the index from the descriptor at COPY_SRC_IDX
+#define CMD_BANK_ENABLE         0x07    // Map window offsets +5..+15 onto the active index (bus interface)
+#define CMD_BANK_DISABLE        0x08    // Return offsets +5..+15 to reserved (bus interface)
+
+// Index descriptor (CMD_LOAD_DESCRIPTOR): bytes 0-10 hold CFG_ADDR_L..CFG_FLAGS
+// in field order, byte 11 is reserved. The 2D row fields are not included;
+// loading a descriptor clears them
+#define INDEX_DESCRIPTOR_SIZE   12
 
 // Shared/system-level command codes (executed via shared COMMAND register at 0xFF)
 // These commands affect the entire system, not a specific window
@@ -81,29 +124,42 @@ typedef struct {
 #define CMD_CLEAR_IRQ               0x03    // Clear all pending interrupts
 #define CMD_COPY_BLOCK              0x04    // Execute DMA block copy
 #define CMD_SYSTEM_RESET            0x05    // Full hardware reset (reboots Pico and 6502)
+#define CMD_SYSTEM_FAST_RESET       0x06    // Reboot the 6502 only, from the warm boot cache
+#define CMD_FILL_BLOCK              0x07    // DMA fill of COPY_COUNT bytes at COPY_DST_IDX with FILL_VALUE
+#define CMD_COPY_RECT               0x08    // DMA copy of COPY_ROWS rows of COPY_COUNT bytes, stepping by the pitches
+#define CMD_OAM_DMA                 0x09    // DMA copy of all of sprite OAM (1KB) from COPY_SRC_IDX
+#define CMD_SNAPSHOT_SAVE           0x0A    // Save MIA memory and state to flash, resumed at power-up
 
 // Status bits (non-IRQ related)
-#define STATUS_BUSY             0x01
+#define STATUS_BUSY             0x01    // Deferred shared command in progress
 #define STATUS_IRQ_PENDING      0x02    // For bus interface compatibility
 #define STATUS_MEMORY_ERROR     0x04
-#define STATUS_INDEX_OVERFLOW   0x08
+#define STATUS_PSRAM_WAIT       0x08    // A window shows a PSRAM page not cached yet
 #define STATUS_USB_DATA_READY   0x10
 #define STATUS_VIDEO_FRAME_READY 0x20
 #define STATUS_DMA_ACTIVE       0x40
 #define STATUS_SYSTEM_READY     0x80
 
+// Access kernels (index_t.kernel)
+// Chosen whenever an index is configured, so read/write/commit run a path
+// specialised for its flags instead of testing them on every access
+#define KERNEL_GENERIC          0       // Any flags, bounds checked on every access
+#define KERNEL_FIXED            1       // No auto-step, address validated at config time
+#define KERNEL_FORWARD          2       // Forward auto-step without wrap, bounds checked
+#define KERNEL_FORWARD_WRAP     3       // Forward auto-step with wrap, stays in range by construction
+
 // Performance optimization macros
 #define ADDR_VALID(addr) ((addr) < MIA_MEMORY_SIZE)
 #define CHECK_ADDR_OR_RETURN(addr, retval) \
     if ((addr) >= MIA_MEMORY_SIZE) { \
-        g_state.status |= STATUS_MEMORY_ERROR; \
+        __atomic_fetch_or(&g_state.status, STATUS_MEMORY_ERROR, __ATOMIC_RELAXED); \
         irq_set_bits(IRQ_MEMORY_ERROR); \
         return retval; \
     }
 
 #define CHECK_ADDR_OR_RETURN_VOID(addr) \
     if ((addr) >= MIA_MEMORY_SIZE) { \
-        g_state.status |= STATUS_MEMORY_ERROR; \
+        __atomic_fetch_or(&g_state.status, STATUS_MEMORY_ERROR, __ATOMIC_RELAXED); \
         irq_set_bits(IRQ_MEMORY_ERROR); \
         return; \
     }
@@ -115,26 +171,56 @@ typedef enum {
     ADDR_LIMIT
 } addr_field_t;
 
-// Memory index structure (16 bytes per index)
+// Memory index, the part every access uses (8 bytes per index)
 typedef struct {
     uint32_t current_addr;      // 24-bit current address (upper 8 bits unused)
+    uint8_t step;               // Step size (0-255 bytes)
+    uint8_t flags;              // Behavior flags (AUTO_STEP, DIRECTION, WRAP_ON_LIMIT)
+    uint8_t kernel;             // Access kernel (KERNEL_*), derived from the fields and range
+    uint8_t column;             // FLAG_2D: steps taken in the current row
+} index_t;
+
+// Memory index range, used by commands, configuration, wrap-on-limit and
+// 2D row steps only (12 bytes per index)
+typedef struct {
     uint32_t default_addr;      // 24-bit default address (upper 8 bits unused)
     uint32_t limit_addr;        // 24-bit limit address for wrap-on-limit (upper 8 bits unused)
-    uint8_t step;              // Step size (0-255 bytes)
-    uint8_t flags;             // Behavior flags (AUTO_STEP, DIRECTION, WRAP_ON_LIMIT)
-    uint16_t reserved;         // Reserved for future use
-} index_t;
+    uint16_t row_stride;        // FLAG_2D: row start to row start
+    uint8_t row_width;          // FLAG_2D: steps per row (0 = no row jumps)
+    uint8_t reserved;           // Reserved for future use
+} index_range_t;
+
+// DATA_PORT burst cursor
+// Resolved state of one forward-stepping index, cached by the bus interface
+// so consecutive DATA_PORT accesses are a bounds check and an add. While a
+// cursor is held, the index's current_addr is only updated by
+// indexed_memory_burst_end().
+typedef struct {
+    uint8_t *mem;               // MIA memory base
+    uint32_t addr;              // Current address
+    uint32_t end;               // Addresses at or above this are out of range
+    uint32_t limit;             // Wrap when stepping reaches this (UINT32_MAX = never)
+    uint32_t wrap_addr;         // Address loaded on wrap (default address)
+    uint8_t step;               // Step per access (0 when auto-step is disabled)
+    uint8_t idx;                // Cached index
+} indexed_memory_burst_t;
 
 // Global DMA configuration
 typedef struct {
     uint8_t src_idx;
     uint8_t dst_idx;
     uint16_t count;
+    uint8_t mode;               // COPY_MODE_* bits
+    uint8_t fill_value;         // CMD_FILL_BLOCK pattern byte
+    uint8_t rows;               // CMD_COPY_RECT height
+    uint16_t src_pitch;         // CMD_COPY_RECT row pitches
+    uint16_t dst_pitch;
 } dma_config_t;
 
-// System state (non-IRQ related)
+// System state (non-IRQ related), as moved by get_state/set_state
 typedef struct {
     index_t indexes[256];       // 256 memory indexes
+    index_range_t ranges[256];  // Their default and limit addresses
     dma_config_t dma_config;    // DMA operation configuration
     uint8_t status;            // System status register (non-IRQ bits)
 } indexed_memory_state_t;
@@ -146,19 +232,169 @@ void indexed_memory_init(void);
 uint8_t indexed_memory_read(uint8_t idx);
 void indexed_memory_write(uint8_t idx, uint8_t data);
 
+// Split read for speculative bus access: peek has no side effects,
+// commit applies the auto-step once the cycle is confirmed as a READ
+uint8_t indexed_memory_peek(uint8_t idx);
+void indexed_memory_commit_read(uint8_t idx);
+
+// Video area base (video_memory_t) and dirty flags (VIDEO_TRACKED_BLOCKS,
+// one byte per block)
+// Set on Core 0 by every path that writes MIA memory (bus writes, bursts and
+// DMA completion), taken by Core 1 at frame boundaries. Flags are whole
+// bytes, so setting and clearing need no read-modify-write across cores.
+#define INDEXED_MEMORY_VIDEO_AREA_BASE 0x00004800
+extern volatile uint8_t g_video_dirty[VIDEO_TRACKED_BLOCKS];
+
+static inline void indexed_memory_mark_video_dirty(uint32_t addr) {
+    uint32_t offset = addr - INDEXED_MEMORY_VIDEO_AREA_BASE;
+    if (offset < VIDEO_TRACKED_SIZE) {
+        // Data before flag: Core 1 clears a flag before reading its block
+        atomic_signal_fence(memory_order_release);
+        g_video_dirty[offset >> VIDEO_DIRTY_BLOCK_SHIFT] = 1;
+    }
+}
+
+void indexed_memory_mark_video_dirty_range(uint32_t addr, uint32_t count);
+
+// OR the pending flags of count blocks from first into dirty[] and clear
+// them (Core 1)
+void indexed_memory_take_video_dirty(uint32_t first, uint32_t count, uint8_t *dirty);
+
+// Burst cursor (see indexed_memory_burst_t)
+// begin returns false for backward-stepping indexes, which are not cached
+bool indexed_memory_burst_begin(uint8_t idx, indexed_memory_burst_t *burst);
+void indexed_memory_burst_end(const indexed_memory_burst_t *burst);
+void indexed_memory_burst_fault(void);
+uint8_t indexed_memory_burst_get_config_field(const indexed_memory_burst_t *burst, uint8_t field);
+
+static inline void indexed_memory_burst_advance(indexed_memory_burst_t *burst, uint32_t addr) {
+    addr += burst->step;
+    if (addr >= burst->limit) {
+        addr = burst->wrap_addr;
+    }
+    burst->addr = addr;
+}
+
+// Same results and side effects as indexed_memory_read/write/peek/commit_read
+static inline uint8_t indexed_memory_burst_read(indexed_memory_burst_t *burst) {
+    uint32_t addr = burst->addr;
+    if (addr >= burst->end) {
+        indexed_memory_burst_fault();
+        return 0;
+    }
+    uint8_t data = burst->mem[addr];
+    indexed_memory_burst_advance(burst, addr);
+    return data;
+}
+
+static inline void indexed_memory_burst_write(indexed_memory_burst_t *burst, uint8_t data) {
+    uint32_t addr = burst->addr;
+    if (addr >= burst->end) {
+        indexed_memory_burst_fault();
+        return;
+    }
+    burst->mem[addr] = data;
+    indexed_memory_mark_video_dirty(addr);
+    indexed_memory_burst_advance(burst, addr);
+}
+
+static inline uint8_t indexed_memory_burst_peek(const indexed_memory_burst_t *burst) {
+    return burst->addr < burst->end ? burst->mem[burst->addr] : 0;
+}
+
+static inline void indexed_memory_burst_commit_read(indexed_memory_burst_t *burst) {
+    uint32_t addr = burst->addr;
+    if (addr >= burst->end) {
+        indexed_memory_burst_fault();
+        return;
+    }
+    indexed_memory_burst_advance(burst, addr);
+}
+
+// Direct access at a MIA address, no index involved (bank windows)
+// read and write report out-of-range addresses like the DATA_PORT path,
+// peek reads them as 0 with no side effects. A PSRAM page not cached yet
+// reads as 0xFF (indexed_memory_address_ready() false) and a DATA_PORT read
+// of it does not step, see psram_cache.h
+uint32_t indexed_memory_get_address(uint8_t idx);
+uint8_t indexed_memory_read_address(uint32_t addr);
+uint8_t indexed_memory_peek_address(uint32_t addr);
+bool indexed_memory_address_ready(uint32_t addr);
+void indexed_memory_write_address(uint32_t addr, uint8_t data);
+
 // Configuration
 uint8_t indexed_memory_get_config_field(uint8_t idx, uint8_t field);
 void indexed_memory_set_config_field(uint8_t idx, uint8_t field, uint8_t value);
 
+// Whole index configuration as an INDEX_DESCRIPTOR_SIZE descriptor (the
+// remote memory service); set selects the access kernel like CMD_LOAD_DESCRIPTOR
+void indexed_memory_get_descriptor(uint8_t idx, uint8_t *desc);
+void indexed_memory_set_descriptor(uint8_t idx, const uint8_t *desc);
+
 // Commands
 void indexed_memory_execute_window_command(uint8_t idx, uint8_t cmd);
 void indexed_memory_execute_shared_command(uint8_t cmd);
 
-// Status management
+// Queue a copy of a whole OAM image from an index into sprite OAM
+// (CMD_OAM_DMA), completing like CMD_COPY_BLOCK
+void indexed_memory_queue_oam_dma(uint8_t src_idx);
+
+// Status management (atomic, safe from either core and from interrupts)
 void indexed_memory_set_status(uint8_t status_bits);
+void indexed_memory_clear_status(uint8_t status_bits);
 uint8_t indexed_memory_get_status(void);
 
-// Core 1 processing
+// Incremented whenever memory, indexes or status change outside the bus
+// write path (DMA completion, status updates, re-initialization)
+uint32_t indexed_memory_get_generation(void);
+
+// Raw pointer into the 16KB I/O buffer area, for boot-time producers that
+// run before the bus interface is active. NULL if offset is out of range.
+#define INDEXED_MEMORY_IO_BUFFER_SIZE 0x4000
+uint8_t *indexed_memory_get_io_buffer(uint32_t offset);
+
+// Video area (video_memory_t in video/video_controller.h), the memory the
+// video controller renders from
+uint8_t *indexed_memory_get_video_area(void);
+
+// User area, for producers that fill it behind the bus interface (the USB
+// loader); they call indexed_memory_notify_write() once the bytes are in
+#define INDEXED_MEMORY_USER_AREA_BASE 0x00013800
+#define INDEXED_MEMORY_USER_AREA_SIZE 0x00028800    // Up to the I/O buffer area
+uint8_t *indexed_memory_get_user_area(void);
+
+// Raw pointer to length bytes at a MIA address, for producers and consumers
+// behind the bus interface (the remote memory service). NULL if the range
+// does not fit in MIA memory.
+uint8_t *indexed_memory_get_range(uint32_t addr, uint32_t length);
+
+// Memory was written outside the bus write path: bus reads must see it
+void indexed_memory_notify_write(void);
+
+// Warm boot cache: copy of the last streamed boot image, kept at the top of
+// the user area. The 6502 may overwrite it, so users validate it first.
+#define INDEXED_MEMORY_BOOT_CACHE_SIZE 0xA000   // $4000-$DFFF, the largest image
+uint8_t *indexed_memory_get_boot_cache(void);
+
+// Snapshot (CMD_SNAPSHOT_SAVE, system/snapshot.h)
+// requested returns true once per command and done ends it like a deferred
+// command (STATUS_BUSY clears, IRQ_COMMAND_DONE). get_state and set_state
+// move the index table, DMA configuration and status; set_state keeps only
+// the error bits of the saved status and re-derives the access kernels.
+#define INDEXED_MEMORY_SIZE 0x00040000  // SRAM, from MIA address 0
+bool indexed_memory_snapshot_requested(void);
+void indexed_memory_snapshot_done(void);
+void indexed_memory_get_state(indexed_memory_state_t *state);
+void indexed_memory_set_state(const indexed_memory_state_t *state);
+
+// Fast reset (CMD_SYSTEM_FAST_RESET)
+// requested returns true once per command, restore_defaults reloads the
+// factory index configuration and status without clearing MIA memory
+bool indexed_memory_fast_reset_requested(void);
+void indexed_memory_restore_defaults(void);
+
+// Core 0 background work, between bus IRQs
 void indexed_memory_process_copy_command(void);
+void indexed_memory_process_deferred_command(void);
 
 #endif // INDEXED_MEMORY_H
\ No newline at end of file
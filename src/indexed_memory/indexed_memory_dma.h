@@ -9,31 +9,55 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+// Copy jobs started together, run back-to-back through DMA chaining
+#define INDEXED_MEMORY_DMA_BATCH_MAX    16
+
+// One copy or fill of a batch (count must not be zero: a zero-count block
+// ends the chain). Copies whose source and destination share the same word
+// alignment, and all fills, move their aligned middle 32 bits at a time
+typedef struct {
+    void *dst;
+    const void *src;            // Ignored for fills
+    uint32_t count;
+    bool fill;                  // Set count bytes at dst to value instead of copying
+    uint8_t value;
+    bool notify;                // Invoke the completion callback when this job is done
+} indexed_memory_dma_job_t;
+
 /**
  * Initialize DMA for memory operations
- * Returns the DMA channel number, or -1 on failure
+ * Claims a data channel and a control channel that reloads it for every
+ * job of a batch. Safe to call again, the channels are claimed once.
+ * Returns the data channel number, or -1 on failure
  */
 int indexed_memory_dma_init(void);
 
 /**
- * Start an asynchronous DMA transfer
+ * Start a batch of asynchronous copies and fills
+ * 
+ * The jobs run one after the other without CPU involvement. The job array
+ * is consumed before returning.
+ * 
+ * @param jobs Copies to run, in order
+ * @param count Number of jobs (1 to INDEXED_MEMORY_DMA_BATCH_MAX)
+ * @return false if a batch is still running (nothing is started)
  * 
- * @param dst Destination address
- * @param src Source address
- * @param count Number of bytes to transfer
+ * The completion callback runs after every job with notify set, and always
+ * at the end of the batch.
  */
-void indexed_memory_dma_start_transfer(void* dst, const void* src, uint32_t count);
+bool indexed_memory_dma_start_batch(const indexed_memory_dma_job_t *jobs, uint32_t count);
 
 /**
  * Check if DMA is currently busy
- * Returns true if transfer in progress, false if idle
+ * Returns true while a batch is running, false if idle
  */
 bool indexed_memory_dma_is_busy(void);
 
 /**
  * Set callback for DMA completion
- * The callback will be invoked from interrupt context when transfer completes
+ * The callback will be invoked from interrupt context, with batch_done set
+ * once the whole batch has finished (and the engine is idle again)
  */
-void indexed_memory_dma_set_completion_callback(void (*callback)(void));
+void indexed_memory_dma_set_completion_callback(void (*callback)(bool batch_done));
 
 #endif // INDEXED_MEMORY_DMA_H
@@ -0,0 +1,60 @@
+/**
+ * DMA batch interrupt bookkeeping
+ *
+ * Shared by the hardware driver and the test mock, so the decision of what
+ * an interrupt means is the same in both. A batch raises one interrupt per
+ * job with notify set and one for the terminating null trigger, but the
+ * flag is per channel: interrupts raised before the handler runs merge, and
+ * the null trigger can raise it again after the handler has already seen
+ * the chain finish. Only the batch state tells a job interrupt from a
+ * stray one.
+ */
+
+#ifndef INDEXED_MEMORY_DMA_BATCH_H
+#define INDEXED_MEMORY_DMA_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    volatile bool running;
+    volatile uint32_t notifies;     // Jobs with notify whose interrupt has not been seen
+} indexed_memory_dma_batch_t;
+
+typedef enum {
+    DMA_BATCH_IRQ_IGNORE,           // Nothing in flight: no callback
+    DMA_BATCH_IRQ_JOB,              // A notify job finished, more to come
+    DMA_BATCH_IRQ_DONE              // The batch finished (covers merged job interrupts)
+} dma_batch_irq_t;
+
+/**
+ * Record a batch being started (before the chain is triggered)
+ */
+static inline void indexed_memory_dma_batch_start(indexed_memory_dma_batch_t *batch, uint32_t notifies) {
+    batch->notifies = notifies;
+    batch->running = true;
+}
+
+/**
+ * Classify an interrupt of the data channel
+ *
+ * @param chain_idle Both channels idle, which the chain only is after the
+ *                   null trigger
+ */
+static inline dma_batch_irq_t indexed_memory_dma_batch_irq(indexed_memory_dma_batch_t *batch, bool chain_idle) {
+    if (!batch->running) {
+        return DMA_BATCH_IRQ_IGNORE;
+    }
+    if (chain_idle) {
+        batch->notifies = 0;
+        batch->running = false;
+        return DMA_BATCH_IRQ_DONE;
+    }
+    if (batch->notifies == 0) {
+        return DMA_BATCH_IRQ_IGNORE;
+    }
+    batch->notifies--;
+    return DMA_BATCH_IRQ_JOB;
+}
+
+#endif // INDEXED_MEMORY_DMA_BATCH_H
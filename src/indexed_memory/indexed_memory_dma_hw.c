@@ -1,71 +1,217 @@
 /**
  * Hardware DMA implementation for Raspberry Pi Pico
+ * 
+ * A batch is a list of control blocks in SRAM. The control channel copies
+ * one block into the data channel's alias 1 registers (CTRL, READ_ADDR,
+ * WRITE_ADDR, TRANS_COUNT_TRIG), which starts the copy. The data channel
+ * chains back to the control channel when it finishes, so jobs run
+ * back-to-back. A final block with a zero count is a null trigger: it ends
+ * the chain and, with IRQ_QUIET set, raises the end-of-batch interrupt.
+ * 
+ * When source and destination share the same alignment, a job is split into
+ * a byte head up to the next word boundary, a 32-bit body and a byte tail, so
+ * aligned copies take a quarter of the bus transfers.
+ * 
+ * Fill jobs use the same split, reading a replicated pattern word with read
+ * increment disabled; only the destination alignment matters for them.
  */
 
 #include "indexed_memory_dma.h"
+#include "indexed_memory_dma_batch.h"
+#include "config/irq_config.h"
 #include "hardware/dma.h"
 #include "hardware/irq.h"
 #include <stddef.h>
 
-static int dma_channel = -1;
-static void (*completion_callback)(void) = NULL;
+// Control block, in the order of the data channel's alias 1 registers
+typedef struct {
+    uint32_t ctrl;
+    const void *read_addr;
+    void *write_addr;
+    uint32_t transfer_count;
+} dma_control_block_t;
+
+// Up to three blocks per job (head, body, tail) plus the null trigger
+#define CONTROL_BLOCKS_PER_JOB  3
+static dma_control_block_t control_blocks[INDEXED_MEMORY_DMA_BATCH_MAX * CONTROL_BLOCKS_PER_JOB + 1]
+    __attribute__((aligned(16)));
+
+// Pattern words of the fill jobs, read without increment while the batch runs
+static uint32_t fill_patterns[INDEXED_MEMORY_DMA_BATCH_MAX] __attribute__((aligned(4)));
+
+static int dma_channel = -1;        // Data channel (does the copies)
+static int control_channel = -1;    // Reloads the data channel per job
+static indexed_memory_dma_batch_t batch;
+static void (*completion_callback)(bool batch_done) = NULL;
 
 /**
  * DMA interrupt handler
+ * Raised after a job with notify set and by the terminating null trigger
  */
 static void dma_irq_handler(void) {
     if (dma_channel >= 0 && dma_channel_get_irq0_status(dma_channel)) {
         // Clear the interrupt
         dma_channel_acknowledge_irq0(dma_channel);
         
+        // The chain only leaves both channels idle after the null trigger
+        bool chain_idle = !dma_channel_is_busy(dma_channel) && !dma_channel_is_busy(control_channel);
+        dma_batch_irq_t event = indexed_memory_dma_batch_irq(&batch, chain_idle);
+        if (event == DMA_BATCH_IRQ_IGNORE) {
+            return;
+        }
+        if (event == DMA_BATCH_IRQ_DONE) {
+            // Nothing is raised after the chain ends: drop a flag the null
+            // trigger set again since the acknowledge above
+            dma_channel_acknowledge_irq0(dma_channel);
+        }
+        
         // Call completion callback if set
         if (completion_callback) {
-            completion_callback();
+            completion_callback(event == DMA_BATCH_IRQ_DONE);
         }
     }
 }
 
 int indexed_memory_dma_init(void) {
-    // Claim an unused DMA channel
+    if (dma_channel >= 0) {
+        return dma_channel;  // Already claimed (factory reset)
+    }
+    
+    // Claim the data and control channels
     dma_channel = dma_claim_unused_channel(true);
+    control_channel = dma_claim_unused_channel(true);
+    
+    // Control channel: 4 words per trigger into the data channel's alias 1
+    // registers, wrapping on that 16-byte block, walking the control blocks
+    dma_channel_config c = dma_channel_get_default_config(control_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, 4);
+    dma_channel_configure(control_channel, &c,
+                          &dma_hw->ch[dma_channel].al1_ctrl,
+                          control_blocks,
+                          4,
+                          false);
     
-    // Enable interrupt for this channel
+    // Enable interrupt for the data channel
     dma_channel_set_irq0_enabled(dma_channel, true);
     irq_set_exclusive_handler(DMA_IRQ_0, dma_irq_handler);
+    irq_set_priority(DMA_IRQ_0, MIA_IRQ_PRIORITY_DMA);
     irq_set_enabled(DMA_IRQ_0, true);
     
     return dma_channel;
 }
 
-void indexed_memory_dma_start_transfer(void* dst, const void* src, uint32_t count) {
-    if (dma_channel < 0) {
-        return;  // Not initialized
-    }
-    
-    // Configure DMA channel
+/**
+ * Build the CTRL value of a job block
+ * Copies (or fills) of the given size that chain back to the control channel
+ */
+static uint32_t job_ctrl_value(bool fill, enum dma_channel_transfer_size size, bool quiet) {
     dma_channel_config c = dma_channel_get_default_config(dma_channel);
-    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);  // 8-bit transfers
-    channel_config_set_read_increment(&c, true);             // Increment read address
+    channel_config_set_transfer_data_size(&c, size);
+    channel_config_set_read_increment(&c, !fill);            // Fills re-read the pattern
     channel_config_set_write_increment(&c, true);            // Increment write address
+    channel_config_set_chain_to(&c, control_channel);
+    channel_config_set_irq_quiet(&c, quiet);
+    return channel_config_get_ctrl_value(&c);
+}
+
+/**
+ * Split a job into head/body/tail blocks
+ * Only the job's last block may raise the per-job interrupt
+ * Returns the number of blocks written
+ */
+static uint32_t build_job_blocks(dma_control_block_t *blocks, const indexed_memory_dma_job_t *job,
+                                 const uint8_t *src, const uint32_t ctrl[2][2]) {
+    uint8_t *dst = job->dst;
+    uint32_t head = job->count;
+    uint32_t words = 0;
     
-    // Start DMA transfer
-    dma_channel_configure(
-        dma_channel,
-        &c,
-        dst,      // Write address
-        src,      // Read address
-        count,    // Transfer count
-        true      // Start immediately
-    );
+    // Word body only when both addresses reach a word boundary together
+    // (a fill pattern is aligned and never advances)
+    if (job->fill || (((uintptr_t)src ^ (uintptr_t)dst) & 3) == 0) {
+        uint32_t align = (4 - ((uintptr_t)dst & 3)) & 3;
+        if (job->count >= align + 4) {
+            head = align;
+            words = (job->count - align) / 4;
+        }
+    }
+    
+    // {transfer count, word sized}; a job without a word run is one byte block
+    const uint32_t parts[3][2] = {
+        { head, 0 },
+        { words, 1 },
+        { job->count - head - words * 4, 0 },
+    };
+    
+    uint32_t n = 0;
+    bool last_word = false;
+    for (uint32_t p = 0; p < 3; p++) {
+        if (parts[p][0] == 0) {
+            continue;
+        }
+        last_word = parts[p][1];
+        blocks[n].ctrl = ctrl[last_word][1];
+        blocks[n].read_addr = src;
+        blocks[n].write_addr = dst;
+        blocks[n].transfer_count = parts[p][0];
+        if (!job->fill) {
+            src += parts[p][0] << (last_word ? 2 : 0);
+        }
+        dst += parts[p][0] << (last_word ? 2 : 0);
+        n++;
+    }
+    
+    if (job->notify && n > 0) {
+        blocks[n - 1].ctrl = ctrl[last_word][0];
+    }
+    return n;
 }
 
-bool indexed_memory_dma_is_busy(void) {
-    if (dma_channel < 0) {
+bool indexed_memory_dma_start_batch(const indexed_memory_dma_job_t *jobs, uint32_t count) {
+    if (dma_channel < 0 || batch.running || count == 0 || count > INDEXED_MEMORY_DMA_BATCH_MAX) {
         return false;
     }
-    return dma_channel_is_busy(dma_channel);
+    
+    // [fill][word size][quiet]: byte/word copies or fills, with or without
+    // the job IRQ
+    const uint32_t ctrl[2][2][2] = {
+        {
+            { job_ctrl_value(false, DMA_SIZE_8, false),  job_ctrl_value(false, DMA_SIZE_8, true) },
+            { job_ctrl_value(false, DMA_SIZE_32, false), job_ctrl_value(false, DMA_SIZE_32, true) },
+        },
+        {
+            { job_ctrl_value(true, DMA_SIZE_8, false),   job_ctrl_value(true, DMA_SIZE_8, true) },
+            { job_ctrl_value(true, DMA_SIZE_32, false),  job_ctrl_value(true, DMA_SIZE_32, true) },
+        },
+    };
+    
+    uint32_t n = 0;
+    uint32_t notifies = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *src = jobs[i].src;
+        notifies += jobs[i].notify;
+        if (jobs[i].fill) {
+            fill_patterns[i] = jobs[i].value * 0x01010101u;
+            src = (const uint8_t *)&fill_patterns[i];
+        }
+        n += build_job_blocks(&control_blocks[n], &jobs[i], src, ctrl[jobs[i].fill]);
+    }
+    control_blocks[n].ctrl = ctrl[0][0][1];
+    control_blocks[n].read_addr = NULL;
+    control_blocks[n].write_addr = NULL;
+    control_blocks[n].transfer_count = 0;  // Null trigger: end of batch
+    
+    indexed_memory_dma_batch_start(&batch, notifies);
+    dma_channel_set_read_addr(control_channel, control_blocks, true);
+    return true;
+}
+
+bool indexed_memory_dma_is_busy(void) {
+    return batch.running;
 }
 
-void indexed_memory_dma_set_completion_callback(void (*callback)(void)) {
+void indexed_memory_dma_set_completion_callback(void (*callback)(bool batch_done)) {
     completion_callback = callback;
 }
@@ -0,0 +1,30 @@
+/**
+ * PSRAM abstraction layer for the MIA memory expansion
+ * Provides a clean interface that can be mocked for testing
+ *
+ * Offsets are bytes from the start of the PSRAM. Accesses bypass the XIP
+ * cache, so they never evict the flash code or data it holds, and each is
+ * one or more QSPI transfers: several hundred ns for a byte.
+ */
+
+#ifndef PSRAM_H
+#define PSRAM_H
+
+#include <stdint.h>
+
+/**
+ * Detect the PSRAM and set up the QMI for memory-mapped access
+ * Safe to call again, the part is set up once.
+ *
+ * @return PSRAM size in bytes (PSRAM_SIZE), or 0 if none answered
+ */
+uint32_t psram_init(void);
+
+// Byte write, for writes the cache could not hold
+void psram_write_byte(uint32_t offset, uint8_t data);
+
+// Page transfers (offset and count multiples of 4)
+void psram_read(uint32_t offset, void *dst, uint32_t count);
+void psram_write(uint32_t offset, const void *src, uint32_t count);
+
+#endif // PSRAM_H
@@ -0,0 +1,260 @@
+/**
+ * MIA PSRAM Page Cache Implementation
+ */
+
+#include "psram_cache.h"
+#include "psram.h"
+#include "config/bus_config.h"
+#include "indexed_memory/indexed_memory.h"
+#include "system/background.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+_Static_assert((PSRAM_CACHE_SETS & (PSRAM_CACHE_SETS - 1)) == 0, "PSRAM_CACHE_SETS must be a power of two");
+_Static_assert((PSRAM_CACHE_WAYS & (PSRAM_CACHE_WAYS - 1)) == 0, "PSRAM_CACHE_WAYS must be a power of two");
+_Static_assert(PSRAM_PAGE_SIZE % 4 == 0, "PSRAM pages are transferred in words");
+
+#define NO_PAGE                 UINT32_MAX
+#define PAGE_OFFSET(offset)     ((offset) & (PSRAM_PAGE_SIZE - 1))
+
+// Cached pages, way w of set s at s * PSRAM_CACHE_WAYS + w
+static uint8_t pages[PSRAM_CACHE_PAGES][PSRAM_PAGE_SIZE] __attribute__((aligned(4)));
+static BUS_HOT_DATA volatile uint32_t tags[PSRAM_CACHE_PAGES];     // PSRAM page number, or NO_PAGE
+static BUS_HOT_DATA volatile bool dirty[PSRAM_CACHE_PAGES];        // Written by the bus path since the last write-back
+static uint8_t next_victim[PSRAM_CACHE_SETS];                      // Way replaced next in each set
+
+// Pages asked for by the bus path (head), taken by the promotion (tail)
+static BUS_HOT_DATA volatile uint32_t queue[PSRAM_CACHE_QUEUE_DEPTH];
+static BUS_HOT_DATA volatile uint8_t queue_head;
+static BUS_HOT_DATA volatile uint8_t queue_tail;
+
+// Page being promoted, and whether the bus path wrote to it meanwhile
+static BUS_HOT_DATA volatile uint32_t filling;
+static BUS_HOT_DATA volatile bool fill_stale;
+
+// Writes to missing pages, oldest first, one entry per byte. Appended by the
+// bus path; the Core 0 thread only takes entries with interrupts disabled
+static BUS_HOT_DATA uint32_t pending_offset[PSRAM_CACHE_PENDING_WRITES];
+static BUS_HOT_DATA uint8_t pending_data[PSRAM_CACHE_PENDING_WRITES];
+static BUS_HOT_DATA volatile uint32_t pending_count;
+
+static uint32_t psram_size;
+static bool cache_ready;
+
+/**
+ * Cache slot holding a page, or -1
+ */
+static inline int BUS_HOT_FUNC(find_slot)(uint32_t page) {
+    uint32_t base = (page & (PSRAM_CACHE_SETS - 1)) * PSRAM_CACHE_WAYS;
+    for (uint32_t w = 0; w < PSRAM_CACHE_WAYS; w++) {
+        if (tags[base + w] == page) {
+            return (int)(base + w);
+        }
+    }
+    return -1;
+}
+
+/**
+ * Queue a page for promotion, once
+ * A full queue drops the request: the next miss asks again
+ */
+static void BUS_HOT_FUNC(request_page)(uint32_t page) {
+    uint8_t head = queue_head;
+    for (uint8_t i = queue_tail; i != head; i++) {
+        if (queue[i & (PSRAM_CACHE_QUEUE_DEPTH - 1)] == page) {
+            return;
+        }
+    }
+    if ((uint8_t)(head - queue_tail) == PSRAM_CACHE_QUEUE_DEPTH) {
+        return;
+    }
+    queue[head & (PSRAM_CACHE_QUEUE_DEPTH - 1)] = page;
+    queue_head = head + 1;
+    background_post(BACKGROUND_WORK_PSRAM);
+}
+
+uint32_t psram_cache_init(void) {
+    psram_size = psram_init();
+    if (cache_ready) {
+        psram_cache_flush();
+    }
+
+    for (uint32_t i = 0; i < PSRAM_CACHE_PAGES; i++) {
+        tags[i] = NO_PAGE;
+        dirty[i] = false;
+    }
+    memset(next_victim, 0, sizeof(next_victim));
+    queue_head = 0;
+    queue_tail = 0;
+    filling = NO_PAGE;
+    fill_stale = false;
+    pending_count = 0;
+    cache_ready = true;
+    return psram_size;
+}
+
+bool BUS_HOT_FUNC(psram_cache_read)(uint32_t offset, uint8_t *data) {
+    uint32_t page = offset >> PSRAM_PAGE_SHIFT;
+    int slot = find_slot(page);
+    if (slot >= 0) {
+        *data = pages[slot][PAGE_OFFSET(offset)];
+        return true;
+    }
+    request_page(page);
+    *data = PSRAM_CACHE_NOT_READY;
+    return false;
+}
+
+void BUS_HOT_FUNC(psram_cache_write)(uint32_t offset, uint8_t data) {
+    uint32_t page = offset >> PSRAM_PAGE_SHIFT;
+    int slot = find_slot(page);
+    if (slot >= 0) {
+        pages[slot][PAGE_OFFSET(offset)] = data;
+        dirty[slot] = true;
+        return;
+    }
+    request_page(page);
+    
+    // Held until the page is promoted; a byte written again keeps its entry
+    uint32_t count = pending_count;
+    for (uint32_t i = 0; i < count; i++) {
+        if (pending_offset[i] == offset) {
+            pending_data[i] = data;
+            return;
+        }
+    }
+    if (count < PSRAM_CACHE_PENDING_WRITES) {
+        pending_offset[count] = offset;
+        pending_data[count] = data;
+        pending_count = count + 1;
+        return;
+    }
+    
+    // List full, with no older held write to the byte to land after this one
+    psram_write_byte(offset, data);
+    if (page == filling) {
+        fill_stale = true;
+    }
+}
+
+/**
+ * Move the pending writes to a page into its slot (interrupts disabled)
+ */
+static void merge_pending(uint32_t page, uint32_t slot) {
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < pending_count; i++) {
+        if ((pending_offset[i] >> PSRAM_PAGE_SHIFT) == page) {
+            pages[slot][PAGE_OFFSET(pending_offset[i])] = pending_data[i];
+            dirty[slot] = true;
+        } else {
+            pending_offset[kept] = pending_offset[i];
+            pending_data[kept] = pending_data[i];
+            kept++;
+        }
+    }
+    pending_count = kept;
+}
+
+void BUS_HOT_FUNC(psram_cache_prefetch)(uint32_t offset) {
+    uint32_t page = offset >> PSRAM_PAGE_SHIFT;
+    if (find_slot(page) < 0) {
+        request_page(page);
+    }
+}
+
+bool BUS_HOT_FUNC(psram_cache_contains)(uint32_t offset) {
+    return find_slot(offset >> PSRAM_PAGE_SHIFT) >= 0;
+}
+
+/**
+ * Write a slot back while it stays visible
+ *
+ * @return false if the bus path wrote to it during the copy (still dirty)
+ */
+static bool write_back(uint32_t slot) {
+    dirty[slot] = false;
+    psram_write(tags[slot] << PSRAM_PAGE_SHIFT, pages[slot], PSRAM_PAGE_SIZE);
+    return !dirty[slot];
+}
+
+void psram_cache_process(void) {
+    if (queue_tail == queue_head) {
+        return;
+    }
+    uint32_t page = queue[queue_tail & (PSRAM_CACHE_QUEUE_DEPTH - 1)];
+    queue_tail++;
+    if (queue_tail != queue_head) {
+        background_post(BACKGROUND_WORK_PSRAM);
+    }
+    if (find_slot(page) >= 0) {
+        return;
+    }
+
+    // An empty way, otherwise the ways of the set in turn
+    uint32_t set = page & (PSRAM_CACHE_SETS - 1);
+    uint32_t slot = set * PSRAM_CACHE_WAYS + next_victim[set];
+    for (uint32_t w = 0; w < PSRAM_CACHE_WAYS; w++) {
+        if (tags[set * PSRAM_CACHE_WAYS + w] == NO_PAGE) {
+            slot = set * PSRAM_CACHE_WAYS + w;
+            break;
+        }
+    }
+    if (tags[slot] != NO_PAGE) {
+        next_victim[set] = (next_victim[set] + 1) & (PSRAM_CACHE_WAYS - 1);
+        if (dirty[slot] && !write_back(slot)) {
+            return;
+        }
+
+        // Still clean with interrupts off: from here the bus path goes to
+        // the PSRAM, which holds everything it wrote
+        uint32_t saved = save_and_disable_interrupts();
+        bool clean = !dirty[slot];
+        if (clean) {
+            tags[slot] = NO_PAGE;
+        }
+        restore_interrupts(saved);
+        if (!clean) {
+            return;
+        }
+    }
+
+    // Fill while invisible; a bus write to the page meanwhile may land
+    // between the copy of its word and the store, so that fill is dropped
+    filling = page;
+    fill_stale = false;
+    psram_read(page << PSRAM_PAGE_SHIFT, pages[slot], PSRAM_PAGE_SIZE);
+    uint32_t saved = save_and_disable_interrupts();
+    bool promoted = !fill_stale;
+    if (promoted) {
+        merge_pending(page, slot);
+        tags[slot] = page;
+    }
+    filling = NO_PAGE;
+    restore_interrupts(saved);
+    
+    // Reads that found the page missing can be answered now
+    if (promoted) {
+        indexed_memory_notify_write();
+    }
+}
+
+void psram_cache_flush(void) {
+    for (uint32_t slot = 0; slot < PSRAM_CACHE_PAGES; slot++) {
+        while (tags[slot] != NO_PAGE && dirty[slot] && !write_back(slot)) {
+        }
+    }
+    
+    // Oldest first; a write to the byte after its entry is taken gets a new one
+    while (pending_count) {
+        uint32_t saved = save_and_disable_interrupts();
+        uint32_t offset = pending_offset[0];
+        uint8_t data = pending_data[0];
+        for (uint32_t i = 1; i < pending_count; i++) {
+            pending_offset[i - 1] = pending_offset[i];
+            pending_data[i - 1] = pending_data[i];
+        }
+        pending_count--;
+        restore_interrupts(saved);
+        psram_write_byte(offset, data);
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * MIA PSRAM Page Cache
+ *
+ * Keeps the PSRAM pages that indexes are streaming in SRAM. Page n can be
+ * held in any of the PSRAM_CACHE_WAYS ways of set n % PSRAM_CACHE_SETS
+ * (config/memory_config.h), so that many streams whose pages collide
+ * still fit.
+ *
+ * The bus path reads and writes through psram_cache_read/write(). A cached
+ * page is accessed in SRAM. The bus path never waits for the PSRAM: a read
+ * of a missing page returns PSRAM_CACHE_NOT_READY and reports the miss, and
+ * a write to one is held in a short pending list; either way the page is
+ * queued for promotion. psram_cache_prefetch() queues a page ahead of a
+ * stream. Queued pages are promoted one per psram_cache_process() call, in
+ * the Core 0 background work (BACKGROUND_WORK_PSRAM), after the dirty page
+ * they replace is written back. The pending writes to a page are merged
+ * into it as it becomes visible, and bus reads are told with
+ * indexed_memory_notify_write(). Only a write missing with the pending
+ * list full goes to the PSRAM directly.
+ *
+ * Everything runs on Core 0 and the bus path preempts the promotion at any
+ * point. A page is tagged, and so visible to the bus path, only while its
+ * SRAM copy holds every byte the bus path wrote; a promotion that races a
+ * bus write to its page gives up, and the next miss asks again.
+ *
+ * Offsets are bytes from the start of the PSRAM.
+ */
+
+#ifndef PSRAM_CACHE_H
+#define PSRAM_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config/memory_config.h"
+
+#define PSRAM_CACHE_PAGES       (PSRAM_CACHE_SETS * PSRAM_CACHE_WAYS)
+#define PSRAM_CACHE_QUEUE_DEPTH 8       // Pages waiting for promotion (power of two)
+#define PSRAM_CACHE_PENDING_WRITES 16   // Writes to missing pages held until promotion
+#define PSRAM_CACHE_NOT_READY   0xFF    // Read of a missing page
+
+/**
+ * Set up the PSRAM (once), write back dirty pages and empty the cache
+ *
+ * @return PSRAM size in bytes, 0 without PSRAM
+ */
+uint32_t psram_cache_init(void);
+
+// Bus path access (offset below the PSRAM size)
+// psram_cache_read() returns false, with PSRAM_CACHE_NOT_READY in *data, if
+// the page is not cached yet
+bool psram_cache_read(uint32_t offset, uint8_t *data);
+void psram_cache_write(uint32_t offset, uint8_t data);
+
+// Queue the page holding offset unless it is cached (bus path)
+void psram_cache_prefetch(uint32_t offset);
+
+// True while the page holding offset is cached
+bool psram_cache_contains(uint32_t offset);
+
+// Promote the oldest queued page (Core 0 background work)
+void psram_cache_process(void);
+
+// Write every dirty page and pending write back to the PSRAM (Core 0 thread mode)
+void psram_cache_flush(void);
+
+#endif // PSRAM_CACHE_H
@@ -0,0 +1,166 @@
+/**
+ * Hardware PSRAM implementation for the RP2350
+ *
+ * The PSRAM (an APS6404L or compatible) sits on the QMI's second chip
+ * select, next to the flash. Setup runs once from SRAM with interrupts
+ * disabled, since the flash is unreachable while the QMI is in direct mode:
+ * read the ID in SPI mode, reset the part, switch it to QPI, then program
+ * the M1 window with quad read (0xEB) and write (0x38) commands and timing
+ * for the current system clock. After that the PSRAM is plain memory at
+ * the uncached XIP alias of the CS1 window.
+ */
+
+#include "psram.h"
+#include "config/memory_config.h"
+#include "config/bus_config.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/qmi.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/regs/addressmap.h"
+#include "pico/platform.h"
+
+// CS1 window (16MB above CS0) in the alias that neither hits nor fills the
+// XIP cache
+#define PSRAM_NOCACHE_BASE      (XIP_NOCACHE_NOALLOC_BASE + 0x01000000)
+
+#define PSRAM_KGD_PASS          0x5D    // Known good die byte of the read ID reply
+
+static uint32_t psram_size;
+static bool psram_probed;
+
+/**
+ * Send one direct-mode byte and return the byte clocked in
+ */
+static uint8_t __no_inline_not_in_flash_func(direct_transfer)(uint32_t tx) {
+    qmi_hw->direct_tx = tx;
+    while (!(qmi_hw->direct_csr & QMI_DIRECT_CSR_TXEMPTY_BITS)) {
+    }
+    while (qmi_hw->direct_csr & QMI_DIRECT_CSR_BUSY_BITS) {
+    }
+    return (uint8_t)qmi_hw->direct_rx;
+}
+
+/**
+ * Send a single-byte command with CS1 asserted around it
+ */
+static void __no_inline_not_in_flash_func(direct_command)(uint32_t tx) {
+    qmi_hw->direct_csr |= QMI_DIRECT_CSR_ASSERT_CS1N_BITS;
+    direct_transfer(tx);
+    qmi_hw->direct_csr &= ~QMI_DIRECT_CSR_ASSERT_CS1N_BITS;
+    for (int i = 0; i < 20; i++) {
+        __asm volatile("nop");      // CS1 high between commands
+    }
+}
+
+/**
+ * Probe and set up the part (interrupts disabled, flash unreachable)
+ *
+ * @return true if the part answered with a good ID
+ */
+static bool __no_inline_not_in_flash_func(psram_setup)(uint32_t sys_hz) {
+    qmi_hw->direct_csr = 30 << QMI_DIRECT_CSR_CLKDIV_LSB | QMI_DIRECT_CSR_EN_BITS;
+    // The cooldown of the last XIP transfer must expire first
+    while (qmi_hw->direct_csr & QMI_DIRECT_CSR_BUSY_BITS) {
+    }
+    
+    // Leave QPI mode in case the part is already in it (soft reboot)
+    direct_command(QMI_DIRECT_TX_OE_BITS | QMI_DIRECT_TX_IWIDTH_VALUE_Q << QMI_DIRECT_TX_IWIDTH_LSB | 0xF5);
+    
+    // Read ID (SPI): command, 3 address bytes, MFID, KGD
+    qmi_hw->direct_csr |= QMI_DIRECT_CSR_ASSERT_CS1N_BITS;
+    uint8_t kgd = 0;
+    for (int i = 0; i < 6; i++) {
+        uint8_t rx = direct_transfer(i == 0 ? 0x9F : 0xFF);
+        if (i == 5) {
+            kgd = rx;
+        }
+    }
+    qmi_hw->direct_csr &= ~QMI_DIRECT_CSR_ASSERT_CS1N_BITS;
+    
+    if (kgd != PSRAM_KGD_PASS) {
+        qmi_hw->direct_csr &= ~QMI_DIRECT_CSR_EN_BITS;
+        return false;
+    }
+    
+    // Reset enable, reset, enter QPI
+    direct_command(0x66);
+    direct_command(0x99);
+    direct_command(0x35);
+    qmi_hw->direct_csr &= ~QMI_DIRECT_CSR_EN_BITS;
+    
+    // Clock divisor for the QPI limit; max select is at most 8us (in units
+    // of 64 system clocks), min deselect at least 18ns
+    uint32_t divisor = (sys_hz + PSRAM_MAX_FREQ_HZ - 1) / PSRAM_MAX_FREQ_HZ;
+    if (divisor == 1 && sys_hz > 100000000) {
+        divisor = 2;
+    }
+    uint32_t rxdelay = divisor;
+    if (sys_hz / divisor > 100000000) {
+        rxdelay++;
+    }
+    uint32_t period_fs = (uint32_t)(1000000000000000ull / sys_hz);
+    uint32_t max_select = (125 * 1000000) / period_fs;
+    uint32_t min_deselect = (18 * 1000000 + period_fs - 1) / period_fs - (divisor + 1) / 2;
+    
+    qmi_hw->m[1].timing = 1 << QMI_M1_TIMING_COOLDOWN_LSB |
+                          QMI_M1_TIMING_PAGEBREAK_VALUE_1024 << QMI_M1_TIMING_PAGEBREAK_LSB |
+                          max_select << QMI_M1_TIMING_MAX_SELECT_LSB |
+                          min_deselect << QMI_M1_TIMING_MIN_DESELECT_LSB |
+                          rxdelay << QMI_M1_TIMING_RXDELAY_LSB |
+                          divisor << QMI_M1_TIMING_CLKDIV_LSB;
+    
+    // Quad everything: command, address, 6 dummy nibble pairs, data
+    uint32_t quad = QMI_M1_RFMT_PREFIX_WIDTH_VALUE_Q << QMI_M1_RFMT_PREFIX_WIDTH_LSB |
+                    QMI_M1_RFMT_ADDR_WIDTH_VALUE_Q << QMI_M1_RFMT_ADDR_WIDTH_LSB |
+                    QMI_M1_RFMT_SUFFIX_WIDTH_VALUE_Q << QMI_M1_RFMT_SUFFIX_WIDTH_LSB |
+                    QMI_M1_RFMT_DUMMY_WIDTH_VALUE_Q << QMI_M1_RFMT_DUMMY_WIDTH_LSB |
+                    QMI_M1_RFMT_DATA_WIDTH_VALUE_Q << QMI_M1_RFMT_DATA_WIDTH_LSB |
+                    QMI_M1_RFMT_PREFIX_LEN_VALUE_8 << QMI_M1_RFMT_PREFIX_LEN_LSB;
+    qmi_hw->m[1].rfmt = quad | 6 << QMI_M1_RFMT_DUMMY_LEN_LSB;
+    qmi_hw->m[1].rcmd = 0xEB;
+    qmi_hw->m[1].wfmt = quad;
+    qmi_hw->m[1].wcmd = 0x38;
+    return true;
+}
+
+uint32_t psram_init(void) {
+    if (psram_probed) {
+        return psram_size;
+    }
+    psram_probed = true;
+    
+    gpio_set_function(PSRAM_CS_PIN, GPIO_FUNC_XIP_CS1);
+    
+    uint32_t saved = save_and_disable_interrupts();
+    bool found = psram_setup(clock_get_hz(clk_sys));
+    restore_interrupts(saved);
+    
+    if (found) {
+        hw_set_bits(&xip_ctrl_hw->ctrl, XIP_CTRL_WRITABLE_M1_BITS);
+        psram_size = PSRAM_SIZE;
+    }
+    return psram_size;
+}
+
+// Only after the pending list fills or on a flush, never for a read
+void BUS_HOT_FUNC(psram_write_byte)(uint32_t offset, uint8_t data) {
+    ((volatile uint8_t *)PSRAM_NOCACHE_BASE)[offset] = data;
+}
+
+void psram_read(uint32_t offset, void *dst, uint32_t count) {
+    const volatile uint32_t *src = (const volatile uint32_t *)(PSRAM_NOCACHE_BASE + offset);
+    uint32_t *words = dst;
+    for (uint32_t i = 0; i < count / 4; i++) {
+        words[i] = src[i];
+    }
+}
+
+void psram_write(uint32_t offset, const void *src, uint32_t count) {
+    volatile uint32_t *dst = (volatile uint32_t *)(PSRAM_NOCACHE_BASE + offset);
+    const uint32_t *words = src;
+    for (uint32_t i = 0; i < count / 4; i++) {
+        dst[i] = words[i];
+    }
+}
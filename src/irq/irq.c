@@ -6,204 +6,242 @@
 
 #include "irq.h"
 #include "hardware/gpio_mapping.h"
+#include "config/bus_config.h"
 
 // Always include GPIO for IRQ line control (mocked in tests)
 #include "hardware/gpio.h"
 
 // IRQ system state
+// Shared by both cores: Core 1 raises causes (DMA completion, USB, video)
+// while the bus path on Core 0 acknowledges them and writes the mask. Every
+// field is changed with a single atomic read-modify-write (LDREX/STREX on the
+// RP2350), so concurrent updates never lose each other's bits.
 typedef struct {
-    uint16_t irq_cause;        // Interrupt cause register (16-bit bit mask)
-    uint16_t irq_mask;         // 16-bit interrupt mask register (which IRQs are enabled)
-    uint8_t irq_enable;        // Global interrupt enable/disable (1 = enabled, 0 = disabled)
+    volatile uint32_t irq_cause;    // Interrupt cause register (16-bit bit mask)
+    volatile uint32_t irq_mask;     // 16-bit interrupt mask register (which IRQs are enabled)
+    volatile uint8_t irq_enable;    // Global interrupt enable/disable (1 = enabled, 0 = disabled)
 } irq_state_t;
 
 // Private state
-static irq_state_t g_irq_state;
+static BUS_HOT_DATA irq_state_t g_irq_state;
 
-/**
- * Assert IRQ line to 6502 (active low)
- */
-static void assert_irq_line(void) {
-    gpio_put(GPIO_IRQ_OUT, 0);  // Active low
+// IRQ_VECTOR of the pending, unmasked causes, kept with the line
+static BUS_HOT_DATA volatile uint8_t g_irq_vector;
+
+// Bumped on every state change so readers holding a copy of the IRQ
+// registers (the bus read shadow) can tell when to refresh it
+static BUS_HOT_DATA volatile uint32_t g_irq_generation;
+
+static bool BUS_HOT_FUNC(pending)(uint32_t cause, uint32_t mask, uint8_t enable) {
+    return enable && (cause & mask) != 0;
+}
+
+// Highest set bit first (CLZ)
+static uint8_t BUS_HOT_FUNC(vector_of)(uint32_t causes) {
+    causes &= 0xFFFF;
+    return causes ? IRQ_VECTOR_OF(31 - __builtin_clz(causes)) : IRQ_VECTOR_NONE;
 }
 
 /**
- * Deassert IRQ line to 6502 (inactive high)
+ * Drive the IRQ line (active low) and IRQ_VECTOR from the current state
+ * 
+ * Called after every change, once its generation bump is visible. The
+ * level is taken from one snapshot and written with the SIO set/clear
+ * aliases (gpio_put), then the snapshot is checked against the generation:
+ * if the other core changed the state meanwhile, our level may be stale and
+ * is written again. Whichever core's write is last was taken after the last
+ * change, so the line always settles on the final state without a lock.
  */
-static void deassert_irq_line(void) {
-    gpio_put(GPIO_IRQ_OUT, 1);  // Inactive high
+static void BUS_HOT_FUNC(update_irq_line)(void) {
+    uint32_t generation;
+    do {
+        generation = __atomic_load_n(&g_irq_generation, __ATOMIC_ACQUIRE);
+        uint32_t cause = __atomic_load_n(&g_irq_state.irq_cause, __ATOMIC_RELAXED);
+        uint32_t mask = __atomic_load_n(&g_irq_state.irq_mask, __ATOMIC_RELAXED);
+        bool active = pending(cause, mask, __atomic_load_n(&g_irq_state.irq_enable, __ATOMIC_RELAXED));
+        g_irq_vector = vector_of(cause & mask);
+        gpio_put(GPIO_IRQ_OUT, !active);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    } while (generation != __atomic_load_n(&g_irq_generation, __ATOMIC_RELAXED));
+}
+
+// A state change is complete: publish it and settle the line
+static void BUS_HOT_FUNC(state_changed)(void) {
+    __atomic_fetch_add(&g_irq_generation, 1, __ATOMIC_SEQ_CST);
+    update_irq_line();
 }
 
 /**
  * Initialize IRQ system
  */
 void irq_init(void) {
-    g_irq_state.irq_cause = IRQ_NO_IRQ;
-    g_irq_state.irq_mask = 0xFFFF; // All interrupts enabled by default (16-bit)
-    g_irq_state.irq_enable = 0x01; // Global interrupts enabled by default
+    __atomic_store_n(&g_irq_state.irq_cause, IRQ_NO_IRQ, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_irq_state.irq_mask, 0xFFFF, __ATOMIC_RELAXED); // All interrupts enabled by default (16-bit)
+    __atomic_store_n(&g_irq_state.irq_enable, 0x01, __ATOMIC_RELAXED); // Global interrupts enabled by default
     
-    // Deassert IRQ line initially
-    deassert_irq_line();
+    // Deasserts the IRQ line
+    state_changed();
 }
 
 /**
  * Set interrupt cause and assert IRQ line if enabled
  */
-void irq_set_bits(uint16_t cause) {
-    // Set the interrupt bit(s) in the pending register (OR to accumulate)
-    g_irq_state.irq_cause |= cause;
-    
-    // Check if any enabled interrupts are pending and global enable is on
-    if (g_irq_state.irq_enable && ((g_irq_state.irq_cause & g_irq_state.irq_mask) != 0)) {
-        assert_irq_line();
-    }
+void BUS_HOT_FUNC(irq_set_bits)(uint16_t cause) {
+    // OR to accumulate, atomically against acknowledges from the other core
+    __atomic_fetch_or(&g_irq_state.irq_cause, cause, __ATOMIC_SEQ_CST);
+    state_changed();
 }
 
 /**
  * Clear interrupt cause and deassert IRQ line if no more enabled interrupts
  */
-void irq_clear_bits(uint16_t cause) {
-    // Clear the interrupt bit(s) from the pending register
-    g_irq_state.irq_cause &= ~cause;
-    
-    // If no enabled interrupts are pending, deassert IRQ line
-    if ((g_irq_state.irq_cause & g_irq_state.irq_mask) == 0) {
-        deassert_irq_line();
-    }
+void BUS_HOT_FUNC(irq_clear_bits)(uint16_t cause) {
+    // Only the given bits: a cause raised meanwhile stays pending
+    __atomic_fetch_and(&g_irq_state.irq_cause, ~(uint32_t)cause, __ATOMIC_SEQ_CST);
+    state_changed();
 }
 
 /**
  * Clear all interrupts and deassert IRQ line
  */
-void irq_clear_all(void) {
-    g_irq_state.irq_cause = IRQ_NO_IRQ;
-    deassert_irq_line();
+void BUS_HOT_FUNC(irq_clear_all)(void) {
+    __atomic_store_n(&g_irq_state.irq_cause, IRQ_NO_IRQ, __ATOMIC_SEQ_CST);
+    state_changed();
 }
 
 /**
  * Get full 16-bit IRQ cause
  */
 uint16_t irq_get_cause(void) {
-    return g_irq_state.irq_cause;
+    return (uint16_t)__atomic_load_n(&g_irq_state.irq_cause, __ATOMIC_RELAXED);
 }
 
 /**
  * Get IRQ cause low byte (bits 0-7)
  */
-uint8_t irq_get_cause_low(void) {
-    return g_irq_state.irq_cause & 0xFF;
+uint8_t BUS_HOT_FUNC(irq_get_cause_low)(void) {
+    return irq_get_cause() & 0xFF;
 }
 
 /**
  * Get IRQ cause high byte (bits 8-15)
  */
-uint8_t irq_get_cause_high(void) {
-    return (g_irq_state.irq_cause >> 8) & 0xFF;
+uint8_t BUS_HOT_FUNC(irq_get_cause_high)(void) {
+    return (irq_get_cause() >> 8) & 0xFF;
 }
 
 /**
  * Write-1-to-clear IRQ cause low byte
  */
-void irq_write_cause_low(uint8_t clear_bits) {
-    // Clear specified bits in low byte
-    g_irq_state.irq_cause &= ~((uint16_t)clear_bits);
-    
-    // If no enabled interrupts are pending, deassert IRQ line
-    if ((g_irq_state.irq_cause & g_irq_state.irq_mask) == 0) {
-        deassert_irq_line();
-    }
+void BUS_HOT_FUNC(irq_write_cause_low)(uint8_t clear_bits) {
+    irq_clear_bits(clear_bits);
 }
 
 /**
  * Write-1-to-clear IRQ cause high byte
  */
-void irq_write_cause_high(uint8_t clear_bits) {
-    // Clear specified bits in high byte
-    g_irq_state.irq_cause &= ~((uint16_t)clear_bits << 8);
-    
-    // If no enabled interrupts are pending, deassert IRQ line
-    if ((g_irq_state.irq_cause & g_irq_state.irq_mask) == 0) {
-        deassert_irq_line();
-    }
+void BUS_HOT_FUNC(irq_write_cause_high)(uint8_t clear_bits) {
+    irq_clear_bits((uint16_t)clear_bits << 8);
 }
 
 /**
  * Get IRQ mask
  */
 uint16_t irq_get_mask(void) {
-    return g_irq_state.irq_mask;
+    return (uint16_t)__atomic_load_n(&g_irq_state.irq_mask, __ATOMIC_RELAXED);
+}
+
+/**
+ * Replace the mask bits in field with those of bits, in one step
+ */
+static void BUS_HOT_FUNC(update_mask)(uint16_t field, uint16_t bits) {
+    uint32_t mask = __atomic_load_n(&g_irq_state.irq_mask, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&g_irq_state.irq_mask, &mask, (mask & ~(uint32_t)field) | bits,
+                                        true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+    }
+    state_changed();
 }
 
 /**
  * Set IRQ mask and update IRQ line state
  */
 void irq_set_mask(uint16_t mask) {
-    g_irq_state.irq_mask = mask;
-    
-    // Re-evaluate IRQ line state based on new mask
-    if ((g_irq_state.irq_cause & g_irq_state.irq_mask) == 0) {
-        deassert_irq_line();
-    } else if (g_irq_state.irq_enable) {
-        assert_irq_line();
-    }
+    update_mask(0xFFFF, mask);
 }
 
 /**
  * Get IRQ mask low byte
  */
-uint8_t irq_get_mask_low(void) {
-    return g_irq_state.irq_mask & 0xFF;
+uint8_t BUS_HOT_FUNC(irq_get_mask_low)(void) {
+    return irq_get_mask() & 0xFF;
 }
 
 /**
  * Set IRQ mask low byte
  */
-void irq_set_mask_low(uint8_t mask) {
-    uint16_t new_mask = (g_irq_state.irq_mask & 0xFF00) | mask;
-    irq_set_mask(new_mask);
+void BUS_HOT_FUNC(irq_set_mask_low)(uint8_t mask) {
+    update_mask(0x00FF, mask);
 }
 
 /**
  * Get IRQ mask high byte
  */
-uint8_t irq_get_mask_high(void) {
-    return (g_irq_state.irq_mask >> 8) & 0xFF;
+uint8_t BUS_HOT_FUNC(irq_get_mask_high)(void) {
+    return (irq_get_mask() >> 8) & 0xFF;
 }
 
 /**
  * Set IRQ mask high byte
  */
-void irq_set_mask_high(uint8_t mask) {
-    uint16_t new_mask = (g_irq_state.irq_mask & 0x00FF) | ((uint16_t)mask << 8);
-    irq_set_mask(new_mask);
+void BUS_HOT_FUNC(irq_set_mask_high)(uint8_t mask) {
+    update_mask(0xFF00, (uint16_t)mask << 8);
 }
 
 /**
  * Get global IRQ enable state
  */
-uint8_t irq_get_enable(void) {
-    return g_irq_state.irq_enable;
+uint8_t BUS_HOT_FUNC(irq_get_enable)(void) {
+    return __atomic_load_n(&g_irq_state.irq_enable, __ATOMIC_RELAXED);
 }
 
 /**
  * Set global IRQ enable and update IRQ line state
  */
-void irq_set_enable(uint8_t enable) {
-    g_irq_state.irq_enable = enable ? 0x01 : 0x00;
-    
-    // Re-evaluate IRQ line state
-    if (g_irq_state.irq_enable) {
-        if ((g_irq_state.irq_cause & g_irq_state.irq_mask) != 0) {
-            assert_irq_line();
-        }
-    } else {
-        deassert_irq_line();
-    }
+void BUS_HOT_FUNC(irq_set_enable)(uint8_t enable) {
+    __atomic_store_n(&g_irq_state.irq_enable, enable ? 0x01 : 0x00, __ATOMIC_SEQ_CST);
+    state_changed();
 }
 
 /**
  * Check if any IRQ is pending
  */
-bool irq_is_pending(void) {
-    return g_irq_state.irq_enable && ((g_irq_state.irq_cause & g_irq_state.irq_mask) != 0);
+bool BUS_HOT_FUNC(irq_is_pending)(void) {
+    return pending(__atomic_load_n(&g_irq_state.irq_cause, __ATOMIC_RELAXED),
+                   __atomic_load_n(&g_irq_state.irq_mask, __ATOMIC_RELAXED),
+                   __atomic_load_n(&g_irq_state.irq_enable, __ATOMIC_RELAXED));
+}
+
+/**
+ * Get the IRQ vector of the highest-priority pending cause
+ */
+uint8_t BUS_HOT_FUNC(irq_get_vector)(void) {
+    return g_irq_vector;
+}
+
+/**
+ * Acknowledge the cause behind an IRQ vector read by the 6502
+ * Only that cause is cleared: one raised since the read stays pending
+ */
+uint8_t BUS_HOT_FUNC(irq_acknowledge_vector)(uint8_t vector) {
+    if (vector != IRQ_VECTOR_NONE) {
+        irq_clear_bits((uint16_t)(1u << (vector / 2 - 1)));
+    }
+    return vector;
+}
+
+/**
+ * Get IRQ state generation counter
+ */
+uint32_t BUS_HOT_FUNC(irq_get_generation)(void) {
+    return __atomic_load_n(&g_irq_generation, __ATOMIC_ACQUIRE);
 }
@@ -20,8 +20,8 @@
 #define IRQ_DMA_ERROR           0x0008  // Bit 3 (low byte)
 #define IRQ_USB_KEYBOARD        0x0010  // Bit 4 (low byte)
 #define IRQ_USB_DEVICE_CHANGE   0x0020  // Bit 5 (low byte)
-#define IRQ_RESERVED_6          0x0040  // Bit 6 (low byte) - reserved
-#define IRQ_RESERVED_7          0x0080  // Bit 7 (low byte) - reserved
+#define IRQ_USB_LOAD            0x0040  // Bit 6 (low byte)
+#define IRQ_COMMAND_DONE        0x0080  // Bit 7 (low byte) - deferred shared command finished
 
 // High byte (bits 8-15): Video interrupts
 #define IRQ_VIDEO_FRAME_COMPLETE 0x0100 // Bit 8 (high byte, bit 0)
@@ -33,6 +33,14 @@
 #define IRQ_RESERVED_14         0x4000  // Bit 14 (high byte, bit 6) - reserved
 #define IRQ_RESERVED_15         0x8000  // Bit 15 (high byte, bit 7) - reserved
 
+// IRQ vector (IRQ_VECTOR register)
+// Jump table offset of the highest-priority pending cause that is not
+// masked: (bit + 1) * 2, so `LDX IRQ_VECTOR / JMP (table,X)` dispatches in
+// one read. Higher cause bits have higher priority. IRQ_VECTOR_NONE means
+// nothing is pending; table entry 0 takes that (spurious) case.
+#define IRQ_VECTOR_NONE         0x00
+#define IRQ_VECTOR_OF(bit)      (((bit) + 1) * 2)
+
 // Status register bits
 #define STATUS_IRQ_PENDING      0x02
 
@@ -55,5 +63,8 @@ void irq_set_mask_high(uint8_t mask);
 uint8_t irq_get_enable(void);
 void irq_set_enable(uint8_t enable);
 bool irq_is_pending(void);
+uint8_t irq_get_vector(void);
+uint8_t irq_acknowledge_vector(uint8_t vector);  // Clear the cause a vector was read for
+uint32_t irq_get_generation(void);     // Incremented on every IRQ state change
 
 #endif // IRQ_H
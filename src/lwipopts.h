@@ -16,7 +16,7 @@
 #define MEMP_MEM_MALLOC            0
 #define MEM_ALIGNMENT              4
 #define MEM_SIZE                   4000
-#define MEMP_NUM_PBUF              10
+#define MEMP_NUM_PBUF              16      // PBUF_REF per fragment span (FRAME_MAX_SPANS) + slack
 #define MEMP_NUM_UDP_PCB           6
 #define MEMP_NUM_TCP_PCB           10
 #define MEMP_NUM_TCP_PCB_LISTEN    8
@@ -27,7 +27,7 @@
 #define MEMP_NUM_IGMP_GROUP        8
 
 // Pbuf options
-#define PBUF_POOL_SIZE             10
+#define PBUF_POOL_SIZE             16      // Received datagrams, incl. remote writes held to a frame boundary
 #define PBUF_POOL_BUFSIZE          592
 
 // ARP options
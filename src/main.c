@@ -6,27 +6,97 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "pico/multicore.h"
+#include "pico/flash.h"
 #include "hardware/gpio.h"
 #include "hardware/pwm.h"
 #include "hardware/clocks.h"
+#include "hardware/irq.h"
 
 #include "hardware/gpio_mapping.h"
 #include "system/clock_control.h"
 #include "system/reset_control.h"
+#include "system/scheduler.h"
+#include "system/background.h"
+#include "system/snapshot.h"
+#ifdef CONFIG_MIA_TIMING_BENCH
+#include "system/timing_bench.h"
+#endif
 #include "rom_emulation/rom_emulator.h"
 #include "indexed_memory/indexed_memory.h"
+#include "indexed_memory/indexed_memory_dma.h"
 #include "bus_interface/bus_interface.h"
 #include "bus_interface/bus_sync_pio.h"
+#include "bus_interface/bus_timing.h"
+#include "bus_interface/bus_trace.h"
+#include "config/bus_config.h"
+#include "config/video_config.h"
+#include "config/irq_config.h"
+#include "config/memory_config.h"
+#ifdef CONFIG_MIA_PSRAM
+#include "indexed_memory/psram_cache.h"
+#endif
 #include "video/video_controller.h"
+#include "video/video_output.h"
 #include "usb/usb_controller.h"
 #include "network/wifi_controller.h"
+#include "network/memory_service.h"
+
+// Core 1 task periods: how often tasks without a wakeup event poll
+#define VIDEO_TASK_PERIOD_US    500     // Frame boundary check (latch jitter)
+#define USB_TASK_PERIOD_US      1000    // Between USB events (keyboard, trace, loader)
+#define CLOCK_TASK_PERIOD_US    1000    // IDX_CLOCK_CONTROL changes
+#define CONSOLE_TASK_PERIOD_US  20000   // Debug keys on the USB console
+
+// Core 1 stack in main SRAM, leaving SCRATCH_X to the index table
+// (BUS_INDEX_DATA). Only Core 0 writes it, remote memory writes included;
+// Core 1 tasks read a few fields (keyboard ring tail, clock speed, remote
+// index reads), a handful of loads per task period
+static uint32_t core1_stack[PICO_CORE1_STACK_SIZE / sizeof(uint32_t)];
+
+// Frame boundaries wake the Wi-Fi task to send the new frame
+static void video_task(void) {
+    static uint32_t frame_number;
+    video_controller_process();
+    uint32_t latched = video_controller_get_frame()->frame_number;
+    if (latched != frame_number) {
+        frame_number = latched;
+        scheduler_signal(SCHED_EVENT_FRAME);
+    }
+}
+
+#if defined(CONFIG_BUS_TIMING_STATS) || defined(CONFIG_BUS_TRACE)
+static void console_task(void) {
+    int key = getchar_timeout_us(0);
+#ifdef CONFIG_BUS_TIMING_STATS
+    // 't' on the USB console dumps the bus timing statistics
+    if (key == 't') {
+        bus_timing_dump(clock_get_hz(clk_sys));
+    }
+#endif
+#ifdef CONFIG_BUS_TRACE
+    // 'r' on the USB console starts/stops streaming the bus trace
+    if (key == 'r') {
+        bus_trace_set_enabled(!bus_trace_is_enabled());
+    }
+#endif
+}
+#endif
 
 // Core 1 entry point for video processing
 void supporting_functions_loop() {
+    // Core 0 pauses this core while it writes snapshots to flash
+    flash_safe_execute_core_init();
+    
     // Initialize video controller (Core 0 portion)
     video_controller_init();
     printf("[Video] Controller Initialized.\n");
     
+#ifdef CONFIG_VIDEO_LOCAL_OUTPUT
+    // Local VGA output (its line interrupt runs on this core)
+    video_output_init();
+    printf("[Video] Local output Initialized.\n");
+#endif
+    
     // // Initialize USB controller (mode detection and setup)
     usb_controller_init();
     printf("[USB] Controller Initialized.\n");
@@ -34,20 +104,89 @@ void supporting_functions_loop() {
     wifi_controller_init();
     printf("[Wi-Fi] Controller Initialized.\n");
 
-    while (true) {
-        video_controller_process();
-        usb_controller_process();
-        wifi_controller_process();
-        indexed_memory_process_copy_command();
-        
-        tight_loop_contents();
+    // Highest priority first
+    scheduler_init();
+    scheduler_add_task(video_task, 0, VIDEO_TASK_PERIOD_US);
+    scheduler_add_task(usb_controller_process, SCHED_EVENT_USB, USB_TASK_PERIOD_US);
+    scheduler_add_task(wifi_controller_process, SCHED_EVENT_FRAME, WIFI_POLL_INTERVAL_US);
+    scheduler_add_task(clock_control_process, 0, CLOCK_TASK_PERIOD_US);
+#if defined(CONFIG_BUS_TIMING_STATS) || defined(CONFIG_BUS_TRACE)
+    scheduler_add_task(console_task, 0, CONSOLE_TASK_PERIOD_US);
+#endif
+#ifdef CONFIG_MIA_TIMING_BENCH
+    // PHI2 sweep against the built-in 6502 test program
+    timing_bench_init(clock_get_hz(clk_sys));
+    scheduler_add_task(timing_bench_process, 0, TIMING_BENCH_TASK_PERIOD_US);
+#endif
+    
+    scheduler_run();
+}
+
+// Run the boot ROM until the boot loader has jumped to the kernel
+static void run_boot_sequence(void) {
+    while (rom_emulator_is_active()) {
+        // Handle ROM emulation during boot phase
+        rom_emulator_process();
+                
+        // Handle reset control
+        reset_control_process();
+    }
+}
+
+// CMD_SYSTEM_FAST_RESET: reboot the 6502 from the boot catalog entry
+// selected in the reset control index, without rebooting the Pico.
+// Core 1 (video, USB, Wi-Fi) keeps running.
+static void fast_reset(void) {
+    if (!indexed_memory_fast_reset_requested()) {
+        return;     // Cancelled by a factory reset
     }
+    
+    uint8_t image = indexed_memory_peek(IDX_RESET_CONTROL);
+    if (!rom_emulator_select_image(image)) {
+        printf("Boot image %u not in the catalog, keeping image %u\n", image, rom_emulator_get_image());
+    }
+    
+    // Hold the 6502 in reset first, then hand the bus to the boot ROM
+    rom_emulator_start_fast_boot();
+    bus_sync_pio_deinit();
+    irq_clear_all();
+    indexed_memory_restore_defaults();
+    
+    run_boot_sequence();
+    
+    bus_interface_init();
+    bus_sync_pio_init();
+    printf("Fast reset complete, bus interface reactivated\n");
+}
+
+// CMD_SNAPSHOT_SAVE: write MIA memory and state to flash with the 6502
+// clock held, once the copies queued before the command have landed
+static void save_snapshot(void) {
+    if (!indexed_memory_snapshot_requested()) {
+        return;
+    }
+    
+    do {
+        while (indexed_memory_dma_is_busy()) {
+        }
+        indexed_memory_process_copy_command();
+    } while (indexed_memory_dma_is_busy());
+    
+    clock_control_hold(true);
+    bool saved = snapshot_save();
+    clock_control_hold(false);
+    printf("Snapshot %s\n", saved ? "saved" : "failed");
+    
+    indexed_memory_snapshot_done();
 }
 
 int main() {
     // Initialize standard I/O
     stdio_init_all();
     
+    // USB stdio starts TinyUSB here, so its interrupt is on Core 0, below the bus
+    irq_set_priority(USBCTRL_IRQ, MIA_IRQ_PRIORITY_USB);
+    
     printf("MIA (Multifunction Interface Adapter) Starting...\n");
     
     // Initialize GPIO pin mappings
@@ -62,9 +201,26 @@ int main() {
     irq_init();
     printf("IRQ system initialized\n");
 
+    // Core 0 background work: copy batches, heavy shared commands, fast
+    // resets, PSRAM page promotion, snapshots and remote memory writes
+    background_init();
+    background_set_handler(BACKGROUND_WORK_COPY, indexed_memory_process_copy_command);
+    background_set_handler(BACKGROUND_WORK_COMMAND, indexed_memory_process_deferred_command);
+    background_set_handler(BACKGROUND_WORK_FAST_RESET, fast_reset);
+#ifdef CONFIG_MIA_PSRAM
+    background_set_handler(BACKGROUND_WORK_PSRAM, psram_cache_process);
+#endif
+    background_set_handler(BACKGROUND_WORK_SNAPSHOT, save_snapshot);
+    background_set_handler(BACKGROUND_WORK_REMOTE, memory_service_process);
+    
     // Initialize indexed memory system
     indexed_memory_init();
     printf("Indexed memory system initialized\n");
+    
+    // Memory and state of the last snapshot, before the kernel boots
+    if (snapshot_restore()) {
+        printf("Snapshot restored\n");
+    }
 
     // Initialize ROM emulator for boot phase
     rom_emulator_init();
@@ -75,18 +231,12 @@ int main() {
     printf("Starting boot sequence...\n");
     
     // Core 0 main loop - system control
-    while (rom_emulator_is_active()) {
-        // Handle ROM emulation during boot phase
-        rom_emulator_process();
-                
-        // Handle reset control
-        reset_control_process();
-    }
+    run_boot_sequence();
 
     printf("Boot sequence completed. Transitioning to normal operation...\n");
 
     // Launch Core 1 for video processing
-    multicore_launch_core1(supporting_functions_loop);
+    multicore_launch_core1_with_stack(supporting_functions_loop, core1_stack, sizeof(core1_stack));
     printf("Enabling Core 1 for Video, USB and Wi-Fi support\n");
 
     // Activate bus interface for normal MIA operations
@@ -95,8 +245,14 @@ int main() {
     bus_sync_pio_init();
     printf("Bus interface initialized\n");
 
+    // Core 0 main loop - background work between bus IRQs. 6502 writes
+    // queued by the bus IRQ handler are applied by the bus write IRQ, which
+    // preempts this loop, so they precede the commands and copies the 6502
+    // issues after them. The loop also pends it for shadow refreshes the bus
+    // has not picked up yet
     while (true) {
-        tight_loop_contents();
+        bus_sync_pio_poll_shadow();
+        background_run_next();
     }
     
     return 0;
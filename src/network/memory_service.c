@@ -0,0 +1,142 @@
+/**
+ * MIA Remote Memory Service Implementation
+ */
+
+#include "memory_service.h"
+#include "indexed_memory/indexed_memory.h"
+#include "bus_interface/bus_sync_pio.h"
+#include "system/background.h"
+#include <string.h>
+
+// Owned by Core 1, apart from the batch entries Core 0 reads while applying
+static memory_write_t queue[MEMORY_SERVICE_QUEUE_DEPTH];
+static uint8_t queue_head;          // Oldest pending write
+static uint8_t queue_count;
+
+// Handover: Core 1 sets batch and posts, Core 0 applies the batch oldest
+// first and sets applied, Core 1 answers them and clears both
+static volatile uint8_t batch;      // Writes from queue_head handed to Core 0
+static volatile bool applied;
+static memory_service_copy_t batch_copy;
+
+void memory_service_init(void) {
+    memset(queue, 0, sizeof(queue));
+    queue_head = 0;
+    queue_count = 0;
+    batch = 0;
+    applied = false;
+    batch_copy = NULL;
+}
+
+uint16_t memory_service_data_size(const memory_request_t *request) {
+    if (request->type == MEMORY_PACKET_INDEX_READ || request->type == MEMORY_PACKET_INDEX_WRITE) {
+        return (uint16_t)(request->length * INDEX_DESCRIPTOR_SIZE);
+    }
+    return request->length;
+}
+
+uint8_t memory_service_check(const memory_request_t *request, uint16_t data_size) {
+    uint32_t size;
+    switch (request->type) {
+        case MEMORY_PACKET_READ:
+        case MEMORY_PACKET_WRITE:
+            size = request->length;
+            if (size == 0 || size > MEMORY_SERVICE_MAX_DATA ||
+                !indexed_memory_get_range(request->address, size)) {
+                return MEMORY_STATUS_RANGE;
+            }
+            break;
+        case MEMORY_PACKET_INDEX_READ:
+        case MEMORY_PACKET_INDEX_WRITE:
+            size = (uint32_t)request->length * INDEX_DESCRIPTOR_SIZE;
+            if (request->length == 0 || size > MEMORY_SERVICE_MAX_DATA ||
+                request->address >= 256 || request->length > 256 - request->address) {
+                return MEMORY_STATUS_RANGE;
+            }
+            break;
+        default:
+            return MEMORY_STATUS_BAD_REQUEST;
+    }
+    
+    // Writes carry exactly their data, reads nothing
+    if (data_size != (memory_service_is_write(request) ? size : 0)) {
+        return MEMORY_STATUS_BAD_REQUEST;
+    }
+    return MEMORY_STATUS_OK;
+}
+
+void memory_service_read_indexes(const memory_request_t *request, uint8_t *data) {
+    for (uint16_t i = 0; i < request->length; i++) {
+        indexed_memory_get_descriptor((uint8_t)(request->address + i), data + i * INDEX_DESCRIPTOR_SIZE);
+    }
+}
+
+bool memory_service_queue_write(const memory_request_t *request, void *packet,
+                                uint32_t addr, uint16_t port) {
+    if (queue_count == MEMORY_SERVICE_QUEUE_DEPTH) {
+        return false;
+    }
+    memory_write_t *write = &queue[(queue_head + queue_count) % MEMORY_SERVICE_QUEUE_DEPTH];
+    write->request = *request;
+    write->packet = packet;
+    write->addr = addr;
+    write->port = port;
+    queue_count++;
+    return true;
+}
+
+uint8_t memory_service_pending(void) {
+    return queue_count;
+}
+
+bool memory_service_start_apply(memory_service_copy_t copy) {
+    if (queue_count == 0 || batch != 0) {
+        return false;
+    }
+    batch_copy = copy;
+    __atomic_store_n(&batch, queue_count, __ATOMIC_RELEASE);
+    background_post(BACKGROUND_WORK_REMOTE);
+    return true;
+}
+
+static void apply_write(const memory_write_t *write) {
+    const memory_request_t *request = &write->request;
+    if (request->type == MEMORY_PACKET_WRITE) {
+        // Straight from the datagram into place
+        batch_copy(write->packet, indexed_memory_get_range(request->address, request->length),
+                   request->length, sizeof(memory_request_t));
+        indexed_memory_mark_video_dirty_range(request->address, request->length);
+        indexed_memory_notify_write();
+    } else {
+        uint8_t desc[INDEX_DESCRIPTOR_SIZE];
+        for (uint16_t i = 0; i < request->length; i++) {
+            batch_copy(write->packet, desc, INDEX_DESCRIPTOR_SIZE,
+                       sizeof(memory_request_t) + i * INDEX_DESCRIPTOR_SIZE);
+            bus_sync_pio_load_descriptor((uint8_t)(request->address + i), desc);
+        }
+    }
+}
+
+void memory_service_process(void) {
+    uint8_t count = __atomic_load_n(&batch, __ATOMIC_ACQUIRE);
+    if (count == 0 || applied) {
+        return;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        apply_write(&queue[(queue_head + i) % MEMORY_SERVICE_QUEUE_DEPTH]);
+    }
+    __atomic_store_n(&applied, true, __ATOMIC_RELEASE);
+}
+
+bool memory_service_take_done(memory_write_t *done) {
+    if (!__atomic_load_n(&applied, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *done = queue[queue_head];
+    queue_head = (queue_head + 1) % MEMORY_SERVICE_QUEUE_DEPTH;
+    queue_count--;
+    if (--batch == 0) {
+        applied = false;
+    }
+    return true;
+}
@@ -0,0 +1,132 @@
+/**
+ * MIA Remote Memory Service
+ *
+ * Reads and patches MIA memory and the index table of a running machine
+ * over Wi-Fi without stopping the 6502: a live debugger in place of printf
+ * over the USB console, and a fast way to push character tables, palettes
+ * and other assets from a development machine.
+ *
+ * Requests are UDP datagrams to WIFI_MEMORY_PORT: a memory_request_t, then
+ * for writes the data. Every request is answered with its own header (type
+ * with MEMORY_PACKET_REPLY set, status filled in, tag echoed), then for
+ * successful reads the data:
+ *   MEMORY_PACKET_READ         length bytes from MIA address
+ *   MEMORY_PACKET_WRITE        length bytes to MIA address
+ *   MEMORY_PACKET_INDEX_READ   length index descriptors from index address
+ *   MEMORY_PACKET_INDEX_WRITE  length index descriptors to index address
+ * Index descriptors are INDEX_DESCRIPTOR_SIZE bytes in the
+ * CMD_LOAD_DESCRIPTOR layout. A request and its reply each fit in one
+ * datagram (MEMORY_SERVICE_MAX_DATA bytes of data).
+ *
+ * Reads are answered at once, sent straight from MIA memory: a live view,
+ * where bytes the 6502 changes during the send may show either value.
+ * Writes keep their received datagram, with no copy, until the next frame
+ * boundary. There Core 1 hands all pending writes to Core 0
+ * (BACKGROUND_WORK_REMOTE), which owns the index table and applies them in
+ * arrival order between bus cycles, so the 6502 and the video stream see
+ * them at the start of the frame. Index descriptors go through the bus
+ * write queue consumer (bus_sync_pio_load_descriptor()), in order with the
+ * 6502's own writes. Video area writes go out with the next frame. A write
+ * is answered once Core 0 has applied it, or at once with
+ * MEMORY_STATUS_BUSY when MEMORY_SERVICE_QUEUE_DEPTH writes are already
+ * pending. Requests that are malformed or out of range change nothing.
+ */
+
+#ifndef MEMORY_SERVICE_H
+#define MEMORY_SERVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "wifi_controller.h"
+
+#define MEMORY_SERVICE_QUEUE_DEPTH  4   // Pending writes (each holds its received pbufs)
+
+// Request types (memory_request_t.type)
+#define MEMORY_PACKET_READ          0x20
+#define MEMORY_PACKET_WRITE         0x21
+#define MEMORY_PACKET_INDEX_READ    0x22
+#define MEMORY_PACKET_INDEX_WRITE   0x23
+#define MEMORY_PACKET_REPLY         0x80    // Set in the type of replies
+
+// Reply status (memory_request_t.status)
+#define MEMORY_STATUS_OK            0x00
+#define MEMORY_STATUS_BAD_REQUEST   0x01    // Unknown type, or length and data disagree
+#define MEMORY_STATUS_RANGE         0x02    // Outside MIA memory or the index table, or too long
+#define MEMORY_STATUS_BUSY          0x03    // Write queue full, send again
+
+typedef struct {
+    uint8_t type;               // MEMORY_PACKET_*
+    uint8_t status;             // MEMORY_STATUS_* (replies)
+    uint16_t length;            // Bytes, or descriptors for index requests
+    uint32_t address;           // MIA address, or first index
+    uint32_t tag;               // Echoed in the reply
+} memory_request_t;
+
+_Static_assert(sizeof(memory_request_t) == 12, "memory_request_t must be 12 bytes");
+
+#define MEMORY_SERVICE_MAX_DATA     (VIDEO_STREAM_PACKET_MAX - sizeof(memory_request_t))
+
+// A write waiting for the frame boundary
+typedef struct {
+    memory_request_t request;
+    void *packet;               // Received datagram holding the data (a pbuf)
+    uint32_t addr;              // Client IPv4 address (as stored by lwIP)
+    uint16_t port;
+} memory_write_t;
+
+// Reads the data of a held datagram: length bytes at offset into dst
+typedef void (*memory_service_copy_t)(void *packet, void *dst, uint16_t length, uint16_t offset);
+
+// Drop all pending writes (their packets must already be freed)
+void memory_service_init(void);
+
+/**
+ * Check a request before serving or queueing it
+ *
+ * @param data_size Datagram bytes after the header
+ * @return MEMORY_STATUS_*
+ */
+uint8_t memory_service_check(const memory_request_t *request, uint16_t data_size);
+
+// Data bytes of the request (writes) or of its reply (reads)
+uint16_t memory_service_data_size(const memory_request_t *request);
+
+static inline bool memory_service_is_write(const memory_request_t *request) {
+    return request->type == MEMORY_PACKET_WRITE || request->type == MEMORY_PACKET_INDEX_WRITE;
+}
+
+// Descriptors of a checked MEMORY_PACKET_INDEX_READ, into data
+void memory_service_read_indexes(const memory_request_t *request, uint8_t *data);
+
+/**
+ * Hold a checked write until the next frame boundary
+ *
+ * @return false if the queue is full (the caller still owns packet)
+ */
+bool memory_service_queue_write(const memory_request_t *request, void *packet,
+                                uint32_t addr, uint16_t port);
+
+// Writes not answered yet (waiting, or being applied by Core 0)
+uint8_t memory_service_pending(void);
+
+/**
+ * Hand the pending writes to Core 0 (Core 1, at a frame boundary)
+ * Writes queued later wait for the next boundary
+ *
+ * @param copy Reads the data out of the held datagrams (on Core 0)
+ * @return false if nothing is pending or the last batch is still applying
+ */
+bool memory_service_start_apply(memory_service_copy_t copy);
+
+// Apply the batch handed over (Core 0 background work, BACKGROUND_WORK_REMOTE)
+void memory_service_process(void);
+
+/**
+ * Take the oldest write Core 0 has applied (Core 1)
+ *
+ * @param done Receives the write, for its reply and to free its packet
+ * @return false when no applied write is left
+ */
+bool memory_service_take_done(memory_write_t *done);
+
+#endif // MEMORY_SERVICE_H
@@ -0,0 +1,116 @@
+/**
+ * MIA Video Client Table Implementation
+ * Subscriber bookkeeping and per-client rate adaptation
+ */
+
+#include "video_clients.h"
+#include <string.h>
+
+static video_client_t clients[WIFI_MAX_CLIENTS];
+
+void video_clients_init(void) {
+    memset(clients, 0, sizeof(clients));
+}
+
+video_client_t *video_clients_find(uint32_t addr, uint16_t port) {
+    for (uint8_t i = 0; i < WIFI_MAX_CLIENTS; i++) {
+        if (clients[i].active && clients[i].addr == addr && clients[i].port == port) {
+            return &clients[i];
+        }
+    }
+    return NULL;
+}
+
+video_client_t *video_clients_subscribe(uint32_t addr, uint16_t port, uint32_t now_ms, bool *added) {
+    video_client_t *client = video_clients_find(addr, port);
+    *added = false;
+    
+    if (!client) {
+        for (uint8_t i = 0; i < WIFI_MAX_CLIENTS && !client; i++) {
+            if (!clients[i].active) {
+                client = &clients[i];
+            }
+        }
+        if (!client) {
+            return NULL;
+        }
+        memset(client, 0, sizeof(*client));
+        client->addr = addr;
+        client->port = port;
+        client->active = true;
+        *added = true;
+    }
+    
+    client->last_seen_ms = now_ms;
+    return client;
+}
+
+void video_clients_unsubscribe(uint32_t addr, uint16_t port) {
+    video_client_t *client = video_clients_find(addr, port);
+    if (client) {
+        client->active = false;
+    }
+}
+
+void video_clients_ack(uint32_t addr, uint16_t port, uint32_t sequence, uint32_t now_ms) {
+    video_client_t *client = video_clients_find(addr, port);
+    if (!client) {
+        return;
+    }
+    
+    // Ignore stale (reordered) acknowledgements
+    if (!client->acking || (int32_t)(sequence - client->acked) > 0) {
+        client->acked = sequence;
+    }
+    client->acking = true;
+    client->last_seen_ms = now_ms;
+}
+
+void video_clients_expire(uint32_t now_ms) {
+    for (uint8_t i = 0; i < WIFI_MAX_CLIENTS; i++) {
+        if (clients[i].active && now_ms - clients[i].last_seen_ms >= VIDEO_CLIENT_TIMEOUT_MS) {
+            clients[i].active = false;
+        }
+    }
+}
+
+uint32_t video_clients_frame_mask(uint32_t sequence, bool keyframe) {
+    uint32_t mask = 0;
+    
+    for (uint8_t i = 0; i < WIFI_MAX_CLIENTS; i++) {
+        video_client_t *client = &clients[i];
+        if (!client->active) {
+            continue;
+        }
+        
+        if (client->acking) {
+            uint32_t lag = client->sent - client->acked;
+            if (!client->throttled && lag > VIDEO_CLIENT_MAX_LAG) {
+                client->throttled = true;
+            } else if (client->throttled && keyframe && lag == 0) {
+                // Caught up: deltas apply again from this keyframe on
+                client->throttled = false;
+            }
+        }
+        
+        if (!client->throttled || keyframe) {
+            client->sent = sequence;
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+uint32_t video_clients_active_mask(void) {
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < WIFI_MAX_CLIENTS; i++) {
+        if (clients[i].active) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+video_client_t *video_clients_get(uint8_t slot) {
+    return slot < WIFI_MAX_CLIENTS ? &clients[slot] : NULL;
+}
@@ -0,0 +1,64 @@
+/**
+ * MIA Video Client Table
+ * 
+ * Display clients subscribed to the video stream. Every frame is encoded
+ * once and the same datagrams are sent to each client (unicast fan-out).
+ * 
+ * Clients subscribe with VIDEO_PACKET_SUBSCRIBE and repeat it at least every
+ * VIDEO_CLIENT_TIMEOUT_MS, or are dropped. Clients that acknowledge frames
+ * (VIDEO_PACKET_ACK) are throttled when they fall more than
+ * VIDEO_CLIENT_MAX_LAG frames behind: they get keyframes only, which are
+ * complete on their own, and go back to every frame at the first keyframe
+ * after they have acknowledged everything sent to them. Clients that never
+ * acknowledge are never throttled.
+ */
+
+#ifndef VIDEO_CLIENTS_H
+#define VIDEO_CLIENTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "wifi_controller.h"
+
+#define VIDEO_CLIENT_TIMEOUT_MS     5000
+#define VIDEO_CLIENT_MAX_LAG        4       // Frames sent but not acknowledged
+
+typedef struct {
+    uint32_t addr;              // IPv4 address (as stored by lwIP)
+    uint16_t port;
+    bool active;
+    bool acking;                // Sent at least one VIDEO_PACKET_ACK
+    bool throttled;             // Keyframes only
+    uint32_t sent;              // Last frame sequence sent to the client
+    uint32_t acked;             // Last frame sequence acknowledged
+    uint32_t last_seen_ms;
+} video_client_t;
+
+void video_clients_init(void);
+
+/**
+ * Add a client or refresh an existing one
+ * @return The client, or NULL if the table is full
+ */
+video_client_t *video_clients_subscribe(uint32_t addr, uint16_t port, uint32_t now_ms, bool *added);
+
+void video_clients_unsubscribe(uint32_t addr, uint16_t port);
+void video_clients_ack(uint32_t addr, uint16_t port, uint32_t sequence, uint32_t now_ms);
+
+// Drop clients not heard from for VIDEO_CLIENT_TIMEOUT_MS
+void video_clients_expire(uint32_t now_ms);
+
+video_client_t *video_clients_find(uint32_t addr, uint16_t port);
+
+/**
+ * Bit per client (table slot) to send frame sequence to
+ * Updates throttling and records the frame as sent to those clients
+ */
+uint32_t video_clients_frame_mask(uint32_t sequence, bool keyframe);
+
+// Bit per active client (assets, manifests)
+uint32_t video_clients_active_mask(void);
+
+video_client_t *video_clients_get(uint8_t slot);
+
+#endif // VIDEO_CLIENTS_H
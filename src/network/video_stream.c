@@ -0,0 +1,62 @@
+/**
+ * MIA Video Stream Packetiser
+ * Splits the dirty spans of a latched frame into MTU-sized fragments
+ */
+
+#include "video_stream.h"
+
+void video_stream_begin(video_stream_cursor_t *cursor) {
+    cursor->block = 0;
+    cursor->offset = 0;
+    cursor->length = 0;
+    cursor->first = true;
+}
+
+bool video_stream_next_fragment(const video_frame_t *frame, video_stream_cursor_t *cursor,
+                                frame_span_t *spans, uint8_t *span_count, uint16_t *data_size) {
+    uint32_t used = FRAME_HEADER_SIZE;
+    uint8_t count = 0;
+    
+    while (count < FRAME_MAX_SPANS) {
+        if (cursor->length == 0 &&
+            !video_controller_next_dirty_span(frame, &cursor->block, &cursor->offset, &cursor->length)) {
+            break;
+        }
+        
+        // Room for a table entry and at least one byte
+        if (used + sizeof(frame_span_t) >= VIDEO_STREAM_PACKET_MAX) {
+            break;
+        }
+        uint32_t room = VIDEO_STREAM_PACKET_MAX - used - sizeof(frame_span_t);
+        uint16_t take = cursor->length < room ? cursor->length : (uint16_t)room;
+        
+        spans[count].offset = cursor->offset;
+        spans[count].length = take;
+        count++;
+        used += sizeof(frame_span_t) + take;
+        cursor->offset += take;
+        cursor->length -= take;
+    }
+    
+    if (count == 0 && !cursor->first) {
+        return false;
+    }
+    cursor->first = false;
+    *span_count = count;
+    *data_size = (uint16_t)(used - FRAME_HEADER_SIZE - count * sizeof(frame_span_t));
+    return true;
+}
+
+uint32_t video_stream_count_fragments(const video_frame_t *frame) {
+    video_stream_cursor_t cursor;
+    frame_span_t spans[FRAME_MAX_SPANS];
+    uint8_t span_count;
+    uint16_t data_size;
+    uint32_t fragments = 0;
+    
+    video_stream_begin(&cursor);
+    while (video_stream_next_fragment(frame, &cursor, spans, &span_count, &data_size)) {
+        fragments++;
+    }
+    return fragments;
+}
@@ -0,0 +1,137 @@
+/**
+ * MIA Video Stream Format
+ * 
+ * Wire format of the video frames sent to the display clients, and the
+ * packetiser that splits a latched frame into datagrams.
+ * 
+ * A frame is sent as fragment_count datagrams of at most
+ * VIDEO_STREAM_PACKET_MAX bytes (one CYW43 Ethernet frame, no IP
+ * fragmentation). Each datagram is a frame_header_t, a table of span_count
+ * frame_span_t entries, then the data of each span in table order. Spans are
+ * byte ranges of the frame data (VIDEO_FRAME_DATA_OFFSET onwards in
+ * video_memory_t: all nametables, all palette tables, OAM).
+ * 
+ * Every fragment stands on its own: clients keep a copy of the frame data,
+ * apply the spans of each fragment as it arrives and display the tables of
+ * buffer_set, through the scroll_x/scroll_y viewport, once all fragments of
+ * a sequence number are in. A lost fragment
+ * only leaves its spans stale until they are written again or the next
+ * keyframe (FRAME_FLAG_KEYFRAME, all of the frame data) arrives.
+ * 
+ * Character tables and palette banks (assets) are not part of frames. They
+ * are uploaded (VIDEO_PACKET_ASSET) only when their content hash changes,
+ * and a manifest (VIDEO_PACKET_MANIFEST) lists the hash of every asset. Each
+ * frame carries the hash of the manifest it is drawn with, so clients that
+ * already hold the right assets, e.g. after a reconnect, need nothing else.
+ */
+
+#ifndef VIDEO_STREAM_H
+#define VIDEO_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "video/video_controller.h"
+
+// Datagram sizing: CYW43 Ethernet MTU less the IPv4 and UDP headers
+#define VIDEO_STREAM_MTU            1500
+#define VIDEO_STREAM_PACKET_MAX     (VIDEO_STREAM_MTU - 20 - 8)
+
+#define FRAME_HEADER_SIZE           24
+#define FRAME_MAX_SPANS             8       // Spans per fragment (one PBUF_REF each)
+#define VIDEO_STREAM_KEYFRAME_INTERVAL 30   // Frames between keyframes (1 s)
+
+// Datagram types (first byte of every datagram)
+#define VIDEO_PACKET_FRAME          0x01
+#define VIDEO_PACKET_ASSET          0x02
+#define VIDEO_PACKET_MANIFEST       0x03
+
+// Client to MIA datagrams (client_packet_t, see video_clients.h)
+#define VIDEO_PACKET_SUBSCRIBE      0x10    // Start or keep receiving the stream
+#define VIDEO_PACKET_UNSUBSCRIBE    0x11
+#define VIDEO_PACKET_ACK            0x12    // sequence: last frame fully received
+#define VIDEO_PACKET_ASSET_REQUEST  0x13    // asset: id missing from the client cache
+
+// Header flags
+#define FRAME_FLAG_KEYFRAME         0x01    // The spans cover all of the frame data
+
+typedef struct {
+    uint8_t type;               // VIDEO_PACKET_FRAME
+    uint8_t flags;              // FRAME_FLAG_*
+    uint8_t fragment_index;     // 0 to fragment_count - 1
+    uint8_t fragment_count;
+    uint32_t sequence;          // Sent frame number, +1 per frame (gaps = lost frames)
+    uint32_t timestamp;         // Send time, microseconds since boot (low 32 bits)
+    uint32_t asset_manifest;    // Manifest hash of the assets the frame is drawn with
+    uint16_t payload_size;      // Bytes after the header in this datagram
+    uint8_t buffer_set;         // Tables to display (IDX_ACTIVE_FRAME)
+    uint8_t span_count;         // frame_span_t entries in this datagram
+    uint16_t scroll_x;          // Viewport into the buffer set's plane (video_frame_t)
+    uint16_t scroll_y;
+} frame_header_t;
+
+_Static_assert(sizeof(frame_header_t) == FRAME_HEADER_SIZE, "frame_header_t must be 24 bytes");
+
+typedef struct {
+    uint16_t offset;            // Byte offset into the frame data
+    uint16_t length;
+} frame_span_t;
+
+// Asset upload: one datagram per chunk of an asset (character table ids
+// 0-7, palette bank ids 8-23), followed by length bytes at offset
+typedef struct {
+    uint8_t type;               // VIDEO_PACKET_ASSET
+    uint8_t asset;
+    uint16_t offset;
+    uint32_t hash;              // Content hash of the whole asset
+    uint16_t length;
+    uint16_t total_size;
+} asset_header_t;
+
+_Static_assert(sizeof(asset_header_t) == 12, "asset_header_t must be 12 bytes");
+
+// Asset manifest: followed by count uint32_t asset hashes, in asset order
+typedef struct {
+    uint8_t type;               // VIDEO_PACKET_MANIFEST
+    uint8_t count;
+    uint16_t reserved;
+    uint32_t manifest;          // Hash of the hash list (frame_header_t.asset_manifest)
+} manifest_header_t;
+
+typedef struct {
+    uint8_t type;               // VIDEO_PACKET_SUBSCRIBE to VIDEO_PACKET_ASSET_REQUEST
+    uint8_t asset;
+    uint16_t reserved;
+    uint32_t sequence;
+} client_packet_t;
+
+// Packetiser position within a frame's dirty spans
+typedef struct {
+    uint32_t block;             // Next dirty block to look at
+    uint16_t offset;            // Part of the current span not sent yet
+    uint16_t length;
+    bool first;                 // No fragment produced yet
+} video_stream_cursor_t;
+
+/**
+ * Start packetising a frame
+ */
+void video_stream_begin(video_stream_cursor_t *cursor);
+
+/**
+ * Fill the span table of the next fragment
+ * Spans are split where the datagram is full. The first fragment of a frame
+ * with nothing dirty has no spans (it still carries the buffer set).
+ * @param spans Receives up to FRAME_MAX_SPANS entries
+ * @param span_count Receives the number of entries
+ * @param data_size Receives the total span length
+ * @return false when the frame has no fragments left
+ */
+bool video_stream_next_fragment(const video_frame_t *frame, video_stream_cursor_t *cursor,
+                                frame_span_t *spans, uint8_t *span_count, uint16_t *data_size);
+
+/**
+ * Number of fragments video_stream_next_fragment() produces for a frame
+ */
+uint32_t video_stream_count_fragments(const video_frame_t *frame);
+
+#endif // VIDEO_STREAM_H
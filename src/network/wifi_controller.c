@@ -4,15 +4,163 @@
  */
 
 #include "wifi_controller.h"
+#include "video_clients.h"
+#include "memory_service.h"
 #include "video/video_controller.h"
+#include "indexed_memory/indexed_memory.h"
 #include "pico/cyw43_arch.h"
+#include "lwip/pbuf.h"
 #include "lwip/udp.h"
 #include "pico/time.h"
+#include <string.h>
 
 static wifi_state_t current_state = WIFI_STATE_DISCONNECTED;
 static struct udp_pcb *udp_pcb = NULL;
-static absolute_time_t last_frame_time;
-static uint32_t frame_count = 0;
+static uint32_t frame_count = 0;       // Frames sent completely
+static uint32_t frame_sequence = 0;    // Frames started (frame_header_t.sequence)
+static bool keyframe_requested = false;
+static uint32_t assets_pending = 0;    // Bit per asset to upload (VIDEO_ASSETS)
+static bool manifest_pending = false;
+static struct udp_pcb *memory_pcb = NULL;
+static uint32_t memory_frame = 0;      // Frame number pending writes were last applied at
+
+/**
+ * Client datagrams: subscriptions, acknowledgements and asset requests
+ * (client_packet_t, see video_clients.h)
+ */
+static void client_packet_received(void *arg, struct udp_pcb *pcb, struct pbuf *p,
+                                   const ip_addr_t *addr, u16_t port) {
+    (void)arg;
+    (void)pcb;
+    client_packet_t packet;
+    if (p->tot_len < sizeof(packet)) {
+        pbuf_free(p);
+        return;
+    }
+    pbuf_copy_partial(p, &packet, sizeof(packet), 0);
+    pbuf_free(p);
+    
+    uint32_t ip = ip4_addr_get_u32(ip_2_ip4(addr));
+    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+    bool added;
+    
+    switch (packet.type) {
+        case VIDEO_PACKET_SUBSCRIBE:
+            // A new client needs the whole frame; it asks for missing assets
+            if (video_clients_subscribe(ip, port, now_ms, &added) && added) {
+                keyframe_requested = true;
+            }
+            break;
+        case VIDEO_PACKET_UNSUBSCRIBE:
+            video_clients_unsubscribe(ip, port);
+            break;
+        case VIDEO_PACKET_ACK:
+            video_clients_ack(ip, port, packet.sequence, now_ms);
+            break;
+        case VIDEO_PACKET_ASSET_REQUEST:
+            if (video_clients_find(ip, port) && packet.asset < VIDEO_ASSETS) {
+                assets_pending |= 1u << packet.asset;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Chain a PBUF_REF to p, pointing straight into MIA memory, so Core 1 never
+ * copies frame or asset data (the CYW43 driver reads it from there while
+ * sending). PBUF_REF, not PBUF_ROM, tells lwIP the memory may change, so
+ * anything it has to queue is copied first.
+ */
+static bool chain_ref(struct pbuf *p, const uint8_t *data, uint16_t length) {
+    struct pbuf *ref = pbuf_alloc(PBUF_RAW, length, PBUF_REF);
+    if (!ref) {
+        return false;
+    }
+    ref->payload = (void *)data;
+    pbuf_cat(p, ref);
+    return true;
+}
+
+/**
+ * Answer a memory request: its header with the reply type and status, then
+ * the data of successful reads (see memory_service.h)
+ */
+static void send_memory_reply(const memory_request_t *request, uint8_t status,
+                              const ip_addr_t *addr, u16_t port) {
+    memory_request_t reply = *request;
+    reply.type |= MEMORY_PACKET_REPLY;
+    reply.status = status;
+    
+    bool index_read = status == MEMORY_STATUS_OK && request->type == MEMORY_PACKET_INDEX_READ;
+    uint16_t size = sizeof(reply) + (index_read ? memory_service_data_size(request) : 0);
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
+    if (!p) {
+        return;
+    }
+    memcpy(p->payload, &reply, sizeof(reply));
+    if (index_read) {
+        memory_service_read_indexes(request, (uint8_t *)p->payload + sizeof(reply));
+    } else if (status == MEMORY_STATUS_OK && request->type == MEMORY_PACKET_READ &&
+               !chain_ref(p, indexed_memory_get_range(request->address, request->length), request->length)) {
+        pbuf_free(p);
+        return;
+    }
+    udp_sendto(memory_pcb, p, addr, port);
+    pbuf_free(p);
+}
+
+/**
+ * Memory requests (memory_request_t): reads are answered now, writes keep
+ * their pbuf until the next frame boundary (apply_memory_writes())
+ */
+static void memory_packet_received(void *arg, struct udp_pcb *pcb, struct pbuf *p,
+                                   const ip_addr_t *addr, u16_t port) {
+    (void)arg;
+    (void)pcb;
+    memory_request_t request;
+    if (p->tot_len < sizeof(request)) {
+        pbuf_free(p);
+        return;
+    }
+    pbuf_copy_partial(p, &request, sizeof(request), 0);
+    
+    uint8_t status = memory_service_check(&request, p->tot_len - sizeof(request));
+    if (status == MEMORY_STATUS_OK && memory_service_is_write(&request)) {
+        if (memory_service_queue_write(&request, p, ip4_addr_get_u32(ip_2_ip4(addr)), port)) {
+            return;
+        }
+        status = MEMORY_STATUS_BUSY;
+    }
+    pbuf_free(p);
+    send_memory_reply(&request, status, addr, port);
+}
+
+static void copy_from_pbuf(void *packet, void *dst, uint16_t length, uint16_t offset) {
+    pbuf_copy_partial((struct pbuf *)packet, dst, length, offset);
+}
+
+/**
+ * Answer and free the memory writes Core 0 has applied, and hand the
+ * pending ones to it once per frame boundary
+ */
+static void apply_memory_writes(void) {
+    memory_write_t write;
+    while (memory_service_take_done(&write)) {
+        ip_addr_t addr;
+        ip_addr_set_ip4_u32(&addr, write.addr);
+        send_memory_reply(&write.request, MEMORY_STATUS_OK, &addr, write.port);
+        pbuf_free((struct pbuf *)write.packet);
+    }
+    
+    uint32_t frame = video_controller_get_frame()->frame_number;
+    if (frame == memory_frame) {
+        return;
+    }
+    memory_frame = frame;
+    memory_service_start_apply(copy_from_pbuf);
+}
 
 void wifi_controller_init(void) {
     // Initialize CYW43 Wi-Fi chip
@@ -24,23 +172,50 @@ void wifi_controller_init(void) {
     // Enable station mode
     cyw43_arch_enable_sta_mode();
     
+    // Video stream socket: clients subscribe to it, frames are sent from it
+    video_clients_init();
+    udp_pcb = udp_new();
+    if (udp_pcb) {
+        udp_bind(udp_pcb, IP_ANY_TYPE, WIFI_VIDEO_PORT);
+        udp_recv(udp_pcb, client_packet_received, NULL);
+    }
+    
+    // Remote memory access (memory_service.h)
+    memory_service_init();
+    memory_pcb = udp_new();
+    if (memory_pcb) {
+        udp_bind(memory_pcb, IP_ANY_TYPE, WIFI_MEMORY_PORT);
+        udp_recv(memory_pcb, memory_packet_received, NULL);
+    }
+    memory_frame = video_controller_get_frame()->frame_number;
+    
     current_state = WIFI_STATE_DISCONNECTED;
-    last_frame_time = get_absolute_time();
     frame_count = 0;
+    frame_sequence = 0;
+    keyframe_requested = true;
+    assets_pending = 0;
+    manifest_pending = true;
 }
 
 void wifi_controller_process(void) {
-    // Check if it's time to transmit a new frame
+    // Runs on Core 1 as soon as a frame is latched (SCHED_EVENT_FRAME), so
+    // each one is sent without waiting for a fixed timer, and every
+    // WIFI_POLL_INTERVAL_US for client packets and lwIP timers
     absolute_time_t current_time = get_absolute_time();
     
-    if (absolute_time_diff_us(last_frame_time, current_time) >= (WIFI_FRAME_INTERVAL_MS * 1000)) {
-        if (current_state == WIFI_STATE_CONNECTED && video_controller_is_frame_ready()) {
-            wifi_controller_transmit_frame();
-            last_frame_time = current_time;
+    // Remote writes land between frames
+    apply_memory_writes();
+    
+    if (current_state == WIFI_STATE_CONNECTED && video_controller_is_frame_ready()) {
+        // A frame that could not be sent keeps its changes for the next
+        if (wifi_controller_transmit_frame()) {
+            video_controller_release_frame();
         }
     }
     
-    // Process network stack
+    // Process network stack: right after a send this pushes the frame out
+    // (or frees pbufs for a retry)
+    video_clients_expire(to_ms_since_boot(current_time));
     cyw43_arch_poll();
 }
 
@@ -52,44 +227,227 @@ bool wifi_controller_is_connected(void) {
     return current_state == WIFI_STATE_CONNECTED;
 }
 
-void wifi_controller_transmit_frame(void) {
+/**
+ * Send a datagram to every client in mask, then free it
+ * 
+ * Datagrams are built once per frame and shared by all clients. Their first
+ * pbuf is PBUF_RAW (no headroom), so udp_sendto() chains its headers in a
+ * new pbuf on every send instead of writing them into ours. A failed send
+ * is treated like a lost datagram.
+ */
+static void send_to_clients(struct pbuf *p, uint32_t mask) {
+    while (mask) {
+        uint8_t slot = (uint8_t)__builtin_ctz(mask);
+        mask &= mask - 1;
+        const video_client_t *client = video_clients_get(slot);
+        ip_addr_t addr;
+        ip_addr_set_ip4_u32(&addr, client->addr);
+        udp_sendto(udp_pcb, p, &addr, client->port);
+    }
+    pbuf_free(p);
+}
+
+/**
+ * Build one fragment: header and span table, then a PBUF_REF per span
+ */
+static struct pbuf *build_fragment(const video_frame_t *frame, const frame_header_t *header,
+                                   const frame_span_t *spans) {
+    uint16_t table_size = header->span_count * sizeof(frame_span_t);
+    struct pbuf *head = pbuf_alloc(PBUF_RAW, sizeof(frame_header_t) + table_size, PBUF_RAM);
+    if (!head) {
+        return NULL;
+    }
+    memcpy(head->payload, header, sizeof(frame_header_t));
+    memcpy((uint8_t *)head->payload + sizeof(frame_header_t), spans, table_size);
+    
+    for (uint8_t i = 0; i < header->span_count; i++) {
+        if (!chain_ref(head, frame->data + spans[i].offset, spans[i].length)) {
+            pbuf_free(head);
+            return NULL;
+        }
+    }
+    return head;
+}
+
+/**
+ * Upload one asset to the clients in mask, in datagram-sized chunks
+ */
+static bool transmit_asset(uint8_t asset, uint32_t mask) {
+    uint16_t size;
+    const uint8_t *data = video_controller_get_asset(asset, &size);
+    
+    asset_header_t header;
+    header.type = VIDEO_PACKET_ASSET;
+    header.asset = asset;
+    header.hash = video_controller_get_asset_hash(asset);
+    header.total_size = size;
+    
+    for (uint16_t offset = 0; offset < size; offset += header.length) {
+        header.offset = offset;
+        header.length = size - offset;
+        if (header.length > VIDEO_STREAM_PACKET_MAX - sizeof(header)) {
+            header.length = VIDEO_STREAM_PACKET_MAX - sizeof(header);
+        }
+        
+        struct pbuf *head = pbuf_alloc(PBUF_RAW, sizeof(header), PBUF_RAM);
+        if (!head) {
+            return false;
+        }
+        memcpy(head->payload, &header, sizeof(header));
+        if (!chain_ref(head, data + offset, header.length)) {
+            pbuf_free(head);
+            return false;
+        }
+        send_to_clients(head, mask);
+    }
+    return true;
+}
+
+/**
+ * Send the hash of every asset to the clients in mask
+ */
+static bool transmit_manifest(uint32_t manifest, uint32_t mask) {
+    manifest_header_t header = {
+        .type = VIDEO_PACKET_MANIFEST,
+        .count = VIDEO_ASSETS,
+        .reserved = 0,
+        .manifest = manifest,
+    };
+    uint32_t hashes[VIDEO_ASSETS];
+    for (uint8_t asset = 0; asset < VIDEO_ASSETS; asset++) {
+        hashes[asset] = video_controller_get_asset_hash(asset);
+    }
+    
+    struct pbuf *p = pbuf_alloc(PBUF_RAW, sizeof(header) + sizeof(hashes), PBUF_RAM);
+    if (!p) {
+        return false;
+    }
+    memcpy(p->payload, &header, sizeof(header));
+    memcpy((uint8_t *)p->payload + sizeof(header), hashes, sizeof(hashes));
+    send_to_clients(p, mask);
+    return true;
+}
+
+/**
+ * Send the latched front frame (see video_stream.h for the format)
+ * 
+ * The frame is encoded once and fanned out to the subscribed clients;
+ * throttled clients only get keyframes. All fragments go out back to back
+ * from here, so the cyw43_arch_poll() that follows in
+ * wifi_controller_process() flushes the whole frame.
+ */
+bool wifi_controller_transmit_frame(void) {
     if (!udp_pcb || current_state != WIFI_STATE_CONNECTED) {
-        return;
+        return false;
+    }
+    uint32_t active = video_clients_active_mask();
+    if (!active) {
+        return false;
     }
     
-    // Prepare frame header (will be used in later tasks)
-    // frame_header_t header;
-    // header.frame_number = frame_count & 0xFF;
-    // header.active_char_table = 0;  // Will be set by video controller
-    // header.frame_size = FRAME_NAMETABLE_SIZE + FRAME_PALETTE_SIZE + FRAME_OAM_SIZE;
-    // header.timestamp = to_us_since_boot(get_absolute_time());
+    // Front buffer latched at the last frame boundary, stable while we send
+    const video_frame_t *frame = video_controller_get_frame();
     
-    // Transmit frame data
-    // This will be expanded in later tasks to include actual frame data
+    // Keyframes resend all of the frame data and the manifest, healing
+    // lost fragments
+    frame_header_t header;
+    memset(&header, 0, sizeof(header));
+    if (keyframe_requested || (frame_sequence % VIDEO_STREAM_KEYFRAME_INTERVAL) == 0) {
+        video_controller_mark_all_dirty();
+        header.flags |= FRAME_FLAG_KEYFRAME;
+        keyframe_requested = false;
+        manifest_pending = true;
+    }
+    
+    // Changed assets go first, so clients hold them when the frame arrives;
+    // unchanged ones are never resent
+    uint32_t changes = video_controller_take_asset_changes();
+    if (changes) {
+        assets_pending |= changes;
+        manifest_pending = true;
+    }
+    while (assets_pending) {
+        uint8_t asset = (uint8_t)__builtin_ctz(assets_pending);
+        if (!transmit_asset(asset, active)) {
+            return false;
+        }
+        assets_pending &= ~(1u << asset);
+    }
+    if (manifest_pending) {
+        if (!transmit_manifest(frame->asset_manifest, active)) {
+            return false;
+        }
+        manifest_pending = false;
+    }
+    
+    header.type = VIDEO_PACKET_FRAME;
+    header.sequence = frame_sequence++;
+    header.timestamp = (uint32_t)to_us_since_boot(get_absolute_time());
+    header.asset_manifest = frame->asset_manifest;
+    header.fragment_count = (uint8_t)video_stream_count_fragments(frame);
+    header.buffer_set = frame->buffer_set;
+    header.scroll_x = frame->scroll_x;
+    header.scroll_y = frame->scroll_y;
+    
+    uint32_t mask = video_clients_frame_mask(header.sequence, (header.flags & FRAME_FLAG_KEYFRAME) != 0);
+    
+    video_stream_cursor_t cursor;
+    frame_span_t spans[FRAME_MAX_SPANS];
+    uint16_t data_size;
+    video_stream_begin(&cursor);
+    while (video_stream_next_fragment(frame, &cursor, spans, &header.span_count, &data_size)) {
+        header.payload_size = header.span_count * sizeof(frame_span_t) + data_size;
+        struct pbuf *p = build_fragment(frame, &header, spans);
+        if (!p) {
+            // Out of pbufs: the dirty blocks stay pending, the next frame
+            // resends them
+            return false;
+        }
+        send_to_clients(p, mask);
+        header.fragment_index++;
+    }
     
     frame_count++;
+    return true;
 }
 
+/**
+ * Upload a character table to every client, e.g. one a client reported
+ * missing. Retried with the next frame when it cannot be sent now.
+ */
 void wifi_controller_transmit_character_table(uint8_t table_index) {
-    (void)table_index;  // Unused parameter
-    if (!udp_pcb || current_state != WIFI_STATE_CONNECTED) {
+    if (table_index >= CHARACTER_TABLES) {
         return;
     }
-    
-    // Transmit character table update
-    // This will be expanded in later tasks
+    uint32_t active = video_clients_active_mask();
+    if (!udp_pcb || current_state != WIFI_STATE_CONNECTED || !active ||
+        !transmit_asset(table_index, active)) {
+        assets_pending |= 1u << table_index;
+    }
 }
 
+/**
+ * Upload a palette bank (same as wifi_controller_transmit_character_table)
+ */
 void wifi_controller_transmit_palette_bank(uint8_t bank_index) {
-    (void)bank_index;  // Unused parameter
-    if (!udp_pcb || current_state != WIFI_STATE_CONNECTED) {
+    if (bank_index >= PALETTE_BANKS) {
         return;
     }
-    
-    // Transmit palette bank update
-    // This will be expanded in later tasks
+    uint8_t asset = VIDEO_ASSET_PALETTE_BASE + bank_index;
+    uint32_t active = video_clients_active_mask();
+    if (!udp_pcb || current_state != WIFI_STATE_CONNECTED || !active ||
+        !transmit_asset(asset, active)) {
+        assets_pending |= 1u << asset;
+    }
 }
 
 uint32_t wifi_controller_get_frame_count(void) {
     return frame_count;
+}
+
+/**
+ * Send all of the frame data with the next frame (e.g. for a new client)
+ */
+void wifi_controller_request_keyframe(void) {
+    keyframe_requested = true;
 }
\ No newline at end of file
@@ -8,9 +8,29 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 // External kernel data generated from kernel.bin at build time
 extern const uint8_t kernel_data[];
 extern const size_t kernel_data_size;
 
+// Size of the kernel as streamed to the 6502. Equals kernel_data_size
+// unless kernel_data is an LZ4 block (MIA_KERNEL_LZ4 build option).
+extern const size_t kernel_image_size;
+extern const bool kernel_data_compressed;
+
+// Boot catalog: images the boot loader can stream, selected through the
+// reset control index (IDX_RESET_CONTROL). Entry 0 is kernel.bin, further
+// entries are raw images from the MIA_BOOT_IMAGES build option.
+typedef struct {
+    const char *name;
+    const uint8_t *data;        // Stored image (LZ4 block if compressed)
+    uint32_t data_size;         // Bytes in data
+    uint32_t image_size;        // Bytes streamed to the 6502
+    bool compressed;
+} boot_image_t;
+
+extern const boot_image_t boot_catalog[];
+extern const uint8_t boot_catalog_count;
+
 #endif // KERNEL_DATA_H
\ No newline at end of file
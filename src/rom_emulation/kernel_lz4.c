@@ -0,0 +1,149 @@
+/**
+ * Resumable LZ4 Block Decoder Implementation
+ * 
+ * Byte-granular state machine over the LZ4 sequence layout:
+ *   token | [literal length bytes] | literals | offset (LE16) | [match length bytes]
+ * The last sequence ends after its literals.
+ */
+
+#include "kernel_lz4.h"
+
+// Decoder steps
+enum {
+    LZ4_TOKEN,
+    LZ4_LITERAL_LENGTH,
+    LZ4_LITERALS,
+    LZ4_OFFSET_LOW,
+    LZ4_OFFSET_HIGH,
+    LZ4_MATCH_LENGTH,
+    LZ4_MATCH,
+    LZ4_DONE
+};
+
+#define LZ4_MIN_MATCH   4
+
+void kernel_lz4_init(kernel_lz4_t *d, const uint8_t *src, size_t src_size,
+                     uint8_t *ring, uint32_t ring_size) {
+    d->src = src;
+    d->src_end = src + src_size;
+    d->ring = ring;
+    d->ring_mask = ring_size - 1;
+    d->produced = 0;
+    d->count = 0;
+    d->offset = 0;
+    d->token = 0;
+    d->state = (src_size > 0) ? LZ4_TOKEN : LZ4_DONE;
+    d->error = false;
+}
+
+static inline void kernel_lz4_fail(kernel_lz4_t *d) {
+    d->error = true;
+    d->state = LZ4_DONE;
+}
+
+// Enter the match part of a sequence, or finish if the block ends here
+static inline void kernel_lz4_end_literals(kernel_lz4_t *d) {
+    d->state = (d->src == d->src_end) ? LZ4_DONE : LZ4_OFFSET_LOW;
+}
+
+uint32_t kernel_lz4_decode(kernel_lz4_t *d, uint32_t limit) {
+    uint32_t produced = d->produced;
+    
+    while (d->state != LZ4_DONE) {
+        // Input steps need a byte, output steps need room below the limit
+        if (d->state < LZ4_LITERALS || (d->state > LZ4_LITERALS && d->state < LZ4_MATCH)) {
+            if (d->src == d->src_end) {
+                kernel_lz4_fail(d);
+                break;
+            }
+        } else if (produced >= limit) {
+            break;
+        }
+        
+        switch (d->state) {
+            case LZ4_TOKEN:
+                d->token = *d->src++;
+                d->count = d->token >> 4;
+                if (d->count == 15) {
+                    d->state = LZ4_LITERAL_LENGTH;
+                } else if (d->count > 0) {
+                    d->state = LZ4_LITERALS;
+                } else {
+                    kernel_lz4_end_literals(d);
+                }
+                break;
+                
+            case LZ4_LITERAL_LENGTH: {
+                uint8_t b = *d->src++;
+                d->count += b;
+                if (b != 255) {
+                    d->state = LZ4_LITERALS;
+                }
+                break;
+            }
+                
+            case LZ4_LITERALS:
+                while (d->count > 0 && produced < limit) {
+                    if (d->src == d->src_end) {
+                        kernel_lz4_fail(d);
+                        break;
+                    }
+                    d->ring[produced++ & d->ring_mask] = *d->src++;
+                    d->count--;
+                }
+                if (d->count == 0 && d->state == LZ4_LITERALS) {
+                    kernel_lz4_end_literals(d);
+                }
+                break;
+                
+            case LZ4_OFFSET_LOW:
+                d->offset = *d->src++;
+                d->state = LZ4_OFFSET_HIGH;
+                break;
+                
+            case LZ4_OFFSET_HIGH:
+                d->offset |= (uint32_t)*d->src++ << 8;
+                if (d->offset == 0 || d->offset > d->ring_mask + 1 || d->offset > produced) {
+                    kernel_lz4_fail(d);
+                    break;
+                }
+                d->count = d->token & 0x0F;
+                if (d->count == 15) {
+                    d->state = LZ4_MATCH_LENGTH;
+                } else {
+                    d->count += LZ4_MIN_MATCH;
+                    d->state = LZ4_MATCH;
+                }
+                break;
+                
+            case LZ4_MATCH_LENGTH: {
+                uint8_t b = *d->src++;
+                d->count += b;
+                if (b != 255) {
+                    d->count += LZ4_MIN_MATCH;
+                    d->state = LZ4_MATCH;
+                }
+                break;
+            }
+                
+            case LZ4_MATCH:
+                // Byte by byte: overlapping matches (offset < length) repeat
+                while (d->count > 0 && produced < limit) {
+                    d->ring[produced & d->ring_mask] = d->ring[(produced - d->offset) & d->ring_mask];
+                    produced++;
+                    d->count--;
+                }
+                if (d->count == 0) {
+                    d->state = LZ4_TOKEN;
+                }
+                break;
+        }
+    }
+    
+    d->produced = produced;
+    return produced;
+}
+
+bool kernel_lz4_done(const kernel_lz4_t *d) {
+    return d->state == LZ4_DONE;
+}
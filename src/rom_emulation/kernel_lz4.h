@@ -0,0 +1,64 @@
+/**
+ * Resumable LZ4 Block Decoder for the Boot Kernel
+ * 
+ * Decodes a raw LZ4 block (no frame header) into a power-of-two ring, a
+ * few bytes at a time, so the ROM emulator can stay just ahead of the
+ * 6502 reading KERNEL_DATA. Match offsets must not exceed the ring size;
+ * scripts/compress_kernel.py limits its window accordingly.
+ */
+
+#ifndef KERNEL_LZ4_H
+#define KERNEL_LZ4_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Decoder state
+typedef struct {
+    const uint8_t *src;         // Next input byte
+    const uint8_t *src_end;     // End of the compressed block
+    uint8_t *ring;              // Output ring
+    uint32_t ring_mask;         // Ring size - 1
+    uint32_t produced;          // Bytes decoded so far
+    uint32_t count;             // Literal or match bytes left in this step
+    uint32_t offset;            // Match offset
+    uint8_t token;              // Current sequence token
+    uint8_t state;              // Decoder step (internal)
+    bool error;                 // Corrupt input detected
+} kernel_lz4_t;
+
+/**
+ * Start decoding a block
+ * 
+ * @param d Decoder state
+ * @param src Compressed block
+ * @param src_size Compressed size in bytes
+ * @param ring Output ring
+ * @param ring_size Ring size in bytes (power of two)
+ */
+void kernel_lz4_init(kernel_lz4_t *d, const uint8_t *src, size_t src_size,
+                     uint8_t *ring, uint32_t ring_size);
+
+/**
+ * Decode until `limit` bytes have been produced in total or the block ends
+ * 
+ * @param d Decoder state
+ * @param limit Total output bytes to stop at
+ * @return Total bytes produced so far
+ */
+uint32_t kernel_lz4_decode(kernel_lz4_t *d, uint32_t limit);
+
+/**
+ * Check if the block has been fully decoded (or decoding failed)
+ */
+bool kernel_lz4_done(const kernel_lz4_t *d);
+
+/**
+ * Read a decoded byte (must be among the last ring_size bytes produced)
+ */
+static inline uint8_t kernel_lz4_byte(const kernel_lz4_t *d, uint32_t pos) {
+    return d->ring[pos & d->ring_mask];
+}
+
+#endif // KERNEL_LZ4_H
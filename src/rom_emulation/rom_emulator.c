@@ -1,28 +1,81 @@
 /**
  * ROM Emulation Implementation
- * Boot-time ROM functionality using C code at 100 kHz
+ * Boot-time ROM served by PIO and a DMA lookup table (see rom_serve.pio)
  */
 
 #include "rom_emulator.h"
 #include "kernel_data.h"
+#include "config/irq_config.h"
 #include "hardware/gpio_mapping.h"
 #include "system/clock_control.h"
 #include "system/reset_control.h"
 #include "pico/time.h"
 #include "hardware/gpio.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "rom_serve.pio.h"
+#include "kernel_lz4.h"
+#include "indexed_memory/indexed_memory.h"
+#include "hardware/sync.h"
+#include <string.h>
 #include <stdio.h>
 
-static rom_state_t current_state = ROM_STATE_INACTIVE;
-static uint32_t kernel_data_pointer = 0;
+static volatile rom_state_t current_state = ROM_STATE_INACTIVE;
+static volatile uint32_t kernel_data_pointer = 0;
 static absolute_time_t reset_start_time;
 static uint32_t reset_cycle_count = 0;
 
-// Forward declarations for internal functions
-static bool rom_emulator_handle_read(uint16_t address, uint8_t *data);
+// ROM image served by the lookup DMA. Aligned so the PIO can form a
+// byte's address by shifting A0-A7 in below the base.
+static uint8_t rom_image[ROM_SIZE] __attribute__((aligned(ROM_SIZE)));
+
+// PIO and DMA resources while the ROM window is served
+static PIO pio_instance = ROM_PIO_INSTANCE;
+static uint serve_offset = 0;
+static uint confirm_offset = 0;
+static uint dma_addr_chan = 0;
+static uint dma_data_chan = 0;
+
+// Last kernel progress printed by rom_emulator_process()
+static uint32_t reported_pointer = 0;
+
+// LZ4 kernel: decoded into a ring in the MIA I/O buffer, ahead of the
+// 6502 reads (producer: rom_emulator_process(), consumer: confirm IRQ)
+#if KERNEL_RING_OFFSET + KERNEL_RING_SIZE > INDEXED_MEMORY_IO_BUFFER_SIZE
+#error "Kernel ring does not fit in the MIA I/O buffer"
+#endif
+static kernel_lz4_t kernel_decoder;
+static bool decode_error_reported = false;
+
+// Boot catalog entry streamed by the next (or current) boot
+static const boot_image_t *boot_image = &boot_catalog[0];
+static uint8_t boot_image_index = 0;
+
+// Where streamed bytes come from: flash, the boot cache, or (NULL) the
+// LZ4 decode ring. cache_fill is set while a flash image is being copied
+// into the boot cache as it streams.
+static const uint8_t *stream_source = NULL;
+static uint8_t *cache_fill = NULL;
+
+// Warm boot cache descriptor (the bytes live in MIA memory)
+typedef struct {
+    bool valid;
+    uint8_t image;              // Boot catalog entry
+    uint32_t size;              // Bytes cached
+    uint32_t checksum;          // FNV-1a over the cached bytes
+} boot_cache_t;
+static boot_cache_t boot_cache;
+
+// Reset hold time of the current boot sequence
+static uint32_t reset_hold_us = ROM_RESET_HOLD_US;
 
 // 6502 Boot Loader Assembly Code
 // This code runs on the 6502 CPU and copies the kernel from MIA to RAM
 // Memory addresses shown are the 6502 CPU addresses ($E000-$E0FF)
+// The kernel is streamed in whole 256-byte pages: the status register is
+// read once per page and the copy loop is unrolled 8 times (12.4 cycles
+// per byte instead of 21 with a status check per byte).
 static const uint8_t bootloader_code[] = {
     // === Kernel Loader Entry Point ($E000) ===
     0x78,                    // $E000: SEI - Disable interrupts during loading
@@ -37,67 +90,358 @@ static const uint8_t bootloader_code[] = {
     // Initialize Y register as offset
     0xA0, 0x00,              // $E00A-$E00B: LDY #$00
     
-    // === Main Kernel Loading Loop ===
-    // LOAD_LOOP: ($E00C)
-    0xAD, 0x80, 0xE0,        // $E00C-$E00E: LDA $E080 - Read status address (mapped to MIA status register)
-    0xF0, 0x0C,              // $E00F-$E010: BEQ LOAD_COMPLETE - If 0, loading is complete (branch to $E01D)
-    
-    // Read next kernel byte
-    0xAD, 0x81, 0xE0,        // $E011-$E013: LDA $E081 - Read data address (mapped to MIA data register)
-    0x91, 0x00,              // $E014-$E015: STA ($00),Y - Store byte at destination address
+    // === Page Loop ===
+    // PAGE_LOOP: ($E00C)
+    0xAD, 0x80, 0xE0,        // $E00C-$E00E: LDA $E080 - Read pages remaining
+    0xF0, 0x3B,              // $E00F-$E010: BEQ LOAD_COMPLETE - If 0, loading is complete (branch to $E04C)
+    0xC9, 0xFF,              // $E011-$E012: CMP #$FF - Next page not ready yet?
+    0xF0, 0xF7,              // $E013-$E014: BEQ PAGE_LOOP - Wait for it (branch to $E00C)
     
-    // Advance destination pointer
-    0xC8,                    // $E016: INY - Increment offset
-    0xD0, 0xF4,              // $E017-$E018: BNE LOAD_LOOP - If Y didn't wrap, continue (branch to $E00C)
+    // === Copy one page, 8 bytes per iteration ===
+    // COPY_LOOP: ($E015)
+    0xAD, 0x81, 0xE0,        // $E015-$E017: LDA $E081 - Read next kernel byte
+    0x91, 0x00,              // $E018-$E019: STA ($00),Y - Store byte at destination address
+    0xC8,                    // $E01A: INY
+    0xAD, 0x81, 0xE0,        // $E01B-$E01D: LDA $E081 - Read next kernel byte
+    0x91, 0x00,              // $E01E-$E01F: STA ($00),Y - Store byte at destination address
+    0xC8,                    // $E020: INY
+    0xAD, 0x81, 0xE0,        // $E021-$E023: LDA $E081 - Read next kernel byte
+    0x91, 0x00,              // $E024-$E025: STA ($00),Y - Store byte at destination address
+    0xC8,                    // $E026: INY
+    0xAD, 0x81, 0xE0,        // $E027-$E029: LDA $E081 - Read next kernel byte
+    0x91, 0x00,              // $E02A-$E02B: STA ($00),Y - Store byte at destination address
+    0xC8,                    // $E02C: INY
+    0xAD, 0x81, 0xE0,        // $E02D-$E02F: LDA $E081 - Read next kernel byte
+    0x91, 0x00,              // $E030-$E031: STA ($00),Y - Store byte at destination address
+    0xC8,                    // $E032: INY
+    0xAD, 0x81, 0xE0,        // $E033-$E035: LDA $E081 - Read next kernel byte
+    0x91, 0x00,              // $E036-$E037: STA ($00),Y - Store byte at destination address
+    0xC8,                    // $E038: INY
+    0xAD, 0x81, 0xE0,        // $E039-$E03B: LDA $E081 - Read next kernel byte
+    0x91, 0x00,              // $E03C-$E03D: STA ($00),Y - Store byte at destination address
+    0xC8,                    // $E03E: INY
+    0xAD, 0x81, 0xE0,        // $E03F-$E041: LDA $E081 - Read next kernel byte
+    0x91, 0x00,              // $E042-$E043: STA ($00),Y - Store byte at destination address
+    0xC8,                    // $E044: INY
+    0xD0, 0xCE,              // $E045-$E046: BNE COPY_LOOP - If Y didn't wrap, continue (branch to $E015)
     
-    // Handle page boundary crossing
-    0xE6, 0x01,              // $E019-$E01A: INC $01 - Increment high byte of destination
-    0x4C, 0x0C, 0xE0,        // $E01B-$E01D: JMP LOAD_LOOP - Continue loading (absolute jump to $E00C)
+    // Next page
+    0xE6, 0x01,              // $E047-$E048: INC $01 - Increment high byte of destination
+    0x4C, 0x0C, 0xE0,        // $E049-$E04B: JMP PAGE_LOOP - Check the next page (absolute jump to $E00C)
     
     // === Loading Complete ===
-    // LOAD_COMPLETE: ($E01E)
-    0x4C, 0x00, 0x40,        // $E01E-$E020: JMP $4000 - Jump directly to kernel entry point
-    
-    // Padding to ensure we don't exceed our space
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E021-$E024: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E025-$E028: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E029-$E02C: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E02D-$E030: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E031-$E034: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E035-$E038: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E039-$E03C: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E03D-$E040: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E041-$E044: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E045-$E048: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E049-$E04C: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E04D-$E050: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E051-$E054: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E055-$E058: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA,  // $E059-$E05C: NOP padding
-    0xEA, 0xEA, 0xEA, 0xEA   // $E05D-$E060: NOP padding
+    // LOAD_COMPLETE: ($E04C)
+    0x4C, 0x00, 0x40         // $E04C-$E04E: JMP $4000 - Jump directly to kernel entry point
 };
 
-// Kernel data is now loaded from kernel.bin at build time
+// Boot images are loaded from kernel.bin (and MIA_BOOT_IMAGES) at build time
 // See kernel_data.h for external declarations
 
+/**
+ * Kernel length rounded up to whole pages (the boot loader copies pages)
+ */
+static inline uint32_t rom_emulator_padded_size(void) {
+    return (boot_image->image_size + KERNEL_PAGE_SIZE - 1) & ~(uint32_t)(KERNEL_PAGE_SIZE - 1);
+}
+
+/**
+ * Kernel byte at `pos` (the last page is padded with zeros)
+ * With LZ4, must be below the decoded count and within the ring
+ */
+static inline uint8_t rom_emulator_kernel_byte(uint32_t pos) {
+    if (pos >= boot_image->image_size) {
+        return 0x00;
+    }
+    return stream_source ? stream_source[pos] : kernel_lz4_byte(&kernel_decoder, pos);
+}
+
+/**
+ * Number of kernel bytes ready to be streamed
+ */
+static inline uint32_t rom_emulator_kernel_available(void) {
+    return stream_source ? boot_image->image_size : kernel_decoder.produced;
+}
+
+/**
+ * Stage the kernel byte at `pos` in KERNEL_DATA, filling the boot cache
+ */
+static inline void rom_emulator_stage_byte(uint32_t pos) {
+    uint8_t data = rom_emulator_kernel_byte(pos);
+    rom_image[KERNEL_DATA_ADDR] = data;
+    if (cache_fill != NULL && pos < boot_image->image_size) {
+        cache_fill[pos] = data;
+    }
+}
+
+/**
+ * KERNEL_STATUS value once `pointer` bytes have been transferred
+ */
+static uint8_t rom_emulator_pages_remaining(uint32_t pointer) {
+    uint32_t pages = (rom_emulator_padded_size() - pointer) / KERNEL_PAGE_SIZE;
+    return pages >= KERNEL_STATUS_BUSY ? KERNEL_STATUS_BUSY - 1 : (uint8_t)pages;
+}
+
+/**
+ * Stage KERNEL_STATUS and KERNEL_DATA for the page starting at `pointer`
+ * Reports KERNEL_STATUS_BUSY until the whole page has been decoded
+ */
+static void rom_emulator_stage_page(uint32_t pointer) {
+    uint32_t page_end = pointer + KERNEL_PAGE_SIZE;
+    if (page_end > boot_image->image_size) {
+        page_end = boot_image->image_size;
+    }
+    
+    if (pointer < boot_image->image_size && rom_emulator_kernel_available() < page_end) {
+        rom_image[KERNEL_STATUS_ADDR] = KERNEL_STATUS_BUSY;
+        return;
+    }
+    
+    rom_emulator_stage_byte(pointer);
+    rom_image[KERNEL_STATUS_ADDR] = rom_emulator_pages_remaining(pointer);
+}
+
+/**
+ * Run the LZ4 decoder as far ahead of the 6502 as the ring allows
+ */
+static void rom_emulator_decode_ahead(void) {
+    if (stream_source != NULL || kernel_lz4_done(&kernel_decoder)) {
+        return;
+    }
+    
+    kernel_lz4_decode(&kernel_decoder, kernel_data_pointer + KERNEL_RING_SIZE);
+    if (kernel_decoder.error && !decode_error_reported) {
+        decode_error_reported = true;
+        printf("Kernel LZ4 decode error after %lu bytes\n", kernel_decoder.produced);
+    }
+}
+
+/**
+ * FNV-1a checksum guarding the boot cache against 6502 writes
+ */
+static uint32_t rom_emulator_checksum(const uint8_t *data, uint32_t size) {
+    uint32_t hash = 0x811C9DC5u;
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 0x01000193u;
+    }
+    return hash;
+}
+
+/**
+ * Pick the stream source for the selected image
+ * The boot cache is used only when requested and still intact, otherwise
+ * the image streams from flash and refills the cache on the way
+ */
+static void rom_emulator_select_source(bool use_cache) {
+    uint8_t *cache = indexed_memory_get_boot_cache();
+    uint32_t size = boot_image->image_size;
+    
+    if (use_cache && boot_cache.valid && boot_cache.image == boot_image_index &&
+        boot_cache.size == size && rom_emulator_checksum(cache, size) == boot_cache.checksum) {
+        stream_source = cache;
+        cache_fill = NULL;
+        printf("Boot image %u (%s) served from the boot cache\n", boot_image_index, boot_image->name);
+        return;
+    }
+    
+    boot_cache.valid = false;
+    stream_source = boot_image->compressed ? NULL : boot_image->data;
+    cache_fill = (size <= INDEXED_MEMORY_BOOT_CACHE_SIZE) ? cache : NULL;
+    printf("Boot image %u (%s) served from flash\n", boot_image_index, boot_image->name);
+}
+
+/**
+ * Build the ROM image: boot loader, kernel registers and reset vector
+ * Unmapped bytes read as NOP, as the boot loader padding does
+ */
+static void rom_emulator_build_image(void) {
+    for (uint32_t i = 0; i < ROM_SIZE; i++) {
+        rom_image[i] = 0xEA;  // NOP
+    }
+    for (uint32_t i = 0; i < sizeof(bootloader_code) && i < KERNEL_STATUS_ADDR; i++) {
+        rom_image[BOOTLOADER_START + i] = bootloader_code[i];
+    }
+    
+    // Pages remaining (0 if complete) and the first kernel byte
+    if (stream_source == NULL) {
+        kernel_lz4_init(&kernel_decoder, boot_image->data, boot_image->data_size,
+                        indexed_memory_get_io_buffer(KERNEL_RING_OFFSET), KERNEL_RING_SIZE);
+        decode_error_reported = false;
+        rom_emulator_decode_ahead();
+    }
+    rom_emulator_stage_page(0);
+    
+    // Reset vector ($FFFC-$FFFD) points at the boot loader ($E000)
+    rom_image[ROM_RESET_VECTOR] = 0x00;
+    rom_image[ROM_RESET_VECTOR + 1] = 0xE0;
+}
+
+/**
+ * Apply the side effects of a confirmed ROM read
+ * Runs in the confirm IRQ, well before the boot loader reads the same
+ * register again (at least 12 cycles later)
+ */
+static void rom_emulator_handle_read(uint8_t address) {
+    if (address == KERNEL_STATUS_ADDR) {
+        if (current_state == ROM_STATE_BOOT_ACTIVE) {
+            current_state = ROM_STATE_KERNEL_LOADING;
+        }
+    } else if (address == KERNEL_DATA_ADDR) {
+        uint32_t pointer = kernel_data_pointer;
+        if (pointer < rom_emulator_padded_size()) {
+            pointer++;
+            kernel_data_pointer = pointer;
+            
+            // Stage the next byte. The boot loader reads the status again
+            // only at a page boundary, and the whole page is ready by then.
+            if ((pointer % KERNEL_PAGE_SIZE) != 0) {
+                rom_emulator_stage_byte(pointer);
+            } else {
+                rom_emulator_stage_page(pointer);
+            }
+        }
+    } else if (address == BOOTLOADER_EXIT_ADDR && kernel_data_pointer >= rom_emulator_padded_size() &&
+               current_state == ROM_STATE_KERNEL_LOADING) {
+        // Last ROM fetch of the boot loader (JMP operand), safe to bank out
+        current_state = ROM_STATE_COMPLETE;
+    }
+}
+
+/**
+ * Confirmed READ IRQ handler (rom_confirm RX FIFO not empty)
+ */
+static void rom_emulator_irq_handler(void) {
+    while (!pio_sm_is_rx_fifo_empty(pio_instance, ROM_PIO_SM_CONFIRM)) {
+        rom_emulator_handle_read((uint8_t)pio_sm_get(pio_instance, ROM_PIO_SM_CONFIRM));
+    }
+}
+
+/**
+ * Start serving the ROM window from PIO
+ */
+static void rom_emulator_start_pio(void) {
+    rom_emulator_build_image();
+    
+    serve_offset = pio_add_program(pio_instance, &rom_serve_program);
+    confirm_offset = pio_add_program(pio_instance, &rom_confirm_program);
+    rom_serve_program_init(pio_instance, ROM_PIO_SM_SERVE, serve_offset);
+    rom_confirm_program_init(pio_instance, ROM_PIO_SM_CONFIRM, confirm_offset);
+    
+    // Lookup DMA: "addr" moves each table address pushed by the SM into
+    // the READ_ADDR trigger of "data", which moves the byte to the TX FIFO
+    dma_addr_chan = dma_claim_unused_channel(true);
+    dma_data_chan = dma_claim_unused_channel(true);
+    
+    dma_channel_config c = dma_channel_get_default_config(dma_data_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio_instance, ROM_PIO_SM_SERVE, true));
+    dma_channel_configure(dma_data_chan, &c,
+                          &pio_instance->txf[ROM_PIO_SM_SERVE],  // Write to TX FIFO
+                          rom_image,                             // Replaced on every trigger
+                          1,                                     // One byte per cycle
+                          false);
+    
+    c = dma_channel_get_default_config(dma_addr_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio_instance, ROM_PIO_SM_SERVE, false));
+    dma_channel_configure(dma_addr_chan, &c,
+                          &dma_hw->ch[dma_data_chan].al3_read_addr_trig,  // Trigger "data"
+                          &pio_instance->rxf[ROM_PIO_SM_SERVE],          // Read from RX FIFO
+                          dma_encode_endless_transfer_count(),
+                          true);
+    
+    // Confirmed READs are reported through the rom_confirm RX FIFO
+    pio_set_irq0_source_enabled(pio_instance,
+                                pio_get_rx_fifo_not_empty_interrupt_source(ROM_PIO_SM_CONFIRM), true);
+    irq_set_exclusive_handler(ROM_PIO_IRQ, rom_emulator_irq_handler);
+    irq_set_priority(ROM_PIO_IRQ, MIA_IRQ_PRIORITY_ROM);
+    irq_set_enabled(ROM_PIO_IRQ, true);
+    
+    // The serving SM takes the table base first, then runs forever
+    pio_sm_put(pio_instance, ROM_PIO_SM_SERVE, (uint32_t)rom_image >> 8);
+    pio_enable_sm_mask_in_sync(pio_instance, (1u << ROM_PIO_SM_SERVE) | (1u << ROM_PIO_SM_CONFIRM));
+}
+
+/**
+ * Stop serving the ROM window and release PIO, DMA and the data bus
+ */
+static void rom_emulator_stop_pio(void) {
+    irq_set_enabled(ROM_PIO_IRQ, false);
+    pio_set_irq0_source_enabled(pio_instance,
+                                pio_get_rx_fifo_not_empty_interrupt_source(ROM_PIO_SM_CONFIRM), false);
+    irq_remove_handler(ROM_PIO_IRQ, rom_emulator_irq_handler);
+    
+    pio_set_sm_mask_enabled(pio_instance, (1u << ROM_PIO_SM_SERVE) | (1u << ROM_PIO_SM_CONFIRM), false);
+    pio_sm_set_consecutive_pindirs(pio_instance, ROM_PIO_SM_SERVE, GPIO_DATA_D0, 8, false);
+    
+    dma_channel_abort(dma_addr_chan);
+    dma_channel_abort(dma_data_chan);
+    dma_channel_unclaim(dma_addr_chan);
+    dma_channel_unclaim(dma_data_chan);
+    
+    pio_remove_program(pio_instance, &rom_serve_program, serve_offset);
+    pio_remove_program(pio_instance, &rom_confirm_program, confirm_offset);
+    
+    // The decode ring is part of the I/O buffer, leave it clean
+    if (stream_source == NULL) {
+        memset(indexed_memory_get_io_buffer(KERNEL_RING_OFFSET), 0, KERNEL_RING_SIZE);
+    }
+    
+    // Hand the data bus back to SIO as inputs until the bus interface takes it
+    for (int i = GPIO_DATA_D0; i <= GPIO_DATA_D7; i++) {
+        gpio_init(i);
+        gpio_set_dir(i, GPIO_IN);
+    }
+}
+
 void rom_emulator_init(void) {
     current_state = ROM_STATE_INACTIVE;
     kernel_data_pointer = 0;
+    reported_pointer = 0;
     reset_cycle_count = 0;
     
-    printf("ROM Emulator initialized - Boot loader: %zu bytes, Kernel: %zu bytes\n", 
-           sizeof(bootloader_code), kernel_data_size);
+    boot_image_index = 0;
+    boot_image = &boot_catalog[0];
+    boot_cache.valid = false;
+    
+    printf("ROM Emulator initialized - Boot loader: %zu bytes, %u boot image(s)\n", 
+           sizeof(bootloader_code), boot_catalog_count);
+    for (uint8_t i = 0; i < boot_catalog_count; i++) {
+        printf("  Image %u: %s, %lu bytes (%lu stored%s)\n", i, boot_catalog[i].name,
+               boot_catalog[i].image_size, boot_catalog[i].data_size,
+               boot_catalog[i].compressed ? ", LZ4" : "");
+    }
+}
+
+bool rom_emulator_select_image(uint8_t image) {
+    if (image >= boot_catalog_count || current_state != ROM_STATE_INACTIVE) {
+        return false;
+    }
+    boot_image_index = image;
+    boot_image = &boot_catalog[image];
+    return true;
+}
+
+uint8_t rom_emulator_get_image(void) {
+    return boot_image_index;
 }
 
 void rom_emulator_start_boot_sequence(void) {
     if (current_state == ROM_STATE_INACTIVE) {
         printf("Starting boot sequence...\n");
+        rom_emulator_select_source(false);
+        kernel_data_pointer = 0;
+        reported_pointer = 0;
         
         // Assert reset for minimum 5 cycles at 100 kHz
         reset_control_assert_reset();
         current_state = ROM_STATE_RESET_SEQUENCE;
         reset_start_time = get_absolute_time();
         reset_cycle_count = 0;
+        reset_hold_us = ROM_RESET_HOLD_US;
         
         // Ensure we're in boot phase with 100 kHz clock
         clock_control_set_phase(CLOCK_PHASE_BOOT);
@@ -106,46 +450,65 @@ void rom_emulator_start_boot_sequence(void) {
     }
 }
 
+void rom_emulator_start_fast_boot(void) {
+    if (current_state == ROM_STATE_INACTIVE) {
+        printf("Starting fast boot sequence...\n");
+        rom_emulator_select_source(true);
+        kernel_data_pointer = 0;
+        reported_pointer = 0;
+        
+        // Short reset at the normal clock: the 100 kHz phase is only
+        // needed on power-up, before the PHI2 divider has been validated
+        reset_control_assert_reset();
+        current_state = ROM_STATE_RESET_SEQUENCE;
+        reset_start_time = get_absolute_time();
+        reset_cycle_count = 0;
+        reset_hold_us = ROM_FAST_RESET_HOLD_US;
+    }
+}
+
 void rom_emulator_process(void) {
-    bool we, oe, rom_cs, video_cs, gen_cs;
-    
     // Handle reset sequence timing
     if (current_state == ROM_STATE_RESET_SEQUENCE) {
-        // Calculate elapsed time and cycles
+        // Calculate elapsed time
         int64_t elapsed_us = absolute_time_diff_us(reset_start_time, get_absolute_time());
-        uint32_t elapsed_cycles = (elapsed_us * CLOCK_FREQ_BOOT) / 1000000;
         
-        // Release reset after minimum 5 cycles (50us at 100kHz)
-        if (elapsed_cycles >= 5 && elapsed_us >= 50) {
+        // Release reset after the hold time (5 cycles at 100kHz on power-up)
+        if (elapsed_us >= reset_hold_us) {
+            // Serve the ROM window before the 6502 fetches its reset vector
+            rom_emulator_start_pio();
+            
             // Bank MIA into high memory space
             gpio_put(GPIO_PICOHIRAM, 0);  // Active low
+            
+            // The PIO keeps up with the normal clock, no need to boot slowly
+            clock_control_set_phase(CLOCK_PHASE_NORMAL);
 
             reset_control_release_reset();
             current_state = ROM_STATE_BOOT_ACTIVE;
                         
-            printf("Reset released after %lld us (%lu cycles), MIA banked into high memory\n", 
-                   elapsed_us, elapsed_cycles);
+            printf("Reset released after %lld us, MIA banked into high memory\n", elapsed_us);
         }
         return;
     }
     
-    // Read control signals
-    gpio_read_control_signals(&we, &oe, &rom_cs, &video_cs, &gen_cs);
-    
-    // Only process if ROM chip select is active and we're in boot phase
-    if (rom_cs && (current_state == ROM_STATE_BOOT_ACTIVE || current_state == ROM_STATE_KERNEL_LOADING)) {
-        uint16_t address = gpio_read_address_bus();
+    // Keep the LZ4 decoder ahead, and release a page the 6502 is waiting on
+    if (stream_source == NULL && current_state != ROM_STATE_INACTIVE) {
+        rom_emulator_decode_ahead();
         
-        if (oe && !we) {  // Read operation
-            uint8_t data;
-            if (rom_emulator_handle_read(address, &data)) {
-                gpio_set_data_bus_direction(true);  // Set as output
-                gpio_write_data_bus(data);
-            }
+        uint32_t irq_state = save_and_disable_interrupts();
+        if (rom_image[KERNEL_STATUS_ADDR] == KERNEL_STATUS_BUSY) {
+            rom_emulator_stage_page(kernel_data_pointer);
         }
-    } else if ((current_state == ROM_STATE_BOOT_ACTIVE || current_state == ROM_STATE_KERNEL_LOADING) && !rom_cs) {
-        // ROM no longer selected, set data bus back to input
-        gpio_set_data_bus_direction(false);
+        restore_interrupts(irq_state);
+    }
+    
+    // Log progress periodically (outside the confirm IRQ)
+    uint32_t pointer = kernel_data_pointer;
+    uint32_t image_size = boot_image->image_size;
+    if (pointer - reported_pointer >= 4096 || (pointer >= image_size && reported_pointer < image_size)) {
+        reported_pointer = pointer;
+        printf("Kernel transfer progress: %lu/%lu bytes\n", pointer, image_size);
     }
     
     // Check for completion and phase transition
@@ -153,80 +516,24 @@ void rom_emulator_process(void) {
         printf("Kernel loading complete, transitioning to normal operation\n");
         
         // Transition to normal operation
-        clock_control_set_phase(CLOCK_PHASE_NORMAL);
+        rom_emulator_stop_pio();
         gpio_put(GPIO_PICOHIRAM, 1);  // Bank out of high memory
-                
-        current_state = ROM_STATE_INACTIVE;
         
-        printf("MIA banked out, clock increased to 1 MHz, bus interface activated\n");
-    }
-}
-
-static bool rom_emulator_handle_read(uint16_t address, uint8_t *data) {
-    if (!data) return false;
-    
-    // Handle reset vector ($FFFC-$FFFD maps to $FC-$FD in MIA space)
-    if (address == ROM_RESET_VECTOR) {
-        // Return low byte of boot loader start address ($E000)
-        *data = 0x00;  // Low byte of $E000
-        return true;
-    } else if (address == ROM_RESET_VECTOR + 1) {
-        // Return high byte of boot loader start address ($E000)
-        *data = 0xE0;  // High byte of $E000
-        return true;
-    }
-    
-    // Handle boot loader code ($E000-$E07F maps to $000-$07F in MIA space)
-    else if (address < KERNEL_STATUS_ADDR) {
-        uint16_t offset = address - BOOTLOADER_START;
-        if (offset < sizeof(bootloader_code)) {
-            *data = bootloader_code[offset];
-        } else {
-            *data = 0xEA;  // NOP padding
-        }
-        return true;
-    }
-    
-    // Handle kernel status register ($E080 maps to $080 in MIA space)
-    else if (address == KERNEL_STATUS_ADDR) {
-        if (current_state != ROM_STATE_KERNEL_LOADING) {
-            current_state = ROM_STATE_KERNEL_LOADING;
-            printf("Kernel loading started by 6502 CPU\n");
+        // Every byte went through the cache on the way: seal it
+        if (cache_fill != NULL) {
+            boot_cache.image = boot_image_index;
+            boot_cache.size = image_size;
+            boot_cache.checksum = rom_emulator_checksum(cache_fill, image_size);
+            boot_cache.valid = true;
+            cache_fill = NULL;
         }
+                
+        current_state = ROM_STATE_INACTIVE;
         
-        // Return 1 if more data available, 0 if complete
-        *data = (kernel_data_pointer < kernel_data_size) ? 0x01 : 0x00;
-        return true;
+        printf("MIA banked out, ROM window released, bus interface activated\n");
     }
-    
-    // Handle kernel data register ($E081 maps to $081 in MIA space)
-    else if (address == KERNEL_DATA_ADDR) {
-        if (kernel_data_pointer < kernel_data_size) {
-            *data = kernel_data[kernel_data_pointer];
-            kernel_data_pointer++;
-            
-            // Log progress periodically
-            if (kernel_data_pointer % 64 == 0 || kernel_data_pointer >= kernel_data_size) {
-                printf("Kernel transfer progress: %lu/%zu bytes\n", 
-                       kernel_data_pointer, kernel_data_size);
-            }
-            
-            // Mark complete when all data transferred
-            if (kernel_data_pointer >= kernel_data_size) {
-                current_state = ROM_STATE_COMPLETE;
-                printf("All kernel data transferred\n");
-            }
-        } else {
-            *data = 0x00;  // No more data
-        }
-        return true;
-    }
-    
-    // Default case - return NOP for unmapped addresses
-    *data = 0xEA;  // NOP
-    return true;
 }
 
 bool rom_emulator_is_active(void) {
     return current_state != ROM_STATE_INACTIVE;
-}
\ No newline at end of file
+}
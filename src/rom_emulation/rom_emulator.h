@@ -16,8 +16,33 @@
 
 // Boot loader addresses within ROM space (maps to $E000-$FFFF on 6502)
 #define BOOTLOADER_START   0x0000   // Boot loader entry point (maps to $E000)
-#define KERNEL_STATUS_ADDR 0x0080   // Status register (maps to $E080)
+#define KERNEL_STATUS_ADDR 0x0080   // Pages remaining, 0 = complete, 0xFF = busy (maps to $E080)
 #define KERNEL_DATA_ADDR   0x0081   // Data register (maps to $E081)
+#define BOOTLOADER_EXIT_ADDR 0x004E // Last byte of the final JMP $4000 (maps to $E04E)
+
+// Kernel streaming protocol: the boot loader copies whole pages and reads
+// KERNEL_STATUS once per page, and waits while it reads KERNEL_STATUS_BUSY
+// (the next page of an LZ4 kernel is still being decoded). The last page
+// is padded with zeros.
+#define KERNEL_PAGE_SIZE   256
+#define KERNEL_STATUS_BUSY 0xFF
+
+// LZ4 kernel decode ring in the MIA I/O buffer (after the USB buffers)
+// Must match the --window passed to compress_kernel.py in CMakeLists.txt
+#define KERNEL_RING_OFFSET 0x2000
+#define KERNEL_RING_SIZE   0x2000
+
+// PIO resources serving the ROM window during boot (see rom_serve.pio)
+// PIO 1 so the bus interface can take PIO 0 as soon as boot completes
+#define ROM_PIO_INSTANCE    pio1
+#define ROM_PIO_SM_SERVE    0       // Lookup table state machine
+#define ROM_PIO_SM_CONFIRM  1       // Confirmed READ reporter
+#define ROM_PIO_IRQ         PIO1_IRQ_0
+
+// Reset hold times: 5 cycles at 100 kHz on power-up, and at least 10
+// cycles at the slowest normal PHI2 speed (1 MHz) for a fast reset
+#define ROM_RESET_HOLD_US       50
+#define ROM_FAST_RESET_HOLD_US  10
 
 // 6502 system addresses
 #define KERNEL_LOAD_ADDRESS 0x4000  // Where kernel gets loaded in Clementina RAM
@@ -36,4 +61,14 @@ void rom_emulator_process(void);
 void rom_emulator_start_boot_sequence(void);
 bool rom_emulator_is_active(void);
 
+// Boot catalog selection (see kernel_data.h), only while inactive
+// Returns false if the image is not in the catalog
+bool rom_emulator_select_image(uint8_t image);
+uint8_t rom_emulator_get_image(void);
+
+// 6502-only reboot (CMD_SYSTEM_FAST_RESET): brief reset at the normal
+// clock, then the selected image streams from the warm boot cache if an
+// intact copy is there, from flash otherwise (refilling the cache)
+void rom_emulator_start_fast_boot(void);
+
 #endif // ROM_EMULATOR_H
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**
+ * MIA Core 0 Background Work Implementation
+ */
+
+#include "background.h"
+#include <stddef.h>
+
+static background_work_fn handlers[BACKGROUND_MAX_WORK];
+static volatile uint32_t pending;
+
+void background_init(void) {
+    for (int i = 0; i < BACKGROUND_MAX_WORK; i++) {
+        handlers[i] = NULL;
+    }
+    pending = 0;
+}
+
+void background_set_handler(uint32_t work, background_work_fn run) {
+    handlers[__builtin_ctz(work)] = run;
+}
+
+void background_post(uint32_t work) {
+    __atomic_fetch_or(&pending, work, __ATOMIC_RELEASE);
+}
+
+bool background_run_next(void) {
+    uint32_t work = __atomic_load_n(&pending, __ATOMIC_ACQUIRE);
+    if (work == 0) {
+        return false;
+    }
+
+    // Clear before running: a post during the run makes the item pending again
+    uint32_t bit = work & -work;
+    __atomic_fetch_and(&pending, ~bit, __ATOMIC_ACQUIRE);
+    background_work_fn run = handlers[__builtin_ctz(bit)];
+    if (run) {
+        run();
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+/**
+ * MIA Core 0 Background Work
+ *
+ * Work that Core 0 runs in thread mode, between bus IRQs, once the bus
+ * interface is serviced by the PIO and its interrupt. The bus IRQ has the
+ * highest NVIC priority and preempts this work at any point, so a long
+ * work item never delays a bus cycle; it only delays the other work.
+ *
+ * Work items are fixed bits with one handler each. A post from any core or
+ * interrupt handler makes the item pending; several posts before it runs
+ * make one run. Pending items run one per background_run_next() call,
+ * lowest bit first, and a post during the run makes the item pending again.
+ */
+
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BACKGROUND_MAX_WORK         8
+
+// Work items, in priority order
+#define BACKGROUND_WORK_COPY        0x01    // Start the next DMA batch (copy queued or batch done)
+#define BACKGROUND_WORK_COMMAND     0x02    // Heavy shared command issued (STATUS_BUSY)
+#define BACKGROUND_WORK_FAST_RESET  0x04    // CMD_SYSTEM_FAST_RESET issued
+#define BACKGROUND_WORK_PSRAM       0x08    // PSRAM page queued for the cache (CONFIG_MIA_PSRAM)
+#define BACKGROUND_WORK_SNAPSHOT    0x10    // CMD_SNAPSHOT_SAVE issued
+#define BACKGROUND_WORK_REMOTE      0x20    // Remote memory writes handed over (network/memory_service.h)
+
+typedef void (*background_work_fn)(void);
+
+// Remove all handlers and pending work
+void background_init(void);
+
+// Set the handler of one work item (BACKGROUND_WORK_*)
+void background_set_handler(uint32_t work, background_work_fn run);
+
+// Make work items pending (any core, IRQ safe)
+void background_post(uint32_t work);
+
+/**
+ * Run the highest-priority pending work item
+ *
+ * @return false if no work was pending
+ */
+bool background_run_next(void);
+
+#endif // BACKGROUND_H
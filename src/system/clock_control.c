@@ -5,63 +5,40 @@
 
 #include "clock_control.h"
 #include "hardware/gpio_mapping.h"
+#include "indexed_memory/indexed_memory.h"
 #include "hardware/pwm.h"
 #include "hardware/clocks.h"
 #include "hardware/gpio.h"
 #include "pico/time.h"
 #include <stdio.h>
-#include <math.h>
 
 static clock_phase_t current_phase = CLOCK_PHASE_BOOT;
+static clock_speed_t current_speed = CLOCK_SPEED_1MHZ;
 static uint slice_num;
 static uint channel;
+static bool held;                   // PHI2 stopped low (clock_control_hold)
 
-static void clock_control_set_frequency(uint32_t frequency_hz) {    
-    // Get system clock frequency
-    uint32_t sys_clk = clock_get_hz(clk_sys);
-    
-    // Calculate optimal PWM parameters for precise frequency generation
-    // PWM frequency = sys_clk / (divider * (wrap + 1))
-    // We want to maximize wrap for better resolution while staying within limits
-    
-    float best_divider = 1.0f;
-    uint32_t best_wrap = 0;
-    float best_error = 1.0f;
-    
-    // Try different divider values to find the best frequency match
-    for (uint32_t div_int = 1; div_int <= 255; div_int++) {
-        for (uint32_t div_frac = 0; div_frac < 16; div_frac++) {
-            float divider = div_int + (div_frac / 16.0f);
-            uint32_t wrap = (uint32_t)((float)sys_clk / (divider * frequency_hz)) - 1;
-            
-            if (wrap > 0 && wrap <= 65535) {
-                float actual_freq = (float)sys_clk / (divider * (wrap + 1));
-                float error = fabsf(actual_freq - frequency_hz) / frequency_hz;
-                
-                if (error < best_error) {
-                    best_error = error;
-                    best_divider = divider;
-                    best_wrap = wrap;
-                }
-            }
-        }
+// Divider settings computed once at init for the current system clock
+static clock_divider_t boot_divider;
+static clock_divider_t speed_dividers[CLOCK_SPEED_COUNT];
+
+// Divider currently programmed into the PWM slice
+static clock_divider_t active_divider;
+
+/**
+ * Program the PWM slice (50% duty cycle)
+ * TOP and the compare level are double-buffered by the PWM and latch at the
+ * next wrap. The divider only changes if it differs, so every table entry
+ * sharing a divider switches without a partial cycle. While held the level
+ * is 0, so the output stays low.
+ */
+static void clock_control_apply(const clock_divider_t *divider) {
+    if (divider->div_int != active_divider.div_int || divider->div_frac != active_divider.div_frac) {
+        pwm_set_clkdiv_int_frac4(slice_num, divider->div_int, divider->div_frac);
     }
-    
-    // Configure PWM with optimal parameters
-    pwm_config config = pwm_get_default_config();
-    pwm_config_set_clkdiv(&config, best_divider);
-    pwm_config_set_wrap(&config, best_wrap);
-    
-    // Set 50% duty cycle
-    uint32_t level = best_wrap / 2;
-    
-    // Apply configuration
-    pwm_init(slice_num, &config, false);
-    pwm_set_chan_level(slice_num, channel, level);
-    pwm_set_enabled(slice_num, true);
-        
-    printf("Clock frequency set to %lu Hz (divider: %.2f, wrap: %lu, error: %.4f%%)\n", 
-           frequency_hz, best_divider, best_wrap, best_error * 100.0f);
+    pwm_set_wrap(slice_num, divider->wrap);
+    pwm_set_chan_level(slice_num, channel, held ? 0 : (divider->wrap + 1) / 2);
+    active_divider = *divider;
 }
 
 void clock_control_init(void) {
@@ -71,9 +48,30 @@ void clock_control_init(void) {
     // Get PWM slice number and channel for GPIO 28
     slice_num = pwm_gpio_to_slice_num(GPIO_CLK_OUT);
     channel = pwm_gpio_to_channel(GPIO_CLK_OUT);
-        
+    
+    // Precompute the divider table for the current system clock
+    uint32_t sys_clk = clock_get_hz(clk_sys);
+    clock_control_compute_divider(sys_clk, CLOCK_FREQ_BOOT, &boot_divider);
+    for (int i = 0; i < CLOCK_SPEED_COUNT; i++) {
+        uint32_t frequency_hz = clock_control_speed_hz((clock_speed_t)i);
+        if (!frequency_hz) {
+            printf("Clock speed %d: above the validated bus timing, refused\n", i);
+            continue;
+        }
+        clock_control_compute_divider(sys_clk, frequency_hz, &speed_dividers[i]);
+        printf("Clock speed %d: %lu Hz (divider: %u + %u/16, wrap: %u)\n", i,
+               frequency_hz, speed_dividers[i].div_int,
+               speed_dividers[i].div_frac, speed_dividers[i].wrap);
+    }
+    
     // Start with boot phase frequency
-    clock_control_set_frequency(CLOCK_FREQ_BOOT);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv_int_frac4(&config, boot_divider.div_int, boot_divider.div_frac);
+    pwm_config_set_wrap(&config, boot_divider.wrap);
+    pwm_init(slice_num, &config, false);
+    pwm_set_chan_level(slice_num, channel, (boot_divider.wrap + 1) / 2);
+    pwm_set_enabled(slice_num, true);
+    active_divider = boot_divider;
     
     printf("Clock control initialized on GPIO %d (PWM slice %d, channel %d)\n", 
            GPIO_CLK_OUT, slice_num, channel);
@@ -84,23 +82,65 @@ void clock_control_set_phase(clock_phase_t phase) {
     
     switch (phase) {
         case CLOCK_PHASE_BOOT:
-            clock_control_set_frequency(CLOCK_FREQ_BOOT);
+            clock_control_apply(&boot_divider);
             break;
         case CLOCK_PHASE_NORMAL:
-            clock_control_set_frequency(CLOCK_FREQ_NORMAL);
+            clock_control_apply(&speed_dividers[current_speed]);
             break;
     }
 }
 
-void clock_control_reset(void) {
-    // Disable PWM
-    pwm_set_enabled(slice_num, false);
+void clock_control_set_speed(clock_speed_t speed) {
+    if (!clock_control_speed_hz(speed)) {
+        return;
+    }
     
-    // Reset to boot phase
-    current_phase = CLOCK_PHASE_BOOT;
+    current_speed = speed;
+    if (current_phase == CLOCK_PHASE_NORMAL) {
+        clock_control_apply(&speed_dividers[speed]);
+    }
+}
+
+clock_speed_t clock_control_get_speed(void) {
+    return current_speed;
+}
+
+bool clock_control_set_frequency_hz(uint32_t frequency_hz) {
+    clock_divider_t divider;
+    if (!clock_control_compute_divider(clock_get_hz(clk_sys), frequency_hz, &divider)) {
+        return false;
+    }
+    
+    clock_control_apply(&divider);
+    return true;
+}
+
+void clock_control_process(void) {
+    // The boot sequence owns the clock until the kernel is loaded
+    if (current_phase != CLOCK_PHASE_NORMAL) {
+        return;
+    }
     
-    // Reinitialize with boot frequency
-    clock_control_set_frequency(CLOCK_FREQ_BOOT);
+    // Speed code written by the 6502 (unknown and unvalidated codes are
+    // ignored)
+    uint8_t speed = indexed_memory_peek(IDX_CLOCK_CONTROL);
+    if (speed != current_speed && clock_control_speed_hz((clock_speed_t)speed)) {
+        clock_control_set_speed((clock_speed_t)speed);
+    }
+}
+
+void clock_control_hold(bool hold) {
+    // A zero level latches at the next wrap: the cycle in progress ends
+    // normally and PHI2 stays low from there
+    held = hold;
+    clock_control_apply(&active_divider);
+}
+
+void clock_control_reset(void) {
+    // Reset to boot phase at 1 MHz normal speed
+    current_phase = CLOCK_PHASE_BOOT;
+    current_speed = CLOCK_SPEED_1MHZ;
+    clock_control_apply(&boot_divider);
     
     printf("Clock control reset to boot phase\n");
-}
\ No newline at end of file
+}
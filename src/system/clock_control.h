@@ -18,8 +18,53 @@ typedef enum {
     CLOCK_PHASE_NORMAL
 } clock_phase_t;
 
+// Normal phase speed codes, selected by the 6502 through the clock control
+// index (IDX_CLOCK_CONTROL). Code 0 is the 1 MHz default so cleared memory
+// always means normal speed.
+typedef enum {
+    CLOCK_SPEED_1MHZ = 0,           // 1 MHz (timing-sensitive code)
+    CLOCK_SPEED_1_25MHZ,            // 1.25 MHz turbo
+    CLOCK_SPEED_1_5MHZ,             // 1.5 MHz turbo
+    CLOCK_SPEED_2MHZ,               // 2 MHz turbo (above BUS_MAX_VALIDATED_HZ by default)
+    CLOCK_SPEED_COUNT
+} clock_speed_t;
+
+// PWM divider settings for one frequency
+// PHI2 = sys_clk / ((div_int + div_frac / 16) * (wrap + 1))
+typedef struct {
+    uint32_t frequency_hz;          // Requested frequency
+    uint16_t wrap;                  // PWM counter wrap (TOP)
+    uint8_t div_int;                // Integer part of the clock divider (1-255)
+    uint8_t div_frac;               // Fractional part in 1/16ths (0-15)
+} clock_divider_t;
+
 void clock_control_init(void);
 void clock_control_set_phase(clock_phase_t phase);
 void clock_control_reset(void);
 
-#endif // CLOCK_CONTROL_H
\ No newline at end of file
+// Normal phase speed, switched from the precomputed divider table
+// (a few PWM register writes). Takes effect immediately in the normal
+// phase and is remembered across a boot phase.
+void clock_control_set_speed(clock_speed_t speed);
+clock_speed_t clock_control_get_speed(void);
+
+// Switch to an arbitrary frequency (computes the divider on the spot)
+// Returns false if the frequency cannot be generated from the system clock
+bool clock_control_set_frequency_hz(uint32_t frequency_hz);
+
+// Find the divider/wrap pair closest to frequency_hz for a given system clock
+bool clock_control_compute_divider(uint32_t sys_clk_hz, uint32_t frequency_hz, clock_divider_t *divider);
+
+// Frequency of a speed code, 0 for unknown codes and for codes above the bus
+// timing the PIO program is validated for (BUS_MAX_VALIDATED_HZ), which are
+// refused
+uint32_t clock_control_speed_hz(clock_speed_t speed);
+
+// Stop PHI2 low after the current cycle (the W65C02S is fully static) and
+// restart it at the programmed speed; speed changes meanwhile apply on release
+void clock_control_hold(bool hold);
+
+// Core 1 processing: apply speed changes written to the clock control index
+void clock_control_process(void);
+
+#endif // CLOCK_CONTROL_H
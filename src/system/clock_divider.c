@@ -0,0 +1,60 @@
+/**
+ * Clock Divider Computation
+ * Speed code table and PWM divider search, free of hardware access so the
+ * host tests can check them
+ */
+
+#include "clock_control.h"
+#include "config/bus_config.h"
+
+// Frequencies of the normal phase speed codes
+static const uint32_t speed_frequencies[CLOCK_SPEED_COUNT] = {
+    [CLOCK_SPEED_1MHZ]    = CLOCK_FREQ_NORMAL,
+    [CLOCK_SPEED_1_25MHZ] = 1250000,
+    [CLOCK_SPEED_1_5MHZ]  = 1500000,
+    [CLOCK_SPEED_2MHZ]    = 2000000,
+};
+
+uint32_t clock_control_speed_hz(clock_speed_t speed) {
+    if ((unsigned)speed >= CLOCK_SPEED_COUNT || speed_frequencies[speed] > BUS_MAX_VALIDATED_HZ) {
+        return 0;
+    }
+    return speed_frequencies[speed];
+}
+
+bool clock_control_compute_divider(uint32_t sys_clk_hz, uint32_t frequency_hz, clock_divider_t *divider) {
+    if (frequency_hz == 0) {
+        return false;
+    }
+    
+    // PWM frequency = sys_clk * 16 / (div16 * (wrap + 1)), with div16 the
+    // divider in 1/16ths. For each divider take the closest period and keep
+    // the smallest error; ties keep the smaller divider (finer resolution).
+    uint64_t target = (uint64_t)sys_clk_hz * 16;
+    uint64_t best_error = UINT64_MAX;
+    bool found = false;
+    
+    for (uint32_t div16 = 16; div16 <= 255 * 16 + 15; div16++) {
+        uint64_t step = (uint64_t)div16 * frequency_hz;
+        uint64_t period = (target + step / 2) / step;
+        if (period < 2 || period > 65536) {
+            continue;
+        }
+        
+        uint64_t actual = step * period;
+        uint64_t error = actual > target ? actual - target : target - actual;
+        if (error < best_error) {
+            best_error = error;
+            divider->frequency_hz = frequency_hz;
+            divider->wrap = (uint16_t)(period - 1);
+            divider->div_int = (uint8_t)(div16 >> 4);
+            divider->div_frac = (uint8_t)(div16 & 0x0F);
+            found = true;
+            if (error == 0) {
+                break;
+            }
+        }
+    }
+    
+    return found;
+}
@@ -0,0 +1,38 @@
+/**
+ * Flash store abstraction layer for MIA snapshots
+ * Provides a clean interface that can be mocked for testing
+ *
+ * A reserved area at the end of the flash, after the firmware and its
+ * embedded assets. It reads as memory (through the XIP cache) and is
+ * written a 4KB sector at a time. Writing stops all flash access, so the
+ * other core is paused and interrupts are off on the calling core for the
+ * whole erase and program (tens of ms per sector).
+ */
+
+#ifndef FLASH_STORE_H
+#define FLASH_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLASH_STORE_SECTOR_SIZE 4096
+
+/**
+ * Reserve size bytes (a multiple of FLASH_STORE_SECTOR_SIZE) at the end of
+ * the flash
+ *
+ * @return Memory-mapped view of the area, or NULL if it would overlap the
+ *         firmware
+ */
+const uint8_t *flash_store_init(uint32_t size);
+
+/**
+ * Erase one sector and program it with data (in RAM)
+ *
+ * @param offset Sector offset in the area
+ * @param data FLASH_STORE_SECTOR_SIZE bytes, or NULL to leave it erased
+ * @return false if the other core could not be paused (nothing written)
+ */
+bool flash_store_write_sector(uint32_t offset, const void *data);
+
+#endif // FLASH_STORE_H
@@ -0,0 +1,51 @@
+/**
+ * Hardware flash store implementation for the RP2350
+ *
+ * Sectors are erased and programmed with the SDK flash routines, run
+ * through flash_safe_execute(): it pauses the other core (which must have
+ * called flash_safe_execute_core_init()) and disables interrupts here, and
+ * the routines flush the XIP cache afterwards so the mapped view shows the
+ * new data.
+ */
+
+#include "flash_store.h"
+#include "hardware/flash.h"
+#include "hardware/regs/addressmap.h"
+#include "pico/flash.h"
+#include <stddef.h>
+
+#define FLASH_STORE_TIMEOUT_MS  100     // To pause the other core
+
+extern char __flash_binary_end;
+
+static uint32_t store_offset;           // Flash offset of the area
+
+typedef struct {
+    uint32_t offset;
+    const void *data;
+} sector_write_t;
+
+static void write_sector(void *param) {
+    const sector_write_t *write = (const sector_write_t *)param;
+    flash_range_erase(write->offset, FLASH_STORE_SECTOR_SIZE);
+    if (write->data) {
+        flash_range_program(write->offset, write->data, FLASH_STORE_SECTOR_SIZE);
+    }
+}
+
+const uint8_t *flash_store_init(uint32_t size) {
+    uint32_t firmware_end = (uint32_t)((uintptr_t)&__flash_binary_end - XIP_BASE);
+    if (size > PICO_FLASH_SIZE_BYTES || PICO_FLASH_SIZE_BYTES - size < firmware_end) {
+        return NULL;
+    }
+    store_offset = PICO_FLASH_SIZE_BYTES - size;
+    return (const uint8_t *)(uintptr_t)(XIP_BASE + store_offset);
+}
+
+bool flash_store_write_sector(uint32_t offset, const void *data) {
+    sector_write_t write = {
+        .offset = store_offset + offset,
+        .data = data
+    };
+    return flash_safe_execute(write_sector, &write, FLASH_STORE_TIMEOUT_MS) == PICO_OK;
+}
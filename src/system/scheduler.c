@@ -0,0 +1,87 @@
+/**
+ * MIA Core 1 Scheduler Implementation
+ */
+
+#include "scheduler.h"
+#include "pico/time.h"
+#include "hardware/sync.h"
+
+typedef struct {
+    scheduler_task_fn run;
+    uint32_t events;            // Events the task waits for
+    uint32_t period_us;         // 0 = events only
+    uint64_t next_us;           // Next periodic run
+    volatile uint32_t pending;  // Events signalled since the task last ran
+} scheduler_task_t;
+
+static scheduler_task_t tasks[SCHEDULER_MAX_TASKS];
+static uint8_t task_count;
+
+void scheduler_init(void) {
+    task_count = 0;
+}
+
+bool scheduler_add_task(scheduler_task_fn run, uint32_t events, uint32_t period_us) {
+    if (task_count == SCHEDULER_MAX_TASKS) {
+        return false;
+    }
+    scheduler_task_t *task = &tasks[task_count];
+    task->run = run;
+    task->events = events;
+    task->period_us = period_us;
+    task->next_us = 0;          // Periodic tasks run on the first pass
+    task->pending = 0;
+    __atomic_store_n(&task_count, task_count + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void scheduler_signal(uint32_t events) {
+    uint8_t count = __atomic_load_n(&task_count, __ATOMIC_ACQUIRE);
+    for (uint8_t i = 0; i < count; i++) {
+        if (tasks[i].events & events) {
+            __atomic_fetch_or(&tasks[i].pending, tasks[i].events & events, __ATOMIC_RELEASE);
+        }
+    }
+    __sev();
+}
+
+bool scheduler_run_next(uint64_t now_us, uint64_t *wake_us) {
+    uint64_t wake = UINT64_MAX;
+    for (uint8_t i = 0; i < task_count; i++) {
+        scheduler_task_t *task = &tasks[i];
+        bool due = task->period_us && now_us >= task->next_us;
+        if (!due && !__atomic_load_n(&task->pending, __ATOMIC_ACQUIRE)) {
+            if (task->period_us && task->next_us < wake) {
+                wake = task->next_us;
+            }
+            continue;
+        }
+
+        // Take the events before running: a signal during the run makes
+        // the task ready again
+        __atomic_exchange_n(&task->pending, 0, __ATOMIC_ACQUIRE);
+        if (task->period_us) {
+            task->next_us = now_us + task->period_us;
+        }
+        task->run();
+        return true;
+    }
+    *wake_us = wake;
+    return false;
+}
+
+void scheduler_run(void) {
+    while (true) {
+        uint64_t wake_us;
+        if (scheduler_run_next(time_us_64(), &wake_us)) {
+            continue;
+        }
+
+        // Sleep until an event (SEV) or the nearest deadline
+        if (wake_us == UINT64_MAX) {
+            __wfe();
+        } else {
+            best_effort_wfe_or_timeout(from_us_since_boot(wake_us));
+        }
+    }
+}
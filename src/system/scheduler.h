@@ -0,0 +1,62 @@
+/**
+ * MIA Core 1 Scheduler
+ *
+ * Cooperative scheduler for the Core 1 support tasks (video, USB, Wi-Fi,
+ * clock control). A task runs when one of its wakeup events was signalled
+ * or its period has passed, and never otherwise. Tasks are kept in
+ * priority order: after every task the scheduler starts again from the
+ * highest-priority ready one, so video waits for at most the task already
+ * running, whatever the others have to do. With nothing ready, Core 1
+ * sleeps in WFE until an event or the nearest deadline.
+ *
+ * Events are signalled from any core or interrupt handler with
+ * scheduler_signal(). It sets the event on every task that waits for it and
+ * then executes SEV. A signal that lands between the ready check and the
+ * WFE leaves the event register set, and the WFE then returns at once, so
+ * no wakeup is lost.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHEDULER_MAX_TASKS     8
+
+// Wakeup events
+#define SCHED_EVENT_USB         0x01    // USB stack event (TinyUSB interrupt)
+#define SCHED_EVENT_FRAME       0x02    // Frame latched at a frame boundary
+
+typedef void (*scheduler_task_fn)(void);
+
+// Remove all tasks
+void scheduler_init(void);
+
+/**
+ * Add a task, with lower priority than the tasks added before it
+ *
+ * @param run Task body, runs to completion
+ * @param events Events that make the task ready (SCHED_EVENT_*)
+ * @param period_us Also run this long after the previous run (0 = events only)
+ * @return false if SCHEDULER_MAX_TASKS tasks are already added
+ */
+bool scheduler_add_task(scheduler_task_fn run, uint32_t events, uint32_t period_us);
+
+// Make the tasks waiting for events ready and wake Core 1 (any core, IRQ safe)
+void scheduler_signal(uint32_t events);
+
+/**
+ * Run the highest-priority ready task
+ *
+ * @param now_us Current time
+ * @param wake_us Set, when no task is ready, to the nearest deadline
+ *                (UINT64_MAX with no periodic task)
+ * @return false if no task was ready
+ */
+bool scheduler_run_next(uint64_t now_us, uint64_t *wake_us);
+
+// Run tasks forever, sleeping while none is ready
+void scheduler_run(void);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,119 @@
+/**
+ * MIA Snapshot Implementation
+ */
+
+#include "snapshot.h"
+#include "irq/irq.h"
+#include <stddef.h>
+#include <string.h>
+
+#define SNAPSHOT_MAGIC          0x534E4150u     // "SNAP"
+#define SNAPSHOT_META_SIZE      (SNAPSHOT_META_SECTORS * FLASH_STORE_SECTOR_SIZE)
+
+// Changes to the saved structures make older snapshots unusable
+#define SNAPSHOT_LAYOUT         ((uint32_t)(SNAPSHOT_MEMORY_SECTORS << 16) | sizeof(snapshot_meta_t))
+
+typedef struct {
+    uint32_t magic;
+    uint32_t layout;                // SNAPSHOT_LAYOUT when saved
+    uint16_t irq_mask;
+    uint8_t irq_enable;
+    indexed_memory_state_t state;
+} snapshot_meta_t;
+
+_Static_assert(sizeof(snapshot_meta_t) <= SNAPSHOT_META_SIZE, "Snapshot meta data does not fit its sectors");
+_Static_assert(offsetof(snapshot_meta_t, layout) + sizeof(uint32_t) <= FLASH_STORE_SECTOR_SIZE,
+               "The magic and layout must be in the meta sector written last");
+
+// Meta sectors as programmed (the tail stays zero)
+static uint8_t meta_buffer[SNAPSHOT_META_SIZE] __attribute__((aligned(4)));
+
+static const uint8_t *area;             // Flash view, NULL until reserved
+
+static const uint8_t *snapshot_area(void) {
+    if (!area) {
+        area = flash_store_init(SNAPSHOT_SIZE);
+    }
+    return area;
+}
+
+/**
+ * Set the IDX_SNAPSHOT status byte (at the index's default address)
+ */
+static void set_status(uint8_t status) {
+    uint32_t addr = indexed_memory_get_config_field(IDX_SNAPSHOT, CFG_DEFAULT_L) |
+                    ((uint32_t)indexed_memory_get_config_field(IDX_SNAPSHOT, CFG_DEFAULT_M) << 8) |
+                    ((uint32_t)indexed_memory_get_config_field(IDX_SNAPSHOT, CFG_DEFAULT_H) << 16);
+    indexed_memory_write_address(addr, status);
+}
+
+/**
+ * Rewrite one sector if it differs from its flash copy
+ */
+static bool update_sector(uint32_t sector, const uint8_t *data) {
+    uint32_t offset = sector * FLASH_STORE_SECTOR_SIZE;
+    if (memcmp(&area[offset], data, FLASH_STORE_SECTOR_SIZE) == 0) {
+        return true;
+    }
+    return flash_store_write_sector(offset, data);
+}
+
+bool snapshot_save(void) {
+    if (!snapshot_area()) {
+        return false;
+    }
+    
+    // In the saved memory too, so an unchanged machine rewrites nothing
+    set_status(SNAPSHOT_STATUS_SAVED);
+    
+    memset(meta_buffer, 0, sizeof(meta_buffer));
+    snapshot_meta_t *meta = (snapshot_meta_t *)meta_buffer;
+    meta->magic = SNAPSHOT_MAGIC;
+    meta->layout = SNAPSHOT_LAYOUT;
+    meta->irq_mask = irq_get_mask();
+    meta->irq_enable = irq_get_enable();
+    indexed_memory_get_state(&meta->state);
+    
+    const uint8_t *memory = indexed_memory_get_range(0, INDEXED_MEMORY_SIZE);
+    bool changed = memcmp(area, meta_buffer, SNAPSHOT_META_SIZE) != 0;
+    for (uint32_t i = 0; i < SNAPSHOT_MEMORY_SECTORS && !changed; i++) {
+        changed = memcmp(&area[(SNAPSHOT_META_SECTORS + i) * FLASH_STORE_SECTOR_SIZE],
+                         &memory[i * FLASH_STORE_SECTOR_SIZE], FLASH_STORE_SECTOR_SIZE) != 0;
+    }
+    if (!changed) {
+        return true;
+    }
+    
+    // Invalidate first, validate last
+    bool ok = flash_store_write_sector(0, NULL);
+    for (uint32_t i = 0; i < SNAPSHOT_MEMORY_SECTORS && ok; i++) {
+        ok = update_sector(SNAPSHOT_META_SECTORS + i, &memory[i * FLASH_STORE_SECTOR_SIZE]);
+    }
+    for (uint32_t i = SNAPSHOT_META_SECTORS; i-- > 0 && ok; ) {
+        ok = update_sector(i, &meta_buffer[i * FLASH_STORE_SECTOR_SIZE]);
+    }
+    
+    if (!ok) {
+        set_status(SNAPSHOT_STATUS_FAILED);
+    }
+    return ok;
+}
+
+bool snapshot_restore(void) {
+    if (!snapshot_area()) {
+        return false;
+    }
+    const snapshot_meta_t *meta = (const snapshot_meta_t *)area;
+    if (meta->magic != SNAPSHOT_MAGIC || meta->layout != SNAPSHOT_LAYOUT) {
+        return false;
+    }
+    
+    memcpy(indexed_memory_get_range(0, INDEXED_MEMORY_SIZE),
+           &area[SNAPSHOT_META_SECTORS * FLASH_STORE_SECTOR_SIZE], INDEXED_MEMORY_SIZE);
+    indexed_memory_set_state(&meta->state);
+    irq_set_mask(meta->irq_mask);
+    irq_set_enable(meta->irq_enable);
+    
+    set_status(SNAPSHOT_STATUS_RESUMED);
+    return true;
+}
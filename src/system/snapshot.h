@@ -0,0 +1,57 @@
+/**
+ * MIA Snapshot
+ *
+ * CMD_SNAPSHOT_SAVE writes MIA memory (the 256KB SRAM), the index table,
+ * DMA configuration and IRQ mask/enable to a reserved area at the end of
+ * the flash (the video state is all in MIA memory); at power-up they are loaded back before the
+ * boot sequence, so a kernel that finds SNAPSHOT_STATUS_RESUMED in its
+ * IDX_SNAPSHOT byte can pick up where it left off instead of
+ * reinitializing.
+ *
+ * Saves only rewrite the sectors that differ from the flash copy. The meta
+ * sector holding the magic is erased first and programmed last, so a save
+ * cut short by a power loss leaves no snapshot rather than a torn one.
+ * Flash writes stop the bus interface, video and all flash access for tens
+ * of ms per sector: the caller holds the 6502 clock meanwhile.
+ *
+ * Not saved: queued DMA copies (the caller waits for them), pending IRQ
+ * causes (the 6502 cold boots), PSRAM and the boot phase state; the boot
+ * sequence reloads the kernel, rewriting the boot cache and kernel ring.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system/flash_store.h"
+#include "indexed_memory/indexed_memory.h"
+
+// IDX_SNAPSHOT status byte
+#define SNAPSHOT_STATUS_NONE        0   // Cold boot, no snapshot loaded
+#define SNAPSHOT_STATUS_RESUMED     1   // Memory and state loaded from a snapshot at power-up
+#define SNAPSHOT_STATUS_SAVED       2   // Last CMD_SNAPSHOT_SAVE succeeded
+#define SNAPSHOT_STATUS_FAILED      3   // Last CMD_SNAPSHOT_SAVE failed (no snapshot left)
+
+// Flash layout: meta sectors (magic and state), then MIA memory
+#define SNAPSHOT_META_SECTORS       2
+#define SNAPSHOT_MEMORY_SECTORS     (INDEXED_MEMORY_SIZE / FLASH_STORE_SECTOR_SIZE)
+#define SNAPSHOT_SIZE               ((SNAPSHOT_META_SECTORS + SNAPSHOT_MEMORY_SECTORS) * FLASH_STORE_SECTOR_SIZE)
+
+/**
+ * Save a snapshot (Core 0, with the 6502 clock held and no DMA copies in
+ * flight); sets the IDX_SNAPSHOT status
+ *
+ * @return false if the flash area is unavailable or a write failed
+ */
+bool snapshot_save(void);
+
+/**
+ * Load the snapshot, if any, after indexed_memory_init() and before the
+ * boot sequence; sets the IDX_SNAPSHOT status to SNAPSHOT_STATUS_RESUMED
+ *
+ * @return true if a snapshot was loaded
+ */
+bool snapshot_restore(void);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,239 @@
+/**
+ * MIA Hardware-in-the-Loop Timing Bench Implementation
+ */
+
+#include "timing_bench.h"
+#include "system/clock_control.h"
+#include "bus_interface/bus_timing.h"
+#include "bus_interface/bus_sync_pio.h"
+#include "bus_interface/bus_write_queue.h"
+#include "pico/time.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef enum {
+    BENCH_STATE_WAIT,           // Start delay
+    BENCH_STATE_SETTLE,         // New frequency applied
+    BENCH_STATE_DWELL,          // Watching the program
+    BENCH_STATE_DONE            // Result repeated
+} bench_state_t;
+
+static struct {
+    bench_state_t state;
+    uint32_t sys_hz;
+    uint32_t frequency_hz;
+    uint32_t deadline_us;       // End of the current state
+    uint16_t iterations;        // Mailbox pass count when the dwell started
+    uint8_t overflow;           // Write queue overflow count when the dwell started
+    uint8_t early_reads;        // Early READ count when the dwell started
+    bool rx_overflow;           // Seen during the dwell
+    timing_bench_result_t result;
+} bench;
+
+static const char *const fail_names[] = {
+    [TIMING_BENCH_FAIL_NONE]        = "pass",
+    [TIMING_BENCH_FAIL_CHECK]       = "6502 check failed",
+    [TIMING_BENCH_FAIL_STALLED]     = "6502 stalled",
+    [TIMING_BENCH_FAIL_RX_OVERFLOW] = "RX FIFO overflow",
+    [TIMING_BENCH_FAIL_WRITE_QUEUE] = "writes dropped",
+    [TIMING_BENCH_FAIL_EARLY_READ]  = "read ahead of a write",
+    [TIMING_BENCH_FAIL_MARGIN]      = "deadline missed",
+    [TIMING_BENCH_FAIL_LIMIT]       = "frequency limit",
+};
+
+static const char *const check_names[] = {
+    [TIMING_BENCH_CHECK_NONE]        = "none",
+    [TIMING_BENCH_CHECK_DATA_PORT]   = "DATA_PORT",
+    [TIMING_BENCH_CHECK_IDX_SELECT]  = "IDX_SELECT",
+    [TIMING_BENCH_CHECK_CFG_DATA]    = "CFG_DATA",
+    [TIMING_BENCH_CHECK_COPY]        = "COPY_BLOCK",
+    [TIMING_BENCH_CHECK_IRQ_MASK]    = "IRQ_MASK",
+    [TIMING_BENCH_CHECK_WRITE_QUEUE] = "WRITE_QUEUE_OVERFLOW",
+};
+
+static const uint8_t margin_phases[TIMING_BENCH_MARGINS] = {
+    [TIMING_BENCH_MARGIN_PREPARE] = BUS_TIMING_PHASE_PREPARE,
+    [TIMING_BENCH_MARGIN_PUSH]    = BUS_TIMING_PHASE_PUSH,
+};
+
+static inline bool deadline_passed(uint32_t now, uint32_t deadline) {
+    return (int32_t)(now - deadline) >= 0;
+}
+
+static uint8_t mailbox(uint8_t offset) {
+    return indexed_memory_peek_address(TIMING_BENCH_MAILBOX + offset);
+}
+
+static uint16_t mailbox_iterations(void) {
+    return mailbox(TIMING_BENCH_MB_ITERATIONS) | (mailbox(TIMING_BENCH_MB_ITERATIONS + 1) << 8);
+}
+
+static int32_t cycles_to_ns(uint32_t cycles) {
+    return (int32_t)((uint64_t)cycles * 1000000000u / bench.sys_hz);
+}
+
+int32_t timing_bench_deadline_ns(uint32_t frequency_hz, uint8_t margin) {
+    int32_t period_ns = (int32_t)(1000000000u / frequency_hz);
+    if (margin == TIMING_BENCH_MARGIN_PREPARE) {
+        return period_ns / 2 + TIMING_BENCH_RW_SAMPLE_NS - TIMING_BENCH_CS_SAMPLE_NS;
+    }
+    return period_ns - TIMING_BENCH_READ_SETUP_NS - TIMING_BENCH_CS_SAMPLE_NS;
+}
+
+static void log_step(const timing_bench_step_t *step) {
+    printf("[Bench] %7lu Hz: %5u passes", (unsigned long)step->frequency_hz, step->iterations);
+    for (int m = 0; m < TIMING_BENCH_MARGINS; m++) {
+        const char *name = (m == TIMING_BENCH_MARGIN_PREPARE) ? "prepare" : "push";
+        if (step->has_margin[m]) {
+            printf(", %s margin %ld ns", name, (long)step->margin_ns[m]);
+        } else {
+            printf(", %s margin n/a", name);
+        }
+    }
+    printf(": %s\n", fail_names[step->fail]);
+}
+
+static void report(void) {
+    const timing_bench_step_t *last = &bench.result.last;
+    printf("[Bench] Max safe PHI2: %lu Hz", (unsigned long)bench.result.max_pass_hz);
+    if (last->fail == TIMING_BENCH_FAIL_LIMIT) {
+        printf(" (sweep ended at %lu Hz without a failure)\n", (unsigned long)last->frequency_hz);
+    } else if (last->fail == TIMING_BENCH_FAIL_CHECK) {
+        printf(" (first failure at %lu Hz: %s %s, read 0x%02X, expected 0x%02X)\n",
+               (unsigned long)last->frequency_hz, fail_names[last->fail],
+               last->check < sizeof(check_names) / sizeof(check_names[0]) ? check_names[last->check] : "unknown",
+               last->got, last->expected);
+    } else {
+        printf(" (first failure at %lu Hz: %s)\n", (unsigned long)last->frequency_hz, fail_names[last->fail]);
+    }
+}
+
+/**
+ * Stop the sweep at a step and fall back to the last passing frequency
+ */
+static void finish(const timing_bench_step_t *step, uint32_t now) {
+    bench.result.done = true;
+    bench.result.last = *step;
+    clock_control_set_frequency_hz(bench.result.max_pass_hz ? bench.result.max_pass_hz : TIMING_BENCH_FREQ_START_HZ);
+    report();
+    bench.state = BENCH_STATE_DONE;
+    bench.deadline_us = now + TIMING_BENCH_REPORT_PERIOD_US;
+}
+
+static void start_step(uint32_t frequency_hz, uint32_t now) {
+    if (frequency_hz > TIMING_BENCH_FREQ_MAX_HZ || !clock_control_set_frequency_hz(frequency_hz)) {
+        timing_bench_step_t step = { .frequency_hz = frequency_hz, .fail = TIMING_BENCH_FAIL_LIMIT };
+        finish(&step, now);
+        return;
+    }
+    bench.frequency_hz = frequency_hz;
+    bench.state = BENCH_STATE_SETTLE;
+    bench.deadline_us = now + TIMING_BENCH_SETTLE_US;
+}
+
+/**
+ * Judge the dwell that just ended
+ */
+static void evaluate(timing_bench_step_t *step) {
+    *step = (timing_bench_step_t){ .frequency_hz = bench.frequency_hz };
+    step->iterations = (uint16_t)(mailbox_iterations() - bench.iterations);
+    
+    // Interrupts held off delay the handler entry, so every phase pays the worst of it
+    bus_timing_phase_t phase;
+    bus_timing_get_phase(BUS_TIMING_PHASE_MASKED, &phase);
+    int32_t masked_ns = phase.count ? cycles_to_ns(phase.max) : 0;
+    bool missed = false;
+    for (int m = 0; m < TIMING_BENCH_MARGINS; m++) {
+        bus_timing_get_phase(margin_phases[m], &phase);
+        if (phase.count == 0) {
+            continue;
+        }
+        step->has_margin[m] = true;
+        step->margin_ns[m] = timing_bench_deadline_ns(bench.frequency_hz, m) - masked_ns - cycles_to_ns(phase.max);
+        missed |= step->margin_ns[m] < 0;
+    }
+    
+    step->check = mailbox(TIMING_BENCH_MB_CHECK);
+    if (step->check != TIMING_BENCH_CHECK_NONE) {
+        step->fail = TIMING_BENCH_FAIL_CHECK;
+        step->got = mailbox(TIMING_BENCH_MB_GOT);
+        step->expected = mailbox(TIMING_BENCH_MB_EXPECTED);
+    } else if (bench.rx_overflow) {
+        step->fail = TIMING_BENCH_FAIL_RX_OVERFLOW;
+    } else if (bus_write_queue_get_overflow() != bench.overflow) {
+        step->fail = TIMING_BENCH_FAIL_WRITE_QUEUE;
+    } else if (bus_write_queue_get_early_reads() != bench.early_reads) {
+        step->fail = TIMING_BENCH_FAIL_EARLY_READ;
+    } else if (step->iterations == 0) {
+        step->fail = TIMING_BENCH_FAIL_STALLED;
+    } else if (missed) {
+        step->fail = TIMING_BENCH_FAIL_MARGIN;
+    }
+}
+
+void timing_bench_init(uint32_t sys_hz) {
+    memset(&bench, 0, sizeof(bench));
+    bench.sys_hz = sys_hz;
+    bench.state = BENCH_STATE_WAIT;
+    bench.deadline_us = time_us_32() + TIMING_BENCH_START_DELAY_US;
+    printf("[Bench] PHI2 sweep from %lu Hz in %lu Hz steps starts in %lu s\n",
+           (unsigned long)TIMING_BENCH_FREQ_START_HZ, (unsigned long)TIMING_BENCH_FREQ_STEP_HZ,
+           (unsigned long)(TIMING_BENCH_START_DELAY_US / 1000000));
+}
+
+void timing_bench_process(void) {
+    uint32_t now = time_us_32();
+    
+    // RX overflow is latched between checks: poll it through the dwell
+    // (an empty TX FIFO is the normal idle state, so underflow is not used)
+    if (bench.state == BENCH_STATE_DWELL) {
+        bool rx_overflow;
+        bus_sync_pio_check_fifo_errors(&rx_overflow, NULL);
+        bench.rx_overflow |= rx_overflow;
+    }
+    
+    if (!deadline_passed(now, bench.deadline_us)) {
+        return;
+    }
+    
+    switch (bench.state) {
+        case BENCH_STATE_WAIT:
+            start_step(TIMING_BENCH_FREQ_START_HZ, now);
+            break;
+    
+        case BENCH_STATE_SETTLE:
+            bus_timing_reset();
+            bench.iterations = mailbox_iterations();
+            bench.overflow = bus_write_queue_get_overflow();
+            bench.early_reads = bus_write_queue_get_early_reads();
+            // Clear what the settle time left latched
+            bus_sync_pio_check_fifo_errors(&bench.rx_overflow, NULL);
+            bench.rx_overflow = false;
+            bench.state = BENCH_STATE_DWELL;
+            bench.deadline_us = now + TIMING_BENCH_DWELL_US;
+            break;
+    
+        case BENCH_STATE_DWELL: {
+            timing_bench_step_t step;
+            evaluate(&step);
+            log_step(&step);
+            if (step.fail != TIMING_BENCH_FAIL_NONE) {
+                finish(&step, now);
+            } else {
+                bench.result.max_pass_hz = step.frequency_hz;
+                bench.result.last = step;
+                start_step(step.frequency_hz + TIMING_BENCH_FREQ_STEP_HZ, now);
+            }
+            break;
+        }
+    
+        case BENCH_STATE_DONE:
+            report();
+            bench.deadline_us = now + TIMING_BENCH_REPORT_PERIOD_US;
+            break;
+    }
+}
+
+const timing_bench_result_t *timing_bench_get_result(void) {
+    return &bench.result;
+}
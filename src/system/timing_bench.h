@@ -0,0 +1,128 @@
+/**
+ * MIA Hardware-in-the-Loop Timing Bench
+ *
+ * Core 1 task of the mia_timing_bench firmware (CONFIG_MIA_TIMING_BENCH),
+ * which boots the built-in 6502 test program of timing_bench_program.c
+ * instead of kernel.bin. The program loops over every register type and a
+ * DMA copy, checking what it reads back, and counts passes in a mailbox in
+ * MIA memory.
+ *
+ * The task steps PHI2 upward from TIMING_BENCH_FREQ_START_HZ. At each
+ * frequency it lets the bus settle, clears the bus timing statistics and
+ * watches the program for TIMING_BENCH_DWELL_US. A step fails when the
+ * program reports a check, stops counting, the bus RX FIFO overflows, a
+ * 6502 write is dropped, a read is answered ahead of an earlier write, or
+ * the slowest handler sample misses its deadline.
+ * Every step is logged on the USB console with the per-phase margins; the
+ * sweep stops at the first failure, drops PHI2 back to the last passing
+ * frequency and repeats the result every TIMING_BENCH_REPORT_PERIOD_US.
+ *
+ * Margins are measured from bus IRQ entry, when the PIO samples CS
+ * (TIMING_BENCH_CS_SAMPLE_NS after PHI2 falls), plus the worst time Core 0
+ * held interrupts off (MASKED):
+ * - PREPARE: read data ready by the OE/WE sample, 30ns after PHI2 rises
+ * - PUSH:    response pushed by the read data setup time before PHI2 falls
+ */
+
+#ifndef TIMING_BENCH_H
+#define TIMING_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "indexed_memory/indexed_memory.h"
+
+// Sweep
+#define TIMING_BENCH_FREQ_START_HZ      1000000     // CLOCK_FREQ_NORMAL
+#define TIMING_BENCH_FREQ_STEP_HZ       50000
+#define TIMING_BENCH_FREQ_MAX_HZ        8000000
+#define TIMING_BENCH_START_DELAY_US     5000000     // Time to open the USB console
+#define TIMING_BENCH_SETTLE_US          20000       // After each frequency change
+#define TIMING_BENCH_DWELL_US           250000      // Watched per frequency
+#define TIMING_BENCH_REPORT_PERIOD_US   5000000     // Result repeated once done
+#define TIMING_BENCH_TASK_PERIOD_US     10000
+
+// Bus cycle deadlines (docs/bus_timing.md)
+#define TIMING_BENCH_CS_SAMPLE_NS       200         // IRQ entry after PHI2 falls
+#define TIMING_BENCH_RW_SAMPLE_NS       30          // OE/WE sample after PHI2 rises
+#define TIMING_BENCH_READ_SETUP_NS      15          // Read data valid before PHI2 falls
+
+// Mailbox written by the 6502 program (start of the user area)
+#define TIMING_BENCH_MAILBOX            INDEXED_MEMORY_USER_AREA_BASE
+#define TIMING_BENCH_MB_ITERATIONS      0           // Passes, 16-bit little endian
+#define TIMING_BENCH_MB_CHECK           2           // Failed check (TIMING_BENCH_CHECK_*), 0 = none
+#define TIMING_BENCH_MB_GOT             3           // Byte read by the failed check
+#define TIMING_BENCH_MB_EXPECTED        4           // Byte it expected
+#define TIMING_BENCH_MAILBOX_SIZE       5
+
+// Checks of the 6502 program
+#define TIMING_BENCH_CHECK_NONE         0
+#define TIMING_BENCH_CHECK_DATA_PORT    1           // DATA_PORT write, then read back
+#define TIMING_BENCH_CHECK_IDX_SELECT   2           // IDX_SELECT read back
+#define TIMING_BENCH_CHECK_CFG_DATA     3           // ADDR_L through CFG_DATA after 64 steps
+#define TIMING_BENCH_CHECK_COPY         4           // COPY_BLOCK result through DATA_PORT
+#define TIMING_BENCH_CHECK_IRQ_MASK     5           // IRQ_MASK_LOW read back
+#define TIMING_BENCH_CHECK_WRITE_QUEUE  6           // WRITE_QUEUE_OVERFLOW still 0
+
+// Why a step failed
+typedef enum {
+    TIMING_BENCH_FAIL_NONE = 0,
+    TIMING_BENCH_FAIL_CHECK,        // The 6502 program reported a check
+    TIMING_BENCH_FAIL_STALLED,      // The 6502 program stopped counting passes
+    TIMING_BENCH_FAIL_RX_OVERFLOW,  // Bus RX FIFO (or ring) overflowed
+    TIMING_BENCH_FAIL_WRITE_QUEUE,  // 6502 writes were dropped
+    TIMING_BENCH_FAIL_EARLY_READ,   // A read was answered ahead of an earlier write
+    TIMING_BENCH_FAIL_MARGIN,       // A handler phase missed its deadline
+    TIMING_BENCH_FAIL_LIMIT         // PHI2 cannot be generated (sweep end, not a failure)
+} timing_bench_fail_t;
+
+// Margins of the handler phases with a deadline
+#define TIMING_BENCH_MARGIN_PREPARE     0
+#define TIMING_BENCH_MARGIN_PUSH        1
+#define TIMING_BENCH_MARGINS            2
+
+// Outcome of one frequency
+typedef struct {
+    uint32_t frequency_hz;
+    uint16_t iterations;                        // Program passes during the dwell
+    timing_bench_fail_t fail;
+    uint8_t check;                              // TIMING_BENCH_CHECK_* (TIMING_BENCH_FAIL_CHECK)
+    uint8_t got;
+    uint8_t expected;
+    bool has_margin[TIMING_BENCH_MARGINS];      // Phase has samples
+    int32_t margin_ns[TIMING_BENCH_MARGINS];    // Deadline minus the slowest sample
+} timing_bench_step_t;
+
+// Sweep result
+typedef struct {
+    bool done;
+    uint32_t max_pass_hz;                       // Highest passing frequency, 0 = none
+    timing_bench_step_t last;                   // Last step: the failure once done
+} timing_bench_result_t;
+
+/**
+ * Start the sweep (Core 1, once the boot sequence is complete)
+ *
+ * @param sys_hz System clock in Hz, to convert cycle counts to ns
+ */
+void timing_bench_init(uint32_t sys_hz);
+
+/**
+ * Core 1 scheduler task: advance the sweep
+ */
+void timing_bench_process(void);
+
+/**
+ * Get the sweep result
+ */
+const timing_bench_result_t *timing_bench_get_result(void);
+
+/**
+ * Deadline of a handler phase, from IRQ entry
+ *
+ * @param frequency_hz PHI2 frequency
+ * @param margin TIMING_BENCH_MARGIN_*
+ * @return Nanoseconds, negative if PHI2 is too fast for the phase at all
+ */
+int32_t timing_bench_deadline_ns(uint32_t frequency_hz, uint8_t margin);
+
+#endif // TIMING_BENCH_H
@@ -0,0 +1,209 @@
+/**
+ * MIA Timing Bench 6502 Program
+ *
+ * Boot image of the mia_timing_bench firmware, linked in place of the
+ * kernel_data.c generated from kernel.bin: the boot loader streams it to
+ * $4000 and jumps there like any kernel.
+ *
+ * The program configures indexes 128-130, then loops forever over every
+ * register type the bus path serves: IDX_SELECT, DATA_PORT,
+ * CFG_FIELD_SELECT/CFG_DATA, window COMMAND, bank bytes, DEVICE_STATUS,
+ * IRQ_CAUSE, IRQ_MASK, WRITE_QUEUE_OVERFLOW and SHARED_COMMAND with a DMA
+ * COPY_BLOCK. The pattern changes every pass. The timing registers are left
+ * alone: a TIMING_DATA write would clear the statistics the bench reads.
+ *
+ * Results go to the mailbox at TIMING_BENCH_MAILBOX (system/timing_bench.h)
+ * through the bank bytes of window D: the pass count, and on the first
+ * failed check its number with the byte read and the byte expected, after
+ * which the program stops.
+ */
+
+#include "rom_emulation/kernel_data.h"
+#include "system/timing_bench.h"
+
+// The program hard-codes the mailbox and buffer addresses
+_Static_assert(TIMING_BENCH_MAILBOX == 0x013800, "Timing bench program expects the mailbox at $013800");
+
+// Memory addresses shown are the 6502 CPU addresses ($4000 on)
+const uint8_t kernel_data[] = {
+    // === Entry Point ($4000) ===
+    0x78,                    // $4000: SEI - Disable interrupts
+    0xD8,                    // $4001: CLD - Clear decimal mode
+    0xA2, 0xFF,              // $4002-$4003: LDX #$FF
+    0x9A,                    // $4004: TXS - Reset the stack
+    0xA2, 0x00,              // $4005-$4006: LDX #$00 - Table offset
+    
+    // Configure indexes 128-130 from IDX_TABLE, 11 fields each
+    // through CFG_DATA with field auto-increment
+    // CFG_NEXT: ($4007)
+    0xBD, 0x2E, 0x41,        // $4007-$4009: LDA $412E,X (IDX_TABLE) - Index number, 0 ends the table
+    0xF0, 0x17,              // $400A-$400B: BEQ $4023 (CFG_DONE)
+    0x8D, 0x00, 0xC0,        // $400C-$400E: STA $C000 - Window A IDX_SELECT
+    0xA9, 0x80,              // $400F-$4010: LDA #$80
+    0x8D, 0x02, 0xC0,        // $4011-$4013: STA $C002 - CFG_FIELD_SELECT = ADDR_L, auto-increment
+    0xE8,                    // $4014: INX
+    0xA0, 0x0B,              // $4015-$4016: LDY #$0B - Field count
+    // CFG_FIELD: ($4017)
+    0xBD, 0x2E, 0x41,        // $4017-$4019: LDA $412E,X (IDX_TABLE)
+    0x8D, 0x03, 0xC0,        // $401A-$401C: STA $C003 - CFG_DATA
+    0xE8,                    // $401D: INX
+    0x88,                    // $401E: DEY
+    0xD0, 0xF6,              // $401F-$4020: BNE $4017 (CFG_FIELD)
+    0xF0, 0xE4,              // $4021-$4022: BEQ $4007 (CFG_NEXT) - Always taken
+    
+    // Copy fields (128 -> 129, 64 bytes), then window B on index 128,
+    // C on 129 and D on 130 in bank mode (mailbox at $C035-$C039)
+    // CFG_DONE: ($4023)
+    0xA9, 0x8B,              // $4023-$4024: LDA #$8B
+    0x8D, 0x02, 0xC0,        // $4025-$4027: STA $C002 - CFG_FIELD_SELECT = COPY_SRC_IDX, auto-increment
+    0xA9, 0x80,              // $4028-$4029: LDA #$80
+    0x8D, 0x03, 0xC0,        // $402A-$402C: STA $C003 - COPY_SRC_IDX
+    0xA9, 0x81,              // $402D-$402E: LDA #$81
+    0x8D, 0x03, 0xC0,        // $402F-$4031: STA $C003 - COPY_DST_IDX
+    0xA9, 0x40,              // $4032-$4033: LDA #$40
+    0x8D, 0x03, 0xC0,        // $4034-$4036: STA $C003 - COPY_COUNT_L
+    0xA9, 0x00,              // $4037-$4038: LDA #$00
+    0x8D, 0x03, 0xC0,        // $4039-$403B: STA $C003 - COPY_COUNT_H
+    0xA9, 0x80,              // $403C-$403D: LDA #$80
+    0x8D, 0x10, 0xC0,        // $403E-$4040: STA $C010 - Window B IDX_SELECT
+    0xA9, 0x81,              // $4041-$4042: LDA #$81
+    0x8D, 0x20, 0xC0,        // $4043-$4045: STA $C020 - Window C IDX_SELECT
+    0xA9, 0x82,              // $4046-$4047: LDA #$82
+    0x8D, 0x30, 0xC0,        // $4048-$404A: STA $C030 - Window D IDX_SELECT
+    0xA9, 0x07,              // $404B-$404C: LDA #$07
+    0x8D, 0x34, 0xC0,        // $404D-$404F: STA $C034 - Window D COMMAND = BANK_ENABLE
+    0xA9, 0x00,              // $4050-$4051: LDA #$00
+    0x8D, 0x35, 0xC0,        // $4052-$4054: STA $C035 - Iterations low
+    0x8D, 0x36, 0xC0,        // $4055-$4057: STA $C036 - Iterations high
+    0x8D, 0x37, 0xC0,        // $4058-$405A: STA $C037 - Failed check
+    0x8D, 0x38, 0xC0,        // $405B-$405D: STA $C038 - Byte read
+    0x8D, 0x39, 0xC0,        // $405E-$4060: STA $C039 - Byte expected
+    0x85, 0x00,              // $4061-$4062: STA $00 - Pattern seed
+    
+    // === Test Loop ===
+    // DATA_PORT writes: 64 pattern bytes (offset XOR seed) through window A
+    // LOOP: ($4063)
+    0xA9, 0x80,              // $4063-$4064: LDA #$80
+    0x8D, 0x00, 0xC0,        // $4065-$4067: STA $C000 - Window A IDX_SELECT
+    0xA9, 0x01,              // $4068-$4069: LDA #$01
+    0x8D, 0x04, 0xC0,        // $406A-$406C: STA $C004 - Window A COMMAND = RESET_INDEX
+    0xA2, 0x00,              // $406D-$406E: LDX #$00
+    // WRITE: ($406F)
+    0x8A,                    // $406F: TXA
+    0x45, 0x00,              // $4070-$4071: EOR $00
+    0x8D, 0x01, 0xC0,        // $4072-$4074: STA $C001 - Window A DATA_PORT
+    0xE8,                    // $4075: INX
+    0xE0, 0x40,              // $4076-$4077: CPX #$40
+    0xD0, 0xF5,              // $4078-$4079: BNE $406F (WRITE)
+    0xA9, 0x01,              // $407A-$407B: LDA #$01
+    0x8D, 0x14, 0xC0,        // $407C-$407E: STA $C014 - Window B COMMAND = RESET_INDEX
+    0xA2, 0x00,              // $407F-$4080: LDX #$00
+    0xA0, 0x01,              // $4081-$4082: LDY #$01
+    
+    // DATA_PORT reads: the pattern back through window B (check 1)
+    // READ: ($4083)
+    0x8A,                    // $4083: TXA
+    0x45, 0x00,              // $4084-$4085: EOR $00
+    0x85, 0x01,              // $4086-$4087: STA $01 - Expected byte
+    0xAD, 0x11, 0xC0,        // $4088-$408A: LDA $C011 - Window B DATA_PORT
+    0xC5, 0x01,              // $408B-$408C: CMP $01
+    0xD0, 0x26,              // $408D-$408E: BNE $40B5 (FAIL)
+    0xE8,                    // $408F: INX
+    0xE0, 0x40,              // $4090-$4091: CPX #$40
+    0xD0, 0xEF,              // $4092-$4093: BNE $4083 (READ)
+    0xA0, 0x02,              // $4094-$4095: LDY #$02 - Check 2: IDX_SELECT reads back
+    0xA9, 0x80,              // $4096-$4097: LDA #$80
+    0x85, 0x01,              // $4098-$4099: STA $01
+    0xAD, 0x10, 0xC0,        // $409A-$409C: LDA $C010 - Window B IDX_SELECT
+    0xC5, 0x01,              // $409D-$409E: CMP $01
+    0xD0, 0x14,              // $409F-$40A0: BNE $40B5 (FAIL)
+    0xA0, 0x03,              // $40A1-$40A2: LDY #$03 - Check 3: CFG_DATA shows ADDR_L stepped by 64
+    0xA9, 0x40,              // $40A3-$40A4: LDA #$40
+    0x85, 0x01,              // $40A5-$40A6: STA $01
+    0xA9, 0x00,              // $40A7-$40A8: LDA #$00
+    0x8D, 0x12, 0xC0,        // $40A9-$40AB: STA $C012 - Window B CFG_FIELD_SELECT = ADDR_L
+    0xAD, 0x13, 0xC0,        // $40AC-$40AE: LDA $C013 - Window B CFG_DATA
+    0xC5, 0x01,              // $40AF-$40B0: CMP $01
+    0xD0, 0x02,              // $40B1-$40B2: BNE $40B5 (FAIL)
+    0xF0, 0x0E,              // $40B3-$40B4: BEQ $40C3 (DMA) - Always taken
+    
+    // === Check Failed: A = byte read, $01 = byte expected, Y = check ===
+    // FAIL: ($40B5)
+    0x8D, 0x38, 0xC0,        // $40B5-$40B7: STA $C038 - Byte read
+    0xA5, 0x01,              // $40B8-$40B9: LDA $01
+    0x8D, 0x39, 0xC0,        // $40BA-$40BC: STA $C039 - Byte expected
+    0x8C, 0x37, 0xC0,        // $40BD-$40BF: STY $C037 - Failed check
+    // HALT: ($40C0)
+    0x4C, 0xC0, 0x40,        // $40C0-$40C2: JMP $40C0 (HALT) - Stop here
+    
+    // COPY_BLOCK the pattern into index 129, wait for DMA_ACTIVE to clear
+    // DMA: ($40C3)
+    0xA9, 0x01,              // $40C3-$40C4: LDA #$01
+    0x8D, 0x14, 0xC0,        // $40C5-$40C7: STA $C014 - Window B COMMAND = RESET_INDEX
+    0x8D, 0x24, 0xC0,        // $40C8-$40CA: STA $C024 - Window C COMMAND = RESET_INDEX
+    0xA9, 0x04,              // $40CB-$40CC: LDA #$04
+    0x8D, 0xFF, 0xC0,        // $40CD-$40CF: STA $C0FF - SHARED_COMMAND = COPY_BLOCK
+    // DMA_WAIT: ($40D0)
+    0xAD, 0xF0, 0xC0,        // $40D0-$40D2: LDA $C0F0 - DEVICE_STATUS
+    0x29, 0x40,              // $40D3-$40D4: AND #$40 - DMA_ACTIVE
+    0xD0, 0xF9,              // $40D5-$40D6: BNE $40D0 (DMA_WAIT)
+    0xA2, 0x00,              // $40D7-$40D8: LDX #$00
+    0xA0, 0x04,              // $40D9-$40DA: LDY #$04
+    
+    // Copied bytes through window C (check 4)
+    // COPY: ($40DB)
+    0x8A,                    // $40DB: TXA
+    0x45, 0x00,              // $40DC-$40DD: EOR $00
+    0x85, 0x01,              // $40DE-$40DF: STA $01 - Expected byte
+    0xAD, 0x21, 0xC0,        // $40E0-$40E2: LDA $C021 - Window C DATA_PORT
+    0xC5, 0x01,              // $40E3-$40E4: CMP $01
+    0xD0, 0xCE,              // $40E5-$40E6: BNE $40B5 (FAIL)
+    0xE8,                    // $40E7: INX
+    0xE0, 0x40,              // $40E8-$40E9: CPX #$40
+    0xD0, 0xEF,              // $40EA-$40EB: BNE $40DB (COPY)
+    0xAD, 0xF3, 0xC0,        // $40EC-$40EE: LDA $C0F3 - IRQ_MASK_LOW
+    0x85, 0x02,              // $40EF-$40F0: STA $02 - Saved mask
+    0xA0, 0x05,              // $40F1-$40F2: LDY #$05 - Check 5: IRQ_MASK_LOW reads back
+    0xA5, 0x00,              // $40F3-$40F4: LDA $00
+    0x85, 0x01,              // $40F5-$40F6: STA $01
+    0x8D, 0xF3, 0xC0,        // $40F7-$40F9: STA $C0F3 - IRQ_MASK_LOW = seed
+    0xAD, 0xF3, 0xC0,        // $40FA-$40FC: LDA $C0F3 - IRQ_MASK_LOW
+    0xC5, 0x01,              // $40FD-$40FE: CMP $01
+    0xD0, 0xB4,              // $40FF-$4100: BNE $40B5 (FAIL)
+    0xA5, 0x02,              // $4101-$4102: LDA $02
+    0x8D, 0xF3, 0xC0,        // $4103-$4105: STA $C0F3 - Restore IRQ_MASK_LOW
+    0xA9, 0xFF,              // $4106-$4107: LDA #$FF
+    0x8D, 0xF1, 0xC0,        // $4108-$410A: STA $C0F1 - Clear IRQ_CAUSE_LOW
+    0xA0, 0x06,              // $410B-$410C: LDY #$06 - Check 6: no dropped writes
+    0xA9, 0x00,              // $410D-$410E: LDA #$00
+    0x85, 0x01,              // $410F-$4110: STA $01
+    0xAD, 0xF6, 0xC0,        // $4111-$4113: LDA $C0F6 - WRITE_QUEUE_OVERFLOW
+    0xC5, 0x01,              // $4114-$4115: CMP $01
+    0xD0, 0x9D,              // $4116-$4117: BNE $40B5 (FAIL)
+    0x18,                    // $4118: CLC
+    0xAD, 0x35, 0xC0,        // $4119-$411B: LDA $C035 - Bank byte 0: iterations low
+    0x69, 0x01,              // $411C-$411D: ADC #$01
+    0x8D, 0x35, 0xC0,        // $411E-$4120: STA $C035
+    0xAD, 0x36, 0xC0,        // $4121-$4123: LDA $C036 - Bank byte 1: iterations high
+    0x69, 0x00,              // $4124-$4125: ADC #$00
+    0x8D, 0x36, 0xC0,        // $4126-$4128: STA $C036
+    0xE6, 0x00,              // $4129-$412A: INC $00 - Next pattern
+    0x4C, 0x63, 0x40,        // $412B-$412D: JMP $4063 (LOOP)
+    
+    // === IDX_TABLE: index, ADDR, DEFAULT, LIMIT (24-bit), STEP, FLAGS ===
+    0x80, 0x00, 0x39, 0x01, 0x00, 0x39, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, // $412E-$4139: Index 128: $013900, step 1, AUTO_STEP
+    0x81, 0x00, 0x3A, 0x01, 0x00, 0x3A, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, // $413A-$4145: Index 129: $013A00, step 1, AUTO_STEP
+    0x82, 0x00, 0x38, 0x01, 0x00, 0x38, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, // $4146-$4151: Index 130: $013800 (mailbox), no stepping
+    0x00,                    // $4152: End of table
+};
+
+const size_t kernel_data_size = sizeof(kernel_data);
+const size_t kernel_image_size = sizeof(kernel_data);
+const bool kernel_data_compressed = false;
+
+// Boot catalog: the program only
+const boot_image_t boot_catalog[] = {
+    { "timing_bench", kernel_data, sizeof(kernel_data), sizeof(kernel_data), false },
+};
+
+const uint8_t boot_catalog_count = 1;
@@ -6,6 +6,8 @@
 #ifndef TUSB_CONFIG_H
 #define TUSB_CONFIG_H
 
+#include "config/usb_config.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -41,11 +43,15 @@ extern "C" {
 #define CFG_TUSB_DEBUG        0
 #endif
 
-// Enable Device stack
+// One stack, selected in config/usb_config.h (the host stack can not share
+// the port with stdio USB)
+#ifdef CONFIG_USB_HOST
+#define CFG_TUD_ENABLED       0
+#define CFG_TUH_ENABLED       1
+#else
 #define CFG_TUD_ENABLED       1
-
-// Disable Host stack for now (causes conflicts with stdio USB)
 #define CFG_TUH_ENABLED       0
+#endif
 
 // Default is max speed that hardware controller could support with on-chip PHY
 #define CFG_TUD_MAX_SPEED     BOARD_TUD_MAX_SPEED
@@ -58,15 +64,19 @@ extern "C" {
 #define CFG_TUD_ENDPOINT0_SIZE    64
 #endif
 
-// Device mode configuration
+// Port mode
+#if CFG_TUH_ENABLED
+#define CFG_TUSB_RHPORT0_MODE     (OPT_MODE_HOST | OPT_MODE_FULL_SPEED)
+#else
 #define CFG_TUSB_RHPORT0_MODE     (OPT_MODE_DEVICE | OPT_MODE_FULL_SPEED)
+#endif
 
 //------------- CLASS -------------//
 #define CFG_TUD_CDC              1
 #define CFG_TUD_MSC              0
 #define CFG_TUD_HID              0
 #define CFG_TUD_MIDI             0
-#define CFG_TUD_VENDOR           0
+#define CFG_TUD_VENDOR           1   // USB loader (usb/usb_loader.h)
 
 // CDC FIFO size of TX and RX
 #define CFG_TUD_CDC_RX_BUFSIZE   (TUD_OPT_HIGH_SPEED ? 512 : 64)
@@ -75,8 +85,14 @@ extern "C" {
 // CDC Endpoint transfer buffer size, more is faster
 #define CFG_TUD_CDC_EP_BUFSIZE   (TUD_OPT_HIGH_SPEED ? 512 : 64)
 
+// Vendor FIFOs: a larger RX FIFO keeps the OUT endpoint busy between
+// usb_controller_process() passes
+#define CFG_TUD_VENDOR_RX_BUFSIZE 1024
+#define CFG_TUD_VENDOR_TX_BUFSIZE 64
+#define CFG_TUD_VENDOR_EPSIZE     64
+
 //--------------------------------------------------------------------
-// Host Configuration (disabled for now)
+// Host Configuration (CONFIG_USB_HOST)
 //--------------------------------------------------------------------
 
 #if CFG_TUH_ENABLED
@@ -1,18 +1,18 @@
 /**
  * USB Controller Implementation
- * Dual mode USB support with keyboard buffer management
+ * Dual mode USB support, keyboard keys through the usb_keyboard ring
  */
 
 #include "usb_controller.h"
+#include "usb_keyboard.h"
+#include "usb_loader.h"
 #include "config/usb_config.h"
 #include "tusb.h"
 #include "tusb_config.h"
-
-// Keyboard buffer (circular buffer)
-static uint8_t keyboard_buffer[USB_KEYBOARD_BUFFER_SIZE];
-static uint8_t buffer_head = 0;
-static uint8_t buffer_tail = 0;
-static bool buffer_full = false;
+#include "config/bus_config.h"
+#include "bus_interface/bus_trace.h"
+#include "irq/irq.h"
+#include "system/scheduler.h"
 
 static usb_mode_t current_mode;
 
@@ -24,10 +24,9 @@ void usb_controller_init(void) {
     current_mode = USB_MODE_DEVICE;
 #endif
     
-    // Initialize keyboard buffer
-    buffer_head = 0;
-    buffer_tail = 0;
-    buffer_full = false;
+    // Initialize keyboard ring and loader
+    usb_keyboard_init();
+    usb_loader_init();
     
     // Initialize TinyUSB based on mode
     if (current_mode == USB_MODE_HOST) {
@@ -39,16 +38,80 @@ void usb_controller_init(void) {
     }
 }
 
+#if defined(CONFIG_BUS_TRACE) && CFG_TUD_ENABLED
+/**
+ * Stream pending bus trace records to the CDC port
+ * Sends as many whole records as the CDC TX FIFO can take
+ */
+static void usb_controller_stream_trace(void) {
+    if (!bus_trace_is_enabled() || !tud_cdc_connected()) {
+        return;
+    }
+    
+    bus_trace_record_t records[8];
+    uint32_t space = tud_cdc_write_available() / sizeof(bus_trace_record_t);
+    
+    while (space > 0) {
+        uint32_t n = bus_trace_read(records, space < 8 ? space : 8);
+        if (n == 0) {
+            break;
+        }
+        tud_cdc_write(records, n * sizeof(bus_trace_record_t));
+        space -= n;
+    }
+    tud_cdc_write_flush();
+}
+#endif
+
+#if CFG_TUD_ENABLED && CFG_TUD_VENDOR
+/**
+ * Move loader data from the vendor endpoint FIFO into MIA memory
+ * Each read goes straight to the bytes' destination; the state of every
+ * finished load is sent back to the host
+ */
+static void usb_controller_service_loader(void) {
+    while (tud_vendor_available()) {
+        uint8_t *dst;
+        uint32_t space = usb_loader_rx_space(&dst);
+        uint32_t count = tud_vendor_read(dst, space);
+        if (count == 0) {
+            break;
+        }
+        
+        if (usb_loader_rx_done(count)) {
+            uint8_t state = usb_loader_get_state();
+            if (state == USB_LOADER_ERROR) {
+                tud_vendor_read_flush();    // Rest of the rejected load
+            }
+            tud_vendor_write(&state, 1);
+            tud_vendor_write_flush();
+        }
+    }
+}
+#endif
+
 void usb_controller_process(void) {
     // Process TinyUSB tasks
+#if CFG_TUD_ENABLED
     tud_task();
     
-    // Host mode disabled for now
-    #if CFG_TUH_ENABLED
+#if CFG_TUD_VENDOR
+    usb_controller_service_loader();
+#endif
+    
+#ifdef CONFIG_BUS_TRACE
+    usb_controller_stream_trace();
+#endif
+#endif
+    
+#if CFG_TUH_ENABLED
     if (current_mode == USB_MODE_HOST) {
         tuh_task();
     }
-    #endif
+#endif
+    
+    // One publish (and at most one IRQ) for the keys of this pass
+    usb_keyboard_publish();
 }
 
 usb_mode_t usb_controller_get_mode(void) {
@@ -75,19 +138,21 @@ bool usb_controller_handle_read(uint16_t address, uint8_t *data) {
         }
         
         case USB_BUFFER_HEAD:
-            *data = buffer_head;
-            return true;
-            
-        case USB_BUFFER_TAIL:
-            *data = buffer_tail;
+        case USB_BUFFER_TAIL: {
+            uint8_t head, tail;
+            usb_keyboard_get_positions(&head, &tail);
+            *data = (address == USB_BUFFER_HEAD) ? head : tail;
             return true;
+        }
             
         case USB_MODE_STATUS: {
             uint8_t status = 0;
             if (current_mode == USB_MODE_HOST) {
-                status |= USB_MODE_HOST;
+                status |= USB_STATUS_MODE_HOST;
+            }
+            if (usb_keyboard_is_mounted()) {
+                status |= USB_STATUS_DEVICE_CONNECTED;
             }
-            // Device connected status would be set by TinyUSB callbacks
             *data = status;
             return true;
         }
@@ -106,37 +171,54 @@ bool usb_controller_handle_write(uint16_t address, uint8_t data) {
 }
 
 void usb_controller_add_key(uint8_t key_code) {
-    if (!buffer_full) {
-        keyboard_buffer[buffer_head] = key_code;
-        buffer_head = (buffer_head + 1) % USB_KEYBOARD_BUFFER_SIZE;
-        
-        if (buffer_head == buffer_tail) {
-            buffer_full = true;
-        }
-    }
+    // Published with the other keys of this pass
+    usb_keyboard_push(key_code);
 }
 
 bool usb_controller_get_key(uint8_t *key_code) {
     if (!key_code) return false;
-    
-    if (buffer_head == buffer_tail && !buffer_full) {
-        return false;  // Buffer empty
-    }
-    
-    *key_code = keyboard_buffer[buffer_tail];
-    buffer_tail = (buffer_tail + 1) % USB_KEYBOARD_BUFFER_SIZE;
-    buffer_full = false;
-    
-    return true;
+    return usb_keyboard_pop(key_code);
 }
 
 bool usb_controller_is_buffer_full(void) {
-    return buffer_full;
+    return usb_keyboard_is_full();
 }
 
 bool usb_controller_is_key_available(void) {
-    return (buffer_head != buffer_tail) || buffer_full;
+    return usb_keyboard_available() != 0;
+}
+
+#if CFG_TUH_ENABLED
+// HID host callbacks (from tuh_task(), Core 1)
+
+void tuh_hid_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t const *desc_report, uint16_t desc_len) {
+    (void)desc_report;
+    (void)desc_len;
+    
+    // Boot protocol keyboards only: fixed 8-byte reports, no report parsing
+    if (tuh_hid_interface_protocol(dev_addr, instance) != HID_ITF_PROTOCOL_KEYBOARD) {
+        return;
+    }
+    usb_keyboard_set_mounted(true);
+    irq_set_bits(IRQ_USB_DEVICE_CHANGE);
+    tuh_hid_receive_report(dev_addr, instance);
+}
+
+void tuh_hid_umount_cb(uint8_t dev_addr, uint8_t instance) {
+    if (tuh_hid_interface_protocol(dev_addr, instance) != HID_ITF_PROTOCOL_KEYBOARD) {
+        return;
+    }
+    usb_keyboard_set_mounted(false);
+    irq_set_bits(IRQ_USB_DEVICE_CHANGE);
+}
+
+void tuh_hid_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const *report, uint16_t len) {
+    usb_keyboard_handle_report(report, len);
+    
+    // Ask for the next report
+    tuh_hid_receive_report(dev_addr, instance);
 }
+#endif
 
 // TinyUSB callbacks (these will be expanded in later tasks)
 void tud_mount_cb(void) {
@@ -154,4 +236,23 @@ void tud_suspend_cb(bool remote_wakeup_en) {
 
 void tud_resume_cb(void) {
     // Device resumed callback
-}
\ No newline at end of file
+}
+// Every event queued for tud_task()/tuh_task() (usually from the USB
+// interrupt) wakes the Core 1 USB task
+#if CFG_TUD_ENABLED
+void tud_event_hook_cb(uint8_t rhport, uint32_t eventid, bool in_isr) {
+    (void)rhport;
+    (void)eventid;
+    (void)in_isr;
+    scheduler_signal(SCHED_EVENT_USB);
+}
+#endif
+
+#if CFG_TUH_ENABLED
+void tuh_event_hook_cb(uint8_t rhport, uint32_t eventid, bool in_isr) {
+    (void)rhport;
+    (void)eventid;
+    (void)in_isr;
+    scheduler_signal(SCHED_EVENT_USB);
+}
+#endif
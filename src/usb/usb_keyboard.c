@@ -0,0 +1,164 @@
+/**
+ * MIA USB Keyboard Ring Implementation
+ */
+
+#include "usb_keyboard.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <string.h>
+
+#define RING_MASK   (USB_KEYBOARD_BUFFER_SIZE - 1)
+
+static uint8_t *ring;               // USB_KEYBOARD_BUFFER_SIZE bytes (index 64)
+static uint8_t *status;             // Index 65
+static uint8_t head;                // Next slot to write, published or not
+static uint8_t prev_keys[USB_KEY_REPORT_SIZE - 2];
+
+// HID key codes 0x00-0x38 to ASCII, unshifted and shifted
+static const uint8_t keycode_ascii[][2] = {
+    {0, 0}, {0, 0}, {0, 0}, {0, 0},
+    {'a', 'A'}, {'b', 'B'}, {'c', 'C'}, {'d', 'D'}, {'e', 'E'}, {'f', 'F'}, {'g', 'G'},
+    {'h', 'H'}, {'i', 'I'}, {'j', 'J'}, {'k', 'K'}, {'l', 'L'}, {'m', 'M'}, {'n', 'N'},
+    {'o', 'O'}, {'p', 'P'}, {'q', 'Q'}, {'r', 'R'}, {'s', 'S'}, {'t', 'T'}, {'u', 'U'},
+    {'v', 'V'}, {'w', 'W'}, {'x', 'X'}, {'y', 'Y'}, {'z', 'Z'},
+    {'1', '!'}, {'2', '@'}, {'3', '#'}, {'4', '$'}, {'5', '%'},
+    {'6', '^'}, {'7', '&'}, {'8', '*'}, {'9', '('}, {'0', ')'},
+    {'\r', '\r'}, {0x1B, 0x1B}, {0x08, 0x08}, {'\t', '\t'}, {' ', ' '},
+    {'-', '_'}, {'=', '+'}, {'[', '{'}, {']', '}'}, {'\\', '|'}, {'#', '~'},
+    {';', ':'}, {'\'', '"'}, {'`', '~'}, {',', '<'}, {'.', '>'}, {'/', '?'},
+};
+
+// Consumer position: index 64's address within the ring (the I/O buffer
+// area starts on a 256-byte boundary, so its low byte is the offset)
+static inline uint8_t ring_tail(void) {
+    uint8_t tail = indexed_memory_get_config_field(IDX_USB_KEYBOARD, CFG_ADDR_L) & RING_MASK;
+    // Slots before the tail are only reused after the consumer's reads
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return tail;
+}
+
+static inline uint8_t published_head(void) {
+    return __atomic_load_n(&status[USB_KEY_STATUS_HEAD], __ATOMIC_RELAXED);
+}
+
+// FLAGS is also written by the 6502 (clearing OVERFLOW) through the bus
+// path, and bus reads only see changes made here once told
+static void flags_update(uint8_t set, uint8_t clear) {
+    uint8_t flags = __atomic_load_n(&status[USB_KEY_STATUS_FLAGS], __ATOMIC_RELAXED);
+    if ((flags & set) == set && (flags & clear) == 0) {
+        return;
+    }
+    if (set) {
+        __atomic_fetch_or(&status[USB_KEY_STATUS_FLAGS], set, __ATOMIC_RELAXED);
+    }
+    if (clear) {
+        __atomic_fetch_and(&status[USB_KEY_STATUS_FLAGS], (uint8_t)~clear, __ATOMIC_RELAXED);
+    }
+    indexed_memory_notify_write();
+}
+
+void usb_keyboard_init(void) {
+    ring = indexed_memory_get_io_buffer(0);
+    status = indexed_memory_get_io_buffer(USB_KEYBOARD_BUFFER_SIZE);
+    head = ring_tail();
+    status[USB_KEY_STATUS_HEAD] = head;
+    status[USB_KEY_STATUS_FLAGS] = 0;
+    memset(prev_keys, 0, sizeof(prev_keys));
+}
+
+bool usb_keyboard_push(uint8_t key) {
+    uint8_t next = (head + 1) & RING_MASK;
+    if (next == ring_tail()) {
+        flags_update(USB_KEY_FLAG_OVERFLOW, 0);
+        return false;
+    }
+    ring[head] = key;
+    head = next;
+    return true;
+}
+
+void usb_keyboard_publish(void) {
+    uint8_t tail = ring_tail();
+    uint8_t published = published_head();
+    
+    if (head != published) {
+        // Keys first, then the head that makes them visible
+        __atomic_store_n(&status[USB_KEY_STATUS_HEAD], head, __ATOMIC_RELEASE);
+        indexed_memory_set_status(STATUS_USB_DATA_READY);
+        if (published == tail) {
+            irq_set_bits(IRQ_USB_KEYBOARD);
+        }
+    } else if (head == tail && (indexed_memory_get_status() & STATUS_USB_DATA_READY)) {
+        indexed_memory_clear_status(STATUS_USB_DATA_READY);
+    }
+}
+
+bool usb_keyboard_pop(uint8_t *key) {
+    uint8_t available = __atomic_load_n(&status[USB_KEY_STATUS_HEAD], __ATOMIC_ACQUIRE);
+    if (available == ring_tail()) {
+        return false;
+    }
+    *key = indexed_memory_read(IDX_USB_KEYBOARD);
+    return true;
+}
+
+uint8_t usb_keyboard_available(void) {
+    return (published_head() - ring_tail()) & RING_MASK;
+}
+
+bool usb_keyboard_is_full(void) {
+    return ((head + 1) & RING_MASK) == ring_tail();
+}
+
+void usb_keyboard_get_positions(uint8_t *published, uint8_t *tail) {
+    *published = published_head();
+    *tail = ring_tail();
+}
+
+void usb_keyboard_set_mounted(bool mounted) {
+    if (mounted) {
+        flags_update(USB_KEY_FLAG_KEYBOARD, 0);
+    } else {
+        flags_update(0, USB_KEY_FLAG_KEYBOARD);
+        memset(prev_keys, 0, sizeof(prev_keys));
+    }
+}
+
+bool usb_keyboard_is_mounted(void) {
+    return (status[USB_KEY_STATUS_FLAGS] & USB_KEY_FLAG_KEYBOARD) != 0;
+}
+
+static uint8_t key_to_ascii(uint8_t code, uint8_t modifiers) {
+    if (code >= sizeof(keycode_ascii) / sizeof(keycode_ascii[0])) {
+        return 0;
+    }
+    uint8_t ascii = keycode_ascii[code][(modifiers & USB_KEY_MOD_SHIFT) ? 1 : 0];
+    if ((modifiers & USB_KEY_MOD_CTRL) && code >= 0x04 && code <= 0x1D) {
+        ascii &= 0x1F;      // Letters: Ctrl-A is 0x01
+    }
+    return ascii;
+}
+
+void usb_keyboard_handle_report(const uint8_t *report, uint16_t len) {
+    if (len < USB_KEY_REPORT_SIZE) {
+        return;
+    }
+    
+    // Codes 1-3 (rollover, POST fail, undefined error) fill the report when
+    // too many keys are down: keep the previous state
+    const uint8_t *keys = &report[2];
+    if (keys[0] >= 0x01 && keys[0] <= 0x03) {
+        return;
+    }
+    
+    for (int i = 0; i < USB_KEY_REPORT_SIZE - 2; i++) {
+        if (keys[i] == 0 || memchr(prev_keys, keys[i], sizeof(prev_keys))) {
+            continue;   // Empty slot or still held
+        }
+        uint8_t ascii = key_to_ascii(keys[i], report[0]);
+        if (ascii != 0) {
+            usb_keyboard_push(ascii);
+        }
+    }
+    memcpy(prev_keys, keys, sizeof(prev_keys));
+}
@@ -0,0 +1,92 @@
+/**
+ * MIA USB Keyboard Ring
+ *
+ * Keys go from the HID host callbacks (Core 1) to the 6502 through a
+ * single producer, single consumer ring that lives in MIA memory, so the
+ * 6502 reads keys straight through index 64 (DATA_PORT, auto-step with
+ * wrap). The ring is USB_KEYBOARD_BUFFER_SIZE bytes at the start of the I/O
+ * buffer area, and byte USB_KEY_STATUS_HEAD of index 65 holds the producer
+ * position. The consumer position is index 64's address: keys are waiting
+ * while its CFG_ADDR_L differs from the head byte. One slot stays empty,
+ * so a full ring holds USB_KEYBOARD_BUFFER_SIZE - 1 keys.
+ *
+ * Keys are stored first and the head is published with release ordering,
+ * so a consumer that sees the new head also sees the keys. The producer
+ * only reuses a slot once index 64 has moved past it.
+ *
+ * Keys pushed during one usb_controller_process() pass are published
+ * together, and IRQ_USB_KEYBOARD is raised only when they land in an empty
+ * ring: a burst of keys is one interrupt, and the handler reads until the
+ * ring is empty. STATUS_USB_DATA_READY is set while keys are waiting.
+ */
+
+#ifndef USB_KEYBOARD_H
+#define USB_KEYBOARD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config/usb_config.h"
+
+#if (USB_KEYBOARD_BUFFER_SIZE & (USB_KEYBOARD_BUFFER_SIZE - 1)) != 0 || USB_KEYBOARD_BUFFER_SIZE > 256
+#error "USB_KEYBOARD_BUFFER_SIZE must be a power of two up to 256"
+#endif
+
+// Index 65 bytes
+#define USB_KEY_STATUS_HEAD     0       // Ring offset of the next key to be written
+#define USB_KEY_STATUS_FLAGS    1       // USB_KEY_FLAG_*
+
+// Status flags (byte USB_KEY_STATUS_FLAGS)
+#define USB_KEY_FLAG_KEYBOARD   0x01    // A keyboard is mounted
+#define USB_KEY_FLAG_OVERFLOW   0x80    // Keys were dropped because the ring was full (until written 0)
+
+// HID boot keyboard report
+#define USB_KEY_REPORT_SIZE     8       // Modifiers, reserved, six key codes
+#define USB_KEY_MOD_CTRL        0x11    // Left or right Ctrl
+#define USB_KEY_MOD_SHIFT       0x22    // Left or right Shift
+
+// Empty the ring
+void usb_keyboard_init(void);
+
+/**
+ * Store a key (producer side), visible once published
+ *
+ * @return false if the ring is full and the key was dropped
+ */
+bool usb_keyboard_push(uint8_t key);
+
+// Publish the keys pushed since the last call and raise the coalesced IRQ
+void usb_keyboard_publish(void);
+
+/**
+ * Take the next published key (consumer side, through index 64)
+ *
+ * @return false if no key is waiting
+ */
+bool usb_keyboard_pop(uint8_t *key);
+
+// Published keys not read yet
+uint8_t usb_keyboard_available(void);
+
+// True when only one more key fits
+bool usb_keyboard_is_full(void);
+
+// Published head and consumer tail (ring offsets)
+void usb_keyboard_get_positions(uint8_t *head, uint8_t *tail);
+
+// Keyboard mount state, shown in the status flags
+void usb_keyboard_set_mounted(bool mounted);
+bool usb_keyboard_is_mounted(void);
+
+/**
+ * Turn a HID boot keyboard report into keys
+ *
+ * Pushes the ASCII code of every key pressed since the previous report
+ * (keys without one, e.g. arrows, are ignored). Ctrl with a letter gives
+ * its control code.
+ *
+ * @param report Report bytes
+ * @param len Report length (shorter reports are ignored)
+ */
+void usb_keyboard_handle_report(const uint8_t *report, uint16_t len);
+
+#endif // USB_KEYBOARD_H
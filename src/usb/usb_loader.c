@@ -0,0 +1,87 @@
+/**
+ * MIA USB Loader Implementation
+ */
+
+#include "usb_loader.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <string.h>
+
+static usb_loader_header_t header;
+static uint32_t header_fill;        // Header bytes received
+static uint32_t load_offset;        // Next payload byte, from the user area start
+static uint32_t load_remaining;     // Payload bytes still to come (0 = header next)
+static uint8_t *status;             // Status block (index 66)
+
+static void put24(uint8_t *p, uint32_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+}
+
+static void set_state(uint8_t state) {
+    status[0] = state;
+    indexed_memory_notify_write();
+}
+
+void usb_loader_init(void) {
+    status = indexed_memory_get_io_buffer(USB_LOADER_STATUS_OFFSET);
+    memset(status, 0, USB_LOADER_STATUS_SIZE);
+    header_fill = 0;
+    load_remaining = 0;
+}
+
+uint32_t usb_loader_rx_space(uint8_t **dst) {
+    if (load_remaining == 0) {
+        *dst = (uint8_t *)&header + header_fill;
+        return sizeof(header) - header_fill;
+    }
+    *dst = indexed_memory_get_user_area() + load_offset;
+    return load_remaining;
+}
+
+// A complete header: start the load or reject it
+static bool start_load(void) {
+    if (header.magic != USB_LOADER_MAGIC || header.length == 0 ||
+        header.offset >= INDEXED_MEMORY_USER_AREA_SIZE ||
+        header.length > INDEXED_MEMORY_USER_AREA_SIZE - header.offset) {
+        set_state(USB_LOADER_ERROR);
+        irq_set_bits(IRQ_USB_LOAD);
+        return true;
+    }
+
+    load_offset = header.offset;
+    load_remaining = header.length;
+    put24(&status[1], INDEXED_MEMORY_USER_AREA_BASE + header.offset);
+    put24(&status[4], header.length);
+    set_state(USB_LOADER_RECEIVING);
+    return false;
+}
+
+bool usb_loader_rx_done(uint32_t count) {
+    if (load_remaining == 0) {
+        header_fill += count;
+        if (header_fill < sizeof(header)) {
+            return false;
+        }
+        header_fill = 0;
+        return start_load();
+    }
+
+    load_offset += count;
+    load_remaining -= count;
+    if (load_remaining != 0) {
+        return false;
+    }
+
+    // Data before the state that announces it
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    status[7]++;
+    set_state(USB_LOADER_DONE);
+    irq_set_bits(IRQ_USB_LOAD);
+    return true;
+}
+
+uint8_t usb_loader_get_state(void) {
+    return status[0];
+}
@@ -0,0 +1,70 @@
+/**
+ * MIA USB Loader
+ *
+ * Loads programs and data from a computer straight into the user area of
+ * MIA memory, over a vendor class bulk endpoint next to the CDC console
+ * (device mode), so trying new 6502 software needs no firmware rebuild.
+ *
+ * The host sends loads back to back, each a usb_loader_header_t and then
+ * length bytes. Payload bytes are read from the endpoint FIFO directly into
+ * their place in MIA memory, with no staging buffer. At the end of a load
+ * IRQ_USB_LOAD is raised and the status block (index 66) reads
+ * USB_LOADER_DONE with the MIA address and length of the data; the 6502
+ * then points an index at it and copies it with CMD_COPY_BLOCK or reads it
+ * through DATA_PORT. A header that is not valid ends in USB_LOADER_ERROR
+ * (also with IRQ_USB_LOAD) and the data after it is discarded. The state
+ * byte is also sent back to the host at the end of every load.
+ *
+ * Status block (USB_LOADER_STATUS_SIZE bytes, index 66):
+ *   0    State (USB_LOADER_*)
+ *   1-3  MIA address of the data (24-bit little endian)
+ *   4-6  Length of the data
+ *   7    Loads completed (wraps)
+ */
+
+#ifndef USB_LOADER_H
+#define USB_LOADER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config/usb_config.h"
+
+#define USB_LOADER_MAGIC        0x4C41494Du     // "MIAL"
+
+// States (status block byte 0)
+#define USB_LOADER_IDLE         0x00
+#define USB_LOADER_RECEIVING    0x01
+#define USB_LOADER_DONE         0x02
+#define USB_LOADER_ERROR        0x03
+
+typedef struct {
+    uint32_t magic;             // USB_LOADER_MAGIC
+    uint32_t offset;            // Destination, from the start of the user area
+    uint32_t length;            // Payload bytes (1 to the end of the user area)
+} usb_loader_header_t;
+
+_Static_assert(sizeof(usb_loader_header_t) == 12, "usb_loader_header_t must be 12 bytes");
+
+// Wait for a header and clear the status block
+void usb_loader_init(void);
+
+/**
+ * Where the next received bytes go
+ *
+ * @param dst Set to the destination (header buffer or MIA memory)
+ * @return Bytes that may be written there before usb_loader_rx_done()
+ */
+uint32_t usb_loader_rx_space(uint8_t **dst);
+
+/**
+ * Account for bytes written at the usb_loader_rx_space() destination
+ *
+ * @param count Bytes written (up to the space returned)
+ * @return true when this ended a load (done or rejected)
+ */
+bool usb_loader_rx_done(uint32_t count);
+
+// State of the last load (USB_LOADER_*)
+uint8_t usb_loader_get_state(void);
+
+#endif // USB_LOADER_H
@@ -4,137 +4,272 @@
  */
 
 #include "video_controller.h"
+#include "video_sprites.h"
 #include "hardware/gpio_mapping.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include "pico/time.h"
 #include <string.h>
 
-// Graphics memory structures
-static uint8_t character_tables[CHARACTER_TABLES][CHARACTERS_PER_TABLE][BYTES_PER_CHARACTER];
-static uint16_t palette_banks[PALETTE_BANKS][COLORS_PER_PALETTE];
-static uint8_t nametables[NAMETABLE_BUFFERS][NAMETABLE_HEIGHT][NAMETABLE_WIDTH];
-static uint8_t palette_tables[PALETTE_TABLE_BUFFERS][NAMETABLE_HEIGHT][NAMETABLE_WIDTH];
-static uint8_t oam_data[MAX_SPRITES][BYTES_PER_SPRITE];
+// Graphics memory: the video area of MIA memory, written by the 6502
+// through indexes 16-57 (no private copy, nothing to sync per frame)
+static video_memory_t *video_memory;
 
 // Video state
 static uint8_t active_character_table __attribute__((unused)) = 0;
-static uint8_t active_nametable __attribute__((unused)) = 0;
-static uint8_t active_palette_table __attribute__((unused)) = 0;
-static bool frame_ready = false;
+static video_frame_t front_frame;   // Latched at frame boundaries (Core 1)
+static bool frame_ready = false;    // front_frame not yet taken by the encoder
+static uint64_t last_latch_us;
+static uint64_t last_flip_us;
 
-// PPU registers
-static uint8_t ppu_control = 0;
-static uint8_t ppu_status = 0;
-static uint16_t ppu_oam_addr = 0;
+// Asset hashes, refreshed from the dirty flags at frame boundaries (Core 1)
+static uint32_t asset_hash[VIDEO_ASSETS];
+static uint32_t asset_changes;      // Bit per asset, taken by the encoder
+static uint32_t asset_manifest;
+static uint8_t asset_dirty[VIDEO_FRAME_DATA_BLOCK];
 
-void video_controller_init(void) {
-    // Initialize video memory to default values using fast memset
-    memset(character_tables, 0, sizeof(character_tables));
-    memset(palette_banks, 0, sizeof(palette_banks));
-    memset(nametables, 0, sizeof(nametables));
-    memset(palette_tables, 0, sizeof(palette_tables));
-    memset(oam_data, 0, sizeof(oam_data));
-    
-    // Initialize PPU registers
-    ppu_control = 0;
-    ppu_status = 0;
-    ppu_oam_addr = 0;
-    frame_ready = false;
-}
+// Sprite bins of the latched frame, for collision detection (Core 1)
+static video_sprite_bins_t sprite_bins;
 
-void video_controller_process(void) {
-    // Core 1 video processing
-    // Prepare frame data for Wi-Fi transmission
-    video_controller_prepare_frame_data();
+/**
+ * FNV-1a, 32-bit
+ */
+static uint32_t hash_bytes(const uint8_t *data, uint32_t size, uint32_t hash) {
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
 }
 
-bool video_controller_handle_read(uint16_t address, uint8_t *data) {
-    if (!data) return false;
+#define HASH_SEED 2166136261u
+
+/**
+ * Rehash the assets with a dirty block, recording the ones that changed
+ */
+static void update_asset_hashes(void) {
+    memset(asset_dirty, 0, sizeof(asset_dirty));
+    indexed_memory_take_video_dirty(0, VIDEO_FRAME_DATA_BLOCK, asset_dirty);
     
-    if (address < VIDEO_PALETTE_BASE + 0x100) {
-        // Palette bank access
-        // Implementation will be expanded in later tasks
-        *data = 0x00;
-        return true;
-    } else if (address >= VIDEO_CHAR_BASE && address < VIDEO_CHAR_BASE + 0x100) {
-        // Character table access
-        // Implementation will be expanded in later tasks
-        *data = 0x00;
-        return true;
-    } else if (address >= VIDEO_OAM_BASE && address < VIDEO_OAM_BASE + 0x100) {
-        // OAM access
-        // Implementation will be expanded in later tasks
-        *data = 0x00;
-        return true;
-    } else if (address >= VIDEO_PPU_BASE && address <= PPU_OAM_DMA) {
-        // PPU register access
-        switch (address) {
-            case PPU_STATUS:
-                *data = ppu_status;
-                return true;
-            case PPU_OAM_DATA:
-                if (ppu_oam_addr < MAX_SPRITES * BYTES_PER_SPRITE) {
-                    uint8_t sprite = ppu_oam_addr / BYTES_PER_SPRITE;
-                    uint8_t byte_offset = ppu_oam_addr % BYTES_PER_SPRITE;
-                    *data = oam_data[sprite][byte_offset];
-                } else {
-                    *data = 0x00;
-                }
-                return true;
-            default:
-                *data = 0x00;
-                return true;
+    bool changed = false;
+    for (uint8_t asset = 0; asset < VIDEO_ASSETS; asset++) {
+        uint16_t size;
+        const uint8_t *data = video_controller_get_asset(asset, &size);
+        uint32_t offset = (uint32_t)(data - (const uint8_t *)video_memory);
+        uint32_t first = offset >> VIDEO_DIRTY_BLOCK_SHIFT;
+        uint32_t last = (offset + size - 1) >> VIDEO_DIRTY_BLOCK_SHIFT;
+        
+        bool dirty = false;
+        for (uint32_t b = first; b <= last && !dirty; b++) {
+            dirty = asset_dirty[b];
+        }
+        if (!dirty) {
+            continue;
+        }
+        
+        uint32_t hash = hash_bytes(data, size, HASH_SEED);
+        if (hash != asset_hash[asset]) {
+            asset_hash[asset] = hash;
+            asset_changes |= 1u << asset;
+            changed = true;
         }
     }
     
-    return false;
+    if (changed) {
+        asset_manifest = hash_bytes((const uint8_t *)asset_hash, sizeof(asset_hash), HASH_SEED);
+    }
 }
 
-bool video_controller_handle_write(uint16_t address, uint8_t data) {
-    if (address < VIDEO_PALETTE_BASE + 0x100) {
-        // Palette bank access
-        // Implementation will be expanded in later tasks
-        return true;
-    } else if (address >= VIDEO_CHAR_BASE && address < VIDEO_CHAR_BASE + 0x100) {
-        // Character table access
-        // Implementation will be expanded in later tasks
-        return true;
-    } else if (address >= VIDEO_OAM_BASE && address < VIDEO_OAM_BASE + 0x100) {
-        // OAM access
-        // Implementation will be expanded in later tasks
-        return true;
-    } else if (address >= VIDEO_PPU_BASE && address <= PPU_OAM_DMA) {
-        // PPU register access
-        switch (address) {
-            case PPU_CONTROL:
-                ppu_control = data;
-                return true;
-            case PPU_OAM_ADDR:
-                ppu_oam_addr = data;
-                return true;
-            case PPU_OAM_DATA:
-                if (ppu_oam_addr < MAX_SPRITES * BYTES_PER_SPRITE) {
-                    uint8_t sprite = ppu_oam_addr / BYTES_PER_SPRITE;
-                    uint8_t byte_offset = ppu_oam_addr % BYTES_PER_SPRITE;
-                    oam_data[sprite][byte_offset] = data;
-                    ppu_oam_addr++;  // Auto-increment
-                }
-                return true;
-            case PPU_OAM_DMA:
-                // DMA transfer - implementation will be expanded in later tasks
-                return true;
-            default:
-                return true;
-        }
+/**
+ * Report the sprite collisions of the latched frame
+ * 
+ * The flags and the bit per colliding sprite are left in the video area
+ * for the 6502 (IDX_SPRITE_COLLISION) until the next frame boundary.
+ * They are written behind the bus interface, so bus reads are told unless
+ * they stay clear from one frame to the next.
+ */
+static void update_sprite_collisions(void) {
+    uint8_t last_status = video_memory->sprite_status;
+    video_sprites_bin(&sprite_bins, video_memory->oam);
+    uint8_t status = video_sprites_detect_collisions(&sprite_bins, video_memory, &front_frame,
+                                                     video_memory->sprite_collisions);
+    video_memory->sprite_status = status;
+    if (status | last_status) {
+        indexed_memory_notify_write();
+    }
+    if (status & (VIDEO_SPRITE_COLLISION | VIDEO_SPRITE_BG_COLLISION)) {
+        irq_set_bits(IRQ_VIDEO_COLLISION);
+    }
+}
+
+/**
+ * Point the front frame at a buffer set
+ */
+static void latch_buffer_set(uint8_t set) {
+    for (int i = 0; i < TABLES_PER_BUFFER_SET; i++) {
+        front_frame.nametables[i] = video_memory->nametables[set * TABLES_PER_BUFFER_SET + i];
+        front_frame.palette_tables[i] = video_memory->palette_tables[set * TABLES_PER_BUFFER_SET + i];
+    }
+    front_frame.oam = video_memory->oam;
+    front_frame.data = (const uint8_t *)video_memory + VIDEO_FRAME_DATA_OFFSET;
+    front_frame.buffer_set = set;
+    front_frame.scroll_x = video_memory->scroll_x % VIDEO_PLANE_WIDTH;
+    front_frame.scroll_y = video_memory->scroll_y % VIDEO_PLANE_HEIGHT;
+}
+
+void video_controller_init(void) {
+    // Video memory is owned (and cleared) by indexed_memory_init()
+    video_memory = (video_memory_t *)indexed_memory_get_video_area();
+    latch_buffer_set(0);
+    front_frame.frame_number = 0;
+    memset(front_frame.dirty, 0, sizeof(front_frame.dirty));
+    
+    // Hash the (cleared) assets now: they are all new to every client
+    memset(asset_hash, 0, sizeof(asset_hash));
+    update_asset_hashes();
+    asset_changes = (1u << VIDEO_ASSETS) - 1;
+    front_frame.asset_manifest = asset_manifest;
+    last_latch_us = time_us_64();
+    last_flip_us = last_latch_us - (uint64_t)VIDEO_FLIP_TIMEOUT_FRAMES * video_controller_get_frame_interval_us();
+    frame_ready = false;
+}
+
+/**
+ * Frame period for the IDX_FRAME_RATE target
+ */
+uint32_t video_controller_get_frame_interval_us(void) {
+    uint8_t rate = video_memory->frame_rate;
+    if (rate == 0) {
+        rate = VIDEO_FRAME_RATE_DEFAULT;
+    } else if (rate > VIDEO_FRAME_RATE_MAX) {
+        rate = VIDEO_FRAME_RATE_MAX;
+    }
+    return 1000000u / rate;
+}
+
+/**
+ * Core 1 video processing: decide when the next frame boundary is
+ * 
+ * A flip is latched as soon as a frame period has passed since the last
+ * latch, so it is sent without waiting for a fixed time grid. While the
+ * program keeps flipping, periodic boundaries would only delay its next
+ * flip, so they are held back until it stops flipping for
+ * VIDEO_FLIP_TIMEOUT_FRAMES periods.
+ */
+void video_controller_process(void) {
+    uint64_t now = time_us_64();
+    uint64_t interval = video_controller_get_frame_interval_us();
+    uint64_t elapsed = now - last_latch_us;
+    if (elapsed < interval) {
+        return;
+    }
+    
+    bool flipped = (video_memory->active_frame & (VIDEO_BUFFER_SETS - 1)) != front_frame.buffer_set;
+    if (flipped) {
+        last_flip_us = now;
+    } else if (now - last_flip_us < VIDEO_FLIP_TIMEOUT_FRAMES * interval &&
+               elapsed < VIDEO_FLIP_TIMEOUT_FRAMES * interval) {
+        return;
     }
     
-    return false;
+    last_latch_us = now;
+    video_controller_prepare_frame_data();
 }
 
+/**
+ * Frame boundary: latch the buffer set flipped to by the 6502
+ * 
+ * The 6502 draws into the back set, then writes its number (0 or 1) to
+ * IDX_ACTIVE_FRAME. The new front set is taken here, in one step, so the
+ * encoder never sees a half-flipped frame. IRQ_VIDEO_FRAME_COMPLETE tells
+ * the 6502 that the previous front set is now free to draw into.
+ */
 void video_controller_prepare_frame_data(void) {
-    // Prepare frame data for Wi-Fi transmission
-    // This will be expanded in later tasks
+    latch_buffer_set(video_memory->active_frame & (VIDEO_BUFFER_SETS - 1));
+    
+    // Changes not sent yet (no client, or frame skipped) stay pending
+    indexed_memory_take_video_dirty(VIDEO_FRAME_DATA_BLOCK, VIDEO_DIRTY_BLOCKS, front_frame.dirty);
+    update_asset_hashes();
+    front_frame.asset_manifest = asset_manifest;
+    update_sprite_collisions();
+    front_frame.frame_number++;
     frame_ready = true;
+    irq_set_bits(IRQ_VIDEO_FRAME_COMPLETE);
 }
 
 bool video_controller_is_frame_ready(void) {
     return frame_ready;
+}
+
+/**
+ * Front frame for the encoder, stable until the next frame boundary
+ */
+const video_frame_t *video_controller_get_frame(void) {
+    return &front_frame;
+}
+
+/**
+ * Mark the latched frame as sent, so it is not encoded twice
+ */
+void video_controller_release_frame(void) {
+    memset(front_frame.dirty, 0, sizeof(front_frame.dirty));
+    frame_ready = false;
+}
+
+/**
+ * Get a character table (assets 0-7) or palette bank (assets 8-23)
+ */
+const uint8_t *video_controller_get_asset(uint8_t asset, uint16_t *size) {
+    if (asset < VIDEO_ASSET_PALETTE_BASE) {
+        *size = CHARACTER_TABLE_SIZE;
+        return &video_memory->character_tables[asset][0][0];
+    }
+    *size = PALETTE_BANK_SIZE;
+    return (const uint8_t *)video_memory->palette_banks[asset - VIDEO_ASSET_PALETTE_BASE];
+}
+
+uint32_t video_controller_get_asset_hash(uint8_t asset) {
+    return asset_hash[asset];
+}
+
+uint32_t video_controller_take_asset_changes(void) {
+    uint32_t changes = asset_changes;
+    asset_changes = 0;
+    return changes;
+}
+
+/**
+ * Send all of the frame data with the latched frame (keyframes)
+ */
+void video_controller_mark_all_dirty(void) {
+    memset(front_frame.dirty, 1, sizeof(front_frame.dirty));
+}
+
+/**
+ * Find the next run of dirty blocks
+ * The last block is clipped to the end of the frame data
+ */
+bool video_controller_next_dirty_span(const video_frame_t *frame, uint32_t *block,
+                                      uint16_t *offset, uint16_t *length) {
+    uint32_t b = *block;
+    while (b < VIDEO_DIRTY_BLOCKS && !frame->dirty[b]) {
+        b++;
+    }
+    if (b >= VIDEO_DIRTY_BLOCKS) {
+        *block = b;
+        return false;
+    }
+    
+    uint32_t start = b;
+    while (b < VIDEO_DIRTY_BLOCKS && frame->dirty[b]) {
+        b++;
+    }
+    *block = b;
+    
+    uint32_t end = b << VIDEO_DIRTY_BLOCK_SHIFT;
+    if (end > VIDEO_FRAME_DATA_SIZE) {
+        end = VIDEO_FRAME_DATA_SIZE;
+    }
+    *offset = (uint16_t)(start << VIDEO_DIRTY_BLOCK_SHIFT);
+    *length = (uint16_t)(end - *offset);
+    return true;
 }
\ No newline at end of file
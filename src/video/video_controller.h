@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // Video system constants
 #define SCREEN_WIDTH        320
@@ -26,30 +27,161 @@
 #define BYTES_PER_COLOR     2   // 16-bit RGB565
 
 #define NAMETABLE_BUFFERS   4   // 2 active + 2 double buffer
-#define PALETTE_TABLE_BUFFERS 2 // 1 active + 1 double buffer
+#define PALETTE_TABLE_BUFFERS 4 // One per nametable
+
+// Double buffering: IDX_ACTIVE_FRAME selects buffer set 0 (nametables and
+// palette tables 0-1) or 1 (2-3). The choice is latched at frame boundaries.
+#define VIDEO_BUFFER_SETS   2
+#define TABLES_PER_BUFFER_SET (NAMETABLE_BUFFERS / VIDEO_BUFFER_SETS)
+
+// Scrolling: the two nametables of the front set form a 640x200 plane (the
+// second one on the right), wrapping in both directions. The scroll offset
+// (coarse cell * 8 + fine pixel) is the plane position of the top-left
+// screen pixel. Sprites are placed on the screen, not on the plane.
+#define VIDEO_PLANE_WIDTH   (SCREEN_WIDTH * TABLES_PER_BUFFER_SET)
+#define VIDEO_PLANE_HEIGHT  SCREEN_HEIGHT
+
+// Frame pacing: IDX_FRAME_RATE sets the target rate (0 = default). A flip is
+// latched as soon as the rate allows; programs that do not flip get a frame
+// boundary every 1/rate seconds, flipping ones only when they flip (or after
+// VIDEO_FLIP_TIMEOUT_FRAMES without one).
+#define VIDEO_FRAME_RATE_DEFAULT    30
+#define VIDEO_FRAME_RATE_MAX        60
+#define VIDEO_FRAME_INTERVAL_US     (1000000 / VIDEO_FRAME_RATE_DEFAULT)
+#define VIDEO_FLIP_TIMEOUT_FRAMES   4
 
 #define MAX_SPRITES         256
 #define BYTES_PER_SPRITE    4
 
-// Memory-mapped I/O addresses (relative to video base)
-#define VIDEO_PALETTE_BASE  0x0000  // $D000-$D0FF
-#define VIDEO_CHAR_BASE     0x0100  // $D100-$D1FF
-#define VIDEO_OAM_BASE      0x0200  // $D200-$D2FF
-#define VIDEO_PPU_BASE      0x0300  // $D300-$D304
+// Character rows are 3 bytes, a 24-bit little-endian value holding pixel x
+// in bits 3x-3x+2. Palette table bytes (and sprite attributes) select the
+// palette bank in bits 0-3 and the character table in bits 4-6; bit 7 of a
+// sprite's attributes is bit 8 of its X position. Background color 0 is
+// opaque, sprite color 0 is transparent.
+#define BYTES_PER_CHARACTER_ROW 3
+#define VIDEO_ATTR_PALETTE_MASK 0x0F
+#define VIDEO_ATTR_TABLE_SHIFT  4
+#define VIDEO_ATTR_TABLE_MASK   0x07
+#define SPRITE_ATTR_X8          0x80
+
+// OAM entry bytes; sprites at Y >= SCREEN_HEIGHT are hidden and lower
+// entries are drawn on top of higher ones
+#define SPRITE_Y            0
+#define SPRITE_TILE         1
+#define SPRITE_ATTR         2
+#define SPRITE_X            3
+
+// Video area of MIA memory, as laid out by indexed_memory_init() and written
+// by the 6502 through indexes 16-57. The video controller works on this view
+// directly (indexed_memory_get_video_area()), there is no private copy.
+typedef struct {
+    uint8_t character_tables[CHARACTER_TABLES][CHARACTERS_PER_TABLE][BYTES_PER_CHARACTER];
+    uint16_t palette_banks[PALETTE_BANKS][COLORS_PER_PALETTE];
+    uint8_t nametables[NAMETABLE_BUFFERS][NAMETABLE_HEIGHT][NAMETABLE_WIDTH];
+    uint8_t palette_tables[PALETTE_TABLE_BUFFERS][NAMETABLE_HEIGHT][NAMETABLE_WIDTH];
+    uint8_t oam[MAX_SPRITES][BYTES_PER_SPRITE];
+    uint8_t active_frame;
+    uint8_t frame_rate;         // Frames per second, 0 = VIDEO_FRAME_RATE_DEFAULT
+    uint8_t sprite_status;      // VIDEO_SPRITE_* flags of the last frame (video_sprites.h)
+    uint8_t sprite_collisions[MAX_SPRITES / 8]; // Bit per sprite that collided in the last frame
+    uint16_t scroll_x;          // Plane X of the screen's left edge (taken modulo VIDEO_PLANE_WIDTH)
+    uint16_t scroll_y;          // Plane Y of the screen's top edge (taken modulo VIDEO_PLANE_HEIGHT)
+} video_memory_t;
+
+/**
+ * Read one 3bpp character row as a 24-bit value (pixel x in bits 3x-3x+2)
+ * 
+ * @param video Video area
+ * @param attr Palette table byte or sprite attributes (selects the table)
+ * @param character Character number
+ * @param row Row within the character (0-7)
+ */
+static inline uint32_t video_character_row(const video_memory_t *video, uint8_t attr,
+                                           uint8_t character, uint8_t row) {
+    uint8_t table = (attr >> VIDEO_ATTR_TABLE_SHIFT) & VIDEO_ATTR_TABLE_MASK;
+    const uint8_t *p = &video->character_tables[table][character][row * BYTES_PER_CHARACTER_ROW];
+    return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+}
+
+// Frame data: the part of the video area sent with every frame (all four
+// nametables and palette tables, then OAM), tracked for changes in blocks of
+// VIDEO_DIRTY_BLOCK_SIZE bytes so the encoder only sends what was written
+#define VIDEO_FRAME_DATA_OFFSET offsetof(video_memory_t, nametables)
+#define VIDEO_FRAME_DATA_SIZE   (offsetof(video_memory_t, active_frame) - VIDEO_FRAME_DATA_OFFSET)
+#define VIDEO_DIRTY_BLOCK_SHIFT 5
+#define VIDEO_DIRTY_BLOCK_SIZE  (1u << VIDEO_DIRTY_BLOCK_SHIFT)
+#define VIDEO_DIRTY_BLOCKS      ((VIDEO_FRAME_DATA_SIZE + VIDEO_DIRTY_BLOCK_SIZE - 1) >> VIDEO_DIRTY_BLOCK_SHIFT)
 
-// PPU registers
-#define PPU_CONTROL         0x0300  // $D300
-#define PPU_STATUS          0x0301  // $D301
-#define PPU_OAM_ADDR        0x0302  // $D302
-#define PPU_OAM_DATA        0x0303  // $D303
-#define PPU_OAM_DMA         0x0304  // $D304
+// Writes are tracked from the start of the video area (character tables and
+// palette banks, for the asset hashes) up to active_frame; the frame data
+// blocks are the tail of this range
+#define VIDEO_TRACKED_SIZE      offsetof(video_memory_t, active_frame)
+#define VIDEO_TRACKED_BLOCKS    ((VIDEO_TRACKED_SIZE + VIDEO_DIRTY_BLOCK_SIZE - 1) >> VIDEO_DIRTY_BLOCK_SHIFT)
+#define VIDEO_FRAME_DATA_BLOCK  (VIDEO_FRAME_DATA_OFFSET >> VIDEO_DIRTY_BLOCK_SHIFT)
+
+// Assets: character tables (ids 0-7) then palette banks (ids 8-23). Clients
+// cache them by content hash (FNV-1a), refreshed at frame boundaries for the
+// assets written since the last one.
+#define CHARACTER_TABLE_SIZE    (CHARACTERS_PER_TABLE * BYTES_PER_CHARACTER)
+#define PALETTE_BANK_SIZE       (COLORS_PER_PALETTE * BYTES_PER_COLOR)
+#define VIDEO_ASSET_PALETTE_BASE CHARACTER_TABLES
+#define VIDEO_ASSETS            (CHARACTER_TABLES + PALETTE_BANKS)
+
+// Front buffer latched at the last frame boundary. The pointers stay valid
+// (and the 6502 must leave these tables alone) until the next boundary.
+typedef struct {
+    const uint8_t (*nametables[TABLES_PER_BUFFER_SET])[NAMETABLE_WIDTH];
+    const uint8_t (*palette_tables[TABLES_PER_BUFFER_SET])[NAMETABLE_WIDTH];
+    const uint8_t (*oam)[BYTES_PER_SPRITE];
+    const uint8_t *data;                // Frame data (VIDEO_FRAME_DATA_SIZE bytes)
+    uint8_t buffer_set;
+    uint16_t scroll_x;                  // Viewport, latched with the buffer set
+    uint16_t scroll_y;
+    uint32_t frame_number;
+    uint32_t asset_manifest;            // Hash of all asset hashes at the latch
+    uint8_t dirty[VIDEO_DIRTY_BLOCKS];  // Blocks written since the last sent frame
+} video_frame_t;
+
+/**
+ * Background cell under a plane position of a frame
+ * 
+ * @param frame Frame (buffer set tables)
+ * @param x Plane X (0 to VIDEO_PLANE_WIDTH - 1)
+ * @param y Plane Y (0 to VIDEO_PLANE_HEIGHT - 1)
+ * @param attr Set to the cell's palette table byte
+ * @return The cell's character number
+ */
+static inline uint8_t video_frame_cell(const video_frame_t *frame, uint16_t x, uint16_t y, uint8_t *attr) {
+    uint8_t table = x / SCREEN_WIDTH;
+    uint8_t col = (x % SCREEN_WIDTH) / TILE_WIDTH;
+    *attr = frame->palette_tables[table][y / TILE_HEIGHT][col];
+    return frame->nametables[table][y / TILE_HEIGHT][col];
+}
+
+// Sprite X position (9 bits, bit 8 in the attributes)
+static inline uint16_t video_sprite_x(const uint8_t *sprite) {
+    return sprite[SPRITE_X] | ((sprite[SPRITE_ATTR] & SPRITE_ATTR_X8) ? 0x100 : 0);
+}
 
 // Function prototypes
 void video_controller_init(void);
 void video_controller_process(void);
-bool video_controller_handle_read(uint16_t address, uint8_t *data);
-bool video_controller_handle_write(uint16_t address, uint8_t data);
+uint32_t video_controller_get_frame_interval_us(void);
 void video_controller_prepare_frame_data(void);
 bool video_controller_is_frame_ready(void);
+const video_frame_t *video_controller_get_frame(void);
+void video_controller_release_frame(void);
+void video_controller_mark_all_dirty(void);
+
+// Asset data and hashes; take_asset_changes returns (and clears) a bit per
+// asset whose hash changed since the last call
+const uint8_t *video_controller_get_asset(uint8_t asset, uint16_t *size);
+uint32_t video_controller_get_asset_hash(uint8_t asset);
+uint32_t video_controller_take_asset_changes(void);
+
+// Next run of dirty blocks at or after *block, as a byte span of the frame
+// data; *block is moved past the run. Returns false when none is left.
+bool video_controller_next_dirty_span(const video_frame_t *frame, uint32_t *block,
+                                      uint16_t *offset, uint16_t *length);
 
 #endif // VIDEO_CONTROLLER_H
\ No newline at end of file
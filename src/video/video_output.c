@@ -0,0 +1,114 @@
+/**
+ * MIA Local Video Output Implementation
+ */
+
+#include "video_output.h"
+#include "video_render.h"
+#include "config/video_config.h"
+#include "config/irq_config.h"
+#include "video_output.pio.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+
+#if (VIDEO_OUTPUT_LINE_BUFFERS & (VIDEO_OUTPUT_LINE_BUFFERS - 1)) != 0
+#error "VIDEO_OUTPUT_LINE_BUFFERS must be a power of two"
+#endif
+
+// State machines (fixed, the three programs fill the PIO block)
+#define SM_HSYNC    0
+#define SM_VSYNC    1
+#define SM_RGB      2
+
+static uint16_t line_buffers[VIDEO_OUTPUT_LINE_BUFFERS][SCREEN_WIDTH] __attribute__((aligned(4)));
+static int dma_channel = -1;
+static uint16_t output_line;    // VGA line being sent (0 to VGA_V_ACTIVE - 1)
+
+static inline uint16_t *line_buffer(uint16_t line) {
+    return line_buffers[line & (VIDEO_OUTPUT_LINE_BUFFERS - 1)];
+}
+
+// Fill the ring with the first scanlines of a frame
+static void render_frame_start(void) {
+    video_render_begin_frame();
+    for (uint16_t line = 0; line < VIDEO_OUTPUT_LINE_BUFFERS; line++) {
+        video_render_line(line, line_buffer(line));
+    }
+}
+
+/**
+ * Line DMA interrupt: a VGA line has been handed to the PIO
+ *
+ * The next line is queued first, so rendering never delays the pixel
+ * stream. Once a scanline has been sent for the last time its buffer takes
+ * the scanline VIDEO_OUTPUT_LINE_BUFFERS further down. The first scanlines
+ * of the next frame are rendered in the vertical blanking, while the PIO
+ * waits for the first active line.
+ */
+static void dma_irq_handler(void) {
+    dma_channel_acknowledge_irq1(dma_channel);
+
+    uint16_t done = output_line;
+    if (++output_line == VGA_V_ACTIVE) {
+        output_line = 0;
+        render_frame_start();
+        dma_channel_set_read_addr(dma_channel, line_buffer(0), true);
+        return;
+    }
+
+    dma_channel_set_read_addr(dma_channel, line_buffer(output_line / VIDEO_OUTPUT_LINE_REPEAT), true);
+
+    if (done % VIDEO_OUTPUT_LINE_REPEAT == VIDEO_OUTPUT_LINE_REPEAT - 1) {
+        uint16_t line = done / VIDEO_OUTPUT_LINE_REPEAT + VIDEO_OUTPUT_LINE_BUFFERS;
+        if (line < SCREEN_HEIGHT) {
+            video_render_line(line, line_buffer(line));
+        }
+    }
+}
+
+void video_output_init(void) {
+    PIO pio = VIDEO_OUTPUT_PIO;
+
+    // The pins may be above GPIO 31, in the upper window of the PIO
+    pio_set_gpio_base(pio, VIDEO_OUTPUT_RGB_BASE_PIN >= 32 || VIDEO_OUTPUT_VSYNC_PIN >= 32 ? 16 : 0);
+
+    float div = (float)clock_get_hz(clk_sys) / VGA_PIXEL_CLOCK_HZ;
+    vga_hsync_program_init(pio, SM_HSYNC, pio_add_program(pio, &vga_hsync_program),
+                           VIDEO_OUTPUT_HSYNC_PIN, div);
+    vga_vsync_program_init(pio, SM_VSYNC, pio_add_program(pio, &vga_vsync_program),
+                           VIDEO_OUTPUT_VSYNC_PIN, div);
+    vga_rgb_program_init(pio, SM_RGB, pio_add_program(pio, &vga_rgb_program),
+                         VIDEO_OUTPUT_RGB_BASE_PIN, div);
+
+    // Counts for the loops that do not fit a SET immediate
+    pio_sm_put(pio, SM_HSYNC, VGA_H_ACTIVE + VGA_H_FRONT_PORCH - 1);
+    pio_sm_put(pio, SM_VSYNC, VGA_V_ACTIVE - 1);
+    pio_sm_put(pio, SM_VSYNC, VGA_V_BACK_PORCH - 1);
+    pio_sm_put(pio, SM_RGB, SCREEN_WIDTH - 1);
+
+    // One scanline (two pixels per word) into the RGB TX FIFO per transfer
+    dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, SM_RGB, true));
+    dma_channel_configure(dma_channel, &c,
+                          &pio->txf[SM_RGB],
+                          line_buffer(0),
+                          SCREEN_WIDTH / 2,
+                          false);
+
+    dma_channel_set_irq1_enabled(dma_channel, true);
+    irq_set_exclusive_handler(DMA_IRQ_1, dma_irq_handler);
+    irq_set_priority(DMA_IRQ_1, MIA_IRQ_PRIORITY_VIDEO);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // First frame, then start the timing with the state machines in step
+    video_render_init();
+    output_line = 0;
+    render_frame_start();
+    dma_channel_start(dma_channel);
+    pio_enable_sm_mask_in_sync(pio, (1u << SM_HSYNC) | (1u << SM_VSYNC) | (1u << SM_RGB));
+}
@@ -0,0 +1,42 @@
+/**
+ * MIA Local Video Output
+ *
+ * Shows the video area on a VGA monitor, next to the Wi-Fi stream. Enabled
+ * with CONFIG_VIDEO_LOCAL_OUTPUT (config/video_config.h).
+ *
+ * PIO 2 generates the 640x400 @ 70 Hz timing (video_output.pio) and shifts
+ * out the pixels of each line, so every 320-pixel scanline is sent twice.
+ * A DMA channel feeds it from a ring of VIDEO_OUTPUT_LINE_BUFFERS line
+ * buffers; its completion interrupt (DMA_IRQ_1, on Core 1) queues the next
+ * line and renders the line that left the ring VIDEO_OUTPUT_LINE_BUFFERS
+ * lines ahead, so there is no framebuffer: the ring is 2.5KB.
+ */
+
+#ifndef VIDEO_OUTPUT_H
+#define VIDEO_OUTPUT_H
+
+#include "video_controller.h"
+
+// VGA 640x400 @ 70 Hz timing (pixels and lines)
+#define VGA_PIXEL_CLOCK_HZ      25175000
+#define VGA_H_ACTIVE            640
+#define VGA_H_FRONT_PORCH       16
+#define VGA_V_ACTIVE            400
+#define VGA_V_BACK_PORCH        35
+
+// Every scanline is shown on this many VGA lines
+#define VIDEO_OUTPUT_LINE_REPEAT (VGA_V_ACTIVE / SCREEN_HEIGHT)
+
+// Rendered scanlines in flight (must be a power of two)
+#define VIDEO_OUTPUT_LINE_BUFFERS 4
+
+#define VIDEO_OUTPUT_PIO        pio2
+
+/**
+ * Start the local video output
+ * Must run on Core 1 (after video_controller_init()), which takes the
+ * per-line DMA interrupt
+ */
+void video_output_init(void);
+
+#endif // VIDEO_OUTPUT_H
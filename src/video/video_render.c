@@ -0,0 +1,74 @@
+/**
+ * MIA Scanline Renderer Implementation
+ */
+
+#include "video_render.h"
+#include "video_sprites.h"
+#include "video_tile_cache.h"
+#include "indexed_memory.h"
+#include <string.h>
+
+static const video_memory_t *video_memory;
+static video_frame_t render_frame;      // Tables and viewport of the frame being drawn
+static video_sprite_bins_t render_sprites;
+
+void video_render_init(void) {
+    video_tile_cache_init();
+}
+
+void video_render_begin_frame(void) {
+    video_memory = (const video_memory_t *)indexed_memory_get_video_area();
+
+    // Only the buffer set number and the viewport are taken from the front
+    // frame, each a single load, so a latch running at the same time can not
+    // tear them (it may mix two frames' values, for one frame)
+    const video_frame_t *front = video_controller_get_frame();
+    uint8_t set = front->buffer_set;
+    for (int i = 0; i < TABLES_PER_BUFFER_SET; i++) {
+        render_frame.nametables[i] = video_memory->nametables[set * TABLES_PER_BUFFER_SET + i];
+        render_frame.palette_tables[i] = video_memory->palette_tables[set * TABLES_PER_BUFFER_SET + i];
+    }
+    render_frame.scroll_x = front->scroll_x % VIDEO_PLANE_WIDTH;
+    render_frame.scroll_y = front->scroll_y % VIDEO_PLANE_HEIGHT;
+    video_sprites_bin(&render_sprites, video_memory->oam);
+    video_tile_cache_sync();
+}
+
+void video_render_line(uint16_t line, uint16_t *pixels) {
+    // Background: the plane cells under the viewport, every one opaque.
+    // With a fine X offset the line spans one more cell, drawn whole and
+    // shifted into place.
+    uint16_t background[SCREEN_WIDTH + TILE_WIDTH];
+    uint16_t y = (line + render_frame.scroll_y) % VIDEO_PLANE_HEIGHT;
+    uint16_t x = render_frame.scroll_x & ~(TILE_WIDTH - 1);
+    uint8_t fine_x = render_frame.scroll_x % TILE_WIDTH;
+    for (int col = 0; col <= NAMETABLE_WIDTH; col++) {
+        uint8_t attr;
+        uint8_t character = video_frame_cell(&render_frame, x, y, &attr);
+        const video_tile_row_t *r = video_tile_cache_row(video_memory, attr, character, y % TILE_HEIGHT);
+        memcpy(&background[col * TILE_WIDTH], r->pixels, sizeof(r->pixels));
+        x = (x + TILE_WIDTH) % VIDEO_PLANE_WIDTH;
+    }
+    memcpy(pixels, &background[fine_x], SCREEN_WIDTH * sizeof(uint16_t));
+
+    // Sprites of the line's band, from the last OAM entry to the first, so
+    // lower entries end on top. Sprites moved since the frame started are
+    // drawn where they are now, or skipped if they left the band.
+    uint8_t band = line / SPRITE_BAND_HEIGHT;
+    for (int i = render_sprites.count[band] - 1; i >= 0; i--) {
+        const uint8_t *sprite = video_memory->oam[render_sprites.sprites[band][i]];
+        uint8_t sprite_row = (uint8_t)(line - sprite[SPRITE_Y]);
+        if (sprite[SPRITE_Y] >= SCREEN_HEIGHT || sprite_row >= TILE_HEIGHT) {
+            continue;
+        }
+
+        uint16_t sprite_x = video_sprite_x(sprite);
+        const video_tile_row_t *r = video_tile_cache_row(video_memory, sprite[SPRITE_ATTR],
+                                                         sprite[SPRITE_TILE], sprite_row);
+        for (int px = 0; px < TILE_WIDTH && sprite_x + px < SCREEN_WIDTH; px++) {
+            if (r->opaque & (1u << px)) {
+                pixels[sprite_x + px] = r->pixels[px];
+            }
+        }
+    }
+}
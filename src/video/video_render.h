@@ -0,0 +1,43 @@
+/**
+ * MIA Scanline Renderer
+ *
+ * Rasterizes the video area (video_controller.h layout) one 320-pixel
+ * RGB565 line at a time, for the local video output. Drawing lines on
+ * demand into a small ring avoids a 128KB framebuffer.
+ *
+ * Background: the nametables of the front buffer set select the character of
+ * every 8x8 cell of the scrolling plane and the palette tables its palette
+ * bank and character table; the scroll offset picks the 320x200 viewport.
+ * Sprites: 8x8, drawn over the background with color 0 transparent, at
+ * most SPRITES_PER_BAND per band of lines (video_sprites.h), placed on the
+ * screen regardless of the scroll offset.
+ *
+ * Cells and sprites are drawn from expanded rows in the tile cache
+ * (video_tile_cache.h).
+ *
+ * The front buffer set is sampled (and OAM binned) by
+ * video_render_begin_frame(), so a flip latched while a frame is being
+ * drawn shows from the next one.
+ */
+
+#ifndef VIDEO_RENDER_H
+#define VIDEO_RENDER_H
+
+#include <stdint.h>
+#include "video_controller.h"
+
+// Reset the renderer (empties the tile cache)
+void video_render_init(void);
+
+// Sample the front buffer set and bin the sprites for the next frame's lines
+void video_render_begin_frame(void);
+
+/**
+ * Draw one line of the current frame
+ *
+ * @param line Line number (0 to SCREEN_HEIGHT - 1)
+ * @param pixels SCREEN_WIDTH RGB565 pixels
+ */
+void video_render_line(uint16_t line, uint16_t *pixels);
+
+#endif // VIDEO_RENDER_H
@@ -0,0 +1,156 @@
+/**
+ * MIA Sprite Binning and Collision Detection Implementation
+ *
+ * Collisions are tested on 8-bit row masks (bit x set when pixel x is
+ * opaque). A pair of sprites is only tested in the first band holding
+ * both, and a sprite against the background only in its own first band,
+ * so nothing is tested twice.
+ */
+
+#include "video_sprites.h"
+#include <string.h>
+
+void video_sprites_bin(video_sprite_bins_t *bins, const uint8_t (*oam)[BYTES_PER_SPRITE]) {
+    memset(bins->count, 0, sizeof(bins->count));
+    bins->overflow = false;
+
+    for (int i = 0; i < MAX_SPRITES; i++) {
+        uint8_t y = oam[i][SPRITE_Y];
+        if (y >= SCREEN_HEIGHT) {
+            continue;
+        }
+
+        uint8_t first = y / SPRITE_BAND_HEIGHT;
+        uint8_t last = (y + TILE_HEIGHT - 1) / SPRITE_BAND_HEIGHT;
+        if (last >= SPRITE_BANDS) {
+            last = SPRITE_BANDS - 1;
+        }
+        for (uint8_t band = first; band <= last; band++) {
+            if (bins->count[band] < SPRITES_PER_BAND) {
+                bins->sprites[band][bins->count[band]++] = (uint8_t)i;
+            } else {
+                bins->overflow = true;
+            }
+        }
+    }
+}
+
+/**
+ * Opaque pixels of a character row
+ */
+static uint8_t opaque_mask(uint32_t bits) {
+    uint8_t mask = 0;
+    for (int x = 0; x < TILE_WIDTH; x++) {
+        if ((bits >> (3 * x)) & 7) {
+            mask |= 1u << x;
+        }
+    }
+    return mask;
+}
+
+/**
+ * Opaque pixels of one sprite row, without the pixels past the right edge
+ */
+static uint8_t sprite_mask(const video_memory_t *video, const uint8_t *sprite, uint8_t row) {
+    uint16_t x = video_sprite_x(sprite);
+    if (x >= SCREEN_WIDTH) {
+        return 0;
+    }
+    uint8_t mask = opaque_mask(video_character_row(video, sprite[SPRITE_ATTR], sprite[SPRITE_TILE], row));
+    if (x > SCREEN_WIDTH - TILE_WIDTH) {
+        mask &= (1u << (SCREEN_WIDTH - x)) - 1;
+    }
+    return mask;
+}
+
+/**
+ * Test two sprites for overlapping opaque pixels
+ */
+static bool sprites_collide(const video_memory_t *video, const uint8_t *a, const uint8_t *b) {
+    int dx = (int)video_sprite_x(b) - (int)video_sprite_x(a);
+    int dy = (int)b[SPRITE_Y] - (int)a[SPRITE_Y];
+    if (dx <= -TILE_WIDTH || dx >= TILE_WIDTH || dy <= -TILE_HEIGHT || dy >= TILE_HEIGHT) {
+        return false;
+    }
+
+    // Walk the shared lines in a's rows
+    int first = dy > 0 ? dy : 0;
+    int last = dy > 0 ? TILE_HEIGHT - 1 : TILE_HEIGHT - 1 + dy;
+    for (int row = first; row <= last && a[SPRITE_Y] + row < SCREEN_HEIGHT; row++) {
+        uint16_t mask_a = sprite_mask(video, a, (uint8_t)row);
+        uint16_t mask_b = sprite_mask(video, b, (uint8_t)(row - dy));
+        bool overlap = dx >= 0 ? (mask_a & (mask_b << dx)) : ((mask_a << -dx) & mask_b);
+        if (overlap) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Opaque pixels of the background cell row under a plane position
+ */
+static uint8_t background_mask(const video_memory_t *video, const video_frame_t *frame, uint16_t x, uint16_t y) {
+    uint8_t attr;
+    uint8_t character = video_frame_cell(frame, x, y, &attr);
+    return opaque_mask(video_character_row(video, attr, character, y % TILE_HEIGHT));
+}
+
+/**
+ * Test a sprite against the non-zero background pixels under it
+ */
+static bool sprite_hits_background(const video_memory_t *video, const uint8_t *sprite,
+                                   const video_frame_t *frame) {
+    // The sprite covers one plane cell, or two when it is not cell aligned
+    uint16_t x = (video_sprite_x(sprite) + frame->scroll_x) % VIDEO_PLANE_WIDTH;
+    uint16_t next_x = (x + TILE_WIDTH) % VIDEO_PLANE_WIDTH;
+    uint8_t shift = x % TILE_WIDTH;
+
+    for (int row = 0; row < TILE_HEIGHT && sprite[SPRITE_Y] + row < SCREEN_HEIGHT; row++) {
+        uint8_t mask = sprite_mask(video, sprite, (uint8_t)row);
+        if (mask == 0) {
+            continue;
+        }
+
+        uint16_t y = (sprite[SPRITE_Y] + row + frame->scroll_y) % VIDEO_PLANE_HEIGHT;
+        uint16_t background = background_mask(video, frame, x, y);
+        if (shift != 0) {
+            background |= (uint16_t)background_mask(video, frame, next_x, y) << TILE_WIDTH;
+        }
+        if (mask & (background >> shift)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t video_sprites_detect_collisions(const video_sprite_bins_t *bins, const video_memory_t *video,
+                                        const video_frame_t *frame, uint8_t *collisions) {
+    uint8_t status = bins->overflow ? VIDEO_SPRITE_OVERFLOW : 0;
+    memset(collisions, 0, MAX_SPRITES / 8);
+
+    for (uint8_t band = 0; band < SPRITE_BANDS; band++) {
+        const uint8_t *list = bins->sprites[band];
+        for (uint8_t i = 0; i < bins->count[band]; i++) {
+            const uint8_t *a = video->oam[list[i]];
+            bool a_starts_here = a[SPRITE_Y] / SPRITE_BAND_HEIGHT == band;
+
+            if (a_starts_here && sprite_hits_background(video, a, frame)) {
+                collisions[list[i] / 8] |= 1u << (list[i] % 8);
+                status |= VIDEO_SPRITE_BG_COLLISION;
+            }
+
+            for (uint8_t j = i + 1; j < bins->count[band]; j++) {
+                const uint8_t *b = video->oam[list[j]];
+                bool b_starts_here = b[SPRITE_Y] / SPRITE_BAND_HEIGHT == band;
+                if ((!a_starts_here && !b_starts_here) || !sprites_collide(video, a, b)) {
+                    continue;   // Pair already tested in the previous band
+                }
+                collisions[list[i] / 8] |= 1u << (list[i] % 8);
+                collisions[list[j] / 8] |= 1u << (list[j] % 8);
+                status |= VIDEO_SPRITE_COLLISION;
+            }
+        }
+    }
+    return status;
+}
@@ -0,0 +1,57 @@
+/**
+ * MIA Sprite Binning and Collision Detection
+ *
+ * Once per frame, OAM is sorted into bands of SPRITE_BAND_HEIGHT lines,
+ * each listing the (up to SPRITES_PER_BAND) sprites that touch it, in OAM
+ * order. Drawing a line then only visits the sprites of its band, and
+ * overlaps are only looked for between sprites sharing a band, so both
+ * cost O(visible sprites) instead of O(256 × lines).
+ *
+ * Collisions are pixel exact: opaque (non-zero) sprite pixels over opaque
+ * pixels of another sprite, or over background pixels of a color other
+ * than 0. Pixels off the screen never collide.
+ */
+
+#ifndef VIDEO_SPRITES_H
+#define VIDEO_SPRITES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_controller.h"
+
+#define SPRITE_BAND_HEIGHT  TILE_HEIGHT
+#define SPRITE_BANDS        (SCREEN_HEIGHT / SPRITE_BAND_HEIGHT)
+#define SPRITES_PER_BAND    32          // Sprites past this are not drawn
+
+// Sprite status flags (video_memory_t.sprite_status)
+#define VIDEO_SPRITE_COLLISION      0x01    // Two sprites overlap
+#define VIDEO_SPRITE_BG_COLLISION   0x02    // A sprite overlaps the background
+#define VIDEO_SPRITE_OVERFLOW       0x04    // A band had more than SPRITES_PER_BAND sprites
+
+typedef struct {
+    uint8_t count[SPRITE_BANDS];
+    uint8_t sprites[SPRITE_BANDS][SPRITES_PER_BAND];   // OAM indexes, ascending
+    bool overflow;
+} video_sprite_bins_t;
+
+/**
+ * Sort the visible sprites into bands
+ *
+ * @param bins Bins to fill
+ * @param oam Sprite OAM
+ */
+void video_sprites_bin(video_sprite_bins_t *bins, const uint8_t (*oam)[BYTES_PER_SPRITE]);
+
+/**
+ * Find the sprites that overlap another sprite or the background
+ *
+ * @param bins Bins filled by video_sprites_bin() from the same OAM
+ * @param video Video area (character tables and OAM)
+ * @param frame Background tables and viewport
+ * @param collisions MAX_SPRITES / 8 bytes, set to a bit per colliding sprite
+ * @return VIDEO_SPRITE_* flags
+ */
+uint8_t video_sprites_detect_collisions(const video_sprite_bins_t *bins, const video_memory_t *video,
+                                        const video_frame_t *frame, uint8_t *collisions);
+
+#endif // VIDEO_SPRITES_H
@@ -0,0 +1,120 @@
+/**
+ * MIA Expanded Tile Cache Implementation
+ */
+
+#include "video_tile_cache.h"
+#include <string.h>
+
+#if (TILE_CACHE_SETS & (TILE_CACHE_SETS - 1)) != 0
+#error "TILE_CACHE_SETS must be a power of two"
+#endif
+
+typedef struct {
+    bool valid;
+    uint8_t table;
+    uint8_t bank;
+    uint8_t character;
+    uint32_t last_use;
+    video_tile_row_t rows[TILE_HEIGHT];
+} tile_cache_entry_t;
+
+static tile_cache_entry_t entries[TILE_CACHE_SETS][TILE_CACHE_WAYS];
+static uint32_t asset_hash[VIDEO_ASSETS];   // Hashes the entries were filled under
+static uint32_t use_clock;
+static uint32_t hits;
+static uint32_t misses;
+
+void video_tile_cache_init(void) {
+    memset(entries, 0, sizeof(entries));
+    for (uint8_t asset = 0; asset < VIDEO_ASSETS; asset++) {
+        asset_hash[asset] = video_controller_get_asset_hash(asset);
+    }
+    use_clock = 0;
+    hits = 0;
+    misses = 0;
+}
+
+void video_tile_cache_sync(void) {
+    uint32_t tables = 0;
+    uint32_t banks = 0;
+    for (uint8_t asset = 0; asset < VIDEO_ASSETS; asset++) {
+        uint32_t hash = video_controller_get_asset_hash(asset);
+        if (hash == asset_hash[asset]) {
+            continue;
+        }
+        asset_hash[asset] = hash;
+        if (asset < VIDEO_ASSET_PALETTE_BASE) {
+            tables |= 1u << asset;
+        } else {
+            banks |= 1u << (asset - VIDEO_ASSET_PALETTE_BASE);
+        }
+    }
+    if (tables == 0 && banks == 0) {
+        return;
+    }
+
+    for (int set = 0; set < TILE_CACHE_SETS; set++) {
+        for (int way = 0; way < TILE_CACHE_WAYS; way++) {
+            tile_cache_entry_t *e = &entries[set][way];
+            if (e->valid && (((tables >> e->table) & 1) || ((banks >> e->bank) & 1))) {
+                e->valid = false;
+            }
+        }
+    }
+}
+
+/**
+ * Expand all rows of a character through its palette bank
+ */
+static void fill_entry(tile_cache_entry_t *e, const video_memory_t *video, uint8_t attr) {
+    const uint16_t *palette = video->palette_banks[e->bank];
+    for (uint8_t row = 0; row < TILE_HEIGHT; row++) {
+        uint32_t bits = video_character_row(video, attr, e->character, row);
+        video_tile_row_t *r = &e->rows[row];
+        r->opaque = 0;
+        for (int x = 0; x < TILE_WIDTH; x++) {
+            uint8_t color = bits & 7;
+            r->pixels[x] = palette[color];
+            if (color != 0) {
+                r->opaque |= 1u << x;
+            }
+            bits >>= 3;
+        }
+    }
+}
+
+const video_tile_row_t *video_tile_cache_row(const video_memory_t *video, uint8_t attr,
+                                             uint8_t character, uint8_t row) {
+    uint8_t table = (attr >> VIDEO_ATTR_TABLE_SHIFT) & VIDEO_ATTR_TABLE_MASK;
+    uint8_t bank = attr & VIDEO_ATTR_PALETTE_MASK;
+    tile_cache_entry_t *set = entries[(character ^ (bank << 2) ^ (table << 1)) & (TILE_CACHE_SETS - 1)];
+    use_clock++;
+
+    // Hit, or the least recently used way (an invalid one first)
+    tile_cache_entry_t *victim = &set[0];
+    for (int way = 0; way < TILE_CACHE_WAYS; way++) {
+        tile_cache_entry_t *e = &set[way];
+        if (e->valid && e->character == character && e->bank == bank && e->table == table) {
+            e->last_use = use_clock;
+            hits++;
+            return &e->rows[row];
+        }
+        if (victim->valid && (!e->valid || e->last_use < victim->last_use)) {
+            victim = e;
+        }
+    }
+
+    victim->valid = true;
+    victim->table = table;
+    victim->bank = bank;
+    victim->character = character;
+    victim->last_use = use_clock;
+    fill_entry(victim, video, attr);
+    misses++;
+    return &victim->rows[row];
+}
+
+void video_tile_cache_get_stats(uint32_t *hits_out, uint32_t *misses_out) {
+    *hits_out = hits;
+    *misses_out = misses;
+}
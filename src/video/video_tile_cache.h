@@ -0,0 +1,54 @@
+/**
+ * MIA Expanded Tile Cache
+ *
+ * Keeps characters already expanded from 3bpp to RGB565 through a palette
+ * bank, keyed by (character table, character, palette bank), so drawing a
+ * cell that was drawn before is a 16-byte copy per line instead of eight
+ * bit extractions and palette lookups. Each row also carries its opaque
+ * pixel mask, for sprites.
+ *
+ * The cache is 4-way set associative with LRU replacement, under 10KB.
+ * Entries are invalidated by video_tile_cache_sync() when the content hash
+ * of their character table or palette bank changes; the hashes are kept
+ * from the video area's dirty tracking at frame boundaries, so a written
+ * character shows from the next frame boundary on at the latest.
+ */
+
+#ifndef VIDEO_TILE_CACHE_H
+#define VIDEO_TILE_CACHE_H
+
+#include <stdint.h>
+#include "video_controller.h"
+
+#define TILE_CACHE_WAYS     4
+#define TILE_CACHE_SETS     16          // Must be a power of two
+#define TILE_CACHE_ENTRIES  (TILE_CACHE_WAYS * TILE_CACHE_SETS)
+
+// One expanded character row
+typedef struct {
+    uint16_t pixels[TILE_WIDTH];        // RGB565
+    uint8_t opaque;                     // Bit x set when pixel x is not color 0
+} video_tile_row_t;
+
+// Empty the cache
+void video_tile_cache_init(void);
+
+// Drop the entries of character tables and palette banks whose hash changed
+void video_tile_cache_sync(void);
+
+/**
+ * Get a row of a character expanded through a palette bank
+ *
+ * @param video Video area
+ * @param attr Palette table byte or sprite attributes (table and bank)
+ * @param character Character number
+ * @param row Row within the character (0-7)
+ * @return The row, valid until the next lookup
+ */
+const video_tile_row_t *video_tile_cache_row(const video_memory_t *video, uint8_t attr,
+                                             uint8_t character, uint8_t row);
+
+// Lookup counters since video_tile_cache_init()
+void video_tile_cache_get_stats(uint32_t *hits, uint32_t *misses);
+
+#endif // VIDEO_TILE_CACHE_H
@@ -0,0 +1,271 @@
+/**
+ * MIA Bus Benchmark
+ * 
+ * Replays 6502 bus traces through the bus interface and indexed memory on
+ * the host, the way the bus IRQ handler (bus_sync_pio.c) drives them:
+ * reads are prepared from the read shadow and committed, writes are
+ * applied, and the Core 0 background work (copies, deferred commands) runs
+ * between cycles, outside the measurement. Reports the time per access,
+ * its 99th percentile and the slowest access for each register, so a hot
+ * path change shows up as a number before it reaches hardware.
+ * 
+ * Host timings only rank changes against each other: the RP2350 runs the
+ * same code at a different speed, from SRAM, with no data cache. The
+ * maximum also catches the host scheduler; the percentile does not.
+ * 
+ * Usage: mia_bench [--passes N] [--quick] [trace.bin ...]
+ * Without trace files it runs the synthetic traces (bench_traces.h).
+ */
+
+#include "bench_traces.h"
+#include "bus_interface/bus_interface.h"
+#include "indexed_memory/indexed_memory.h"
+#include "system/background.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_PASSES  20
+#define HISTOGRAM_NS    4096    // 1ns buckets, the last one collects the rest
+
+// Mock clock of the video controller (a test file defines it in mia_tests)
+uint64_t mock_time_us = 0;
+
+// Register types reported
+enum {
+    REG_TYPE_IDX_SELECT,
+    REG_TYPE_DATA_PORT,
+    REG_TYPE_CFG_FIELD_SELECT,
+    REG_TYPE_CFG_DATA,
+    REG_TYPE_COMMAND,
+    REG_TYPE_BANK,
+    REG_TYPE_DEVICE_STATUS,
+    REG_TYPE_IRQ_CAUSE,
+    REG_TYPE_IRQ_MASK,
+    REG_TYPE_IRQ_ENABLE,
+    REG_TYPE_IRQ_VECTOR,
+    REG_TYPE_IRQ_VECTOR_ACK,
+    REG_TYPE_SHARED_COMMAND,
+    REG_TYPE_SHARED_OTHER,
+    REG_TYPES
+};
+
+static const char *const reg_type_names[REG_TYPES] = {
+    "IDX_SELECT", "DATA_PORT", "CFG_FIELD_SELECT", "CFG_DATA", "COMMAND", "BANK",
+    "DEVICE_STATUS", "IRQ_CAUSE", "IRQ_MASK", "IRQ_ENABLE", "IRQ_VECTOR",
+    "IRQ_VECTOR_ACK", "SHARED_COMMAND", "SHARED_OTHER"
+};
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t prepare_max_ns;    // Reads: up to the data being ready
+    uint32_t histogram[HISTOGRAM_NS];
+} access_stats_t;
+
+static access_stats_t stats[REG_TYPES][2];     // [type][BUS_TRACE_FLAG_*]
+static access_stats_t background_stats;
+static uint64_t timer_overhead_ns;
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t elapsed_ns(uint64_t start, uint64_t end) {
+    uint64_t ns = end - start;
+    return ns > timer_overhead_ns ? ns - timer_overhead_ns : 0;
+}
+
+// Cost of two back-to-back clock reads, subtracted from every sample
+static void calibrate_timer(void) {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 10000; i++) {
+        uint64_t start = now_ns();
+        uint64_t end = now_ns();
+        if (end - start < best) {
+            best = end - start;
+        }
+    }
+    timer_overhead_ns = best;
+}
+
+static uint8_t reg_type(uint8_t addr) {
+    if (!(addr & 0x80)) {
+        uint8_t offset = addr & 0x0F;
+        return offset >= REG_OFFSET_BANK ? REG_TYPE_BANK : (uint8_t)(REG_TYPE_IDX_SELECT + offset);
+    }
+    switch (addr) {
+        case REG_DEVICE_STATUS:     return REG_TYPE_DEVICE_STATUS;
+        case REG_IRQ_CAUSE_LOW:
+        case REG_IRQ_CAUSE_HIGH:    return REG_TYPE_IRQ_CAUSE;
+        case REG_IRQ_MASK_LOW:
+        case REG_IRQ_MASK_HIGH:     return REG_TYPE_IRQ_MASK;
+        case REG_IRQ_ENABLE:        return REG_TYPE_IRQ_ENABLE;
+        case REG_IRQ_VECTOR:        return REG_TYPE_IRQ_VECTOR;
+        case REG_IRQ_VECTOR_ACK:    return REG_TYPE_IRQ_VECTOR_ACK;
+        case REG_SHARED_COMMAND:    return REG_TYPE_SHARED_COMMAND;
+        default:                    return REG_TYPE_SHARED_OTHER;
+    }
+}
+
+static void add_sample(access_stats_t *s, uint64_t ns) {
+    s->count++;
+    s->total_ns += ns;
+    if (ns > s->max_ns) {
+        s->max_ns = ns;
+    }
+    s->histogram[ns < HISTOGRAM_NS ? ns : HISTOGRAM_NS - 1]++;
+}
+
+static uint32_t percentile_ns(const access_stats_t *s, uint32_t percent) {
+    uint64_t rank = (s->count * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (uint32_t ns = 0; ns < HISTOGRAM_NS; ns++) {
+        seen += s->histogram[ns];
+        if (seen >= rank) {
+            return ns;
+        }
+    }
+    return HISTOGRAM_NS - 1;
+}
+
+// Factory state, as after power-up, with the main.c background handlers
+static void reset_mia(void) {
+    irq_init();
+    background_init();
+    background_set_handler(BACKGROUND_WORK_COPY, indexed_memory_process_copy_command);
+    background_set_handler(BACKGROUND_WORK_COMMAND, indexed_memory_process_deferred_command);
+    indexed_memory_init();
+    bus_interface_init();
+}
+
+static volatile uint8_t sink;   // Keeps read data live
+
+static void replay(const bench_trace_t *trace) {
+    for (uint32_t i = 0; i < trace->count; i++) {
+        const bus_trace_record_t *record = &trace->records[i];
+        access_stats_t *s = &stats[reg_type(record->addr)][record->flags & BUS_TRACE_FLAG_WRITE];
+        
+        uint64_t start = now_ns();
+        if (record->flags & BUS_TRACE_FLAG_WRITE) {
+            bus_interface_write(record->addr, record->data);
+            add_sample(s, elapsed_ns(start, now_ns()));
+        } else {
+#ifdef CONFIG_BUS_READ_SHADOW
+            bus_interface_sync_shadow();
+            sink = bus_interface_peek(record->addr);
+            uint64_t prepared = now_ns();
+            bus_interface_commit_read(record->addr);
+            bus_interface_sync_shadow();
+#else
+            sink = bus_interface_read(record->addr);
+            uint64_t prepared = now_ns();
+#endif
+            add_sample(s, elapsed_ns(start, now_ns()));
+            uint64_t prepare_ns = elapsed_ns(start, prepared);
+            if (prepare_ns > s->prepare_max_ns) {
+                s->prepare_max_ns = prepare_ns;
+            }
+        }
+        
+        // Core 0 main loop between bus IRQs
+        start = now_ns();
+        if (background_run_next()) {
+            while (background_run_next()) {
+            }
+            add_sample(&background_stats, elapsed_ns(start, now_ns()));
+        }
+    }
+}
+
+static void print_row(const char *name, const char *rw, const access_stats_t *s, bool prepare) {
+    printf("  %-18s %-2s %10llu %10.1f %8u %8u %10llu", name, rw, (unsigned long long)s->count,
+           (double)s->total_ns / (double)s->count, percentile_ns(s, 50), percentile_ns(s, 99),
+           (unsigned long long)s->max_ns);
+    if (prepare) {
+        printf(" %10llu", (unsigned long long)s->prepare_max_ns);
+    }
+    printf("\n");
+}
+
+static void run_trace(const bench_trace_t *trace, uint32_t passes) {
+    // One pass to warm up caches and fault in memory, not reported
+    reset_mia();
+    replay(trace);
+    memset(stats, 0, sizeof(stats));
+    memset(&background_stats, 0, sizeof(background_stats));
+    
+    uint64_t start = now_ns();
+    for (uint32_t pass = 0; pass < passes; pass++) {
+        reset_mia();
+        replay(trace);
+    }
+    uint64_t total_ns = now_ns() - start;
+    
+    printf("\n%s: %u accesses x %u passes\n", trace->name, trace->count, passes);
+    printf("  %-18s %-2s %10s %10s %8s %8s %10s %10s\n",
+           "register", "", "count", "ns/access", "p50", "p99", "max ns", "prep max");
+    for (int type = 0; type < REG_TYPES; type++) {
+        if (stats[type][BUS_TRACE_FLAG_READ].count) {
+            print_row(reg_type_names[type], "R", &stats[type][BUS_TRACE_FLAG_READ], true);
+        }
+        if (stats[type][BUS_TRACE_FLAG_WRITE].count) {
+            print_row(reg_type_names[type], "W", &stats[type][BUS_TRACE_FLAG_WRITE], false);
+        }
+    }
+    if (background_stats.count) {
+        print_row("background work", "", &background_stats, false);
+    }
+    printf("  %.1f ns/access overall, including background work and resets\n",
+           (double)total_ns / ((double)trace->count * passes));
+}
+
+int main(int argc, char **argv) {
+    uint32_t passes = DEFAULT_PASSES;
+    int first_file = argc;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            passes = 1;
+        } else if (strcmp(argv[i], "--passes") == 0 && i + 1 < argc) {
+            passes = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "Usage: %s [--passes N] [--quick] [trace.bin ...]\n", argv[0]);
+            return 2;
+        } else {
+            first_file = i;
+            break;
+        }
+    }
+    if (passes == 0) {
+        passes = 1;
+    }
+    
+    calibrate_timer();
+    printf("MIA bus benchmark (timer overhead %llu ns, subtracted)\n", (unsigned long long)timer_overhead_ns);
+    
+    bench_trace_t trace;
+    if (first_file == argc) {
+        for (uint32_t n = 0; n < BENCH_SYNTHETIC_TRACES; n++) {
+            bench_trace_build(n, &trace);
+            run_trace(&trace, passes);
+            bench_trace_free(&trace);
+        }
+        return 0;
+    }
+    
+    for (int i = first_file; i < argc; i++) {
+        if (!bench_trace_load(argv[i], &trace)) {
+            fprintf(stderr, "Cannot load trace %s\n", argv[i]);
+            return 1;
+        }
+        run_trace(&trace, passes);
+        bench_trace_free(&trace);
+    }
+    return 0;
+}
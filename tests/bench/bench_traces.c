@@ -0,0 +1,200 @@
+/**
+ * MIA Bus Benchmark Traces Implementation
+ */
+
+#include "bench_traces.h"
+#include "bus_interface/bus_interface.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STREAM_LENGTH   4096
+#define USER_INDEX      IDX_USER_START
+
+static bench_trace_t *building;
+static uint32_t capacity;
+
+static void emit(uint8_t addr, uint8_t data, uint8_t flags) {
+    if (building->count == capacity) {
+        capacity = capacity ? capacity * 2 : 1024;
+        building->records = realloc(building->records, capacity * sizeof(bus_trace_record_t));
+        if (!building->records) {
+            fprintf(stderr, "Out of memory building %s\n", building->name);
+            exit(1);
+        }
+    }
+    bus_trace_record_t *record = &building->records[building->count];
+    record->time = building->count;     // One access per PHI2 cycle at 1 MHz
+    record->addr = addr;
+    record->data = data;
+    record->flags = flags;
+    record->sync = BUS_TRACE_SYNC;
+    building->count++;
+}
+
+static void emit_write(uint8_t addr, uint8_t data) {
+    emit(addr, data, BUS_TRACE_FLAG_WRITE);
+}
+
+static void emit_read(uint8_t addr) {
+    emit(addr, 0, BUS_TRACE_FLAG_READ);
+}
+
+// CFG_DATA writes to consecutive fields of a window's index
+static void emit_config(uint8_t window, uint8_t field, const uint8_t *values, uint32_t count) {
+    emit_write(window + REG_OFFSET_CFG_FIELD_SELECT, field | CFG_FIELD_AUTO_INCREMENT);
+    for (uint32_t i = 0; i < count; i++) {
+        emit_write(window + REG_OFFSET_CFG_DATA, values[i]);
+    }
+}
+
+// Write then read back STREAM_LENGTH bytes through one window
+static void build_data_port_stream(bool burst) {
+    emit_write(WINDOW_A_BASE + REG_OFFSET_IDX_SELECT, USER_INDEX);
+    if (burst) {
+        emit_write(WINDOW_A_BASE + REG_OFFSET_COMMAND, CMD_BURST_ENABLE);
+    }
+    for (uint32_t i = 0; i < STREAM_LENGTH; i++) {
+        emit_write(WINDOW_A_BASE + REG_OFFSET_DATA_PORT, (uint8_t)i);
+    }
+    emit_write(WINDOW_A_BASE + REG_OFFSET_COMMAND, CMD_RESET_INDEX);
+    for (uint32_t i = 0; i < STREAM_LENGTH; i++) {
+        emit_read(WINDOW_A_BASE + REG_OFFSET_DATA_PORT);
+    }
+    if (burst) {
+        emit_write(WINDOW_A_BASE + REG_OFFSET_COMMAND, CMD_BURST_DISABLE);
+    }
+}
+
+// Full configuration of 32 indexes with auto-increment, then read back
+static void build_config_burst(void) {
+    for (uint32_t i = 0; i < 32; i++) {
+        uint32_t addr = INDEXED_MEMORY_USER_AREA_BASE + i * 256;
+        uint32_t limit = addr + 256;
+        uint8_t fields[] = {
+            addr & 0xFF, (addr >> 8) & 0xFF, addr >> 16,
+            addr & 0xFF, (addr >> 8) & 0xFF, addr >> 16,
+            limit & 0xFF, (limit >> 8) & 0xFF, limit >> 16,
+            1, FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT
+        };
+        emit_write(WINDOW_A_BASE + REG_OFFSET_IDX_SELECT, (uint8_t)(USER_INDEX + i));
+        emit_config(WINDOW_A_BASE, CFG_ADDR_L, fields, sizeof(fields));
+        emit_write(WINDOW_A_BASE + REG_OFFSET_CFG_FIELD_SELECT, CFG_ADDR_L | CFG_FIELD_AUTO_INCREMENT);
+        for (uint32_t f = 0; f < sizeof(fields); f++) {
+            emit_read(WINDOW_A_BASE + REG_OFFSET_CFG_DATA);
+        }
+    }
+}
+
+// 64 block copies of 256 bytes, polling DEVICE_STATUS after each
+static void build_copy_commands(void) {
+    const uint8_t copy[] = { USER_INDEX, USER_INDEX + 1, 0x00, 0x01 };
+    emit_config(WINDOW_A_BASE, CFG_COPY_SRC_IDX, copy, sizeof(copy));
+    for (uint32_t i = 0; i < 64; i++) {
+        emit_write(REG_SHARED_COMMAND, CMD_COPY_BLOCK);
+        emit_read(REG_DEVICE_STATUS);
+        emit_read(REG_DEVICE_STATUS);
+    }
+}
+
+// 256 small fills, each acknowledged through IRQ_VECTOR_ACK
+static void build_irq_ack(void) {
+    const uint8_t fill[] = { USER_INDEX + 1, 16, 0 };
+    const uint8_t value = 0x55;
+    emit_write(REG_IRQ_MASK_LOW, IRQ_DMA_COMPLETE);
+    emit_write(REG_IRQ_ENABLE, 1);
+    emit_config(WINDOW_A_BASE, CFG_COPY_DST_IDX, fill, sizeof(fill));
+    emit_config(WINDOW_A_BASE, CFG_FILL_VALUE, &value, 1);
+    for (uint32_t i = 0; i < 256; i++) {
+        emit_write(REG_SHARED_COMMAND, CMD_FILL_BLOCK);
+        emit_read(REG_DEVICE_STATUS);
+        emit_read(REG_IRQ_VECTOR_ACK);
+        emit_read(REG_IRQ_CAUSE_LOW);
+    }
+}
+
+// Two copy loops interleaved over windows A-D (read A, write B, read C, write D)
+static void build_four_windows(void) {
+    for (uint8_t w = 0; w < 4; w++) {
+        emit_write(w * 0x10 + REG_OFFSET_IDX_SELECT, (uint8_t)(USER_INDEX + w));
+    }
+    for (uint32_t i = 0; i < STREAM_LENGTH / 2; i++) {
+        emit_read(WINDOW_A_BASE + REG_OFFSET_DATA_PORT);
+        emit_write(WINDOW_B_BASE + REG_OFFSET_DATA_PORT, (uint8_t)i);
+        emit_read(WINDOW_C_BASE + REG_OFFSET_DATA_PORT);
+        emit_write(WINDOW_D_BASE + REG_OFFSET_DATA_PORT, (uint8_t)~i);
+    }
+}
+
+static const struct {
+    const char *name;
+    void (*build)(void);
+    bool burst;
+} synthetic[BENCH_SYNTHETIC_TRACES] = {
+    { "data_port_stream", NULL, false },
+    { "data_port_burst", NULL, true },
+    { "config_burst", build_config_burst, false },
+    { "copy_commands", build_copy_commands, false },
+    { "irq_ack", build_irq_ack, false },
+    { "four_windows", build_four_windows, false },
+};
+
+void bench_trace_build(uint32_t n, bench_trace_t *trace) {
+    memset(trace, 0, sizeof(*trace));
+    snprintf(trace->name, sizeof(trace->name), "%s", synthetic[n].name);
+    building = trace;
+    capacity = 0;
+    if (synthetic[n].build) {
+        synthetic[n].build();
+    } else {
+        build_data_port_stream(synthetic[n].burst);
+    }
+}
+
+bool bench_trace_load(const char *path, bench_trace_t *trace) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    
+    memset(trace, 0, sizeof(*trace));
+    const char *base = strrchr(path, '/');
+    snprintf(trace->name, sizeof(trace->name), "%s", base ? base + 1 : path);
+    building = trace;
+    capacity = 0;
+    
+    // Slide an 8-byte window until its last byte is the sync byte
+    uint8_t bytes[sizeof(bus_trace_record_t)];
+    size_t have = 0;
+    int c;
+    while ((c = fgetc(file)) != EOF) {
+        bytes[have++] = (uint8_t)c;
+        if (have < sizeof(bytes)) {
+            continue;
+        }
+        if (bytes[7] != BUS_TRACE_SYNC) {
+            memmove(bytes, bytes + 1, sizeof(bytes) - 1);
+            have--;
+            continue;
+        }
+        emit(bytes[4], bytes[5], bytes[6] & BUS_TRACE_FLAG_WRITE);
+        building->records[trace->count - 1].time =
+            bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+        have = 0;
+    }
+    fclose(file);
+    
+    if (trace->count == 0) {
+        bench_trace_free(trace);
+        return false;
+    }
+    return true;
+}
+
+void bench_trace_free(bench_trace_t *trace) {
+    free(trace->records);
+    trace->records = NULL;
+    trace->count = 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * MIA Bus Benchmark Traces
+ * 
+ * Bus cycle traces for the host benchmark, in the record format of the
+ * firmware bus trace (bus_interface/bus_trace.h): synthetic workloads built
+ * here, or files captured with CONFIG_BUS_TRACE and loaded from disk.
+ */
+
+#ifndef BENCH_TRACES_H
+#define BENCH_TRACES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bus_interface/bus_trace.h"
+
+typedef struct {
+    char name[48];
+    bus_trace_record_t *records;
+    uint32_t count;
+} bench_trace_t;
+
+// Number of synthetic traces
+#define BENCH_SYNTHETIC_TRACES  6
+
+/**
+ * Build synthetic trace n (0 to BENCH_SYNTHETIC_TRACES - 1), starting from
+ * the factory index configuration:
+ * DATA_PORT streams (per access and burst), config bursts, copy commands,
+ * IRQ acks and four interleaved windows
+ */
+void bench_trace_build(uint32_t n, bench_trace_t *trace);
+
+/**
+ * Load a captured trace, skipping bytes until a record ends in
+ * BUS_TRACE_SYNC so a stream picked up mid-record still parses
+ * 
+ * @return false if the file cannot be read or holds no records
+ */
+bool bench_trace_load(const char *path, bench_trace_t *trace);
+
+void bench_trace_free(bench_trace_t *trace);
+
+#endif // BENCH_TRACES_H
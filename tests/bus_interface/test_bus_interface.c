@@ -322,7 +322,7 @@ bool test_bus_interface_multiwindow_edge_cases(void) {
         return false;
     }
     
-    // Test boundary between Window D and reserved space
+    // Test boundary between Window D and Window E
     addr = 0x3F;
     is_shared = (addr & 0x80) != 0;
     window_num = (addr >> 4) & 0x07;
@@ -339,18 +339,18 @@ bool test_bus_interface_multiwindow_edge_cases(void) {
     reg_offset = addr & 0x0F;
     
     if (is_shared || window_num != 4 || reg_offset != 0x00) {
-        printf("  FAIL: 0x40 should be first register of future Window E\n");
+        printf("  FAIL: 0x40 should be first register of Window E\n");
         return false;
     }
     
-    // Test boundary between reserved space and shared space
+    // Test boundary between Window H and shared space
     addr = 0x7F;
     is_shared = (addr & 0x80) != 0;
     window_num = (addr >> 4) & 0x07;
     reg_offset = addr & 0x0F;
     
     if (is_shared || window_num != 7 || reg_offset != 0x0F) {
-        printf("  FAIL: 0x7F should be last register of future Window H\n");
+        printf("  FAIL: 0x7F should be last register of Window H\n");
         return false;
     }
     
@@ -950,6 +950,50 @@ bool test_bus_interface_data_port_multi_window(void) {
     return true;
 }
 
+/**
+ * Test all eight windows stream their own index through the read shadow
+ */
+bool test_bus_interface_eight_windows(void) {
+    printf("Testing DATA_PORT streams on Windows A-H...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    // Window w streams index 128 + w, 16 bytes apart
+    for (uint8_t w = 0; w < MAX_WINDOWS; w++) {
+        uint8_t idx = 128 + w;
+        test_set_index_address(idx, 0x00014000 + w * 16);
+        test_set_index_default(idx, 0x00014000 + w * 16);
+        for (uint8_t i = 0; i < 4; i++) {
+            indexed_memory_write(idx, (uint8_t)((w << 4) | i));
+        }
+        indexed_memory_execute_window_command(idx, CMD_RESET_INDEX);
+        bus_interface_write((uint8_t)(w << 4) | REG_OFFSET_IDX_SELECT, idx);
+    }
+    
+    if (bus_interface_read(WINDOW_H_BASE + REG_OFFSET_IDX_SELECT) != 135) {
+        printf("  FAIL: Window H IDX_SELECT should read 135\n");
+        return false;
+    }
+    
+    // Interleaved reads, as a bus cycle does them: peek, then commit
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t w = 0; w < MAX_WINDOWS; w++) {
+            uint8_t addr = (uint8_t)(w << 4) | REG_OFFSET_DATA_PORT;
+            uint8_t value = bus_interface_peek(addr);
+            if (value != ((w << 4) | i)) {
+                printf("  FAIL: Window %c byte %d: expected 0x%02X, got 0x%02X\n",
+                       'A' + w, i, (w << 4) | i, value);
+                return false;
+            }
+            bus_interface_commit_read(addr);
+        }
+    }
+    
+    printf("  PASS: Windows A-H stream independently\n");
+    return true;
+}
+
 /**
  * Test DATA_PORT write handler for all windows
  */
@@ -2392,6 +2436,71 @@ bool test_bus_interface_individual_interrupt_bits(void) {
     return true;
 }
 
+/**
+ * Test IRQ_VECTOR priority order and IRQ_VECTOR_ACK acknowledgement
+ */
+bool test_bus_interface_irq_vector(void) {
+    printf("Testing IRQ vector registers...\n");
+    
+    bus_interface_init();
+    test_setup_indexed_memory();
+    
+    if (bus_interface_read(REG_IRQ_VECTOR) != IRQ_VECTOR_NONE) {
+        printf("  FAIL: IRQ_VECTOR should read IRQ_VECTOR_NONE with nothing pending\n");
+        return false;
+    }
+    
+    // Highest cause bit first, masked causes skipped
+    irq_set_bits(IRQ_MEMORY_ERROR | IRQ_DMA_COMPLETE | IRQ_VIDEO_FRAME_COMPLETE);
+    bus_interface_write(REG_IRQ_MASK_HIGH, 0x00);
+    if (bus_interface_read(REG_IRQ_VECTOR) != IRQ_VECTOR_OF(2) ||
+        bus_interface_read(REG_IRQ_VECTOR) != IRQ_VECTOR_OF(2)) {
+        printf("  FAIL: IRQ_VECTOR should be 0x%02X, got 0x%02X\n", IRQ_VECTOR_OF(2),
+               bus_interface_read(REG_IRQ_VECTOR));
+        return false;
+    }
+    bus_interface_write(REG_IRQ_MASK_HIGH, 0xFF);
+    
+    // Speculative ACK reads acknowledge nothing until committed
+    bus_interface_sync_shadow();
+    uint8_t vector = bus_interface_peek(REG_IRQ_VECTOR_ACK);
+    if (vector != IRQ_VECTOR_OF(8) || bus_interface_peek(REG_IRQ_VECTOR) != vector ||
+        irq_get_cause() != (IRQ_MEMORY_ERROR | IRQ_DMA_COMPLETE | IRQ_VIDEO_FRAME_COMPLETE)) {
+        printf("  FAIL: IRQ_VECTOR_ACK peek should return 0x%02X without side effects\n", IRQ_VECTOR_OF(8));
+        return false;
+    }
+    bus_interface_commit_read(REG_IRQ_VECTOR_ACK);
+    if (irq_get_cause() != (IRQ_MEMORY_ERROR | IRQ_DMA_COMPLETE) ||
+        bus_interface_peek(REG_IRQ_VECTOR_ACK) != IRQ_VECTOR_OF(2)) {
+        printf("  FAIL: Committed IRQ_VECTOR_ACK read should clear only its cause\n");
+        return false;
+    }
+    
+    // A READ queued behind writes acknowledges the vector it sent, even
+    // once the shadow shows a higher one
+    vector = bus_interface_peek(REG_IRQ_VECTOR_ACK);
+    irq_set_bits(IRQ_VIDEO_FRAME_COMPLETE);
+    bus_interface_sync_shadow();
+    bus_interface_commit_queued_read(REG_IRQ_VECTOR_ACK, vector);
+    if (irq_get_cause() != (IRQ_MEMORY_ERROR | IRQ_VIDEO_FRAME_COMPLETE)) {
+        printf("  FAIL: Queued IRQ_VECTOR_ACK read should clear the cause it sent\n");
+        return false;
+    }
+    irq_clear_bits(IRQ_VIDEO_FRAME_COMPLETE);
+    irq_set_bits(IRQ_DMA_COMPLETE);
+    
+    // The handler loop: read and acknowledge until nothing is left
+    if (bus_interface_read(REG_IRQ_VECTOR_ACK) != IRQ_VECTOR_OF(2) ||
+        bus_interface_read(REG_IRQ_VECTOR_ACK) != IRQ_VECTOR_OF(0) ||
+        bus_interface_read(REG_IRQ_VECTOR_ACK) != IRQ_VECTOR_NONE || irq_get_cause() != 0) {
+        printf("  FAIL: IRQ_VECTOR_ACK reads should drain the causes in priority order\n");
+        return false;
+    }
+    
+    printf("  PASS: IRQ vector registers work correctly\n");
+    return true;
+}
+
 /**
  * Test COMMAND register write handler - CMD_RESET_INDEX
  */
@@ -2523,6 +2632,18 @@ bool test_bus_interface_command_reset_all(void) {
     // Execute CMD_RESET_ALL_IDX via SHARED_COMMAND register at 0xFF
     bus_interface_write(0xFF, CMD_RESET_ALL_IDX);
     
+    // The bus path only defers it, busy until the background work runs it
+    if (!(bus_interface_read(0xF0) & STATUS_BUSY) ||
+        indexed_memory_get_config_field(128, CFG_ADDR_M) != 0x39) {
+        printf("  FAIL: Reset should be pending with STATUS_BUSY set\n");
+        return false;
+    }
+    indexed_memory_process_deferred_command();
+    if ((bus_interface_read(0xF0) & STATUS_BUSY) || !(test_get_irq_cause() & IRQ_COMMAND_DONE)) {
+        printf("  FAIL: STATUS_BUSY should clear with IRQ_COMMAND_DONE\n");
+        return false;
+    }
+    
     // Verify all indexes were reset to their defaults
     // Check a few representative indexes
     uint32_t addr_128 = (indexed_memory_get_config_field(128, CFG_ADDR_H) << 16) |
@@ -2636,7 +2757,15 @@ bool test_bus_interface_command_factory_reset_all_idx(void) {
     irq_set_bits(IRQ_DMA_COMPLETE);
     
     // Execute CMD_FACTORY_RESET_ALL_IDX via SHARED_COMMAND register at 0xFF
+    // A CMD_RESET_ALL_IDX issued meanwhile is covered by the factory reset
     bus_interface_write(0xFF, CMD_FACTORY_RESET_ALL_IDX);
+    bus_interface_write(0xFF, CMD_RESET_ALL_IDX);
+    if (!(bus_interface_read(0xF0) & STATUS_BUSY) || test_get_irq_cause() != (IRQ_MEMORY_ERROR | IRQ_DMA_COMPLETE)) {
+        printf("  FAIL: Factory reset should be pending with STATUS_BUSY set\n");
+        return false;
+    }
+    indexed_memory_process_deferred_command();
+    indexed_memory_process_deferred_command();
     
     // Verify indexed memory subsystem was reset to factory defaults
     // Check that indexes were reset
@@ -2654,16 +2783,16 @@ bool test_bus_interface_command_factory_reset_all_idx(void) {
         return false;
     }
     
-    // Check that interrupts were cleared
+    // Check that interrupts were cleared, leaving the completion alone
     uint16_t cause = test_get_irq_cause();
-    if (cause != 0) {
+    if (cause != IRQ_COMMAND_DONE) {
         printf("  FAIL: Interrupts should be cleared after subsystem reset, got 0x%04X\n", cause);
         return false;
     }
     
     // Check that system is ready
     uint8_t status = bus_interface_read(0xF0);  // REG_DEVICE_STATUS
-    if (!(status & STATUS_SYSTEM_READY)) {
+    if (!(status & STATUS_SYSTEM_READY) || (status & STATUS_BUSY)) {
         printf("  FAIL: System should be ready after subsystem reset\n");
         return false;
     }
@@ -2779,7 +2908,7 @@ bool test_bus_interface_command_copy_single_byte(void) {
     // Execute CMD_COPY_BLOCK via SHARED_COMMAND register at 0xFF
     bus_interface_write(0xFF, CMD_COPY_BLOCK);
     
-    // Process queued commands (simulates Core 1 processing)
+    // Process queued commands (simulates the Core 0 background work)
     for (int i = 0; i < 10; i++) {
         indexed_memory_process_copy_command();
     }
@@ -2850,7 +2979,7 @@ bool test_bus_interface_command_copy_multi_byte(void) {
     // Execute CMD_COPY_BLOCK via SHARED_COMMAND register at 0xFF
     bus_interface_write(0xFF, CMD_COPY_BLOCK);
     
-    // Process queued commands (simulates Core 1 processing)
+    // Process queued commands (simulates the Core 0 background work)
     for (int i = 0; i < 10; i++) {
         indexed_memory_process_copy_command();
     }
@@ -2970,7 +3099,7 @@ bool test_bus_interface_dma_completion_interrupt(void) {
     // Execute DMA operation via SHARED_COMMAND register at 0xFF
     bus_interface_write(0xFF, CMD_COPY_BLOCK);
     
-    // Process queued commands (simulates Core 1 processing)
+    // Process queued commands (simulates the Core 0 background work)
     for (int i = 0; i < 10; i++) {
         indexed_memory_process_copy_command();
     }
@@ -2997,6 +3126,570 @@ bool test_bus_interface_dma_completion_interrupt(void) {
     return true;
 }
 
+/**
+ * Test read shadow matches the live read path for every register
+ */
+bool test_bus_interface_read_shadow_matches_live(void) {
+    printf("Testing read shadow matches live register reads...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    // Give the windows something distinct to show
+    test_set_index_address(128, 0x00014000);
+    indexed_memory_write(128, 0x5A);
+    indexed_memory_execute_window_command(128, CMD_RESET_INDEX);
+    bus_interface_write(0x00, 128);                 // Window A: index 128
+    bus_interface_write(0x12, CFG_STEP);            // Window B: CFG_STEP
+    bus_interface_write(REG_IRQ_MASK_LOW, 0x3C);
+    irq_set_bits(IRQ_USB_KEYBOARD);
+    bus_interface_sync_shadow();
+    
+    for (int addr = 0; addr < 256; addr++) {
+        uint8_t shadow = bus_interface_peek(addr);
+        uint8_t live = bus_interface_read(addr);
+        if (shadow != live) {
+            printf("  FAIL: Shadow at 0x%02X is 0x%02X, live read returned 0x%02X\n",
+                   addr, shadow, live);
+            return false;
+        }
+        // Undo DATA_PORT auto-step from the live read
+        if ((addr & 0x80) == 0 && (addr & 0x0F) == REG_OFFSET_DATA_PORT) {
+            uint8_t idx = g_window_state[(addr >> 4) & 0x07].active_index;
+            indexed_memory_execute_window_command(idx, CMD_RESET_INDEX);
+        }
+    }
+    
+    printf("  PASS: Read shadow matches live reads\n");
+    return true;
+}
+
+/**
+ * Test peek has no side effects and commit applies DATA_PORT auto-step
+ */
+bool test_bus_interface_read_shadow_commit(void) {
+    printf("Testing read shadow peek/commit split...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    test_set_index_address(128, 0x00014000);
+    test_set_index_default(128, 0x00014000);
+    for (uint8_t i = 0; i < 4; i++) {
+        indexed_memory_write(128, 0x10 + i);
+    }
+    indexed_memory_execute_window_command(128, CMD_RESET_INDEX);
+    
+    // Windows A and C share index 128
+    bus_interface_write(0x00, 128);
+    bus_interface_write(0x20, 128);
+    
+    // Speculation alone (WRITE or OE-inactive cycles) must not step
+    if (bus_interface_peek(0x01) != 0x10 || bus_interface_peek(0x01) != 0x10) {
+        printf("  FAIL: Peek should not auto-step\n");
+        return false;
+    }
+    
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t value = bus_interface_peek(0x01);
+        if (value != 0x10 + i) {
+            printf("  FAIL: Expected 0x%02X at position %d, got 0x%02X\n", 0x10 + i, i, value);
+            return false;
+        }
+        bus_interface_commit_read(0x01);
+        
+        // Window C sees the stepped index as well
+        if (bus_interface_peek(0x21) != indexed_memory_peek(128)) {
+            printf("  FAIL: Window C shadow not refreshed after commit\n");
+            return false;
+        }
+    }
+    
+    // Committing a register without side effects leaves the index alone
+    uint32_t addr_before = indexed_memory_get_config_field(128, CFG_ADDR_L);
+    bus_interface_commit_read(0x00);
+    bus_interface_commit_read(REG_IRQ_CAUSE_LOW);
+    if (indexed_memory_get_config_field(128, CFG_ADDR_L) != addr_before) {
+        printf("  FAIL: Commit of non DATA_PORT register changed the index\n");
+        return false;
+    }
+    
+    printf("  PASS: Peek/commit split works correctly\n");
+    return true;
+}
+
+/**
+ * Test the write path keeps the shadow current
+ */
+bool test_bus_interface_read_shadow_write_path(void) {
+    printf("Testing read shadow updates on register writes...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    // Indexes 128 and 129 both point at the same byte
+    test_set_index_address(128, 0x00014000);
+    test_set_index_address(129, 0x00014000);
+    test_set_index_flags(129, 0);
+    bus_interface_write(0x00, 128);     // Window A: index 128
+    bus_interface_write(0x10, 129);     // Window B: index 129
+    
+    if (bus_interface_peek(0x00) != 128 || bus_interface_peek(0x10) != 129) {
+        printf("  FAIL: IDX_SELECT shadow not updated\n");
+        return false;
+    }
+    
+    // Write through window B, window A must see the new byte
+    bus_interface_write(0x11, 0xE7);
+    if (bus_interface_peek(0x01) != 0xE7) {
+        printf("  FAIL: Window A DATA_PORT shadow is 0x%02X, expected 0xE7\n",
+               bus_interface_peek(0x01));
+        return false;
+    }
+    
+    // CFG_DATA follows field select and config writes
+    bus_interface_write(0x02, CFG_STEP);
+    bus_interface_write(0x03, 7);
+    if (bus_interface_peek(0x02) != CFG_STEP || bus_interface_peek(0x03) != 7) {
+        printf("  FAIL: CFG_FIELD_SELECT/CFG_DATA shadow not updated\n");
+        return false;
+    }
+    
+    // Shared registers
+    bus_interface_write(REG_IRQ_ENABLE, 0);
+    if (bus_interface_peek(REG_IRQ_ENABLE) != 0) {
+        printf("  FAIL: IRQ_ENABLE shadow not updated\n");
+        return false;
+    }
+    
+    printf("  PASS: Write path keeps the read shadow current\n");
+    return true;
+}
+
+/**
+ * Test sync picks up changes made outside the bus path (Core 1)
+ */
+bool test_bus_interface_read_shadow_sync(void) {
+    printf("Testing read shadow sync after Core 1 changes...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    // IRQ raised outside the bus path: flagged stale, not refreshed, until synced
+    if (bus_interface_shadow_stale()) {
+        printf("  FAIL: Shadow stale right after init\n");
+        return false;
+    }
+    irq_set_bits(IRQ_VIDEO_FRAME_COMPLETE);
+    if (!bus_interface_shadow_stale() || bus_interface_peek(REG_IRQ_CAUSE_HIGH) != 0) {
+        printf("  FAIL: IRQ raise should leave the shadow stale until synced\n");
+        return false;
+    }
+    bus_interface_sync_shadow();
+    if (bus_interface_shadow_stale()) {
+        printf("  FAIL: Shadow still stale after sync\n");
+        return false;
+    }
+    if (bus_interface_peek(REG_IRQ_CAUSE_HIGH) != (IRQ_VIDEO_FRAME_COMPLETE >> 8) ||
+        (bus_interface_peek(REG_DEVICE_STATUS) & STATUS_IRQ_PENDING) == 0) {
+        printf("  FAIL: Shared register shadow not refreshed after IRQ\n");
+        return false;
+    }
+    
+    // DMA copy into the byte window A is looking at
+    test_set_index_address(128, 0x00014000);
+    indexed_memory_write(128, 0x99);
+    test_set_index_address(128, 0x00014000);
+    test_set_index_address(129, 0x00014100);
+    bus_interface_write(0x00, 129);
+    bus_interface_write(0x02, CFG_COPY_SRC_IDX);
+    bus_interface_write(0x03, 128);
+    bus_interface_write(0x02, CFG_COPY_DST_IDX);
+    bus_interface_write(0x03, 129);
+    bus_interface_write(0x02, CFG_COPY_COUNT_L);
+    bus_interface_write(0x03, 1);
+    bus_interface_write(0x02, CFG_COPY_COUNT_H);
+    bus_interface_write(0x03, 0);
+    bus_interface_write(REG_SHARED_COMMAND, CMD_COPY_BLOCK);
+    indexed_memory_process_copy_command();
+    
+    bus_interface_sync_shadow();
+    if (bus_interface_peek(0x01) != 0x99) {
+        printf("  FAIL: DATA_PORT shadow is 0x%02X after DMA, expected 0x99\n",
+               bus_interface_peek(0x01));
+        return false;
+    }
+    
+    printf("  PASS: Sync picks up Core 1 changes\n");
+    return true;
+}
+
+/**
+ * Test burst mode streams DATA_PORT writes like the per-access path
+ */
+bool test_bus_interface_burst_stream(void) {
+    printf("Testing DATA_PORT burst streaming...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    // Character table 16 wraps after 6KB; stream a bit more than that
+    uint32_t base = indexed_memory_get_config_field(16, CFG_ADDR_L) |
+                    (indexed_memory_get_config_field(16, CFG_ADDR_M) << 8) |
+                    (indexed_memory_get_config_field(16, CFG_ADDR_H) << 16);
+    bus_interface_write(0x00, 16);                  // Window A: index 16
+    bus_interface_write(0x04, CMD_BURST_ENABLE);
+    for (uint32_t i = 0; i < 256 * 24 + 3; i++) {
+        bus_interface_write(0x01, (uint8_t)(i * 7));
+    }
+    
+    if (!g_window_state[0].burst_loaded) {
+        printf("  FAIL: Burst cursor not loaded\n");
+        return false;
+    }
+    
+    // CFG_DATA access writes the cursor back
+    bus_interface_write(0x02, CFG_ADDR_L);
+    uint32_t addr = bus_interface_read(0x03);
+    bus_interface_write(0x02, CFG_ADDR_M);
+    addr |= bus_interface_read(0x03) << 8;
+    bus_interface_write(0x02, CFG_ADDR_H);
+    addr |= bus_interface_read(0x03) << 16;
+    if (g_window_state[0].burst_loaded || addr != base + 3) {
+        printf("  FAIL: Address after burst is 0x%06X, expected 0x%06X\n",
+               (unsigned)addr, (unsigned)(base + 3));
+        return false;
+    }
+    
+    // Read back through the per-access path
+    bus_interface_write(0x04, CMD_BURST_DISABLE);
+    bus_interface_write(0x04, CMD_RESET_INDEX);
+    for (uint32_t i = 0; i < 256 * 24; i++) {
+        // The first 3 bytes were overwritten after the wrap
+        uint32_t n = (i < 3) ? i + 256 * 24 : i;
+        uint8_t data = bus_interface_read(0x01);
+        if (data != (uint8_t)(n * 7)) {
+            printf("  FAIL: Byte %u is 0x%02X, expected 0x%02X\n",
+                   (unsigned)i, data, (uint8_t)(n * 7));
+            return false;
+        }
+    }
+    
+    printf("  PASS: Burst streaming matches per-access DATA_PORT\n");
+    return true;
+}
+
+/**
+ * Test burst cursors are written back and are never shared between windows
+ */
+bool test_bus_interface_burst_coherency(void) {
+    printf("Testing DATA_PORT burst coherency...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    test_set_index_address(128, 0x00014000);
+    test_set_index_default(128, 0x00014000);
+    bus_interface_write(0x00, 128);                 // Window A: index 128
+    bus_interface_write(0x04, CMD_BURST_ENABLE);
+    bus_interface_write(0x01, 0x11);
+    bus_interface_write(0x01, 0x22);
+    
+    // Selecting the same index on window B writes the cursor back
+    bus_interface_write(0x10, 128);
+    if (g_window_state[0].burst_loaded) {
+        printf("  FAIL: Cursor still loaded after IDX_SELECT\n");
+        return false;
+    }
+    
+    // While both windows share the index, window A stays uncached
+    bus_interface_write(0x11, 0x33);
+    bus_interface_write(0x01, 0x44);
+    if (g_window_state[0].burst_loaded) {
+        printf("  FAIL: Cursor loaded for an index selected by two windows\n");
+        return false;
+    }
+    
+    bus_interface_write(0x04, CMD_RESET_INDEX);
+    const uint8_t expected[4] = { 0x11, 0x22, 0x33, 0x44 };
+    for (int i = 0; i < 4; i++) {
+        uint8_t data = bus_interface_read(0x01);
+        if (data != expected[i]) {
+            printf("  FAIL: Byte %d is 0x%02X, expected 0x%02X\n", i, data, expected[i]);
+            return false;
+        }
+    }
+    
+    // Backward-stepping indexes are not cached
+    bus_interface_write(0x10, 129);
+    test_set_index_flags(128, FLAG_AUTO_STEP | FLAG_DIRECTION);
+    bus_interface_read(0x01);
+    if (g_window_state[0].burst_loaded) {
+        printf("  FAIL: Cursor loaded for a backward-stepping index\n");
+        return false;
+    }
+    
+    printf("  PASS: Burst cursors stay coherent with the index table\n");
+    return true;
+}
+
+/**
+ * Test the read shadow follows a burst cursor
+ */
+bool test_bus_interface_burst_read_shadow(void) {
+    printf("Testing read shadow with DATA_PORT burst...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    test_set_index_address(128, 0x00014000);
+    test_set_index_default(128, 0x00014000);
+    bus_interface_write(0x00, 128);
+    bus_interface_write(0x04, CMD_BURST_ENABLE);
+    bus_interface_write(0x02, CFG_ADDR_L);
+    for (int i = 0; i < 4; i++) {
+        bus_interface_write(0x01, (uint8_t)(0xA0 + i));
+    }
+    
+    // Shadow CFG_DATA reports the cursor address without a write-back
+    if (!g_window_state[0].burst_loaded || bus_interface_peek(0x03) != 0x04) {
+        printf("  FAIL: CFG_DATA shadow is 0x%02X, expected 0x04\n",
+               bus_interface_peek(0x03));
+        return false;
+    }
+    
+    // Rewind (COMMAND writes back), then stream reads through peek/commit
+    bus_interface_write(0x04, CMD_RESET_INDEX);
+    for (int i = 0; i < 4; i++) {
+        uint8_t data = bus_interface_peek(0x01);
+        bus_interface_commit_read(0x01);
+        if (data != (uint8_t)(0xA0 + i)) {
+            printf("  FAIL: Shadow read %d is 0x%02X, expected 0x%02X\n",
+                   i, data, (uint8_t)(0xA0 + i));
+            return false;
+        }
+    }
+    
+    if (!g_window_state[0].burst_loaded || bus_interface_peek(0x03) != 0x04) {
+        printf("  FAIL: Committed reads did not step the cursor\n");
+        return false;
+    }
+    
+    printf("  PASS: Read shadow follows the burst cursor\n");
+    return true;
+}
+
+/**
+ * Test bank windows: offsets +5..+15 map onto the active index
+ */
+bool test_bus_interface_bank_window(void) {
+    printf("Testing bank window access...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    // Index 128 auto-steps by 1 over a 4-byte record at $014000
+    test_set_index_address(128, 0x00014000);
+    test_set_index_default(128, 0x00014000);
+    for (uint8_t i = 0; i < 16; i++) {
+        indexed_memory_write(128, (uint8_t)(0x40 + i));
+    }
+    indexed_memory_execute_window_command(128, CMD_RESET_INDEX);
+    
+    // Reserved until enabled
+    bus_interface_write(WINDOW_E_BASE + REG_OFFSET_IDX_SELECT, 128);
+    bus_interface_write(WINDOW_E_BASE + REG_OFFSET_BANK + 2, 0x99);
+    if (bus_interface_read(WINDOW_E_BASE + REG_OFFSET_BANK) != 0 ||
+        indexed_memory_peek_address(0x00014002) != 0x42) {
+        printf("  FAIL: Bank offsets should be reserved before BANK_ENABLE\n");
+        return false;
+    }
+    
+    bus_interface_write(WINDOW_E_BASE + REG_OFFSET_COMMAND, CMD_BANK_ENABLE);
+    
+    // Reads, live and through the shadow, without stepping the index
+    for (uint8_t i = 0; i < BANK_WINDOW_SIZE; i++) {
+        uint8_t addr = WINDOW_E_BASE + REG_OFFSET_BANK + i;
+        if (bus_interface_peek(addr) != 0x40 + i || bus_interface_read(addr) != 0x40 + i) {
+            printf("  FAIL: Bank byte %d should read 0x%02X\n", i, 0x40 + i);
+            return false;
+        }
+        bus_interface_commit_read(addr);
+    }
+    if (indexed_memory_get_address(128) != 0x00014000) {
+        printf("  FAIL: Bank reads should not step the index\n");
+        return false;
+    }
+    
+    // Writes go to memory, and windows sharing the index see them
+    bus_interface_write(WINDOW_A_BASE + REG_OFFSET_IDX_SELECT, 128);
+    bus_interface_write(WINDOW_E_BASE + REG_OFFSET_BANK, 0x77);
+    if (indexed_memory_peek_address(0x00014000) != 0x77 ||
+        bus_interface_peek(WINDOW_A_BASE + REG_OFFSET_DATA_PORT) != 0x77) {
+        printf("  FAIL: Bank write should reach memory and other windows\n");
+        return false;
+    }
+    
+    // A DATA_PORT read of the same window moves the bank along
+    bus_interface_commit_read(WINDOW_E_BASE + REG_OFFSET_DATA_PORT);
+    if (bus_interface_peek(WINDOW_E_BASE + REG_OFFSET_BANK) != 0x41) {
+        printf("  FAIL: Bank should follow the DATA_PORT step\n");
+        return false;
+    }
+    
+    // Burst cursors: the bank follows the cursor address
+    bus_interface_write(WINDOW_A_BASE + REG_OFFSET_IDX_SELECT, 0);
+    bus_interface_write(WINDOW_E_BASE + REG_OFFSET_COMMAND, CMD_BURST_ENABLE);
+    bus_interface_commit_read(WINDOW_E_BASE + REG_OFFSET_DATA_PORT);
+    if (!g_window_state[4].burst_loaded ||
+        bus_interface_peek(WINDOW_E_BASE + REG_OFFSET_BANK) != 0x42 ||
+        bus_interface_read(WINDOW_E_BASE + REG_OFFSET_BANK + 1) != 0x43) {
+        printf("  FAIL: Bank should follow the burst cursor\n");
+        return false;
+    }
+    
+    // Disabled again: reserved, and the shadow agrees
+    bus_interface_write(WINDOW_E_BASE + REG_OFFSET_COMMAND, CMD_BANK_DISABLE);
+    if (bus_interface_peek(WINDOW_E_BASE + REG_OFFSET_BANK) != 0 ||
+        bus_interface_read(WINDOW_E_BASE + REG_OFFSET_BANK) != 0) {
+        printf("  FAIL: Bank offsets should read 0 after BANK_DISABLE\n");
+        return false;
+    }
+    
+    printf("  PASS: Bank window access works correctly\n");
+    return true;
+}
+
+/**
+ * Test CFG_FIELD_SELECT auto-increment mode
+ */
+bool test_bus_interface_cfg_data_auto_increment(void) {
+    printf("Testing CFG_DATA auto-increment...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    // Load current, default and limit addresses plus step and flags with
+    // one field select and eleven data writes
+    static const uint8_t fields[11] = {
+        0x00, 0x20, 0x01,   // ADDR    $012000
+        0x00, 0x20, 0x01,   // DEFAULT $012000
+        0x40, 0x20, 0x01,   // LIMIT   $012040
+        0x02,               // STEP
+        FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT
+    };
+    bus_interface_write(0x20, 130);
+    bus_interface_write(0x22, CFG_FIELD_AUTO_INCREMENT | CFG_ADDR_L);
+    for (int i = 0; i < 11; i++) {
+        bus_interface_write(0x23, fields[i]);
+    }
+    
+    if (bus_interface_read(0x22) != (CFG_FIELD_AUTO_INCREMENT | 11)) {
+        printf("  FAIL: Field select is 0x%02X after 11 writes\n", bus_interface_read(0x22));
+        return false;
+    }
+    for (uint8_t f = CFG_ADDR_L; f <= CFG_FLAGS; f++) {
+        if (indexed_memory_get_config_field(130, f) != fields[f]) {
+            printf("  FAIL: Field 0x%02X is 0x%02X, expected 0x%02X\n",
+                   f, indexed_memory_get_config_field(130, f), fields[f]);
+            return false;
+        }
+    }
+    
+    // Reads step too, through the live path and the shadow commit
+    bus_interface_write(0x22, CFG_FIELD_AUTO_INCREMENT | CFG_ADDR_L);
+    if (bus_interface_read(0x23) != 0x00 || bus_interface_read(0x23) != 0x20) {
+        printf("  FAIL: Live CFG_DATA reads did not step the field\n");
+        return false;
+    }
+    bus_interface_write(0x22, CFG_FIELD_AUTO_INCREMENT | CFG_ADDR_H);
+    uint8_t data = bus_interface_peek(0x23);
+    bus_interface_commit_read(0x23);
+    if (data != 0x01 || bus_interface_peek(0x22) != (CFG_FIELD_AUTO_INCREMENT | CFG_DEFAULT_L) ||
+        bus_interface_peek(0x23) != 0x00) {
+        printf("  FAIL: Committed CFG_DATA read did not step the field\n");
+        return false;
+    }
+    
+    // Without the bit the field stays selected
+    bus_interface_write(0x22, CFG_STEP);
+    bus_interface_write(0x23, 0x03);
+    bus_interface_write(0x23, 0x04);
+    if (bus_interface_read(0x22) != CFG_STEP || indexed_memory_get_config_field(130, CFG_FLAGS) != fields[10]) {
+        printf("  FAIL: Plain field select stepped\n");
+        return false;
+    }
+    
+    printf("  PASS: CFG_DATA auto-increment works correctly\n");
+    return true;
+}
+
+/**
+ * Test CMD_LOAD_DESCRIPTOR from a descriptor table
+ */
+bool test_bus_interface_command_load_descriptor(void) {
+    printf("Testing CMD_LOAD_DESCRIPTOR...\n");
+    
+    test_setup_indexed_memory();
+    bus_interface_init();
+    
+    // Two descriptors written through index 140 at $013000
+    static const uint8_t table[2][INDEX_DESCRIPTOR_SIZE] = {
+        { 0x00, 0x40, 0x01, 0x00, 0x40, 0x01, 0x00, 0x41, 0x01, 0x01, FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT, 0 },
+        { 0x80, 0x50, 0x02, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x04, FLAG_AUTO_STEP, 0 },
+    };
+    test_set_index_address(140, 0x013000);
+    for (int d = 0; d < 2; d++) {
+        for (int i = 0; i < INDEX_DESCRIPTOR_SIZE; i++) {
+            indexed_memory_write(140, table[d][i]);
+        }
+    }
+    test_set_index_address(140, 0x013000);
+    test_set_index_flags(140, FLAG_AUTO_STEP | FLAG_COPY_ADVANCE);
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_IDX, 140);
+    indexed_memory_set_config_field(141, CFG_ROW_WIDTH, 4);
+    indexed_memory_set_config_field(141, CFG_ROW_STRIDE_L, 40);
+    
+    // Window A loads index 141, window B index 142: two writes each
+    bus_interface_write(0x00, 141);
+    bus_interface_write(0x04, CMD_LOAD_DESCRIPTOR);
+    bus_interface_write(0x10, 142);
+    bus_interface_write(0x14, CMD_LOAD_DESCRIPTOR);
+    
+    for (int d = 0; d < 2; d++) {
+        for (uint8_t f = CFG_ADDR_L; f <= CFG_FLAGS; f++) {
+            if (indexed_memory_get_config_field(141 + d, f) != table[d][f]) {
+                printf("  FAIL: Index %d field 0x%02X is 0x%02X, expected 0x%02X\n",
+                       141 + d, f, indexed_memory_get_config_field(141 + d, f), table[d][f]);
+                return false;
+            }
+        }
+    }
+    if (indexed_memory_get_config_field(141, CFG_ROW_WIDTH) != 0 ||
+        indexed_memory_get_config_field(141, CFG_ROW_STRIDE_L) != 0) {
+        printf("  FAIL: Row fields kept across a descriptor load\n");
+        return false;
+    }
+    
+    // The loaded index is live: DATA_PORT uses its new address and step
+    indexed_memory_write(142, 0x5A);
+    if (bus_interface_read(0x11) != 0x00 || indexed_memory_get_config_field(142, CFG_ADDR_L) != 0x88) {
+        printf("  FAIL: Loaded index does not step by its descriptor step\n");
+        return false;
+    }
+    
+    // A descriptor crossing the end of MIA memory is rejected
+    test_set_index_address(140, 0x03FFF8);
+    bus_interface_write(0x04, CMD_LOAD_DESCRIPTOR);
+    if (!(test_get_irq_cause() & IRQ_MEMORY_ERROR)) {
+        printf("  FAIL: Out of bounds descriptor not reported\n");
+        return false;
+    }
+    
+    printf("  PASS: CMD_LOAD_DESCRIPTOR works correctly\n");
+    return true;
+}
+
 /**
  * Run all bus interface tests
  */
@@ -3023,6 +3716,7 @@ bool run_bus_interface_tests(void) {
     all_passed &= test_bus_interface_data_port_read();
     all_passed &= test_bus_interface_data_port_auto_step();
     all_passed &= test_bus_interface_data_port_multi_window();
+    all_passed &= test_bus_interface_eight_windows();
     all_passed &= test_bus_interface_data_port_write();
     all_passed &= test_bus_interface_data_port_write_auto_step();
     all_passed &= test_bus_interface_data_port_write_multi_window();
@@ -3038,6 +3732,8 @@ bool run_bus_interface_tests(void) {
     all_passed &= test_bus_interface_cfg_data_multibyte_fields();
     all_passed &= test_bus_interface_cfg_data_dma_fields();
     all_passed &= test_bus_interface_cfg_multi_window();
+    all_passed &= test_bus_interface_cfg_data_auto_increment();
+    all_passed &= test_bus_interface_command_load_descriptor();
     
     // Shared register tests
     all_passed &= test_bus_interface_device_status_read();
@@ -3048,6 +3744,7 @@ bool run_bus_interface_tests(void) {
     all_passed &= test_bus_interface_irq_enable_read_write();
     all_passed &= test_bus_interface_irq_line_behavior();
     all_passed &= test_bus_interface_individual_interrupt_bits();
+    all_passed &= test_bus_interface_irq_vector();
     
     // Command register tests (window-level)
     all_passed &= test_bus_interface_command_reset_index();
@@ -3067,6 +3764,16 @@ bool run_bus_interface_tests(void) {
     all_passed &= test_bus_interface_dma_configuration();
     all_passed &= test_bus_interface_dma_completion_interrupt();
     
+    // Read response shadow tests
+    all_passed &= test_bus_interface_read_shadow_matches_live();
+    all_passed &= test_bus_interface_read_shadow_commit();
+    all_passed &= test_bus_interface_read_shadow_write_path();
+    all_passed &= test_bus_interface_read_shadow_sync();
+    all_passed &= test_bus_interface_burst_stream();
+    all_passed &= test_bus_interface_burst_coherency();
+    all_passed &= test_bus_interface_burst_read_shadow();
+    all_passed &= test_bus_interface_bank_window();
+    
     if (all_passed) {
         printf("\n=== All Bus Interface Tests PASSED ===\n\n");
     } else {
@@ -19,6 +19,7 @@ bool test_bus_interface_config_field_access(void);
 bool test_bus_interface_window_independence(void);
 bool test_bus_interface_direct_access(void);
 bool test_bus_interface_idx_select_read(void);
+bool test_bus_interface_eight_windows(void);
 bool test_bus_interface_data_port_step_sizes(void);
 bool test_bus_interface_data_port_directions(void);
 bool test_bus_interface_data_port_wrap_on_limit(void);
@@ -30,6 +31,8 @@ bool test_bus_interface_cfg_data_write(void);
 bool test_bus_interface_cfg_data_multibyte_fields(void);
 bool test_bus_interface_cfg_data_dma_fields(void);
 bool test_bus_interface_cfg_multi_window(void);
+bool test_bus_interface_cfg_data_auto_increment(void);
+bool test_bus_interface_command_load_descriptor(void);
 
 // Shared register tests
 bool test_bus_interface_device_status_read(void);
@@ -40,6 +43,17 @@ bool test_bus_interface_irq_mask_read_write(void);
 bool test_bus_interface_irq_enable_read_write(void);
 bool test_bus_interface_irq_line_behavior(void);
 bool test_bus_interface_individual_interrupt_bits(void);
+bool test_bus_interface_irq_vector(void);
+
+// Read response shadow tests
+bool test_bus_interface_read_shadow_matches_live(void);
+bool test_bus_interface_read_shadow_commit(void);
+bool test_bus_interface_read_shadow_write_path(void);
+bool test_bus_interface_read_shadow_sync(void);
+bool test_bus_interface_burst_stream(void);
+bool test_bus_interface_burst_coherency(void);
+bool test_bus_interface_burst_read_shadow(void);
+bool test_bus_interface_bank_window(void);
 
 // Main test runner
 bool run_bus_interface_tests(void);
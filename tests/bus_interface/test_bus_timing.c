@@ -0,0 +1,186 @@
+/**
+ * MIA Bus Timing Statistics Test Implementation
+ * 
+ * Tests for the per-phase cycle statistics and the TIMING_SELECT/TIMING_DATA
+ * shared registers.
+ */
+
+#include "test_bus_timing.h"
+#include "bus_interface/bus_timing.h"
+#include "bus_interface/bus_interface.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <stddef.h>
+
+// Test setup helper - initializes dependencies in correct order
+static void test_setup(void) {
+    irq_init();
+    indexed_memory_init();
+    bus_interface_init();
+}
+
+// Read a little-endian value from TIMING_DATA
+static uint32_t test_read_timing(uint8_t bytes) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < bytes; i++) {
+        value |= (uint32_t)bus_interface_read(REG_TIMING_DATA) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Test min/max/count tracking
+ */
+bool test_bus_timing_record(void) {
+    test_setup();
+    
+    bus_timing_phase_t phase;
+    bus_timing_get_phase(BUS_TIMING_PHASE_PUSH, &phase);
+    if (phase.count != 0 || phase.min != 0xFFFF || phase.max != 0) {
+        printf("  FAIL: Statistics not empty after init\n");
+        return false;
+    }
+    
+    bus_timing_record(BUS_TIMING_PHASE_PUSH, 90);
+    bus_timing_record(BUS_TIMING_PHASE_PUSH, 40);
+    bus_timing_record(BUS_TIMING_PHASE_PUSH, 70000);
+    bus_timing_get_phase(BUS_TIMING_PHASE_PUSH, &phase);
+    if (phase.count != 3 || phase.min != 40 || phase.max != 0xFFFF) {
+        printf("  FAIL: count=%u min=%u max=%u, expected 3/40/65535\n",
+               (unsigned)phase.count, phase.min, phase.max);
+        return false;
+    }
+    
+    // Other phases are independent
+    bus_timing_get_phase(BUS_TIMING_PHASE_PREPARE, &phase);
+    if (phase.count != 0) {
+        printf("  FAIL: Sample leaked into another phase\n");
+        return false;
+    }
+    
+    printf("  PASS: Min, max and count are tracked per phase\n");
+    return true;
+}
+
+/**
+ * Test histogram bucketing
+ */
+bool test_bus_timing_histogram(void) {
+    test_setup();
+    
+    bus_timing_record(BUS_TIMING_PHASE_PHI2, 0);
+    bus_timing_record(BUS_TIMING_PHASE_PHI2, BUS_TIMING_BUCKET_CYCLES - 1);
+    bus_timing_record(BUS_TIMING_PHASE_PHI2, BUS_TIMING_BUCKET_CYCLES);
+    bus_timing_record(BUS_TIMING_PHASE_PHI2, 100000);
+    
+    bus_timing_phase_t phase;
+    bus_timing_get_phase(BUS_TIMING_PHASE_PHI2, &phase);
+    if (phase.histogram[0] != 2 || phase.histogram[1] != 1 ||
+        phase.histogram[BUS_TIMING_BUCKETS - 1] != 1) {
+        printf("  FAIL: Histogram buckets %u/%u/%u, expected 2/1/1\n",
+               (unsigned)phase.histogram[0], (unsigned)phase.histogram[1],
+               (unsigned)phase.histogram[BUS_TIMING_BUCKETS - 1]);
+        return false;
+    }
+    
+    printf("  PASS: Samples land in the right histogram buckets\n");
+    return true;
+}
+
+/**
+ * Test the TIMING_SELECT/TIMING_DATA registers
+ */
+bool test_bus_timing_registers(void) {
+    test_setup();
+    
+    bus_timing_record(BUS_TIMING_PHASE_PUSH, 0x123);
+    bus_timing_record(BUS_TIMING_PHASE_PUSH, 0x045);
+    
+    // Select the PUSH phase: latches a snapshot
+    uint8_t base = BUS_TIMING_PHASE_PUSH * BUS_TIMING_PHASE_BYTES;
+    bus_interface_write(REG_TIMING_SELECT, base);
+    if (bus_interface_read(REG_TIMING_SELECT) != base) {
+        printf("  FAIL: TIMING_SELECT reads back 0x%02X\n",
+               bus_interface_read(REG_TIMING_SELECT));
+        return false;
+    }
+    
+    // Samples after the select do not change the snapshot
+    bus_timing_record(BUS_TIMING_PHASE_PUSH, 0x001);
+    
+    uint32_t min = test_read_timing(2);
+    uint32_t max = test_read_timing(2);
+    uint32_t count = test_read_timing(4);
+    if (min != 0x045 || max != 0x123 || count != 2) {
+        printf("  FAIL: Snapshot min=0x%X max=0x%X count=%u\n",
+               (unsigned)min, (unsigned)max, (unsigned)count);
+        return false;
+    }
+    
+    // Reads advanced the offset
+    if (bus_interface_read(REG_TIMING_SELECT) != base + offsetof(bus_timing_phase_t, histogram)) {
+        printf("  FAIL: TIMING_DATA reads did not advance the offset\n");
+        return false;
+    }
+    
+    // Past the snapshot reads as 0
+    bus_interface_write(REG_TIMING_SELECT, 0xFF);
+    if (bus_interface_read(REG_TIMING_DATA) != 0) {
+        printf("  FAIL: Offset past the snapshot did not read 0\n");
+        return false;
+    }
+    
+    // A TIMING_DATA write clears the statistics
+    bus_interface_write(REG_TIMING_DATA, 0);
+    bus_timing_phase_t phase;
+    bus_timing_get_phase(BUS_TIMING_PHASE_PUSH, &phase);
+    if (phase.count != 0) {
+        printf("  FAIL: TIMING_DATA write did not clear the statistics\n");
+        return false;
+    }
+    
+    printf("  PASS: TIMING_SELECT/TIMING_DATA expose a stable snapshot\n");
+    return true;
+}
+
+/**
+ * Test the read shadow follows TIMING_DATA reads
+ */
+bool test_bus_timing_read_shadow(void) {
+    test_setup();
+    
+    bus_timing_record(BUS_TIMING_PHASE_PREPARE, 0x0A0B);
+    bus_interface_write(REG_TIMING_SELECT, 0);
+    
+    // Min low byte, then high byte through peek/commit
+    uint8_t lo = bus_interface_peek(REG_TIMING_DATA);
+    bus_interface_commit_read(REG_TIMING_DATA);
+    uint8_t hi = bus_interface_peek(REG_TIMING_DATA);
+    bus_interface_commit_read(REG_TIMING_DATA);
+    
+    if (lo != 0x0B || hi != 0x0A || bus_interface_peek(REG_TIMING_SELECT) != 2) {
+        printf("  FAIL: Shadow read 0x%02X 0x%02X offset %d\n",
+               lo, hi, bus_interface_peek(REG_TIMING_SELECT));
+        return false;
+    }
+    
+    printf("  PASS: Read shadow follows TIMING_DATA reads\n");
+    return true;
+}
+
+/**
+ * Run all bus timing tests
+ */
+bool run_bus_timing_tests(void) {
+    printf("\n=== Running Bus Timing Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_bus_timing_record();
+    all_passed &= test_bus_timing_histogram();
+    all_passed &= test_bus_timing_registers();
+    all_passed &= test_bus_timing_read_shadow();
+    
+    return all_passed;
+}
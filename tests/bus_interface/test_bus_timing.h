@@ -0,0 +1,21 @@
+/**
+ * MIA Bus Timing Statistics Test Interface
+ * 
+ * Test functions for verifying bus timing statistics and registers
+ */
+
+#ifndef TEST_BUS_TIMING_H
+#define TEST_BUS_TIMING_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_bus_timing_record(void);
+bool test_bus_timing_histogram(void);
+bool test_bus_timing_registers(void);
+bool test_bus_timing_read_shadow(void);
+
+// Test runner
+bool run_bus_timing_tests(void);
+
+#endif // TEST_BUS_TIMING_H
@@ -0,0 +1,21 @@
+/**
+ * MIA Bus Cycle Trace Test Interface
+ * 
+ * Test functions for verifying the bus trace ring
+ */
+
+#ifndef TEST_BUS_TRACE_H
+#define TEST_BUS_TRACE_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_bus_trace_disabled(void);
+bool test_bus_trace_order(void);
+bool test_bus_trace_overwrite(void);
+bool test_bus_trace_enable_resets(void);
+
+// Test runner
+bool run_bus_trace_tests(void);
+
+#endif // TEST_BUS_TRACE_H
@@ -0,0 +1,276 @@
+/**
+ * MIA Bus Write Queue Test Implementation
+ * 
+ * Tests for the SPSC ring that carries 6502 writes from the bus IRQ handler
+ * to bus_interface_write(), and for the shared WRITE_QUEUE_OVERFLOW and
+ * WRITE_QUEUE_EARLY_READS registers.
+ */
+
+#include "test_bus_write_queue.h"
+#include "bus_interface/bus_write_queue.h"
+#include "bus_interface/bus_interface.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <stdio.h>
+
+// Test setup helper - initializes dependencies in correct order
+static void test_setup(void) {
+    irq_init();
+    indexed_memory_init();
+    bus_interface_init();
+    bus_write_queue_init();
+}
+
+// Fill the ring to capacity with a recognizable pattern
+static bool test_fill_queue(void) {
+    for (uint32_t i = 0; i < BUS_WRITE_QUEUE_SIZE; i++) {
+        if (!bus_write_queue_push((uint8_t)i, (uint8_t)(0x80 + i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test that a freshly initialized queue is empty with no overflow
+ */
+bool test_bus_write_queue_init(void) {
+    test_setup();
+
+    bus_write_queue_push(0x01, 0x02);
+    bus_write_queue_init();
+
+    bus_write_t entry;
+    if (!bus_write_queue_is_empty() || bus_write_queue_count() != 0 ||
+        bus_write_queue_get_overflow() != 0 || bus_write_queue_pop(&entry)) {
+        printf("  FAIL: Queue not empty after init\n");
+        return false;
+    }
+
+    printf("  PASS: Write queue initializes empty\n");
+    return true;
+}
+
+/**
+ * Test that writes and queued READs come out in the order they were pushed
+ */
+bool test_bus_write_queue_fifo_order(void) {
+    test_setup();
+
+    bus_write_queue_push(0x00, 0x10);
+    bus_write_queue_push_read(0x03, 0x20, true);
+    bus_write_queue_push(0xF5, 0x30);
+
+    if (bus_write_queue_count() != 3) {
+        printf("  FAIL: Expected 3 queued writes, got %u\n",
+               (unsigned)bus_write_queue_count());
+        return false;
+    }
+
+    const bus_write_t expected[3] = { {0x00, 0x10, false, false}, {0x03, 0x20, true, true}, {0xF5, 0x30, false, false} };
+    for (int i = 0; i < 3; i++) {
+        bus_write_t entry;
+        if (!bus_write_queue_pop(&entry) || entry.addr != expected[i].addr ||
+            entry.data != expected[i].data || entry.read != expected[i].read ||
+            entry.early != expected[i].early) {
+            printf("  FAIL: Entry %d out of order\n", i);
+            return false;
+        }
+    }
+
+    if (!bus_write_queue_is_empty()) {
+        printf("  FAIL: Queue not empty after draining\n");
+        return false;
+    }
+
+    printf("  PASS: Writes are returned in FIFO order\n");
+    return true;
+}
+
+/**
+ * Test that the ring indexes wrap around the buffer end
+ */
+bool test_bus_write_queue_wraparound(void) {
+    test_setup();
+
+    // Push and pop enough entries to cross the end of the ring several times
+    for (uint32_t i = 0; i < BUS_WRITE_QUEUE_SIZE * 3; i++) {
+        bus_write_t entry;
+        if (!bus_write_queue_push((uint8_t)i, (uint8_t)~i) ||
+            !bus_write_queue_pop(&entry) ||
+            entry.addr != (uint8_t)i || entry.data != (uint8_t)~i) {
+            printf("  FAIL: Wraparound mismatch at entry %u\n", (unsigned)i);
+            return false;
+        }
+    }
+
+    // A full ring after wrapping still holds every entry
+    if (!test_fill_queue() || bus_write_queue_count() != BUS_WRITE_QUEUE_SIZE) {
+        printf("  FAIL: Ring does not hold %d entries after wrapping\n",
+               BUS_WRITE_QUEUE_SIZE);
+        return false;
+    }
+
+    printf("  PASS: Ring indexes wrap around correctly\n");
+    return true;
+}
+
+/**
+ * Test that a full queue drops new writes and counts them
+ */
+bool test_bus_write_queue_overflow(void) {
+    test_setup();
+
+    if (!test_fill_queue()) {
+        printf("  FAIL: Could not fill queue to capacity\n");
+        return false;
+    }
+
+    if (bus_write_queue_push(0xAA, 0xBB)) {
+        printf("  FAIL: Push succeeded on a full queue\n");
+        return false;
+    }
+
+    if (bus_write_queue_get_overflow() != 1) {
+        printf("  FAIL: Expected overflow count 1, got %d\n",
+               bus_write_queue_get_overflow());
+        return false;
+    }
+
+    // Queued entries are untouched by the dropped write
+    bus_write_t entry;
+    if (!bus_write_queue_pop(&entry) || entry.addr != 0x00 || entry.data != 0x80) {
+        printf("  FAIL: Oldest entry corrupted by overflow\n");
+        return false;
+    }
+
+    // Space is available again after a pop
+    if (!bus_write_queue_push(0xAA, 0xBB)) {
+        printf("  FAIL: Push failed after freeing a slot\n");
+        return false;
+    }
+
+    bus_write_queue_clear_overflow();
+    if (bus_write_queue_get_overflow() != 0) {
+        printf("  FAIL: Overflow count not cleared\n");
+        return false;
+    }
+
+    printf("  PASS: Full queue drops writes and counts overflow\n");
+    return true;
+}
+
+/**
+ * Test that the overflow counter saturates at 255
+ */
+bool test_bus_write_queue_overflow_saturates(void) {
+    test_setup();
+
+    test_fill_queue();
+    for (int i = 0; i < 300; i++) {
+        bus_write_queue_push(0x00, 0x00);
+    }
+
+    if (bus_write_queue_get_overflow() != 0xFF) {
+        printf("  FAIL: Expected saturated overflow 0xFF, got 0x%02X\n",
+               bus_write_queue_get_overflow());
+        return false;
+    }
+
+    printf("  PASS: Overflow counter saturates at 255\n");
+    return true;
+}
+
+/**
+ * Test the shared WRITE_QUEUE_OVERFLOW register (0xF6)
+ */
+bool test_bus_write_queue_overflow_register(void) {
+    test_setup();
+
+    test_fill_queue();
+    bus_write_queue_push(0x00, 0x00);
+    bus_write_queue_push(0x00, 0x00);
+
+    if (bus_interface_read(REG_WRITE_QUEUE_OVERFLOW) != 2) {
+        printf("  FAIL: Register 0xF6 reads 0x%02X, expected 2\n",
+               bus_interface_read(REG_WRITE_QUEUE_OVERFLOW));
+        return false;
+    }
+
+    bus_interface_refresh_shadow();
+    if (bus_interface_peek(REG_WRITE_QUEUE_OVERFLOW) != 2) {
+        printf("  FAIL: Shadow entry for 0xF6 reads 0x%02X, expected 2\n",
+               bus_interface_peek(REG_WRITE_QUEUE_OVERFLOW));
+        return false;
+    }
+
+    // Any write clears the counter
+    bus_interface_write(REG_WRITE_QUEUE_OVERFLOW, 0x00);
+    if (bus_interface_read(REG_WRITE_QUEUE_OVERFLOW) != 0 ||
+        bus_interface_peek(REG_WRITE_QUEUE_OVERFLOW) != 0) {
+        printf("  FAIL: Register 0xF6 not cleared by write\n");
+        return false;
+    }
+
+    printf("  PASS: WRITE_QUEUE_OVERFLOW register reads and clears\n");
+    return true;
+}
+
+/**
+ * Test the shared WRITE_QUEUE_EARLY_READS register (0xFB)
+ */
+bool test_bus_write_queue_early_reads_register(void) {
+    test_setup();
+
+    bus_interface_refresh_shadow();
+    bus_interface_count_early_read();
+    bus_interface_count_early_read();
+
+    // The consumer's count reaches the shadow without a generation bump
+    if (bus_interface_read(REG_WRITE_QUEUE_EARLY_READS) != 2 ||
+        bus_interface_peek(REG_WRITE_QUEUE_EARLY_READS) != 2) {
+        printf("  FAIL: Register 0xFB reads 0x%02X (shadow 0x%02X), expected 2\n",
+               bus_interface_read(REG_WRITE_QUEUE_EARLY_READS),
+               bus_interface_peek(REG_WRITE_QUEUE_EARLY_READS));
+        return false;
+    }
+
+    for (int i = 0; i < 300; i++) {
+        bus_interface_count_early_read();
+    }
+    if (bus_write_queue_get_early_reads() != 0xFF) {
+        printf("  FAIL: Expected saturated early reads 0xFF, got 0x%02X\n",
+               bus_write_queue_get_early_reads());
+        return false;
+    }
+
+    // Any write clears the counter
+    bus_interface_write(REG_WRITE_QUEUE_EARLY_READS, 0x00);
+    if (bus_interface_read(REG_WRITE_QUEUE_EARLY_READS) != 0 ||
+        bus_interface_peek(REG_WRITE_QUEUE_EARLY_READS) != 0) {
+        printf("  FAIL: Register 0xFB not cleared by write\n");
+        return false;
+    }
+
+    printf("  PASS: WRITE_QUEUE_EARLY_READS register counts, saturates and clears\n");
+    return true;
+}
+
+/**
+ * Run all bus write queue tests
+ */
+bool run_bus_write_queue_tests(void) {
+    printf("\n=== Running Bus Write Queue Tests ===\n");
+
+    bool all_passed = true;
+
+    all_passed &= test_bus_write_queue_init();
+    all_passed &= test_bus_write_queue_fifo_order();
+    all_passed &= test_bus_write_queue_wraparound();
+    all_passed &= test_bus_write_queue_overflow();
+    all_passed &= test_bus_write_queue_overflow_saturates();
+    all_passed &= test_bus_write_queue_overflow_register();
+    all_passed &= test_bus_write_queue_early_reads_register();
+
+    return all_passed;
+}
@@ -0,0 +1,24 @@
+/**
+ * MIA Bus Write Queue Test Interface
+ * 
+ * Test functions for verifying the bus write queue
+ */
+
+#ifndef TEST_BUS_WRITE_QUEUE_H
+#define TEST_BUS_WRITE_QUEUE_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_bus_write_queue_init(void);
+bool test_bus_write_queue_fifo_order(void);
+bool test_bus_write_queue_wraparound(void);
+bool test_bus_write_queue_overflow(void);
+bool test_bus_write_queue_overflow_saturates(void);
+bool test_bus_write_queue_overflow_register(void);
+bool test_bus_write_queue_early_reads_register(void);
+
+// Test runner
+bool run_bus_write_queue_tests(void);
+
+#endif // TEST_BUS_WRITE_QUEUE_H
@@ -8,7 +8,10 @@
 #include "indexed_memory/indexed_memory.h"
 #include "irq/irq.h"
 #include "mocks/pico_mock.h"
+#include "indexed_memory_dma_mock.h"
 #include "bus_interface/bus_interface.h"
+#include "video/video_controller.h"
+#include "config/memory_config.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -61,7 +64,7 @@ static void test_copy_block(uint8_t src_idx, uint8_t dst_idx, uint16_t count) {
     // Execute copy command
     indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
     
-    // Process queued commands (simulates Core 1 processing)
+    // Process queued commands (simulates the Core 0 background work)
     // Call multiple times to ensure all queued commands are processed
     for (int i = 0; i < 10; i++) {
         indexed_memory_process_copy_command();
@@ -616,6 +619,770 @@ bool test_wrap_on_limit(void) {
     return true;
 }
 
+/**
+ * Test the access kernels chosen at config time behave like the generic path
+ */
+bool test_access_kernels(void) {
+    printf("Testing access kernels...\n");
+    
+    test_setup_indexed_memory();
+    uint8_t test_idx = IDX_USER_START + 7;
+    
+    // Fixed kernel: no auto-step, address never moves
+    test_set_index_address(test_idx, 0x14000);
+    test_set_index_flags(test_idx, 0);
+    indexed_memory_write(test_idx, 0x5A);
+    if (indexed_memory_read(test_idx) != 0x5A || get_index_address(test_idx) != 0x14000) {
+        printf("FAIL: Fixed kernel moved or lost data\n");
+        return false;
+    }
+    
+    // An out-of-range fixed address still reports errors on every access
+    test_set_index_address(test_idx, 0x080000);
+    if (indexed_memory_read(test_idx) != 0 || !(test_get_irq_cause() & IRQ_MEMORY_ERROR)) {
+        printf("FAIL: Invalid fixed address not reported\n");
+        return false;
+    }
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    
+    // Forward wrap kernel: selected once limit and default are in range
+    test_set_index_address(test_idx, 0x14000);
+    test_set_index_default(test_idx, 0x14000);
+    test_set_index_limit(test_idx, 0x14006);
+    test_set_index_step(test_idx, 4);
+    test_set_index_flags(test_idx, FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT);
+    indexed_memory_read(test_idx);     // 0x14000 -> 0x14004
+    indexed_memory_commit_read(test_idx);  // 0x14004 -> 0x14008 >= limit -> default
+    if (get_index_address(test_idx) != 0x14000) {
+        printf("FAIL: Forward wrap kernel at 0x%06lX, expected 0x014000\n",
+               (unsigned long)get_index_address(test_idx));
+        return false;
+    }
+    
+    // A limit past the end of memory keeps the per-access bounds check
+    test_set_index_address(test_idx, 0x3FFFE);
+    test_set_index_limit(test_idx, 0x50000);
+    test_set_index_step(test_idx, 1);
+    indexed_memory_write(test_idx, 0x01);
+    indexed_memory_write(test_idx, 0x02);
+    if (test_get_irq_cause() & IRQ_MEMORY_ERROR) {
+        printf("FAIL: In-range writes reported an error\n");
+        return false;
+    }
+    indexed_memory_write(test_idx, 0x03);
+    if (!(test_get_irq_cause() & IRQ_MEMORY_ERROR) || get_index_address(test_idx) != 0x40000) {
+        printf("FAIL: Overrun past memory end not reported\n");
+        return false;
+    }
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    
+    // Reconfiguring through commands picks a new kernel
+    test_set_index_limit(test_idx, 0x14010);
+    indexed_memory_execute_window_command(test_idx, CMD_RESET_INDEX);
+    indexed_memory_read(test_idx);
+    if (get_index_address(test_idx) != 0x14001) {
+        printf("FAIL: Kernel not refreshed after CMD_RESET_INDEX\n");
+        return false;
+    }
+    
+    printf("PASS: Access kernels\n");
+    return true;
+}
+
+/**
+ * Test queued copies: issued back-to-back without waiting, run as one batch
+ */
+bool test_dma_copy_queue(void) {
+    printf("Testing DMA copy queue...\n");
+    
+    test_setup_indexed_memory();
+    uint8_t src_idx = IDX_USER_START + 5;
+    uint8_t dst_idx = IDX_USER_START + 6;
+    
+    // Three sources of 4 bytes each
+    test_set_index_address(src_idx, 0x14000);
+    for (int i = 0; i < 12; i++) {
+        indexed_memory_write(src_idx, (uint8_t)(0x10 + i));
+    }
+    
+    // Queue three copies, moving the indexes between them
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_IDX, src_idx);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_IDX, dst_idx);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_L, 4);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_H, 0);
+    for (int i = 0; i < 3; i++) {
+        test_set_index_address(src_idx, 0x14000 + i * 4);
+        test_set_index_address(dst_idx, 0x14100 + i * 16);
+        indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    }
+    
+    if (test_get_irq_cause() & IRQ_DMA_ERROR) {
+        printf("FAIL: Queued copies rejected while pending\n");
+        return false;
+    }
+    if (!(indexed_memory_get_status() & STATUS_DMA_ACTIVE)) {
+        printf("FAIL: STATUS_DMA_ACTIVE not set while copies are queued\n");
+        return false;
+    }
+    
+    // One background pass starts (and, with the mock, completes) the batch
+    indexed_memory_process_copy_command();
+    if (indexed_memory_get_status() & STATUS_DMA_ACTIVE) {
+        printf("FAIL: STATUS_DMA_ACTIVE still set after the batch\n");
+        return false;
+    }
+    if (!(test_get_irq_cause() & IRQ_DMA_COMPLETE)) {
+        printf("FAIL: IRQ_DMA_COMPLETE not raised\n");
+        return false;
+    }
+    
+    // Each copy used the index addresses at the time it was issued
+    for (int i = 0; i < 3; i++) {
+        test_set_index_address(dst_idx, 0x14100 + i * 16);
+        for (int j = 0; j < 4; j++) {
+            uint8_t value = indexed_memory_read(dst_idx);
+            if (value != 0x10 + i * 4 + j) {
+                printf("FAIL: Copy %d byte %d is 0x%02X\n", i, j, value);
+                return false;
+            }
+        }
+    }
+    
+    // Batch IRQ mode: completion is signalled once, after the batch
+    indexed_memory_set_config_field(0, CFG_COPY_MODE, COPY_MODE_IRQ_BATCH);
+    if (indexed_memory_get_config_field(0, CFG_COPY_MODE) != COPY_MODE_IRQ_BATCH) {
+        printf("FAIL: CFG_COPY_MODE not stored\n");
+        return false;
+    }
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    if (test_get_irq_cause() & IRQ_DMA_COMPLETE) {
+        printf("FAIL: IRQ_DMA_COMPLETE raised before the copies ran\n");
+        return false;
+    }
+    indexed_memory_process_copy_command();
+    if (!(test_get_irq_cause() & IRQ_DMA_COMPLETE)) {
+        printf("FAIL: IRQ_DMA_COMPLETE not raised after the batch\n");
+        return false;
+    }
+    
+    // A full queue rejects the copy without blocking
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    for (int i = 0; i < 40; i++) {
+        indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    }
+    if (!(test_get_irq_cause() & IRQ_DMA_ERROR)) {
+        printf("FAIL: Queue overflow not reported\n");
+        return false;
+    }
+    
+    // Draining the queue takes several batches and ends idle
+    for (int i = 0; i < 4; i++) {
+        indexed_memory_process_copy_command();
+    }
+    if (indexed_memory_get_status() & STATUS_DMA_ACTIVE) {
+        printf("FAIL: STATUS_DMA_ACTIVE still set after draining the queue\n");
+        return false;
+    }
+    
+    printf("PASS: DMA copy queue\n");
+    return true;
+}
+
+/**
+ * Test that a DMA interrupt arriving after its batch has completed, such
+ * as the null trigger raising it again, signals nothing
+ */
+bool test_dma_stray_irq(void) {
+    printf("Testing DMA stray interrupt...\n");
+    
+    test_setup_indexed_memory();
+    uint8_t src_idx = IDX_USER_START + 5;
+    uint8_t dst_idx = IDX_USER_START + 6;
+    test_set_index_address(src_idx, 0x14000);
+    test_set_index_address(dst_idx, 0x14100);
+    
+    // Per copy IRQ mode: a notify job and the null trigger
+    test_copy_block(src_idx, dst_idx, 8);
+    if (!(test_get_irq_cause() & IRQ_DMA_COMPLETE)) {
+        printf("FAIL: IRQ_DMA_COMPLETE not raised\n");
+        return false;
+    }
+    
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    uint32_t generation = indexed_memory_get_generation();
+    mock_dma_raise_irq(true);
+    mock_dma_raise_irq(false);
+    if (test_get_irq_cause() & IRQ_DMA_COMPLETE) {
+        printf("FAIL: Interrupt after the batch raised IRQ_DMA_COMPLETE again\n");
+        return false;
+    }
+    if (indexed_memory_get_generation() != generation) {
+        printf("FAIL: Interrupt after the batch bumped the generation\n");
+        return false;
+    }
+    
+    // The next batch still completes
+    test_copy_block(src_idx, dst_idx, 8);
+    if (!(test_get_irq_cause() & IRQ_DMA_COMPLETE) || (indexed_memory_get_status() & STATUS_DMA_ACTIVE)) {
+        printf("FAIL: Next batch did not complete\n");
+        return false;
+    }
+    
+    printf("PASS: DMA stray interrupt\n");
+    return true;
+}
+
+/**
+ * Test CMD_FILL_BLOCK
+ */
+bool test_dma_fill(void) {
+    printf("Testing DMA fill...\n");
+    
+    test_setup_indexed_memory();
+    uint8_t dst_idx = IDX_USER_START + 7;
+    
+    // Guard bytes around an unaligned 37-byte fill
+    test_set_index_address(dst_idx, 0x15000);
+    for (int i = 0; i < 48; i++) {
+        indexed_memory_write(dst_idx, 0x55);
+    }
+    
+    test_set_index_address(dst_idx, 0x15003);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_IDX, dst_idx);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_L, 37);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_H, 0);
+    indexed_memory_set_config_field(0, CFG_FILL_VALUE, 0xA7);
+    if (indexed_memory_get_config_field(0, CFG_FILL_VALUE) != 0xA7) {
+        printf("FAIL: CFG_FILL_VALUE not stored\n");
+        return false;
+    }
+    
+    indexed_memory_execute_shared_command(CMD_FILL_BLOCK);
+    if (!(indexed_memory_get_status() & STATUS_DMA_ACTIVE)) {
+        printf("FAIL: STATUS_DMA_ACTIVE not set while the fill is queued\n");
+        return false;
+    }
+    indexed_memory_process_copy_command();
+    if (!(test_get_irq_cause() & IRQ_DMA_COMPLETE)) {
+        printf("FAIL: IRQ_DMA_COMPLETE not raised after the fill\n");
+        return false;
+    }
+    
+    test_set_index_address(dst_idx, 0x15000);
+    for (int i = 0; i < 48; i++) {
+        uint8_t expected = (i >= 3 && i < 40) ? 0xA7 : 0x55;
+        uint8_t value = indexed_memory_read(dst_idx);
+        if (value != expected) {
+            printf("FAIL: Byte %d is 0x%02X, expected 0x%02X\n", i, value, expected);
+            return false;
+        }
+    }
+    
+    // A fill past the end of MIA memory is rejected
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    test_set_index_address(dst_idx, 0x3FFF8);
+    indexed_memory_execute_shared_command(CMD_FILL_BLOCK);
+    if (!(test_get_irq_cause() & IRQ_DMA_ERROR)) {
+        printf("FAIL: Out of bounds fill not reported\n");
+        return false;
+    }
+    
+    printf("PASS: DMA fill\n");
+    return true;
+}
+
+/**
+ * Test CMD_COPY_RECT
+ */
+bool test_dma_copy_rect(void) {
+    printf("Testing DMA rectangle copy...\n");
+    
+    test_setup_indexed_memory();
+    uint8_t src_idx = IDX_USER_START + 8;
+    uint8_t dst_idx = IDX_USER_START + 9;
+    
+    // 20 source rows of 40 bytes, each byte row * 8 + column
+    test_set_index_address(src_idx, 0x16000);
+    for (int row = 0; row < 20; row++) {
+        for (int col = 0; col < 40; col++) {
+            indexed_memory_write(src_idx, (uint8_t)((row << 3) + col));
+        }
+    }
+    
+    // Copy a 6x20 block from column 2 into a 64 byte pitch buffer
+    test_set_index_address(src_idx, 0x16002);
+    test_set_index_address(dst_idx, 0x18000);
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_IDX, src_idx);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_IDX, dst_idx);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_L, 6);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_H, 0);
+    indexed_memory_set_config_field(0, CFG_COPY_ROWS, 20);
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_PITCH_L, 40);
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_PITCH_H, 0);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_PITCH_L, 64);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_PITCH_H, 0);
+    if (indexed_memory_get_config_field(0, CFG_COPY_ROWS) != 20 ||
+        indexed_memory_get_config_field(0, CFG_COPY_DST_PITCH_L) != 64) {
+        printf("FAIL: Rectangle fields not stored\n");
+        return false;
+    }
+    indexed_memory_execute_shared_command(CMD_COPY_RECT);
+    
+    // More rows than one batch: no completion until the last row ran
+    indexed_memory_process_copy_command();
+    if (test_get_irq_cause() & IRQ_DMA_COMPLETE) {
+        printf("FAIL: IRQ_DMA_COMPLETE raised in the middle of the rectangle\n");
+        return false;
+    }
+    if (!(indexed_memory_get_status() & STATUS_DMA_ACTIVE)) {
+        printf("FAIL: STATUS_DMA_ACTIVE cleared in the middle of the rectangle\n");
+        return false;
+    }
+    indexed_memory_process_copy_command();
+    if (!(test_get_irq_cause() & IRQ_DMA_COMPLETE)) {
+        printf("FAIL: IRQ_DMA_COMPLETE not raised after the last row\n");
+        return false;
+    }
+    if (indexed_memory_get_status() & STATUS_DMA_ACTIVE) {
+        printf("FAIL: STATUS_DMA_ACTIVE still set after the rectangle\n");
+        return false;
+    }
+    
+    for (int row = 0; row < 20; row++) {
+        test_set_index_address(dst_idx, 0x18000 + row * 64);
+        for (int col = 0; col < 8; col++) {
+            uint8_t expected = (col < 6) ? (uint8_t)((row << 3) + col + 2) : 0;
+            uint8_t value = indexed_memory_read(dst_idx);
+            if (value != expected) {
+                printf("FAIL: Row %d byte %d is 0x%02X, expected 0x%02X\n", row, col, value, expected);
+                return false;
+            }
+        }
+    }
+    
+    // A rectangle whose last row leaves MIA memory is rejected
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    test_set_index_address(dst_idx, 0x3F000);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_PITCH_H, 0x01);
+    indexed_memory_execute_shared_command(CMD_COPY_RECT);
+    if (!(test_get_irq_cause() & IRQ_DMA_ERROR)) {
+        printf("FAIL: Out of bounds rectangle not reported\n");
+        return false;
+    }
+    
+    // A factory reset in the middle of a rectangle drops the rows not yet
+    // issued and counts the rectangle as done
+    test_set_index_address(src_idx, 0x16002);
+    test_set_index_address(dst_idx, 0x18000);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_PITCH_H, 0);
+    indexed_memory_execute_shared_command(CMD_COPY_RECT);
+    indexed_memory_process_copy_command();
+    indexed_memory_execute_shared_command(CMD_FACTORY_RESET_ALL_IDX);
+    indexed_memory_process_deferred_command();
+    if (indexed_memory_get_status() & STATUS_DMA_ACTIVE) {
+        printf("FAIL: STATUS_DMA_ACTIVE still set after a factory reset\n");
+        return false;
+    }
+    indexed_memory_get_range(0x16002 + 16 * 40, 1)[0] = 0x5A;
+    indexed_memory_process_copy_command();
+    if (indexed_memory_get_range(0x18000 + 16 * 64, 1)[0] != 0) {
+        printf("FAIL: Rectangle rows copied after a factory reset\n");
+        return false;
+    }
+    
+    printf("PASS: DMA rectangle copy\n");
+    return true;
+}
+
+// Run the copy engine until nothing is queued (bounded)
+static void test_run_copies(void) {
+    for (int i = 0; i < 64 && (indexed_memory_get_status() & STATUS_DMA_ACTIVE); i++) {
+        indexed_memory_process_copy_command();
+    }
+}
+
+/**
+ * Test CMD_OAM_DMA
+ */
+bool test_dma_oam(void) {
+    printf("Testing OAM DMA...\n");
+    
+    test_setup_indexed_memory();
+    video_controller_init();
+    video_memory_t *vm = (video_memory_t *)indexed_memory_get_video_area();
+    uint8_t src_idx = IDX_USER_START + 10;
+    
+    // Sprite list built in user memory
+    test_set_index_address(src_idx, 0x16000);
+    for (int i = 0; i < MAX_SPRITES * BYTES_PER_SPRITE; i++) {
+        indexed_memory_write(src_idx, (uint8_t)(i * 7));
+    }
+    
+    // IDX_SPRITE_OAM moved elsewhere: OAM is still written from sprite 0
+    indexed_memory_write(IDX_SPRITE_OAM, 0xAA);
+    test_set_index_address(src_idx, 0x16000);
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_IDX, src_idx);
+    indexed_memory_execute_shared_command(CMD_OAM_DMA);
+    if (!(indexed_memory_get_status() & STATUS_DMA_ACTIVE)) {
+        printf("FAIL: OAM DMA not queued\n");
+        return false;
+    }
+    test_run_copies();
+    if (!(test_get_irq_cause() & IRQ_DMA_COMPLETE) || (indexed_memory_get_status() & STATUS_DMA_ACTIVE)) {
+        printf("FAIL: OAM DMA did not signal completion\n");
+        return false;
+    }
+    for (int i = 0; i < MAX_SPRITES * BYTES_PER_SPRITE; i++) {
+        if (vm->oam[i / BYTES_PER_SPRITE][i % BYTES_PER_SPRITE] != (uint8_t)(i * 7)) {
+            printf("FAIL: OAM byte %d not copied\n", i);
+            return false;
+        }
+    }
+    
+    // A source running past the end of MIA memory is rejected
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    test_set_index_address(src_idx, 0x3FF00);
+    indexed_memory_execute_shared_command(CMD_OAM_DMA);
+    if (!(test_get_irq_cause() & IRQ_DMA_ERROR) || (indexed_memory_get_status() & STATUS_DMA_ACTIVE)) {
+        printf("FAIL: Out of bounds OAM DMA not reported\n");
+        return false;
+    }
+    
+    printf("PASS: OAM DMA\n");
+    return true;
+}
+
+/**
+ * Test FLAG_COPY_ADVANCE streaming copies
+ */
+bool test_dma_copy_advance(void) {
+    printf("Testing DMA copy advance...\n");
+    
+    test_setup_indexed_memory();
+    uint8_t src_idx = IDX_USER_START + 10;
+    uint8_t dst_idx = IDX_USER_START + 11;
+    
+    // 24-byte source ring, destination wraps after two 8-byte blocks
+    test_set_index_address(src_idx, 0x17000);
+    for (int i = 0; i < 24; i++) {
+        indexed_memory_write(src_idx, (uint8_t)(0x40 + i));
+    }
+    test_set_index_address(src_idx, 0x17000);
+    test_set_index_address(dst_idx, 0x17100);
+    indexed_memory_set_config_field(dst_idx, CFG_DEFAULT_L, 0x00);
+    indexed_memory_set_config_field(dst_idx, CFG_DEFAULT_M, 0x71);
+    indexed_memory_set_config_field(dst_idx, CFG_DEFAULT_H, 0x01);
+    indexed_memory_set_config_field(dst_idx, CFG_LIMIT_L, 0x10);
+    indexed_memory_set_config_field(dst_idx, CFG_LIMIT_M, 0x71);
+    indexed_memory_set_config_field(dst_idx, CFG_LIMIT_H, 0x01);
+    indexed_memory_set_config_field(src_idx, CFG_FLAGS, FLAG_AUTO_STEP | FLAG_COPY_ADVANCE);
+    indexed_memory_set_config_field(dst_idx, CFG_FLAGS, FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT | FLAG_COPY_ADVANCE);
+    
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_IDX, src_idx);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_IDX, dst_idx);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_L, 8);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_H, 0);
+    
+    // Two copies stream through without reconfiguring the indexes
+    indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    if (get_index_address(src_idx) != 0x17008 || get_index_address(dst_idx) != 0x17108) {
+        printf("FAIL: Indexes not advanced after the first copy\n");
+        return false;
+    }
+    indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    if (get_index_address(src_idx) != 0x17010 || get_index_address(dst_idx) != 0x17100) {
+        printf("FAIL: Destination did not wrap at its limit (0x%05X)\n", get_index_address(dst_idx));
+        return false;
+    }
+    indexed_memory_process_copy_command();
+    
+    test_set_index_address(dst_idx, 0x17100);
+    for (int i = 0; i < 16; i++) {
+        uint8_t value = indexed_memory_read(dst_idx);
+        if (value != 0x40 + i) {
+            printf("FAIL: Streamed byte %d is 0x%02X\n", i, value);
+            return false;
+        }
+    }
+    
+    // Without the flag the indexes stay where they are
+    indexed_memory_set_config_field(src_idx, CFG_FLAGS, FLAG_AUTO_STEP);
+    test_set_index_address(src_idx, 0x17000);
+    indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    indexed_memory_process_copy_command();
+    if (get_index_address(src_idx) != 0x17000) {
+        printf("FAIL: Index moved without FLAG_COPY_ADVANCE\n");
+        return false;
+    }
+    
+    printf("PASS: DMA copy advance\n");
+    return true;
+}
+
+/**
+ * Test 2D indexes: row width steps, then a jump to the next row start
+ */
+bool test_2d_addressing(void) {
+    printf("Testing 2D addressing...\n");
+    
+    test_setup_indexed_memory();
+    uint8_t idx = IDX_USER_START + 12;
+    uint32_t base = 0x18000;
+    
+    // 16-byte pitch bitmap with a known pattern
+    test_set_index_address(idx, base);
+    test_set_index_step(idx, 1);
+    test_set_index_flags(idx, FLAG_AUTO_STEP);
+    for (int i = 0; i < 16 * 8; i++) {
+        indexed_memory_write(idx, (uint8_t)i);
+    }
+    
+    // 4x3 sub-block at column 2, row 1
+    indexed_memory_set_config_field(idx, CFG_ROW_WIDTH, 4);
+    indexed_memory_set_config_field(idx, CFG_ROW_STRIDE_L, 16);
+    indexed_memory_set_config_field(idx, CFG_ROW_STRIDE_H, 0);
+    test_set_index_flags(idx, FLAG_AUTO_STEP | FLAG_2D);
+    test_set_index_address(idx, base + 16 + 2);
+    if (indexed_memory_get_config_field(idx, CFG_ROW_WIDTH) != 4 ||
+        indexed_memory_get_config_field(idx, CFG_ROW_STRIDE_L) != 16) {
+        printf("FAIL: Row fields not read back\n");
+        return false;
+    }
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 4; col++) {
+            uint8_t expected = (uint8_t)((row + 1) * 16 + 2 + col);
+            uint8_t value = indexed_memory_read(idx);
+            if (value != expected) {
+                printf("FAIL: Sub-block byte %d,%d is 0x%02X, expected 0x%02X\n", row, col, value, expected);
+                return false;
+            }
+        }
+    }
+    if (get_index_address(idx) != base + 4 * 16 + 2) {
+        printf("FAIL: Index not at the next row start (0x%05X)\n", get_index_address(idx));
+        return false;
+    }
+    
+    // Width 1 walks a column, one row per access
+    indexed_memory_set_config_field(idx, CFG_ROW_WIDTH, 1);
+    test_set_index_address(idx, base + 5);
+    for (int row = 0; row < 8; row++) {
+        if (indexed_memory_read(idx) != row * 16 + 5) {
+            printf("FAIL: Column walk row %d\n", row);
+            return false;
+        }
+    }
+    
+    // Backward within each row, rows still move forward by the stride
+    indexed_memory_set_config_field(idx, CFG_ROW_WIDTH, 3);
+    test_set_index_flags(idx, FLAG_AUTO_STEP | FLAG_DIRECTION | FLAG_2D);
+    test_set_index_address(idx, base + 7);
+    static const uint8_t backward[] = { 7, 6, 5, 23, 22, 21 };
+    for (int i = 0; i < 6; i++) {
+        if (indexed_memory_read(idx) != backward[i]) {
+            printf("FAIL: Backward 2D read %d\n", i);
+            return false;
+        }
+    }
+    
+    // Setting the address starts a new row
+    test_set_index_flags(idx, FLAG_AUTO_STEP | FLAG_2D);
+    test_set_index_address(idx, base);
+    indexed_memory_read(idx);
+    indexed_memory_read(idx);
+    test_set_index_address(idx, base + 32);
+    for (int i = 0; i < 3; i++) {
+        indexed_memory_read(idx);
+    }
+    if (get_index_address(idx) != base + 48) {
+        printf("FAIL: Column not reset by an address write (0x%05X)\n", get_index_address(idx));
+        return false;
+    }
+    
+    // Width 0 steps linearly
+    indexed_memory_set_config_field(idx, CFG_ROW_WIDTH, 0);
+    test_set_index_address(idx, base);
+    for (int i = 0; i < 20; i++) {
+        indexed_memory_read(idx);
+    }
+    if (get_index_address(idx) != base + 20) {
+        printf("FAIL: Width 0 did not step linearly\n");
+        return false;
+    }
+    
+    printf("PASS: 2D addressing\n");
+    return true;
+}
+
+/**
+ * Test that the video indexes write straight into the video_memory_t view
+ */
+bool test_video_area_layout(void) {
+    printf("Testing video area layout...\n");
+    
+    test_setup_indexed_memory();
+    video_memory_t *video = (video_memory_t *)indexed_memory_get_video_area();
+    
+    indexed_memory_write(IDX_CHARACTER_START + 2, 0x11);
+    indexed_memory_write(IDX_PALETTE_START + 3, 0x22);
+    indexed_memory_write(IDX_PALETTE_START + 3, 0x33);
+    indexed_memory_write(IDX_NAMETABLE_START + 1, 0x44);
+    indexed_memory_write(IDX_PALETTE_TABLE_START + 3, 0x55);
+    indexed_memory_write(IDX_SPRITE_OAM, 0x66);
+    indexed_memory_write(IDX_ACTIVE_FRAME, 0x01);
+    
+    if (video->character_tables[2][0][0] != 0x11 ||
+        video->palette_banks[3][0] != 0x3322 ||
+        video->nametables[1][0][0] != 0x44 ||
+        video->palette_tables[3][0][0] != 0x55 ||
+        video->oam[0][0] != 0x66 ||
+        video->active_frame != 0x01) {
+        printf("FAIL: Video index writes do not match the video_memory_t view\n");
+        return false;
+    }
+    
+    printf("PASS: Video area layout\n");
+    return true;
+}
+
+/**
+ * Test CMD_SYSTEM_FAST_RESET and the memory-preserving default restore
+ */
+bool test_fast_reset(void) {
+    printf("Testing fast reset...\n");
+    
+    test_setup_indexed_memory();
+    if (indexed_memory_fast_reset_requested()) {
+        printf("FAIL: Fast reset pending after init\n");
+        return false;
+    }
+    
+    // The command only raises a request, reported exactly once
+    indexed_memory_execute_shared_command(CMD_SYSTEM_FAST_RESET);
+    if (!indexed_memory_fast_reset_requested() || indexed_memory_fast_reset_requested()) {
+        printf("FAIL: Fast reset request not reported exactly once\n");
+        return false;
+    }
+    
+    // Boot image selection in the reset control index
+    indexed_memory_write(IDX_RESET_CONTROL, 2);
+    if (indexed_memory_peek(IDX_RESET_CONTROL) != 2) {
+        printf("FAIL: Reset control byte not stored\n");
+        return false;
+    }
+    
+    // Reconfigure a user index and store data, then restore the defaults
+    uint8_t test_idx = IDX_USER_START;
+    test_set_index_address(test_idx, 0x20000);
+    test_set_index_step(test_idx, 3);
+    indexed_memory_write(test_idx, 0xC3);
+    uint8_t *cache = indexed_memory_get_boot_cache();
+    cache[0] = 0x42;
+    
+    indexed_memory_restore_defaults();
+    
+    if (get_index_address(test_idx) != 0x13800 ||
+        indexed_memory_get_config_field(test_idx, CFG_STEP) != 1) {
+        printf("FAIL: Index configuration not restored\n");
+        return false;
+    }
+    if (indexed_memory_peek(IDX_RESET_CONTROL) != 2 || cache[0] != 0x42) {
+        printf("FAIL: MIA memory not preserved across restore\n");
+        return false;
+    }
+    test_set_index_address(test_idx, 0x20000);
+    if (indexed_memory_read(test_idx) != 0xC3) {
+        printf("FAIL: User data lost across restore\n");
+        return false;
+    }
+    
+    // The boot cache ends where the I/O buffer starts
+    if (cache + INDEXED_MEMORY_BOOT_CACHE_SIZE != indexed_memory_get_io_buffer(0)) {
+        printf("FAIL: Boot cache not directly below the I/O buffer\n");
+        return false;
+    }
+    
+    printf("PASS: Fast reset\n");
+    return true;
+}
+
+/**
+ * Test the flash asset region: read through indexes, read-only, and a
+ * block copy source (the mock assets are 64 bytes of 0xA0 ^ offset)
+ */
+bool test_flash_assets(void) {
+    printf("Testing flash assets...\n");
+    
+    test_setup_indexed_memory();
+    uint8_t asset_idx = IDX_USER_START + 12;
+    uint8_t dst_idx = IDX_USER_START + 13;
+    
+    // Streamed through an auto-stepping index, split read included
+    test_set_index_address(asset_idx, MIA_ASSET_BASE + 2);
+    test_set_index_step(asset_idx, 1);
+    test_set_index_flags(asset_idx, FLAG_AUTO_STEP);
+    if (indexed_memory_read(asset_idx) != (0xA0 ^ 2) || indexed_memory_peek(asset_idx) != (0xA0 ^ 3)) {
+        printf("FAIL: Asset bytes not read\n");
+        return false;
+    }
+    indexed_memory_commit_read(asset_idx);
+    if (get_index_address(asset_idx) != MIA_ASSET_BASE + 4 ||
+        indexed_memory_read_address(MIA_ASSET_BASE + 63) != (0xA0 ^ 63) ||
+        (indexed_memory_get_status() & STATUS_MEMORY_ERROR)) {
+        printf("FAIL: Asset reads did not step or raised an error\n");
+        return false;
+    }
+    
+    // Read-only, and nothing past the assets
+    indexed_memory_write(asset_idx, 0x55);
+    if (!(indexed_memory_get_status() & STATUS_MEMORY_ERROR) ||
+        get_index_address(asset_idx) != MIA_ASSET_BASE + 4 ||
+        indexed_memory_read_address(MIA_ASSET_BASE + 4) != (0xA0 ^ 4)) {
+        printf("FAIL: Asset write not rejected\n");
+        return false;
+    }
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    indexed_memory_clear_status(STATUS_MEMORY_ERROR);
+    test_set_index_address(asset_idx, MIA_ASSET_BASE + 64);
+    indexed_memory_read(asset_idx);
+    if (!(indexed_memory_get_status() & STATUS_MEMORY_ERROR)) {
+        printf("FAIL: Read past the assets not reported\n");
+        return false;
+    }
+    
+    // Copied into SRAM; copies into the assets or past their end are rejected
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    test_set_index_address(asset_idx, MIA_ASSET_BASE + 16);
+    test_set_index_address(dst_idx, 0x15000);
+    test_set_index_flags(asset_idx, 0);
+    test_copy_block(asset_idx, dst_idx, 32);
+    test_set_index_address(dst_idx, 0x15000);
+    test_set_index_step(dst_idx, 1);
+    test_set_index_flags(dst_idx, FLAG_AUTO_STEP);
+    for (int i = 0; i < 32; i++) {
+        if (indexed_memory_read(dst_idx) != (uint8_t)(0xA0 ^ (16 + i))) {
+            printf("FAIL: Asset byte %d not copied\n", 16 + i);
+            return false;
+        }
+    }
+    test_copy_block(asset_idx, dst_idx, 64);
+    if (!(test_get_irq_cause() & IRQ_DMA_ERROR)) {
+        printf("FAIL: Copy past the assets not reported\n");
+        return false;
+    }
+    indexed_memory_execute_shared_command(CMD_CLEAR_IRQ);
+    test_copy_block(dst_idx, asset_idx, 4);
+    if (!(test_get_irq_cause() & IRQ_MEMORY_ERROR)) {
+        printf("FAIL: Copy into the assets not rejected\n");
+        return false;
+    }
+    
+    printf("PASS: Flash assets\n");
+    return true;
+}
+
 /**
  * Run all indexed memory tests
  */
@@ -633,6 +1400,17 @@ bool run_indexed_memory_tests(void) {
     all_passed &= test_window_management();
     all_passed &= test_error_handling();
     all_passed &= test_wrap_on_limit();
+    all_passed &= test_access_kernels();
+    all_passed &= test_fast_reset();
+    all_passed &= test_dma_copy_queue();
+    all_passed &= test_dma_stray_irq();
+    all_passed &= test_dma_fill();
+    all_passed &= test_dma_copy_rect();
+    all_passed &= test_dma_oam();
+    all_passed &= test_dma_copy_advance();
+    all_passed &= test_2d_addressing();
+    all_passed &= test_video_area_layout();
+    all_passed &= test_flash_assets();
     
     printf("\n=== Test Results ===\n");
     if (all_passed) {
@@ -18,6 +18,17 @@ bool test_configuration_fields(void);
 bool test_dma_operations(void);
 bool test_window_management(void);
 bool test_error_handling(void);
+bool test_access_kernels(void);
+bool test_fast_reset(void);
+bool test_dma_copy_queue(void);
+bool test_dma_stray_irq(void);
+bool test_dma_fill(void);
+bool test_dma_copy_rect(void);
+bool test_dma_oam(void);
+bool test_dma_copy_advance(void);
+bool test_2d_addressing(void);
+bool test_video_area_layout(void);
+bool test_flash_assets(void);
 
 // Main test runner
 bool run_indexed_memory_tests(void);
@@ -0,0 +1,237 @@
+/**
+ * PSRAM Page Cache Tests
+ * 
+ * Tests for promotion of missed pages, write-back of dirty victims, bus
+ * writes held for or racing a promotion and the request queue, against the
+ * mock PSRAM
+ */
+
+#include "test_psram_cache.h"
+#include "indexed_memory/psram_cache.h"
+#include "indexed_memory/indexed_memory.h"
+#include "system/background.h"
+#include "psram_mock.h"
+#include <stdio.h>
+
+// First byte of PSRAM page n
+#define PAGE(n) ((uint32_t)(n) << PSRAM_PAGE_SHIFT)
+
+static void test_setup_psram_cache(void) {
+    psram_cache_init();     // Writes back what the last test left dirty
+    mock_psram_reset();
+    background_init();
+    background_set_handler(BACKGROUND_WORK_PSRAM, psram_cache_process);
+}
+
+static void run_background(void) {
+    while (background_run_next()) {
+    }
+}
+
+/**
+ * Test that a miss is answered as not ready without touching the PSRAM and
+ * queues its page, and that the promoted page serves later accesses from
+ * SRAM and tells bus reads about it
+ */
+bool test_psram_cache_miss_promotes(void) {
+    printf("Testing PSRAM cache miss and promotion...\n");
+    
+    test_setup_psram_cache();
+    mock_psram[PAGE(3) + 0x12] = 0x5A;
+    uint8_t data = 0;
+    if (psram_cache_read(PAGE(3) + 0x12, &data) || data != PSRAM_CACHE_NOT_READY ||
+        mock_psram_byte_accesses != 0) {
+        printf("FAIL: Miss not answered as not ready, or the PSRAM accessed\n");
+        return false;
+    }
+    if (psram_cache_contains(PAGE(3))) {
+        printf("FAIL: Page cached before the background work ran\n");
+        return false;
+    }
+    
+    uint32_t generation = indexed_memory_get_generation();
+    run_background();
+    if (!psram_cache_contains(PAGE(3)) || mock_psram_page_reads != 1) {
+        printf("FAIL: Missed page not promoted\n");
+        return false;
+    }
+    if (indexed_memory_get_generation() == generation) {
+        printf("FAIL: Promotion did not notify bus reads\n");
+        return false;
+    }
+    psram_cache_write(PAGE(3) + 0x13, 0xA5);
+    uint8_t first = 0, second = 0;
+    if (!psram_cache_read(PAGE(3) + 0x12, &first) || !psram_cache_read(PAGE(3) + 0x13, &second) ||
+        first != 0x5A || second != 0xA5 || mock_psram_byte_accesses != 0) {
+        printf("FAIL: Hits not served from the cache\n");
+        return false;
+    }
+    if (mock_psram[PAGE(3) + 0x13] == 0xA5) {
+        printf("FAIL: Hit written through to the PSRAM\n");
+        return false;
+    }
+    
+    printf("PASS: PSRAM cache miss and promotion\n");
+    return true;
+}
+
+/**
+ * Test that colliding pages share a set, that an evicted dirty page is
+ * written back first, and that a flush writes back what is still cached
+ */
+bool test_psram_cache_write_back(void) {
+    printf("Testing PSRAM cache write-back...\n");
+    
+    test_setup_psram_cache();
+    
+    // PSRAM_CACHE_WAYS pages of one set all fit
+    for (uint32_t way = 0; way < PSRAM_CACHE_WAYS; way++) {
+        psram_cache_prefetch(PAGE(way * PSRAM_CACHE_SETS));
+    }
+    run_background();
+    for (uint32_t way = 0; way < PSRAM_CACHE_WAYS; way++) {
+        if (!psram_cache_contains(PAGE(way * PSRAM_CACHE_SETS))) {
+            printf("FAIL: Colliding page %lu not cached\n", (unsigned long)way);
+            return false;
+        }
+    }
+    
+    // One more evicts the oldest, written back with its changes
+    psram_cache_write(PAGE(0) + 1, 0xC3);
+    psram_cache_prefetch(PAGE(PSRAM_CACHE_WAYS * PSRAM_CACHE_SETS));
+    run_background();
+    if (psram_cache_contains(PAGE(0)) || !psram_cache_contains(PAGE(PSRAM_CACHE_WAYS * PSRAM_CACHE_SETS))) {
+        printf("FAIL: Oldest page not replaced\n");
+        return false;
+    }
+    if (mock_psram[PAGE(0) + 1] != 0xC3 || mock_psram_page_writes != 1) {
+        printf("FAIL: Dirty victim not written back\n");
+        return false;
+    }
+    
+    // Clean pages are not written back
+    psram_cache_write(PAGE(PSRAM_CACHE_SETS) + 2, 0x3C);
+    psram_cache_flush();
+    if (mock_psram[PAGE(PSRAM_CACHE_SETS) + 2] != 0x3C || mock_psram_page_writes != 2) {
+        printf("FAIL: Flush did not write back the dirty page only\n");
+        return false;
+    }
+    
+    printf("PASS: PSRAM cache write-back\n");
+    return true;
+}
+
+// Bus write to the page being promoted, in the middle of its first copy
+static void write_filling_page(void) {
+    mock_psram_read_hook = NULL;
+    psram_cache_write(PAGE(5) + 0x04, 0x77);
+}
+
+/**
+ * Test that a write to a missing page is held and merged as the page is
+ * promoted, that a flush writes back what is still held, and that with the
+ * pending list full a promotion raced by a written-through bus write gives
+ * up, so the write is never lost, and the next promotion picks it up
+ */
+bool test_psram_cache_write_during_fill(void) {
+    printf("Testing PSRAM cache write during promotion...\n");
+    
+    test_setup_psram_cache();
+    psram_cache_prefetch(PAGE(5));
+    mock_psram_read_hook = write_filling_page;
+    background_run_next();
+    uint8_t data = 0;
+    if (!psram_cache_contains(PAGE(5)) || !psram_cache_read(PAGE(5) + 0x04, &data) || data != 0x77) {
+        printf("FAIL: Held write not merged into the promoted page\n");
+        return false;
+    }
+    if (mock_psram_byte_accesses != 0 || mock_psram[PAGE(5) + 0x04] == 0x77) {
+        printf("FAIL: Held write went to the PSRAM\n");
+        return false;
+    }
+    
+    // Held writes to a page never promoted reach the PSRAM on a flush,
+    // the last of two to one byte winning
+    psram_cache_write(PAGE(6) + 0x01, 0x11);
+    psram_cache_write(PAGE(6) + 0x01, 0x22);
+    psram_cache_flush();
+    if (mock_psram[PAGE(6) + 0x01] != 0x22 || mock_psram_byte_accesses != 1) {
+        printf("FAIL: Flush did not write the held write once\n");
+        return false;
+    }
+    
+    // With the list full of held writes to the page, the racing write goes
+    // to the PSRAM
+    test_setup_psram_cache();
+    for (uint32_t i = 0; i < PSRAM_CACHE_PENDING_WRITES; i++) {
+        psram_cache_write(PAGE(5) + 0x10 + i, (uint8_t)i);
+    }
+    mock_psram_read_hook = write_filling_page;
+    background_run_next();
+    if (psram_cache_contains(PAGE(5)) || mock_psram[PAGE(5) + 0x04] != 0x77) {
+        printf("FAIL: Raced promotion kept, or write not in the PSRAM\n");
+        return false;
+    }
+    
+    // The write asked for the page again, and the held writes are kept
+    run_background();
+    if (!psram_cache_contains(PAGE(5)) || !psram_cache_read(PAGE(5) + 0x04, &data) || data != 0x77) {
+        printf("FAIL: Page not promoted with the write\n");
+        return false;
+    }
+    for (uint32_t i = 0; i < PSRAM_CACHE_PENDING_WRITES; i++) {
+        if (!psram_cache_read(PAGE(5) + 0x10 + i, &data) || data != i) {
+            printf("FAIL: Held write %lu lost\n", (unsigned long)i);
+            return false;
+        }
+    }
+    
+    printf("PASS: PSRAM cache write during promotion\n");
+    return true;
+}
+
+/**
+ * Test that requests are queued once each and dropped when the queue is
+ * full
+ */
+bool test_psram_cache_prefetch_queue(void) {
+    printf("Testing PSRAM cache request queue...\n");
+    
+    test_setup_psram_cache();
+    for (uint32_t page = 0; page <= PSRAM_CACHE_QUEUE_DEPTH; page++) {
+        psram_cache_prefetch(PAGE(page));
+        psram_cache_prefetch(PAGE(page));
+    }
+    run_background();
+    if (mock_psram_page_reads != PSRAM_CACHE_QUEUE_DEPTH) {
+        printf("FAIL: %lu pages promoted, expected %d\n",
+               (unsigned long)mock_psram_page_reads, PSRAM_CACHE_QUEUE_DEPTH);
+        return false;
+    }
+    for (uint32_t page = 0; page < PSRAM_CACHE_QUEUE_DEPTH; page++) {
+        if (!psram_cache_contains(PAGE(page))) {
+            printf("FAIL: Queued page %lu not cached\n", (unsigned long)page);
+            return false;
+        }
+    }
+    if (psram_cache_contains(PAGE(PSRAM_CACHE_QUEUE_DEPTH))) {
+        printf("FAIL: Request beyond a full queue was kept\n");
+        return false;
+    }
+    
+    printf("PASS: PSRAM cache request queue\n");
+    return true;
+}
+
+bool run_psram_cache_tests(void) {
+    printf("\n=== PSRAM Cache Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_psram_cache_miss_promotes();
+    all_passed &= test_psram_cache_write_back();
+    all_passed &= test_psram_cache_write_during_fill();
+    all_passed &= test_psram_cache_prefetch_queue();
+    
+    return all_passed;
+}
@@ -0,0 +1,19 @@
+/**
+ * PSRAM Page Cache Test Interface
+ */
+
+#ifndef TEST_PSRAM_CACHE_H
+#define TEST_PSRAM_CACHE_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_psram_cache_miss_promotes(void);
+bool test_psram_cache_write_back(void);
+bool test_psram_cache_write_during_fill(void);
+bool test_psram_cache_prefetch_queue(void);
+
+// Main test runner
+bool run_psram_cache_tests(void);
+
+#endif // TEST_PSRAM_CACHE_H
@@ -0,0 +1,20 @@
+/**
+ * Mock flash assets for unit testing
+ * Stands in for the generated asset_data.c: ASSET_MOCK_SIZE bytes of a
+ * known pattern
+ */
+
+#include "asset_data.h"
+
+#define ASSET_MOCK_SIZE 64
+
+#define ASSET_BYTE(i) (uint8_t)(0xA0 ^ (i))
+#define ASSET_ROW(i) ASSET_BYTE(i), ASSET_BYTE(i + 1), ASSET_BYTE(i + 2), ASSET_BYTE(i + 3), \
+                     ASSET_BYTE(i + 4), ASSET_BYTE(i + 5), ASSET_BYTE(i + 6), ASSET_BYTE(i + 7)
+
+const uint8_t asset_data[ASSET_MOCK_SIZE] __attribute__((aligned(4))) = {
+    ASSET_ROW(0), ASSET_ROW(8), ASSET_ROW(16), ASSET_ROW(24),
+    ASSET_ROW(32), ASSET_ROW(40), ASSET_ROW(48), ASSET_ROW(56)
+};
+
+const uint32_t asset_data_size = ASSET_MOCK_SIZE;
@@ -6,6 +6,7 @@
  */
 
 #include "bus_interface/bus_sync_pio.h"
+#include "bus_interface/bus_interface.h"
 #include <stdio.h>
 #include <stdbool.h>
 
@@ -14,6 +15,7 @@ static uint8_t mock_rx_fifo[8];
 static uint8_t mock_tx_fifo[8];
 static uint8_t mock_rx_level = 0;
 static uint8_t mock_tx_level = 0;
+static bool mock_rx_stalled = false;        // Push into a full RX FIFO (FDEBUG.RXSTALL)
 static bool mock_initialized = false;
 
 /**
@@ -25,6 +27,7 @@ void bus_sync_pio_init(void) {
     // Reset FIFO state
     mock_rx_level = 0;
     mock_tx_level = 0;
+    mock_rx_stalled = false;
     mock_initialized = true;
 }
 
@@ -56,6 +59,13 @@ bool bus_sync_pio_process_write_data(void) {
     return false;
 }
 
+/**
+ * Load an index descriptor (mock: no bus IRQ to order against)
+ */
+void bus_sync_pio_load_descriptor(uint8_t idx, const uint8_t *desc) {
+    bus_interface_load_descriptor(idx, desc);
+}
+
 /**
  * Check if PIO is ready for next cycle (mock)
  */
@@ -95,8 +105,9 @@ void bus_sync_pio_check_fifo_errors(bool *rx_overflow, bool *tx_underflow) {
     }
     
     if (rx_overflow) {
-        // Simulate overflow if RX FIFO is full
-        *rx_overflow = (mock_rx_level >= 8);
+        // Simulate overflow if RX FIFO is full, or was pushed to while full
+        *rx_overflow = (mock_rx_level >= 8) || mock_rx_stalled;
+        mock_rx_stalled = false;
     }
     
     if (tx_underflow) {
@@ -115,9 +126,18 @@ void mock_pio_push_rx(uint8_t data) {
     if (mock_rx_level < 8) {
         mock_rx_fifo[mock_rx_level] = data;
         mock_rx_level++;
+    } else {
+        mock_rx_stalled = true;
     }
 }
 
+/**
+ * Simulate the IRQ handler emptying the RX FIFO (for testing)
+ */
+void mock_pio_drain_rx(void) {
+    mock_rx_level = 0;
+}
+
 /**
  * Simulate pulling data from TX FIFO (for testing)
  */
@@ -135,4 +155,5 @@ uint8_t mock_pio_pull_tx(void) {
 void mock_pio_reset(void) {
     mock_rx_level = 0;
     mock_tx_level = 0;
+    mock_rx_stalled = false;
 }
@@ -0,0 +1,22 @@
+/**
+ * Mock clock control for unit testing
+ */
+
+#include "clock_control_mock.h"
+#include "system/clock_control.h"
+
+uint32_t mock_clock_frequency_hz = CLOCK_FREQ_NORMAL;
+uint32_t mock_clock_max_hz = UINT32_MAX;
+
+void mock_clock_control_reset(void) {
+    mock_clock_frequency_hz = CLOCK_FREQ_NORMAL;
+    mock_clock_max_hz = UINT32_MAX;
+}
+
+bool clock_control_set_frequency_hz(uint32_t frequency_hz) {
+    if (frequency_hz == 0 || frequency_hz > mock_clock_max_hz) {
+        return false;
+    }
+    mock_clock_frequency_hz = frequency_hz;
+    return true;
+}
@@ -0,0 +1,18 @@
+/**
+ * Mock clock control for unit testing
+ * Records the PHI2 frequency asked for; frequencies above the limit cannot
+ * be generated, as if the PWM divider ran out
+ */
+
+#ifndef CLOCK_CONTROL_MOCK_H
+#define CLOCK_CONTROL_MOCK_H
+
+#include <stdint.h>
+
+extern uint32_t mock_clock_frequency_hz;
+extern uint32_t mock_clock_max_hz;
+
+// 1 MHz, no limit
+void mock_clock_control_reset(void);
+
+#endif // CLOCK_CONTROL_MOCK_H
@@ -0,0 +1,38 @@
+/**
+ * Mock flash store for unit testing
+ * An array stands in for the reserved flash area
+ */
+
+#include "system/flash_store.h"
+#include "flash_store_mock.h"
+#include <string.h>
+
+uint8_t mock_flash_store[MOCK_FLASH_STORE_SIZE];
+uint32_t mock_flash_store_writes;
+int mock_flash_store_fail_after = -1;
+
+void mock_flash_store_reset(void) {
+    memset(mock_flash_store, 0xFF, sizeof(mock_flash_store));
+    mock_flash_store_writes = 0;
+    mock_flash_store_fail_after = -1;
+}
+
+const uint8_t *flash_store_init(uint32_t size) {
+    return size <= MOCK_FLASH_STORE_SIZE ? mock_flash_store : NULL;
+}
+
+bool flash_store_write_sector(uint32_t offset, const void *data) {
+    if (mock_flash_store_fail_after == 0) {
+        return false;
+    }
+    if (mock_flash_store_fail_after > 0) {
+        mock_flash_store_fail_after--;
+    }
+    mock_flash_store_writes++;
+    if (data) {
+        memcpy(&mock_flash_store[offset], data, FLASH_STORE_SECTOR_SIZE);
+    } else {
+        memset(&mock_flash_store[offset], 0xFF, FLASH_STORE_SECTOR_SIZE);
+    }
+    return true;
+}
@@ -0,0 +1,21 @@
+/**
+ * Mock flash store for unit testing
+ * The counter shows how many sectors were rewritten; a countdown makes a
+ * write fail, as if the other core could not be paused
+ */
+
+#ifndef FLASH_STORE_MOCK_H
+#define FLASH_STORE_MOCK_H
+
+#include <stdint.h>
+
+#define MOCK_FLASH_STORE_SIZE   (80 * 4096)
+
+extern uint8_t mock_flash_store[MOCK_FLASH_STORE_SIZE];
+extern uint32_t mock_flash_store_writes;
+extern int mock_flash_store_fail_after;     // Writes that succeed before one fails (-1 = never)
+
+// Erased area, no failures
+void mock_flash_store_reset(void);
+
+#endif // FLASH_STORE_MOCK_H
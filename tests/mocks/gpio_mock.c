@@ -0,0 +1,7 @@
+/**
+ * Mock GPIO output state for host-based testing
+ */
+
+#include "hardware/gpio.h"
+
+volatile uint64_t mock_gpio_out;
@@ -11,6 +11,10 @@
 #define GPIO_IN  0
 #define GPIO_OUT 1
 
+// Output levels, a bit per GPIO (tests/mocks/gpio_mock.c), updated
+// atomically like the SIO set/clear aliases
+extern volatile uint64_t mock_gpio_out;
+
 // Mock GPIO functions
 static inline void gpio_init(uint gpio) {
     (void)gpio;
@@ -27,8 +31,16 @@ static inline bool gpio_get(uint gpio) {
 }
 
 static inline void gpio_put(uint gpio, bool value) {
-    (void)gpio;
-    (void)value;
+    if (value) {
+        __atomic_fetch_or(&mock_gpio_out, 1ull << gpio, __ATOMIC_SEQ_CST);
+    } else {
+        __atomic_fetch_and(&mock_gpio_out, ~(1ull << gpio), __ATOMIC_SEQ_CST);
+    }
+}
+
+// Last level written with gpio_put()
+static inline bool mock_gpio_get_out(uint gpio) {
+    return (__atomic_load_n(&mock_gpio_out, __ATOMIC_SEQ_CST) >> gpio) & 1;
 }
 
 static inline void gpio_pull_up(uint gpio) {
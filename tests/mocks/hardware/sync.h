@@ -0,0 +1,26 @@
+/**
+ * Mock hardware/sync.h for host-based testing
+ */
+
+#ifndef HARDWARE_SYNC_MOCK_H
+#define HARDWARE_SYNC_MOCK_H
+
+#include "../pico_mock.h"
+
+// Events and sleep are no-ops: host tests never wait
+static inline void __sev(void) {
+}
+
+static inline void __wfe(void) {
+}
+
+// Host tests run handlers and the code they interrupt one after the other
+static inline uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void)status;
+}
+
+#endif // HARDWARE_SYNC_MOCK_H
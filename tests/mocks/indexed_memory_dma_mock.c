@@ -4,38 +4,59 @@
  */
 
 #include "indexed_memory_dma.h"
+#include "indexed_memory_dma_batch.h"
+#include "indexed_memory_dma_mock.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 
-static bool dma_busy = false;
-static void (*completion_callback)(void) = NULL;
+static indexed_memory_dma_batch_t batch;
+static void (*completion_callback)(bool batch_done) = NULL;
+
+void mock_dma_raise_irq(bool chain_idle) {
+    dma_batch_irq_t event = indexed_memory_dma_batch_irq(&batch, chain_idle);
+    if (event != DMA_BATCH_IRQ_IGNORE && completion_callback) {
+        completion_callback(event == DMA_BATCH_IRQ_DONE);
+    }
+}
 
 int indexed_memory_dma_init(void) {
     printf("Mock DMA initialized\n");
     return 0;  // Mock channel 0
 }
 
-void indexed_memory_dma_start_transfer(void* dst, const void* src, uint32_t count) {
-    dma_busy = true;
-    
-    // Perform synchronous copy
-    memcpy(dst, src, count);
-    
-    // Simulate completion
-    dma_busy = false;
+bool indexed_memory_dma_start_batch(const indexed_memory_dma_job_t *jobs, uint32_t count) {
+    if (batch.running || count == 0 || count > INDEXED_MEMORY_DMA_BATCH_MAX) {
+        return false;
+    }
+    uint32_t notifies = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        notifies += jobs[i].notify;
+    }
+    indexed_memory_dma_batch_start(&batch, notifies);
     
-    // Call completion callback if set
-    if (completion_callback) {
-        completion_callback();
+    // Perform synchronous copies, in order
+    for (uint32_t i = 0; i < count; i++) {
+        if (jobs[i].fill) {
+            memset(jobs[i].dst, jobs[i].value, jobs[i].count);
+        } else {
+            memcpy(jobs[i].dst, jobs[i].src, jobs[i].count);
+        }
+        if (jobs[i].notify) {
+            mock_dma_raise_irq(false);
+        }
     }
+    
+    // Simulate completion: the null trigger's interrupt
+    mock_dma_raise_irq(true);
+    return true;
 }
 
 bool indexed_memory_dma_is_busy(void) {
-    return dma_busy;
+    return batch.running;
 }
 
-void indexed_memory_dma_set_completion_callback(void (*callback)(void)) {
+void indexed_memory_dma_set_completion_callback(void (*callback)(bool batch_done)) {
     completion_callback = callback;
 }
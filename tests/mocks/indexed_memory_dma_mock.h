@@ -0,0 +1,15 @@
+/**
+ * Mock DMA for unit testing
+ * Batches run synchronously; interrupts go through the same batch
+ * bookkeeping as the hardware driver
+ */
+
+#ifndef INDEXED_MEMORY_DMA_MOCK_H
+#define INDEXED_MEMORY_DMA_MOCK_H
+
+#include <stdbool.h>
+
+// Deliver a data channel interrupt now, as a stray or late one would be
+void mock_dma_raise_irq(bool chain_idle);
+
+#endif // INDEXED_MEMORY_DMA_MOCK_H
@@ -0,0 +1,13 @@
+/**
+ * Mock pico/platform.h for host-based testing
+ */
+
+#ifndef PICO_PLATFORM_MOCK_H
+#define PICO_PLATFORM_MOCK_H
+
+// Host code has a single memory: section placement is dropped
+#define __not_in_flash_func(func) func
+#define __scratch_x(group)
+#define __scratch_y(group)
+
+#endif // PICO_PLATFORM_MOCK_H
@@ -0,0 +1,35 @@
+/**
+ * Mock pico/time.h for host-based testing
+ */
+
+#ifndef PICO_TIME_MOCK_H
+#define PICO_TIME_MOCK_H
+
+#include "../pico_mock.h"
+
+// Host clock, advanced by hand in tests
+extern uint64_t mock_time_us;
+
+static inline uint64_t time_us_64(void) {
+    return mock_time_us;
+}
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)mock_time_us;
+}
+
+typedef uint64_t absolute_time_t;
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+// Sleeping jumps the host clock to the timeout
+static inline bool best_effort_wfe_or_timeout(absolute_time_t timeout) {
+    if (mock_time_us < timeout) {
+        mock_time_us = timeout;
+    }
+    return true;
+}
+
+#endif // PICO_TIME_MOCK_H
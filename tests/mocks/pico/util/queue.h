@@ -35,6 +35,10 @@ static inline bool queue_try_add(queue_t *q, const void *data) {
     return true;
 }
 
+static inline bool queue_is_empty(queue_t *q) {
+    return q->rptr == q->wptr;
+}
+
 static inline bool queue_try_remove(queue_t *q, void *data) {
     if (q->rptr == q->wptr) return false; // Empty
     
@@ -0,0 +1,44 @@
+/**
+ * Mock PSRAM implementation for unit testing
+ */
+
+#include "psram.h"
+#include "psram_mock.h"
+#include <string.h>
+
+uint8_t mock_psram[PSRAM_SIZE];
+uint32_t mock_psram_byte_accesses;
+uint32_t mock_psram_page_reads;
+uint32_t mock_psram_page_writes;
+void (*mock_psram_read_hook)(void);
+
+void mock_psram_reset(void) {
+    memset(mock_psram, 0, sizeof(mock_psram));
+    mock_psram_byte_accesses = 0;
+    mock_psram_page_reads = 0;
+    mock_psram_page_writes = 0;
+    mock_psram_read_hook = NULL;
+}
+
+uint32_t psram_init(void) {
+    return PSRAM_SIZE;
+}
+
+void psram_write_byte(uint32_t offset, uint8_t data) {
+    mock_psram_byte_accesses++;
+    mock_psram[offset] = data;
+}
+
+void psram_read(uint32_t offset, void *dst, uint32_t count) {
+    mock_psram_page_reads++;
+    memcpy(dst, &mock_psram[offset], count / 2);
+    if (mock_psram_read_hook) {
+        mock_psram_read_hook();
+    }
+    memcpy((uint8_t *)dst + count / 2, &mock_psram[offset + count / 2], count - count / 2);
+}
+
+void psram_write(uint32_t offset, const void *src, uint32_t count) {
+    mock_psram_page_writes++;
+    memcpy(&mock_psram[offset], src, count);
+}
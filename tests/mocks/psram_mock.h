@@ -0,0 +1,24 @@
+/**
+ * Mock PSRAM for unit testing
+ * An array stands in for the part; the counters show which accesses went
+ * to it directly (held writes that did not fit, flushes) and which as page
+ * transfers
+ */
+
+#ifndef PSRAM_MOCK_H
+#define PSRAM_MOCK_H
+
+#include <stdint.h>
+#include "config/memory_config.h"
+
+extern uint8_t mock_psram[PSRAM_SIZE];
+extern uint32_t mock_psram_byte_accesses;
+extern uint32_t mock_psram_page_reads;
+extern uint32_t mock_psram_page_writes;
+
+// Called in the middle of each page read, to race it with bus accesses
+extern void (*mock_psram_read_hook)(void);
+
+void mock_psram_reset(void);
+
+#endif // PSRAM_MOCK_H
@@ -0,0 +1,272 @@
+/**
+ * Remote Memory Service Tests
+ * 
+ * Tests for request checks, writes held until the frame boundary and
+ * applied by Core 0, and index descriptor access
+ */
+
+#include "test_memory_service.h"
+#include "network/memory_service.h"
+#include "indexed_memory/indexed_memory.h"
+#include "bus_interface/bus_interface.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CLIENT      0x0A00000Au, 7000
+
+// A received datagram: header then data
+typedef struct {
+    memory_request_t request;
+    uint8_t data[MEMORY_SERVICE_MAX_DATA];
+} test_packet_t;
+
+static void test_setup_memory_service(void) {
+    irq_init();
+    indexed_memory_init();
+    memory_service_init();
+}
+
+static void copy_from_packet(void *packet, void *dst, uint16_t length, uint16_t offset) {
+    memcpy(dst, (const uint8_t *)packet + offset, length);
+}
+
+static memory_request_t make_request(uint8_t type, uint32_t address, uint16_t length) {
+    memory_request_t request = {type, 0, length, address, 0x1234};
+    return request;
+}
+
+/**
+ * Test that malformed and out of range requests are refused
+ */
+bool test_memory_service_check(void) {
+    printf("Testing memory service request checks...\n");
+    
+    test_setup_memory_service();
+    memory_request_t read = make_request(MEMORY_PACKET_READ, 0x3FF00, 0x100);
+    memory_request_t write = make_request(MEMORY_PACKET_WRITE, INDEXED_MEMORY_USER_AREA_BASE, 16);
+    if (memory_service_check(&read, 0) != MEMORY_STATUS_OK ||
+        memory_service_check(&write, 16) != MEMORY_STATUS_OK) {
+        printf("FAIL: Valid requests refused\n");
+        return false;
+    }
+    
+    memory_request_t past_end = make_request(MEMORY_PACKET_READ, 0x3FF00, 0x101);
+    memory_request_t too_long = make_request(MEMORY_PACKET_READ, 0, MEMORY_SERVICE_MAX_DATA + 1);
+    memory_request_t empty = make_request(MEMORY_PACKET_WRITE, 0, 0);
+    memory_request_t indexes = make_request(MEMORY_PACKET_INDEX_READ, 250, 7);
+    if (memory_service_check(&past_end, 0) != MEMORY_STATUS_RANGE ||
+        memory_service_check(&too_long, 0) != MEMORY_STATUS_RANGE ||
+        memory_service_check(&empty, 0) != MEMORY_STATUS_RANGE ||
+        memory_service_check(&indexes, 0) != MEMORY_STATUS_RANGE) {
+        printf("FAIL: Out of range request accepted\n");
+        return false;
+    }
+    
+    memory_request_t unknown = make_request(0x42, 0, 1);
+    if (memory_service_check(&write, 15) != MEMORY_STATUS_BAD_REQUEST ||
+        memory_service_check(&read, 1) != MEMORY_STATUS_BAD_REQUEST ||
+        memory_service_check(&unknown, 0) != MEMORY_STATUS_BAD_REQUEST) {
+        printf("FAIL: Malformed request accepted\n");
+        return false;
+    }
+    
+    printf("PASS: Memory service request checks\n");
+    return true;
+}
+
+/**
+ * Test that writes change nothing until applied, then mark video blocks dirty
+ */
+bool test_memory_service_deferred_write(void) {
+    printf("Testing memory service deferred writes...\n");
+    
+    test_setup_memory_service();
+    static test_packet_t packets[MEMORY_SERVICE_QUEUE_DEPTH + 1];
+    uint32_t video = INDEXED_MEMORY_VIDEO_AREA_BASE + 0x100;
+    for (int i = 0; i <= MEMORY_SERVICE_QUEUE_DEPTH; i++) {
+        packets[i].request = make_request(MEMORY_PACKET_WRITE, video + i * 4, 4);
+        memset(packets[i].data, 0xA0 + i, 4);
+    }
+    for (int i = 0; i < MEMORY_SERVICE_QUEUE_DEPTH; i++) {
+        if (!memory_service_queue_write(&packets[i].request, &packets[i], CLIENT)) {
+            printf("FAIL: Write %d not queued\n", i);
+            return false;
+        }
+    }
+    if (memory_service_queue_write(&packets[MEMORY_SERVICE_QUEUE_DEPTH].request,
+                                   &packets[MEMORY_SERVICE_QUEUE_DEPTH], CLIENT)) {
+        printf("FAIL: Write queued past MEMORY_SERVICE_QUEUE_DEPTH\n");
+        return false;
+    }
+    
+    uint8_t *mem = indexed_memory_get_range(video, 4 * MEMORY_SERVICE_QUEUE_DEPTH);
+    uint32_t generation = indexed_memory_get_generation();
+    if (mem[0] != 0 || memory_service_pending() != MEMORY_SERVICE_QUEUE_DEPTH) {
+        printf("FAIL: Write applied before the frame boundary\n");
+        return false;
+    }
+    
+    // Frame boundary: every pending write goes to Core 0, nothing is
+    // answered before it has run
+    uint8_t dirty[VIDEO_TRACKED_BLOCKS];
+    indexed_memory_take_video_dirty(0, VIDEO_TRACKED_BLOCKS, dirty);
+    memory_write_t done;
+    if (!memory_service_start_apply(copy_from_packet) || memory_service_start_apply(copy_from_packet)) {
+        printf("FAIL: Batch not handed over once\n");
+        return false;
+    }
+    if (memory_service_take_done(&done) || mem[0] != 0) {
+        printf("FAIL: Write answered before Core 0 applied it\n");
+        return false;
+    }
+    memory_service_process();
+    for (int i = 0; i < MEMORY_SERVICE_QUEUE_DEPTH; i++) {
+        if (!memory_service_take_done(&done) || done.packet != &packets[i] ||
+            done.request.tag != 0x1234 || done.port != 7000) {
+            printf("FAIL: Write %d not applied in order\n", i);
+            return false;
+        }
+    }
+    memory_service_process();
+    if (memory_service_take_done(&done) || memory_service_pending() != 0) {
+        printf("FAIL: Write applied twice\n");
+        return false;
+    }
+    for (int i = 0; i < MEMORY_SERVICE_QUEUE_DEPTH; i++) {
+        if (mem[i * 4] != 0xA0 + i || mem[i * 4 + 3] != 0xA0 + i) {
+            printf("FAIL: Write %d data not in place\n", i);
+            return false;
+        }
+    }
+    if (indexed_memory_get_generation() == generation) {
+        printf("FAIL: Applied write not visible to bus reads\n");
+        return false;
+    }
+    
+    memset(dirty, 0, sizeof(dirty));
+    indexed_memory_take_video_dirty(0, VIDEO_TRACKED_BLOCKS, dirty);
+    if (!dirty[0x100 >> VIDEO_DIRTY_BLOCK_SHIFT]) {
+        printf("FAIL: Video area write not marked dirty\n");
+        return false;
+    }
+    
+    printf("PASS: Memory service deferred writes\n");
+    return true;
+}
+
+/**
+ * Test index descriptor reads and writes, which select the access kernel
+ */
+bool test_memory_service_indexes(void) {
+    printf("Testing memory service index access...\n");
+    
+    test_setup_memory_service();
+    static test_packet_t packet;
+    packet.request = make_request(MEMORY_PACKET_INDEX_WRITE, 200, 2);
+    static const uint8_t desc[2][INDEX_DESCRIPTOR_SIZE] = {
+        {0x00, 0x38, 0x01, 0x00, 0x38, 0x01, 0x10, 0x38, 0x01, 1, FLAG_AUTO_STEP | FLAG_WRAP_ON_LIMIT, 0},
+        {0x34, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 2, 0, 0},
+    };
+    memcpy(packet.data, desc, sizeof(desc));
+    if (memory_service_check(&packet.request, sizeof(desc)) != MEMORY_STATUS_OK ||
+        !memory_service_queue_write(&packet.request, &packet, CLIENT)) {
+        printf("FAIL: Index write refused\n");
+        return false;
+    }
+    
+    memory_write_t done;
+    memory_service_start_apply(copy_from_packet);
+    memory_service_process();
+    memory_service_take_done(&done);
+    if (indexed_memory_get_config_field(200, CFG_ADDR_H) != 0x01 ||
+        indexed_memory_get_config_field(201, CFG_ADDR_M) != 0x12 ||
+        indexed_memory_get_config_field(201, CFG_STEP) != 2) {
+        printf("FAIL: Index descriptors not loaded\n");
+        return false;
+    }
+    
+    // The written index works through DATA_PORT, wrapping at its limit
+    indexed_memory_get_range(0x13800, 1)[0] = 0x5A;
+    for (int i = 0; i < 16; i++) {
+        indexed_memory_read(200);
+    }
+    if (indexed_memory_read(200) != 0x5A) {
+        printf("FAIL: Written index does not wrap at its limit\n");
+        return false;
+    }
+    
+    memory_request_t read = make_request(MEMORY_PACKET_INDEX_READ, 200, 2);
+    uint8_t data[2 * INDEX_DESCRIPTOR_SIZE];
+    memory_service_read_indexes(&read, data);
+    if (memory_service_data_size(&read) != sizeof(data) ||
+        memcmp(data + INDEX_DESCRIPTOR_SIZE, desc[1], INDEX_DESCRIPTOR_SIZE) != 0 ||
+        data[CFG_ADDR_L] != 0x01 || data[CFG_FLAGS] != desc[0][CFG_FLAGS]) {
+        printf("FAIL: Index descriptors read back wrong\n");
+        return false;
+    }
+    
+    printf("PASS: Memory service index access\n");
+    return true;
+}
+
+/**
+ * Test that an index write replaces a window's burst cursor instead of
+ * being overwritten when the cursor is written back
+ */
+bool test_memory_service_index_burst(void) {
+    printf("Testing memory service index write under a burst cursor...\n");
+    
+    test_setup_memory_service();
+    bus_interface_init();
+    bus_interface_write(0x00, 201);                 // Window A: index 201
+    bus_interface_write(0x04, CMD_BURST_ENABLE);
+    bus_interface_write(0x01, 0x11);
+    if (!g_window_state[0].burst_loaded) {
+        printf("FAIL: Burst cursor not loaded\n");
+        return false;
+    }
+    
+    static test_packet_t packet;
+    static const uint8_t desc[INDEX_DESCRIPTOR_SIZE] = {0x34, 0x12, 0x00, 0, 0, 0, 0, 0, 0, 2, FLAG_AUTO_STEP, 0};
+    packet.request = make_request(MEMORY_PACKET_INDEX_WRITE, 201, 1);
+    memcpy(packet.data, desc, sizeof(desc));
+    indexed_memory_get_range(0x1234, 1)[0] = 0x77;
+    memory_service_queue_write(&packet.request, &packet, CLIENT);
+    memory_service_start_apply(copy_from_packet);
+    memory_service_process();
+    
+    if (g_window_state[0].burst_loaded || bus_interface_peek(0x01) != 0x77) {
+        printf("FAIL: Window still shows the old cursor\n");
+        return false;
+    }
+    
+    // Selecting the index again writes back nothing stale
+    bus_interface_write(0x00, 201);
+    if (indexed_memory_get_config_field(201, CFG_ADDR_L) != 0x34 ||
+        indexed_memory_get_config_field(201, CFG_ADDR_M) != 0x12 ||
+        bus_interface_read(0x01) != 0x77) {
+        printf("FAIL: Index descriptor overwritten by the burst cursor\n");
+        return false;
+    }
+    
+    memory_write_t done;
+    memory_service_take_done(&done);
+    bus_interface_write(0x04, CMD_BURST_DISABLE);
+    
+    printf("PASS: Memory service index write under a burst cursor\n");
+    return true;
+}
+
+bool run_memory_service_tests(void) {
+    printf("\n=== Memory Service Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_memory_service_check();
+    all_passed &= test_memory_service_deferred_write();
+    all_passed &= test_memory_service_indexes();
+    all_passed &= test_memory_service_index_burst();
+    
+    return all_passed;
+}
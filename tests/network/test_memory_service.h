@@ -0,0 +1,19 @@
+/**
+ * Remote Memory Service Test Interface
+ */
+
+#ifndef TEST_MEMORY_SERVICE_H
+#define TEST_MEMORY_SERVICE_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_memory_service_check(void);
+bool test_memory_service_deferred_write(void);
+bool test_memory_service_indexes(void);
+bool test_memory_service_index_burst(void);
+
+// Main test runner
+bool run_memory_service_tests(void);
+
+#endif // TEST_MEMORY_SERVICE_H
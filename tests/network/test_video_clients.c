@@ -0,0 +1,124 @@
+/**
+ * Video Client Table Tests
+ * 
+ * Tests for subscriptions, timeouts and keyframe-only throttling
+ */
+
+#include "test_video_clients.h"
+#include "network/video_clients.h"
+#include <stdio.h>
+
+#define CLIENT_A    0x0A00000Au, 7000
+#define CLIENT_B    0x0B00000Au, 7000
+
+/**
+ * Test that subscriptions fill the table once per client
+ */
+bool test_video_clients_subscribe(void) {
+    printf("Testing video client subscriptions...\n");
+    
+    video_clients_init();
+    bool added;
+    if (!video_clients_subscribe(CLIENT_A, 0, &added) || !added ||
+        !video_clients_subscribe(CLIENT_A, 10, &added) || added) {
+        printf("FAIL: Resubscribing added a second entry\n");
+        return false;
+    }
+    
+    for (uint32_t i = 1; i < WIFI_MAX_CLIENTS; i++) {
+        video_clients_subscribe(0x0C00000Au + i, 7000, 0, &added);
+    }
+    if (video_clients_subscribe(CLIENT_B, 0, &added) ||
+        video_clients_active_mask() != (1u << WIFI_MAX_CLIENTS) - 1) {
+        printf("FAIL: Table accepted more than WIFI_MAX_CLIENTS clients\n");
+        return false;
+    }
+    
+    video_clients_unsubscribe(CLIENT_A);
+    if (video_clients_find(CLIENT_A) || !video_clients_subscribe(CLIENT_B, 0, &added)) {
+        printf("FAIL: Unsubscribe did not free the entry\n");
+        return false;
+    }
+    
+    printf("PASS: Video client subscriptions\n");
+    return true;
+}
+
+/**
+ * Test that silent clients are dropped after VIDEO_CLIENT_TIMEOUT_MS
+ */
+bool test_video_clients_expire(void) {
+    printf("Testing video client expiry...\n");
+    
+    video_clients_init();
+    bool added;
+    video_clients_subscribe(CLIENT_A, 1000, &added);
+    video_clients_subscribe(CLIENT_B, 1000, &added);
+    video_clients_ack(CLIENT_B, 0, 1000 + VIDEO_CLIENT_TIMEOUT_MS - 1);
+    
+    video_clients_expire(1000 + VIDEO_CLIENT_TIMEOUT_MS);
+    if (video_clients_find(CLIENT_A) || !video_clients_find(CLIENT_B)) {
+        printf("FAIL: Expiry did not follow the last datagram\n");
+        return false;
+    }
+    
+    printf("PASS: Video client expiry\n");
+    return true;
+}
+
+/**
+ * Test that a lagging client gets keyframes only until it catches up
+ */
+bool test_video_clients_throttle(void) {
+    printf("Testing video client throttling...\n");
+    
+    video_clients_init();
+    bool added;
+    video_clients_subscribe(CLIENT_A, 0, &added);   // Acknowledges
+    video_clients_subscribe(CLIENT_B, 0, &added);   // Never acknowledges
+    
+    uint32_t seq = 100;
+    video_clients_frame_mask(seq, true);
+    video_clients_ack(CLIENT_A, seq, 0);
+    
+    // A stops acknowledging: throttled once more than MAX_LAG frames behind
+    uint32_t mask = 0;
+    for (int i = 0; i <= VIDEO_CLIENT_MAX_LAG + 1; i++) {
+        mask = video_clients_frame_mask(++seq, false);
+    }
+    if (mask != 0x2) {
+        printf("FAIL: Lagging client not throttled (mask %x)\n", mask);
+        return false;
+    }
+    
+    // Still behind at a keyframe: gets the keyframe, stays throttled
+    if (video_clients_frame_mask(++seq, true) != 0x3 ||
+        video_clients_frame_mask(++seq, false) != 0x2) {
+        printf("FAIL: Throttled client should get keyframes only\n");
+        return false;
+    }
+    
+    // Caught up: back to every frame from the next keyframe
+    video_clients_ack(CLIENT_A, seq - 1, 0);
+    if (video_clients_frame_mask(++seq, false) != 0x2 ||
+        video_clients_frame_mask(++seq, true) != 0x3 ||
+        video_clients_frame_mask(++seq, false) != 0x3) {
+        printf("FAIL: Client did not resume at the keyframe\n");
+        return false;
+    }
+    
+    printf("PASS: Video client throttling\n");
+    return true;
+}
+
+bool run_video_clients_tests(void) {
+    printf("\n=== Video Client Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_video_clients_subscribe();
+    all_passed &= test_video_clients_expire();
+    all_passed &= test_video_clients_throttle();
+    
+    return all_passed;
+}
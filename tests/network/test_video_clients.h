@@ -0,0 +1,18 @@
+/**
+ * Video Client Table Test Interface
+ */
+
+#ifndef TEST_VIDEO_CLIENTS_H
+#define TEST_VIDEO_CLIENTS_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_video_clients_subscribe(void);
+bool test_video_clients_expire(void);
+bool test_video_clients_throttle(void);
+
+// Main test runner
+bool run_video_clients_tests(void);
+
+#endif // TEST_VIDEO_CLIENTS_H
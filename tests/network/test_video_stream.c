@@ -0,0 +1,128 @@
+/**
+ * Video Stream Packetiser Tests
+ * 
+ * Tests for splitting dirty frame spans into MTU-sized fragments
+ */
+
+#include "test_video_stream.h"
+#include "network/video_stream.h"
+#include <stdio.h>
+#include <string.h>
+
+static video_frame_t frame;
+
+/**
+ * Walk all fragments, checking sizes and that the spans tile the dirty
+ * blocks in order. Returns the fragment count, or -1 on a bad fragment.
+ */
+static int check_fragments(void) {
+    video_stream_cursor_t cursor;
+    frame_span_t spans[FRAME_MAX_SPANS];
+    uint8_t span_count;
+    uint16_t data_size;
+    uint8_t covered[VIDEO_FRAME_DATA_SIZE];
+    uint32_t last_end = 0;
+    int fragments = 0;
+    
+    memset(covered, 0, sizeof(covered));
+    video_stream_begin(&cursor);
+    while (video_stream_next_fragment(&frame, &cursor, spans, &span_count, &data_size)) {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < span_count; i++) {
+            if (spans[i].length == 0 || spans[i].offset < last_end ||
+                spans[i].offset + spans[i].length > VIDEO_FRAME_DATA_SIZE) {
+                printf("FAIL: Fragment %d span %u out of order\n", fragments, i);
+                return -1;
+            }
+            memset(&covered[spans[i].offset], 1, spans[i].length);
+            last_end = spans[i].offset + spans[i].length;
+            total += spans[i].length;
+        }
+        if (total != data_size ||
+            FRAME_HEADER_SIZE + span_count * sizeof(frame_span_t) + data_size > VIDEO_STREAM_PACKET_MAX) {
+            printf("FAIL: Fragment %d size %u does not fit\n", fragments, data_size);
+            return -1;
+        }
+        fragments++;
+    }
+    
+    for (uint32_t b = 0; b < VIDEO_FRAME_DATA_SIZE; b++) {
+        if (covered[b] != frame.dirty[b >> VIDEO_DIRTY_BLOCK_SHIFT]) {
+            printf("FAIL: Byte %u %s\n", b, covered[b] ? "sent but clean" : "dirty but not sent");
+            return -1;
+        }
+    }
+    return fragments;
+}
+
+/**
+ * Test that a frame with nothing dirty still sends one (empty) fragment
+ */
+bool test_video_stream_empty_frame(void) {
+    printf("Testing video stream empty frame...\n");
+    
+    memset(&frame, 0, sizeof(frame));
+    if (check_fragments() != 1 || video_stream_count_fragments(&frame) != 1) {
+        printf("FAIL: Empty frame is not one fragment\n");
+        return false;
+    }
+    
+    printf("PASS: Video stream empty frame\n");
+    return true;
+}
+
+/**
+ * Test that a full frame is split into full-size datagrams
+ */
+bool test_video_stream_keyframe(void) {
+    printf("Testing video stream keyframe...\n");
+    
+    memset(&frame, 0, sizeof(frame));
+    memset(frame.dirty, 1, sizeof(frame.dirty));
+    
+    uint32_t per_fragment = VIDEO_STREAM_PACKET_MAX - FRAME_HEADER_SIZE - sizeof(frame_span_t);
+    int expected = (int)((VIDEO_FRAME_DATA_SIZE + per_fragment - 1) / per_fragment);
+    int fragments = check_fragments();
+    if (fragments != expected || video_stream_count_fragments(&frame) != (uint32_t)expected) {
+        printf("FAIL: Keyframe took %d fragments, expected %d\n", fragments, expected);
+        return false;
+    }
+    
+    printf("PASS: Video stream keyframe\n");
+    return true;
+}
+
+/**
+ * Test that scattered spans are limited to FRAME_MAX_SPANS per fragment
+ */
+bool test_video_stream_scattered_spans(void) {
+    printf("Testing video stream scattered spans...\n");
+    
+    memset(&frame, 0, sizeof(frame));
+    for (uint32_t b = 0; b < VIDEO_DIRTY_BLOCKS; b += 2) {
+        frame.dirty[b] = 1;
+    }
+    
+    int spans = (VIDEO_DIRTY_BLOCKS + 1) / 2;
+    int expected = (spans + FRAME_MAX_SPANS - 1) / FRAME_MAX_SPANS;
+    int fragments = check_fragments();
+    if (fragments != expected) {
+        printf("FAIL: Scattered frame took %d fragments, expected %d\n", fragments, expected);
+        return false;
+    }
+    
+    printf("PASS: Video stream scattered spans\n");
+    return true;
+}
+
+bool run_video_stream_tests(void) {
+    printf("\n=== Video Stream Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_video_stream_empty_frame();
+    all_passed &= test_video_stream_keyframe();
+    all_passed &= test_video_stream_scattered_spans();
+    
+    return all_passed;
+}
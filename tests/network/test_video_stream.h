@@ -0,0 +1,18 @@
+/**
+ * Video Stream Packetiser Test Interface
+ */
+
+#ifndef TEST_VIDEO_STREAM_H
+#define TEST_VIDEO_STREAM_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_video_stream_empty_frame(void);
+bool test_video_stream_keyframe(void);
+bool test_video_stream_scattered_spans(void);
+
+// Main test runner
+bool run_video_stream_tests(void);
+
+#endif // TEST_VIDEO_STREAM_H
@@ -0,0 +1,154 @@
+/**
+ * Kernel LZ4 Decoder Test Implementation
+ * 
+ * Tests for the resumable LZ4 block decoder used by the boot ROM.
+ */
+
+#include "test_kernel_lz4.h"
+#include "rom_emulation/kernel_lz4.h"
+#include <stdio.h>
+#include <string.h>
+
+// "MIA " + "ab" x 20 + 300 zero bytes + "0123456789" x 3 + "END!!",
+// compressed by scripts/compress_kernel.py --window 64. Covers extended
+// literal and match lengths and overlapping matches.
+static const uint8_t sample_block[] = {
+    0x6F, 0x4D, 0x49, 0x41, 0x20, 0x61, 0x62, 0x02, 0x00, 0x13, 0x1F, 0x00,
+    0x01, 0x00, 0xFF, 0x19, 0xAF, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x0A, 0x00, 0x01, 0x50, 0x45, 0x4E, 0x44, 0x21, 0x21
+};
+
+#define SAMPLE_SIZE 379
+
+// Build the uncompressed sample
+static void build_sample(uint8_t *out) {
+    uint32_t n = 0;
+    memcpy(&out[n], "MIA ", 4);
+    n += 4;
+    for (int i = 0; i < 20; i++) {
+        out[n++] = 'a';
+        out[n++] = 'b';
+    }
+    memset(&out[n], 0, 300);
+    n += 300;
+    for (int i = 0; i < 3; i++) {
+        memcpy(&out[n], "0123456789", 10);
+        n += 10;
+    }
+    memcpy(&out[n], "END!!", 5);
+}
+
+/**
+ * Test decoding a whole block in one call
+ */
+bool test_kernel_lz4_full_decode(void) {
+    uint8_t expected[SAMPLE_SIZE];
+    static uint8_t ring[512];
+    build_sample(expected);
+    
+    kernel_lz4_t d;
+    kernel_lz4_init(&d, sample_block, sizeof(sample_block), ring, sizeof(ring));
+    uint32_t produced = kernel_lz4_decode(&d, UINT32_MAX);
+    
+    if (produced != SAMPLE_SIZE || !kernel_lz4_done(&d) || d.error) {
+        printf("  FAIL: Decoded %u bytes (error=%d), expected %u\n",
+               (unsigned)produced, d.error, SAMPLE_SIZE);
+        return false;
+    }
+    if (memcmp(ring, expected, SAMPLE_SIZE) != 0) {
+        printf("  FAIL: Decoded data does not match\n");
+        return false;
+    }
+    
+    printf("  PASS: Block decodes in one call\n");
+    return true;
+}
+
+/**
+ * Test byte-at-a-time decoding into a ring smaller than the output
+ */
+bool test_kernel_lz4_incremental_ring(void) {
+    uint8_t expected[SAMPLE_SIZE];
+    uint8_t ring[64];
+    build_sample(expected);
+    
+    kernel_lz4_t d;
+    kernel_lz4_init(&d, sample_block, sizeof(sample_block), ring, sizeof(ring));
+    
+    uint32_t consumed = 0;
+    while (!kernel_lz4_done(&d) || consumed < d.produced) {
+        uint32_t produced = kernel_lz4_decode(&d, consumed + 1);
+        if (produced > consumed + 1) {
+            printf("  FAIL: Decoder ran past its limit (%u > %u)\n",
+                   (unsigned)produced, (unsigned)(consumed + 1));
+            return false;
+        }
+        if (produced > consumed) {
+            if (consumed >= SAMPLE_SIZE || kernel_lz4_byte(&d, consumed) != expected[consumed]) {
+                printf("  FAIL: Byte %u mismatch\n", (unsigned)consumed);
+                return false;
+            }
+            consumed++;
+        }
+    }
+    
+    if (consumed != SAMPLE_SIZE || d.error) {
+        printf("  FAIL: Consumed %u bytes, expected %u\n", (unsigned)consumed, SAMPLE_SIZE);
+        return false;
+    }
+    
+    printf("  PASS: Incremental decode through a small ring\n");
+    return true;
+}
+
+/**
+ * Test that corrupt blocks stop the decoder with an error
+ */
+bool test_kernel_lz4_corrupt_input(void) {
+    uint8_t ring[64];
+    kernel_lz4_t d;
+    
+    // Match offset 0
+    static const uint8_t zero_offset[] = { 0x10, 0x41, 0x00, 0x00, 0x50, 1, 2, 3, 4, 5 };
+    kernel_lz4_init(&d, zero_offset, sizeof(zero_offset), ring, sizeof(ring));
+    kernel_lz4_decode(&d, UINT32_MAX);
+    if (!kernel_lz4_done(&d) || !d.error) {
+        printf("  FAIL: Zero offset not rejected\n");
+        return false;
+    }
+    
+    // Offset beyond the ring
+    static const uint8_t far_offset[] = { 0x10, 0x41, 0x41, 0x00, 0x50, 1, 2, 3, 4, 5 };
+    kernel_lz4_init(&d, far_offset, sizeof(far_offset), ring, sizeof(ring));
+    kernel_lz4_decode(&d, UINT32_MAX);
+    if (!d.error) {
+        printf("  FAIL: Offset beyond the ring not rejected\n");
+        return false;
+    }
+    
+    // Truncated literals
+    kernel_lz4_init(&d, sample_block, 4, ring, sizeof(ring));
+    kernel_lz4_decode(&d, UINT32_MAX);
+    if (!kernel_lz4_done(&d) || !d.error) {
+        printf("  FAIL: Truncated block not rejected\n");
+        return false;
+    }
+    
+    printf("  PASS: Corrupt blocks rejected\n");
+    return true;
+}
+
+/**
+ * Run all kernel LZ4 decoder tests
+ */
+bool run_kernel_lz4_tests(void) {
+    printf("\n=== Running Kernel LZ4 Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_kernel_lz4_full_decode();
+    all_passed &= test_kernel_lz4_incremental_ring();
+    all_passed &= test_kernel_lz4_corrupt_input();
+    
+    return all_passed;
+}
@@ -0,0 +1,20 @@
+/**
+ * Kernel LZ4 Decoder Test Interface
+ * 
+ * Test functions for verifying the resumable LZ4 block decoder
+ */
+
+#ifndef TEST_KERNEL_LZ4_H
+#define TEST_KERNEL_LZ4_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_kernel_lz4_full_decode(void);
+bool test_kernel_lz4_incremental_ring(void);
+bool test_kernel_lz4_corrupt_input(void);
+
+// Test runner
+bool run_kernel_lz4_tests(void);
+
+#endif // TEST_KERNEL_LZ4_H
@@ -0,0 +1,173 @@
+/**
+ * Core 0 Background Work Tests
+ * 
+ * Tests for work priority, coalesced posts and the copy commands posted by
+ * the bus write path
+ */
+
+#include "test_background.h"
+#include "system/background.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <string.h>
+
+#define WORK_LOW    0x80
+
+static char run_log[16];
+static uint8_t run_count;
+
+static void log_run(char name) {
+    if (run_count < sizeof(run_log) - 1) {
+        run_log[run_count++] = name;
+        run_log[run_count] = '\0';
+    }
+}
+
+static void work_copy(void) { log_run('C'); }
+static void work_reset(void) { log_run('R'); }
+
+// Posts itself again while running, until it has run three times
+static void work_repost(void) {
+    log_run('L');
+    if (run_count < 4) {
+        background_post(WORK_LOW);
+    }
+}
+
+static void test_setup_background(void) {
+    background_init();
+    run_count = 0;
+    run_log[0] = '\0';
+}
+
+/**
+ * Test that pending work runs one item at a time, lowest bit first, once
+ * per run of posts
+ */
+bool test_background_priority(void) {
+    printf("Testing background work priority...\n");
+    
+    test_setup_background();
+    background_set_handler(BACKGROUND_WORK_COPY, work_copy);
+    background_set_handler(BACKGROUND_WORK_FAST_RESET, work_reset);
+    if (background_run_next()) {
+        printf("FAIL: Work ran without a post\n");
+        return false;
+    }
+    
+    background_post(BACKGROUND_WORK_FAST_RESET);
+    background_post(BACKGROUND_WORK_COPY);
+    background_post(BACKGROUND_WORK_COPY);
+    if (!background_run_next() || strcmp(run_log, "C") != 0) {
+        printf("FAIL: Copy work did not run first (%s)\n", run_log);
+        return false;
+    }
+    
+    // A post between runs goes ahead of lower-priority pending work
+    background_post(BACKGROUND_WORK_COPY);
+    while (background_run_next()) {
+    }
+    if (strcmp(run_log, "CCR") != 0) {
+        printf("FAIL: Wrong run order %s, expected CCR\n", run_log);
+        return false;
+    }
+    
+    // Work without a handler is dropped
+    background_post(WORK_LOW);
+    if (!background_run_next() || background_run_next() || run_count != 3) {
+        printf("FAIL: Work without a handler not dropped\n");
+        return false;
+    }
+    
+    printf("PASS: Background work priority\n");
+    return true;
+}
+
+/**
+ * Test that a post while the item runs is not lost
+ */
+bool test_background_post_during_run(void) {
+    printf("Testing background post during a run...\n");
+    
+    test_setup_background();
+    background_set_handler(WORK_LOW, work_repost);
+    background_set_handler(BACKGROUND_WORK_FAST_RESET, work_reset);
+    background_post(WORK_LOW | BACKGROUND_WORK_FAST_RESET);
+    while (background_run_next()) {
+    }
+    if (strcmp(run_log, "RLLL") != 0) {
+        printf("FAIL: Expected RLLL, got %s\n", run_log);
+        return false;
+    }
+    
+    printf("PASS: Background post during a run\n");
+    return true;
+}
+
+/**
+ * Test that a queued copy posts the copy work, and the work runs it
+ */
+bool test_background_copy_commands(void) {
+    printf("Testing background copy commands...\n");
+    
+    irq_init();
+    indexed_memory_init();
+    test_setup_background();
+    background_set_handler(BACKGROUND_WORK_COPY, indexed_memory_process_copy_command);
+    background_set_handler(BACKGROUND_WORK_FAST_RESET, work_reset);
+    
+    uint8_t *memory = indexed_memory_get_range(INDEXED_MEMORY_USER_AREA_BASE, 32);
+    for (int i = 0; i < 16; i++) {
+        memory[i] = (uint8_t)(0xA0 + i);
+    }
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_IDX, 1);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_IDX, 2);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_L, 16);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_H, 0);
+    indexed_memory_set_config_field(1, CFG_ADDR_L, 0x00);
+    indexed_memory_set_config_field(1, CFG_ADDR_M, 0x38);
+    indexed_memory_set_config_field(1, CFG_ADDR_H, 0x01);
+    indexed_memory_set_config_field(2, CFG_ADDR_L, 0x10);
+    indexed_memory_set_config_field(2, CFG_ADDR_M, 0x38);
+    indexed_memory_set_config_field(2, CFG_ADDR_H, 0x01);
+    indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    if (memory[16] == 0xA0 || !(indexed_memory_get_status() & STATUS_DMA_ACTIVE)) {
+        printf("FAIL: Copy ran on the bus write path\n");
+        return false;
+    }
+    
+    // The mock DMA completes the batch as it starts
+    while (background_run_next()) {
+    }
+    if (memcmp(&memory[16], memory, 16) != 0 ||
+        (indexed_memory_get_status() & STATUS_DMA_ACTIVE) ||
+        !(irq_get_cause() & IRQ_DMA_COMPLETE)) {
+        printf("FAIL: Background work did not run the copy\n");
+        return false;
+    }
+    
+    // Fast resets are posted too, for the Core 0 main loop
+    indexed_memory_execute_shared_command(CMD_SYSTEM_FAST_RESET);
+    while (background_run_next()) {
+    }
+    if (strcmp(run_log, "R") != 0 || !indexed_memory_fast_reset_requested()) {
+        printf("FAIL: Fast reset not posted (%s)\n", run_log);
+        return false;
+    }
+    
+    printf("PASS: Background copy commands\n");
+    return true;
+}
+
+bool run_background_tests(void) {
+    printf("\n=== Background Work Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_background_priority();
+    all_passed &= test_background_post_during_run();
+    all_passed &= test_background_copy_commands();
+    
+    return all_passed;
+}
@@ -0,0 +1,18 @@
+/**
+ * Core 0 Background Work Test Interface
+ */
+
+#ifndef TEST_BACKGROUND_H
+#define TEST_BACKGROUND_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_background_priority(void);
+bool test_background_post_during_run(void);
+bool test_background_copy_commands(void);
+
+// Main test runner
+bool run_background_tests(void);
+
+#endif // TEST_BACKGROUND_H
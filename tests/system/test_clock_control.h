@@ -11,6 +11,10 @@
 void clock_control_test_basic_functionality(void);
 void clock_control_test_frequency_accuracy(void);
 
+// Host tests (divider search and speed code table)
+bool test_clock_control_divider(void);
+bool test_clock_control_speed_table(void);
+
 // Main test runner
 bool run_clock_control_tests(void);
 
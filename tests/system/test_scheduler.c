@@ -0,0 +1,204 @@
+/**
+ * Core 1 Scheduler Tests
+ * 
+ * Tests for priority order, event wakeups and periodic deadlines
+ */
+
+#include "test_scheduler.h"
+#include "system/scheduler.h"
+#include <stdio.h>
+#include <string.h>
+
+// Wakeup events are plain bits to the scheduler
+#define EVENT_A     0x01
+#define EVENT_B     0x02
+#define EVENT_C     0x04
+#define EVENT_D     0x08
+
+static char run_log[16];
+static uint8_t run_count;
+
+static void log_run(char name) {
+    if (run_count < sizeof(run_log) - 1) {
+        run_log[run_count++] = name;
+        run_log[run_count] = '\0';
+    }
+}
+
+static void task_a(void) { log_run('A'); }
+static void task_b(void) { log_run('B'); }
+static void task_c(void) { log_run('C'); }
+
+// Signals its own event while running, as a task that finds more work does
+static void task_resignal(void) {
+    log_run('R');
+    if (run_count < 3) {
+        scheduler_signal(EVENT_B);
+    }
+}
+
+static void test_setup_scheduler(void) {
+    scheduler_init();
+    run_count = 0;
+    run_log[0] = '\0';
+}
+
+// Run ready tasks at now_us until none is left, return the nearest deadline
+static uint64_t run_ready(uint64_t now_us) {
+    uint64_t wake_us = 0;
+    for (int i = 0; i < 16 && scheduler_run_next(now_us, &wake_us); i++) {
+    }
+    return wake_us;
+}
+
+/**
+ * Test that ready tasks run one at a time, highest priority first
+ */
+bool test_scheduler_priority(void) {
+    printf("Testing scheduler priority order...\n");
+    
+    test_setup_scheduler();
+    scheduler_add_task(task_a, EVENT_A, 0);
+    scheduler_add_task(task_b, EVENT_C, 0);
+    scheduler_add_task(task_c, EVENT_A | EVENT_C, 0);
+    
+    scheduler_signal(EVENT_C | EVENT_A);
+    uint64_t wake_us;
+    if (!scheduler_run_next(0, &wake_us) || strcmp(run_log, "A") != 0) {
+        printf("FAIL: Highest-priority task did not run first (%s)\n", run_log);
+        return false;
+    }
+    
+    // A signal raised between runs goes ahead of lower-priority ready tasks
+    scheduler_signal(EVENT_A);
+    run_ready(0);
+    if (strcmp(run_log, "AABC") != 0) {
+        printf("FAIL: Wrong run order %s, expected AABC\n", run_log);
+        return false;
+    }
+    
+    while (scheduler_add_task(task_a, 0, 0)) {
+    }
+    if (scheduler_add_task(task_a, 0, 0)) {
+        printf("FAIL: Task added past SCHEDULER_MAX_TASKS\n");
+        return false;
+    }
+    
+    printf("PASS: Scheduler priority order\n");
+    return true;
+}
+
+/**
+ * Test that event-only tasks run once per signal and otherwise never
+ */
+bool test_scheduler_events(void) {
+    printf("Testing scheduler event wakeups...\n");
+    
+    test_setup_scheduler();
+    scheduler_add_task(task_a, EVENT_A | EVENT_B, 0);
+    scheduler_add_task(task_b, EVENT_D, 0);
+    
+    uint64_t wake_us = 0;
+    if (scheduler_run_next(0, &wake_us) || wake_us != UINT64_MAX) {
+        printf("FAIL: Task ran with no event, or event-only tasks set a deadline\n");
+        return false;
+    }
+    
+    // Several signals before the task runs wake it once
+    scheduler_signal(EVENT_A);
+    scheduler_signal(EVENT_B);
+    scheduler_signal(EVENT_C);
+    run_ready(1000000);
+    if (strcmp(run_log, "A") != 0) {
+        printf("FAIL: Expected one run of A, got %s\n", run_log);
+        return false;
+    }
+    
+    scheduler_signal(EVENT_D);
+    run_ready(2000000);
+    if (strcmp(run_log, "AB") != 0) {
+        printf("FAIL: Event D did not wake B only (%s)\n", run_log);
+        return false;
+    }
+    
+    printf("PASS: Scheduler event wakeups\n");
+    return true;
+}
+
+/**
+ * Test periodic deadlines and the wakeup time reported when idle
+ */
+bool test_scheduler_periods(void) {
+    printf("Testing scheduler periodic deadlines...\n");
+    
+    test_setup_scheduler();
+    scheduler_add_task(task_a, 0, 500);
+    scheduler_add_task(task_b, EVENT_C, 1000);
+    
+    // Periodic tasks run on the first pass
+    uint64_t wake_us = run_ready(100);
+    if (strcmp(run_log, "AB") != 0 || wake_us != 600) {
+        printf("FAIL: First pass ran %s, next wakeup %llu (expected AB, 600)\n",
+               run_log, (unsigned long long)wake_us);
+        return false;
+    }
+    
+    // Nothing before the deadline, A alone at it
+    if (run_ready(599) != 600 || run_count != 2) {
+        printf("FAIL: Task ran before its deadline\n");
+        return false;
+    }
+    wake_us = run_ready(600);
+    if (strcmp(run_log, "ABA") != 0 || wake_us != 1100) {
+        printf("FAIL: Deadline at 600 ran %s, next wakeup %llu\n",
+               run_log, (unsigned long long)wake_us);
+        return false;
+    }
+    
+    // An event runs B early and restarts its period
+    scheduler_signal(EVENT_C);
+    run_ready(700);
+    wake_us = run_ready(1100);
+    if (strcmp(run_log, "ABABA") != 0 || wake_us != 1600) {
+        printf("FAIL: Early event run gave %s, next wakeup %llu\n",
+               run_log, (unsigned long long)wake_us);
+        return false;
+    }
+    
+    printf("PASS: Scheduler periodic deadlines\n");
+    return true;
+}
+
+/**
+ * Test that a signal raised while the task runs is not lost
+ */
+bool test_scheduler_signal_during_run(void) {
+    printf("Testing scheduler signal during a run...\n");
+    
+    test_setup_scheduler();
+    scheduler_add_task(task_resignal, EVENT_A | EVENT_B, 0);
+    scheduler_add_task(task_c, EVENT_A, 0);
+    
+    scheduler_signal(EVENT_A);
+    run_ready(0);
+    if (strcmp(run_log, "RRRC") != 0) {
+        printf("FAIL: Expected RRRC, got %s\n", run_log);
+        return false;
+    }
+    
+    printf("PASS: Scheduler signal during a run\n");
+    return true;
+}
+
+bool run_scheduler_tests(void) {
+    printf("\n=== Scheduler Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_scheduler_priority();
+    all_passed &= test_scheduler_events();
+    all_passed &= test_scheduler_periods();
+    all_passed &= test_scheduler_signal_during_run();
+    
+    return all_passed;
+}
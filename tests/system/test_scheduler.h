@@ -0,0 +1,19 @@
+/**
+ * Core 1 Scheduler Test Interface
+ */
+
+#ifndef TEST_SCHEDULER_H
+#define TEST_SCHEDULER_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_scheduler_priority(void);
+bool test_scheduler_events(void);
+bool test_scheduler_periods(void);
+bool test_scheduler_signal_during_run(void);
+
+// Main test runner
+bool run_scheduler_tests(void);
+
+#endif // TEST_SCHEDULER_H
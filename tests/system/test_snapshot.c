@@ -0,0 +1,172 @@
+/**
+ * MIA Snapshot Tests
+ * 
+ * Tests for saving MIA memory and state to the (mock) flash store, loading
+ * them back, sector-level incremental saves and torn snapshots
+ */
+
+#include "test_snapshot.h"
+#include "system/snapshot.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include "flash_store_mock.h"
+#include <stdio.h>
+
+#define TEST_ADDR   (INDEXED_MEMORY_USER_AREA_BASE + 0x100)
+
+static void test_setup_snapshot(void) {
+    irq_init();
+    indexed_memory_init();
+    mock_flash_store_reset();
+}
+
+/**
+ * Test that a saved snapshot brings memory, indexes and the IRQ mask back
+ * after a cold init
+ */
+bool test_snapshot_round_trip(void) {
+    printf("Testing snapshot round trip...\n");
+    
+    test_setup_snapshot();
+    uint8_t *memory = indexed_memory_get_range(0, INDEXED_MEMORY_SIZE);
+    for (int i = 0; i < 64; i++) {
+        memory[TEST_ADDR + i] = (uint8_t)(0x5A ^ i);
+    }
+    memory[INDEXED_MEMORY_SIZE - 1] = 0xC3;
+    indexed_memory_set_config_field(200, CFG_ADDR_L, 0x34);
+    indexed_memory_set_config_field(200, CFG_STEP, 3);
+    irq_set_mask(0x0204);
+    if (!snapshot_save()) {
+        printf("FAIL: Save failed\n");
+        return false;
+    }
+    if (indexed_memory_peek(IDX_SNAPSHOT) != SNAPSHOT_STATUS_SAVED) {
+        printf("FAIL: Status after save is %u\n", indexed_memory_peek(IDX_SNAPSHOT));
+        return false;
+    }
+    
+    irq_init();
+    indexed_memory_init();
+    if (memory[TEST_ADDR] != 0 || indexed_memory_peek(IDX_SNAPSHOT) != SNAPSHOT_STATUS_NONE) {
+        printf("FAIL: Init did not clear memory\n");
+        return false;
+    }
+    if (!snapshot_restore()) {
+        printf("FAIL: Snapshot not restored\n");
+        return false;
+    }
+    for (int i = 0; i < 64; i++) {
+        if (memory[TEST_ADDR + i] != (uint8_t)(0x5A ^ i)) {
+            printf("FAIL: Memory at +%d is 0x%02X\n", i, memory[TEST_ADDR + i]);
+            return false;
+        }
+    }
+    if (memory[INDEXED_MEMORY_SIZE - 1] != 0xC3) {
+        printf("FAIL: Last memory sector not restored\n");
+        return false;
+    }
+    if (indexed_memory_get_config_field(200, CFG_ADDR_L) != 0x34 ||
+        indexed_memory_get_config_field(200, CFG_STEP) != 3) {
+        printf("FAIL: Index configuration not restored\n");
+        return false;
+    }
+    if (irq_get_mask() != 0x0204) {
+        printf("FAIL: IRQ mask is 0x%04X\n", irq_get_mask());
+        return false;
+    }
+    if (indexed_memory_peek(IDX_SNAPSHOT) != SNAPSHOT_STATUS_RESUMED) {
+        printf("FAIL: Status after restore is %u\n", indexed_memory_peek(IDX_SNAPSHOT));
+        return false;
+    }
+    
+    printf("PASS: Snapshot round trip\n");
+    return true;
+}
+
+/**
+ * Test that saves only rewrite the sectors that changed
+ */
+bool test_snapshot_incremental_save(void) {
+    printf("Testing incremental snapshot saves...\n");
+    
+    test_setup_snapshot();
+    if (!snapshot_save()) {
+        printf("FAIL: First save failed\n");
+        return false;
+    }
+    if (mock_flash_store_writes < SNAPSHOT_MEMORY_SECTORS) {
+        printf("FAIL: First save wrote %u sectors\n", mock_flash_store_writes);
+        return false;
+    }
+    
+    mock_flash_store_writes = 0;
+    if (!snapshot_save() || mock_flash_store_writes != 0) {
+        printf("FAIL: Unchanged save wrote %u sectors\n", mock_flash_store_writes);
+        return false;
+    }
+    
+    // Invalidate, the changed memory sector, then the first meta sector
+    indexed_memory_get_range(TEST_ADDR, 1)[0] = 0x77;
+    if (!snapshot_save() || mock_flash_store_writes != 3) {
+        printf("FAIL: One byte changed wrote %u sectors\n", mock_flash_store_writes);
+        return false;
+    }
+    
+    printf("PASS: Incremental snapshot saves\n");
+    return true;
+}
+
+/**
+ * Test that an erased store or a save cut short leaves nothing to restore
+ */
+bool test_snapshot_invalid(void) {
+    printf("Testing invalid snapshots...\n");
+    
+    test_setup_snapshot();
+    if (snapshot_restore()) {
+        printf("FAIL: Restored from an erased store\n");
+        return false;
+    }
+    if (indexed_memory_peek(IDX_SNAPSHOT) != SNAPSHOT_STATUS_NONE) {
+        printf("FAIL: Status changed without a snapshot\n");
+        return false;
+    }
+    
+    // Fails after the invalidation and a few memory sectors
+    if (!snapshot_save()) {
+        printf("FAIL: Save failed\n");
+        return false;
+    }
+    for (uint32_t i = 0; i < 4; i++) {
+        indexed_memory_get_range(i * FLASH_STORE_SECTOR_SIZE, 1)[0] ^= 0xFF;
+    }
+    mock_flash_store_fail_after = 3;
+    if (snapshot_save()) {
+        printf("FAIL: Save succeeded with a failing store\n");
+        return false;
+    }
+    if (indexed_memory_peek(IDX_SNAPSHOT) != SNAPSHOT_STATUS_FAILED) {
+        printf("FAIL: Status after a failed save is %u\n", indexed_memory_peek(IDX_SNAPSHOT));
+        return false;
+    }
+    mock_flash_store_fail_after = -1;
+    if (snapshot_restore()) {
+        printf("FAIL: Restored a torn snapshot\n");
+        return false;
+    }
+    
+    printf("PASS: Invalid snapshots\n");
+    return true;
+}
+
+bool run_snapshot_tests(void) {
+    printf("\n=== Snapshot Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_snapshot_round_trip();
+    all_passed &= test_snapshot_incremental_save();
+    all_passed &= test_snapshot_invalid();
+    
+    return all_passed;
+}
@@ -0,0 +1,18 @@
+/**
+ * MIA Snapshot Test Interface
+ */
+
+#ifndef TEST_SNAPSHOT_H
+#define TEST_SNAPSHOT_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_snapshot_round_trip(void);
+bool test_snapshot_incremental_save(void);
+bool test_snapshot_invalid(void);
+
+// Main test runner
+bool run_snapshot_tests(void);
+
+#endif // TEST_SNAPSHOT_H
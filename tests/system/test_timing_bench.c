@@ -0,0 +1,277 @@
+/**
+ * MIA Timing Bench Tests
+ *
+ * Tests for the PHI2 sweep of the timing bench firmware, with a simulated
+ * 6502 program writing the mailbox and the (mock) clock control
+ */
+
+#include "test_timing_bench.h"
+#include "system/timing_bench.h"
+#include "indexed_memory/indexed_memory.h"
+#include "bus_interface/bus_timing.h"
+#include "bus_interface/bus_interface.h"
+#include "bus_interface/bus_write_queue.h"
+#include "irq/irq.h"
+#include "clock_control_mock.h"
+#include <stdio.h>
+
+#define TEST_SYS_HZ     150000000
+
+extern uint64_t mock_time_us;
+extern void mock_pio_push_rx(uint8_t data);
+extern void mock_pio_drain_rx(void);
+extern void mock_pio_reset(void);
+
+// Simulated 6502 program, called once per task period
+typedef void (*test_program_fn)(void);
+
+static uint16_t test_passes;
+static uint32_t test_fail_hz;     // Frequency from which the program misbehaves
+
+static void test_setup_timing_bench(uint32_t max_hz) {
+    irq_init();
+    indexed_memory_init();
+    bus_write_queue_init();
+    bus_timing_init();
+    mock_pio_reset();
+    mock_clock_control_reset();
+    mock_clock_max_hz = max_hz;
+    test_passes = 0;
+    test_fail_hz = UINT32_MAX;
+    timing_bench_init(TEST_SYS_HZ);
+}
+
+static void test_count_pass(void) {
+    test_passes++;
+    indexed_memory_write_address(TIMING_BENCH_MAILBOX + TIMING_BENCH_MB_ITERATIONS, test_passes & 0xFF);
+    indexed_memory_write_address(TIMING_BENCH_MAILBOX + TIMING_BENCH_MB_ITERATIONS + 1, test_passes >> 8);
+}
+
+static void test_program_passes(void) {
+    test_count_pass();
+    bus_timing_record(BUS_TIMING_PHASE_PREPARE, 30);
+    bus_timing_record(BUS_TIMING_PHASE_PUSH, 60);
+}
+
+static void test_program_check_fails(void) {
+    if (mock_clock_frequency_hz < test_fail_hz) {
+        test_program_passes();
+        return;
+    }
+    indexed_memory_write_address(TIMING_BENCH_MAILBOX + TIMING_BENCH_MB_CHECK, TIMING_BENCH_CHECK_COPY);
+    indexed_memory_write_address(TIMING_BENCH_MAILBOX + TIMING_BENCH_MB_GOT, 0x12);
+    indexed_memory_write_address(TIMING_BENCH_MAILBOX + TIMING_BENCH_MB_EXPECTED, 0x13);
+}
+
+static void test_program_stalls(void) {
+    if (mock_clock_frequency_hz < test_fail_hz) {
+        test_program_passes();
+    }
+}
+
+static void test_program_drops_writes(void) {
+    test_program_passes();
+    if (mock_clock_frequency_hz >= test_fail_hz) {
+        for (int i = 0; i <= BUS_WRITE_QUEUE_SIZE; i++) {
+            bus_write_queue_push(0x01, 0x00);
+        }
+    }
+}
+
+static void test_program_reads_early(void) {
+    test_program_passes();
+    if (mock_clock_frequency_hz >= test_fail_hz) {
+        bus_interface_count_early_read();
+    }
+}
+
+static void test_program_overflows_rx(void) {
+    test_program_passes();
+    if (mock_clock_frequency_hz >= test_fail_hz) {
+        for (int i = 0; i < 8; i++) {
+            mock_pio_push_rx(0);
+        }
+    }
+}
+
+// Overflows and is drained again before the bench polls
+static void test_program_overflows_rx_briefly(void) {
+    test_program_overflows_rx();
+    if (mock_clock_frequency_hz >= test_fail_hz) {
+        mock_pio_push_rx(0);
+        mock_pio_drain_rx();
+    }
+}
+
+static void test_program_slow_prepare(void) {
+    test_count_pass();
+    bus_timing_record(BUS_TIMING_PHASE_PREPARE, 60);     // 400ns, past the 330ns at 1 MHz
+}
+
+// Run the sweep until it is done
+static const timing_bench_result_t *test_run_sweep(test_program_fn program) {
+    for (int i = 0; i < 100000 && !timing_bench_get_result()->done; i++) {
+        program();
+        mock_time_us += TIMING_BENCH_TASK_PERIOD_US;
+        timing_bench_process();
+    }
+    return timing_bench_get_result();
+}
+
+/**
+ * Test the phase deadlines against the 1 MHz cycle of docs/bus_timing.md
+ */
+bool test_timing_bench_deadlines(void) {
+    printf("Testing timing bench deadlines...\n");
+    
+    if (timing_bench_deadline_ns(1000000, TIMING_BENCH_MARGIN_PREPARE) != 330 ||
+        timing_bench_deadline_ns(1000000, TIMING_BENCH_MARGIN_PUSH) != 785) {
+        printf("FAIL: 1 MHz deadlines are %ld/%ld ns\n",
+               (long)timing_bench_deadline_ns(1000000, TIMING_BENCH_MARGIN_PREPARE),
+               (long)timing_bench_deadline_ns(1000000, TIMING_BENCH_MARGIN_PUSH));
+        return false;
+    }
+    if (timing_bench_deadline_ns(4000000, TIMING_BENCH_MARGIN_PREPARE) >= 0) {
+        printf("FAIL: 4 MHz leaves time before the OE/WE sample\n");
+        return false;
+    }
+    
+    printf("PASS: Timing bench deadlines\n");
+    return true;
+}
+
+/**
+ * Test a sweep that passes every step up to the clock limit
+ */
+bool test_timing_bench_sweep(void) {
+    printf("Testing timing bench sweep...\n");
+    
+    test_setup_timing_bench(1200000);
+    if (timing_bench_get_result()->done) {
+        printf("FAIL: Done before the start delay\n");
+        return false;
+    }
+    const timing_bench_result_t *result = test_run_sweep(test_program_passes);
+    if (!result->done || result->last.fail != TIMING_BENCH_FAIL_LIMIT) {
+        printf("FAIL: Sweep did not end at the clock limit (fail %d)\n", result->last.fail);
+        return false;
+    }
+    if (result->max_pass_hz != 1200000 || result->last.frequency_hz != 1250000) {
+        printf("FAIL: Max pass %lu Hz, last step %lu Hz\n",
+               (unsigned long)result->max_pass_hz, (unsigned long)result->last.frequency_hz);
+        return false;
+    }
+    if (mock_clock_frequency_hz != 1200000) {
+        printf("FAIL: PHI2 left at %lu Hz\n", (unsigned long)mock_clock_frequency_hz);
+        return false;
+    }
+    
+    printf("PASS: Timing bench sweep\n");
+    return true;
+}
+
+/**
+ * Test that each kind of failure ends the sweep at the first failing step
+ * and drops PHI2 back to the last passing one
+ */
+bool test_timing_bench_failures(void) {
+    printf("Testing timing bench failures...\n");
+    
+    static const struct {
+        test_program_fn program;
+        timing_bench_fail_t fail;
+    } cases[] = {
+        { test_program_check_fails,          TIMING_BENCH_FAIL_CHECK },
+        { test_program_stalls,               TIMING_BENCH_FAIL_STALLED },
+        { test_program_drops_writes,         TIMING_BENCH_FAIL_WRITE_QUEUE },
+        { test_program_reads_early,          TIMING_BENCH_FAIL_EARLY_READ },
+        { test_program_overflows_rx,         TIMING_BENCH_FAIL_RX_OVERFLOW },
+        { test_program_overflows_rx_briefly, TIMING_BENCH_FAIL_RX_OVERFLOW },
+    };
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        test_setup_timing_bench(UINT32_MAX);
+        test_fail_hz = 1100000;
+        const timing_bench_result_t *result = test_run_sweep(cases[c].program);
+        if (!result->done || result->last.fail != cases[c].fail || result->last.frequency_hz != 1100000) {
+            printf("FAIL: Case %u ended with %d at %lu Hz\n", c, result->last.fail,
+                   (unsigned long)result->last.frequency_hz);
+            return false;
+        }
+        if (result->max_pass_hz != 1050000 || mock_clock_frequency_hz != 1050000) {
+            printf("FAIL: Case %u did not fall back to 1050000 Hz\n", c);
+            return false;
+        }
+    }
+    
+    // The failed check and its bytes from the mailbox
+    test_setup_timing_bench(UINT32_MAX);
+    test_fail_hz = 1100000;
+    const timing_bench_result_t *result = test_run_sweep(test_program_check_fails);
+    if (result->last.check != TIMING_BENCH_CHECK_COPY || result->last.got != 0x12 || result->last.expected != 0x13) {
+        printf("FAIL: Check %u, got 0x%02X, expected 0x%02X\n", result->last.check, result->last.got, result->last.expected);
+        return false;
+    }
+    
+    printf("PASS: Timing bench failures\n");
+    return true;
+}
+
+/**
+ * Test that a handler phase past its deadline fails even with good data
+ */
+bool test_timing_bench_margins(void) {
+    printf("Testing timing bench margins...\n");
+    
+    // 30 and 60 cycles at 150 MHz: 200ns misses the prepare deadline above 1.35 MHz
+    test_setup_timing_bench(UINT32_MAX);
+    const timing_bench_result_t *result = test_run_sweep(test_program_passes);
+    if (result->last.fail != TIMING_BENCH_FAIL_MARGIN || result->last.frequency_hz != 1400000) {
+        printf("FAIL: Shrinking cycle ended with %d at %lu Hz\n", result->last.fail,
+               (unsigned long)result->last.frequency_hz);
+        return false;
+    }
+    if (!result->last.has_margin[TIMING_BENCH_MARGIN_PREPARE] ||
+        !result->last.has_margin[TIMING_BENCH_MARGIN_PUSH]) {
+        printf("FAIL: No margins recorded\n");
+        return false;
+    }
+    if (result->last.margin_ns[TIMING_BENCH_MARGIN_PREPARE] >= 0 &&
+        result->last.margin_ns[TIMING_BENCH_MARGIN_PUSH] >= 0) {
+        printf("FAIL: Failing step has no negative margin\n");
+        return false;
+    }
+    
+    // Too slow already at the start frequency: nothing passes
+    test_setup_timing_bench(UINT32_MAX);
+    result = test_run_sweep(test_program_slow_prepare);
+    if (result->last.fail != TIMING_BENCH_FAIL_MARGIN || result->max_pass_hz != 0 ||
+        result->last.margin_ns[TIMING_BENCH_MARGIN_PREPARE] != 330 - 400) {
+        printf("FAIL: Start step margin %ld ns (fail %d, max %lu Hz)\n",
+               (long)result->last.margin_ns[TIMING_BENCH_MARGIN_PREPARE], result->last.fail,
+               (unsigned long)result->max_pass_hz);
+        return false;
+    }
+    if (mock_clock_frequency_hz != TIMING_BENCH_FREQ_START_HZ) {
+        printf("FAIL: PHI2 not back at the start frequency\n");
+        return false;
+    }
+    
+    printf("PASS: Timing bench margins\n");
+    return true;
+}
+
+/**
+ * Run all timing bench tests
+ */
+bool run_timing_bench_tests(void) {
+    printf("\n=== Timing Bench Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_timing_bench_deadlines();
+    all_passed &= test_timing_bench_sweep();
+    all_passed &= test_timing_bench_failures();
+    all_passed &= test_timing_bench_margins();
+    
+    return all_passed;
+}
@@ -0,0 +1,19 @@
+/**
+ * MIA Timing Bench Test Interface
+ */
+
+#ifndef TEST_TIMING_BENCH_H
+#define TEST_TIMING_BENCH_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_timing_bench_deadlines(void);
+bool test_timing_bench_sweep(void);
+bool test_timing_bench_failures(void);
+bool test_timing_bench_margins(void);
+
+// Main test runner
+bool run_timing_bench_tests(void);
+
+#endif // TEST_TIMING_BENCH_H
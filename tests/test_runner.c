@@ -11,10 +11,28 @@
 // Include test headers
 #include "bus_interface/test_bus_interface.h"
 #include "bus_interface/test_bus_sync_pio_fifo.h"
+#include "bus_interface/test_bus_write_queue.h"
+#include "bus_interface/test_bus_timing.h"
+#include "bus_interface/test_bus_trace.h"
 #include "indexed_memory/test_indexed_memory.h"
+#include "indexed_memory/test_psram_cache.h"
 #include "irq/test_irq.h"
+#include "network/test_video_stream.h"
+#include "network/test_video_clients.h"
+#include "network/test_memory_service.h"
 #include "rom_emulation/test_rom_emulator.h"
+#include "rom_emulation/test_kernel_lz4.h"
 #include "system/test_clock_control.h"
+#include "system/test_scheduler.h"
+#include "system/test_background.h"
+#include "system/test_snapshot.h"
+#include "system/test_timing_bench.h"
+#include "video/test_video_controller.h"
+#include "video/test_video_render.h"
+#include "video/test_video_sprites.h"
+#include "video/test_video_tile_cache.h"
+#include "usb/test_usb_keyboard.h"
+#include "usb/test_usb_loader.h"
 
 int main(void) {
     printf("===========================================\n");
@@ -36,6 +54,39 @@ int main(void) {
         printf("✗ Bus Interface Tests FAILED\n\n");
     }
     
+    // Run bus write queue tests
+    printf("Running Bus Write Queue Tests...\n");
+    total_suites++;
+    if (run_bus_write_queue_tests()) {
+        passed_suites++;
+        printf("✓ Bus Write Queue Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Bus Write Queue Tests FAILED\n\n");
+    }
+    
+    // Run bus timing tests
+    printf("Running Bus Timing Tests...\n");
+    total_suites++;
+    if (run_bus_timing_tests()) {
+        passed_suites++;
+        printf("✓ Bus Timing Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Bus Timing Tests FAILED\n\n");
+    }
+    
+    // Run bus trace tests
+    printf("Running Bus Trace Tests...\n");
+    total_suites++;
+    if (run_bus_trace_tests()) {
+        passed_suites++;
+        printf("✓ Bus Trace Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Bus Trace Tests FAILED\n\n");
+    }
+    
     // Run indexed memory tests
     printf("Running Indexed Memory Tests...\n");
     total_suites++;
@@ -47,6 +98,17 @@ int main(void) {
         printf("✗ Indexed Memory Tests FAILED\n\n");
     }
     
+    // Run PSRAM cache tests
+    printf("Running PSRAM Cache Tests...\n");
+    total_suites++;
+    if (run_psram_cache_tests()) {
+        passed_suites++;
+        printf("✓ PSRAM Cache Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ PSRAM Cache Tests FAILED\n\n");
+    }
+    
     // Run IRQ tests
     printf("Running IRQ Tests...\n");
     total_suites++;
@@ -65,6 +127,17 @@ int main(void) {
         printf("✗ ROM Emulator Tests FAILED\n\n");
     }
     
+    // Run kernel LZ4 decoder tests
+    printf("Running Kernel LZ4 Tests...\n");
+    total_suites++;
+    if (run_kernel_lz4_tests()) {
+        passed_suites++;
+        printf("✓ Kernel LZ4 Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Kernel LZ4 Tests FAILED\n\n");
+    }
+    
     // Run clock control tests
     printf("Running Clock Control Tests...\n");
     total_suites++;
@@ -76,6 +149,149 @@ int main(void) {
         printf("✗ Clock Control Tests FAILED\n\n");
     }
     
+    // Run Core 1 scheduler tests
+    printf("Running Scheduler Tests...\n");
+    total_suites++;
+    if (run_scheduler_tests()) {
+        passed_suites++;
+        printf("✓ Scheduler Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Scheduler Tests FAILED\n\n");
+    }
+    
+    // Run Core 0 background work tests
+    printf("Running Background Work Tests...\n");
+    total_suites++;
+    if (run_background_tests()) {
+        passed_suites++;
+        printf("✓ Background Work Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Background Work Tests FAILED\n\n");
+    }
+    
+    // Run snapshot tests
+    printf("Running Snapshot Tests...\n");
+    total_suites++;
+    if (run_snapshot_tests()) {
+        passed_suites++;
+        printf("✓ Snapshot Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Snapshot Tests FAILED\n\n");
+    }
+    
+    // Run timing bench tests
+    printf("Running Timing Bench Tests...\n");
+    total_suites++;
+    if (run_timing_bench_tests()) {
+        passed_suites++;
+        printf("✓ Timing Bench Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Timing Bench Tests FAILED\n\n");
+    }
+    
+    // Run video controller tests
+    printf("Running Video Controller Tests...\n");
+    total_suites++;
+    if (run_video_controller_tests()) {
+        passed_suites++;
+        printf("✓ Video Controller Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Video Controller Tests FAILED\n\n");
+    }
+    
+    // Run video render tests
+    printf("Running Video Render Tests...\n");
+    total_suites++;
+    if (run_video_render_tests()) {
+        passed_suites++;
+        printf("✓ Video Render Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Video Render Tests FAILED\n\n");
+    }
+    
+    // Run video sprites tests
+    printf("Running Video Sprites Tests...\n");
+    total_suites++;
+    if (run_video_sprites_tests()) {
+        passed_suites++;
+        printf("✓ Video Sprites Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Video Sprites Tests FAILED\n\n");
+    }
+    
+    // Run video tile cache tests
+    printf("Running Video Tile Cache Tests...\n");
+    total_suites++;
+    if (run_video_tile_cache_tests()) {
+        passed_suites++;
+        printf("✓ Video Tile Cache Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Video Tile Cache Tests FAILED\n\n");
+    }
+    
+    // Run USB keyboard tests
+    printf("Running USB Keyboard Tests...\n");
+    total_suites++;
+    if (run_usb_keyboard_tests()) {
+        passed_suites++;
+        printf("✓ USB Keyboard Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ USB Keyboard Tests FAILED\n\n");
+    }
+    
+    // Run USB loader tests
+    printf("Running USB Loader Tests...\n");
+    total_suites++;
+    if (run_usb_loader_tests()) {
+        passed_suites++;
+        printf("✓ USB Loader Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ USB Loader Tests FAILED\n\n");
+    }
+    
+    // Run video stream tests
+    printf("Running Video Stream Tests...\n");
+    total_suites++;
+    if (run_video_stream_tests()) {
+        passed_suites++;
+        printf("✓ Video Stream Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Video Stream Tests FAILED\n\n");
+    }
+    
+    // Run video client tests
+    printf("Running Video Client Tests...\n");
+    total_suites++;
+    if (run_video_clients_tests()) {
+        passed_suites++;
+        printf("✓ Video Client Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Video Client Tests FAILED\n\n");
+    }
+    
+    // Run remote memory service tests
+    printf("Running Memory Service Tests...\n");
+    total_suites++;
+    if (run_memory_service_tests()) {
+        passed_suites++;
+        printf("✓ Memory Service Tests PASSED\n\n");
+    } else {
+        all_passed = false;
+        printf("✗ Memory Service Tests FAILED\n\n");
+    }
+    
     // Run PIO-C FIFO communication tests
     printf("Running PIO-C FIFO Communication Tests...\n");
     total_suites++;
@@ -0,0 +1,204 @@
+/**
+ * USB Keyboard Ring Tests
+ *
+ * Tests for the key ring read by the 6502 through index 64, its coalesced
+ * IRQ and the HID report translation
+ */
+
+#include "test_usb_keyboard.h"
+#include "usb/usb_keyboard.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <string.h>
+
+static void test_setup_usb_keyboard(void) {
+    irq_init();
+    indexed_memory_init();
+    usb_keyboard_init();
+}
+
+static uint8_t ring_head(void) {
+    return indexed_memory_get_io_buffer(USB_KEYBOARD_BUFFER_SIZE)[USB_KEY_STATUS_HEAD];
+}
+
+static void send_report(uint8_t modifiers, uint8_t key0, uint8_t key1) {
+    uint8_t report[USB_KEY_REPORT_SIZE] = {modifiers, 0, key0, key1, 0, 0, 0, 0};
+    usb_keyboard_handle_report(report, sizeof(report));
+}
+
+/**
+ * Test that published keys are read through index 64, with one IRQ a burst
+ */
+bool test_usb_keyboard_ring(void) {
+    printf("Testing USB keyboard ring...\n");
+    
+    test_setup_usb_keyboard();
+    usb_keyboard_push('a');
+    usb_keyboard_push('b');
+    usb_keyboard_push('c');
+    if (ring_head() != 0 || usb_keyboard_available() != 0) {
+        printf("FAIL: Keys visible before they were published\n");
+        return false;
+    }
+    
+    usb_keyboard_publish();
+    if (ring_head() != 3 || usb_keyboard_available() != 3) {
+        printf("FAIL: Head not published\n");
+        return false;
+    }
+    if (!(irq_get_cause() & IRQ_USB_KEYBOARD) || !(indexed_memory_get_status() & STATUS_USB_DATA_READY)) {
+        printf("FAIL: Keyboard IRQ or STATUS_USB_DATA_READY not raised\n");
+        return false;
+    }
+    
+    // More keys while the ring is not empty: no new interrupt
+    irq_clear_all();
+    indexed_memory_read(IDX_USB_KEYBOARD);  // 'a'
+    usb_keyboard_push('d');
+    usb_keyboard_publish();
+    if (irq_get_cause() & IRQ_USB_KEYBOARD) {
+        printf("FAIL: Keyboard IRQ raised again before the ring was emptied\n");
+        return false;
+    }
+    
+    // The 6502 reads the rest through DATA_PORT, then the ring is empty
+    uint8_t b = indexed_memory_read(IDX_USB_KEYBOARD);
+    uint8_t c = indexed_memory_read(IDX_USB_KEYBOARD);
+    uint8_t key = 0;
+    if (b != 'b' || c != 'c' || !usb_keyboard_pop(&key) || key != 'd' || usb_keyboard_pop(&key)) {
+        printf("FAIL: Keys not read in order\n");
+        return false;
+    }
+    if (indexed_memory_get_config_field(IDX_USB_KEYBOARD, CFG_ADDR_L) != ring_head()) {
+        printf("FAIL: Index 64 not at the head once the ring is empty\n");
+        return false;
+    }
+    usb_keyboard_publish();
+    if (indexed_memory_get_status() & STATUS_USB_DATA_READY) {
+        printf("FAIL: STATUS_USB_DATA_READY still set with an empty ring\n");
+        return false;
+    }
+    
+    // The next burst lands in an empty ring: interrupt again
+    usb_keyboard_push('e');
+    usb_keyboard_publish();
+    if (!(irq_get_cause() & IRQ_USB_KEYBOARD)) {
+        printf("FAIL: Keyboard IRQ not raised for a new burst\n");
+        return false;
+    }
+    
+    printf("PASS: USB keyboard ring\n");
+    return true;
+}
+
+/**
+ * Test that a full ring drops keys instead of overwriting unread ones
+ */
+bool test_usb_keyboard_full(void) {
+    printf("Testing USB keyboard full ring...\n");
+    
+    test_setup_usb_keyboard();
+    for (int i = 0; i < USB_KEYBOARD_BUFFER_SIZE - 1; i++) {
+        if (!usb_keyboard_push((uint8_t)i)) {
+            printf("FAIL: Key %d dropped before the ring was full\n", i);
+            return false;
+        }
+    }
+    uint32_t generation = indexed_memory_get_generation();
+    if (!usb_keyboard_is_full() || usb_keyboard_push(0xFF)) {
+        printf("FAIL: Key accepted into a full ring\n");
+        return false;
+    }
+    if (!(indexed_memory_get_io_buffer(USB_KEYBOARD_BUFFER_SIZE)[USB_KEY_STATUS_FLAGS] & USB_KEY_FLAG_OVERFLOW)) {
+        printf("FAIL: Overflow flag not set\n");
+        return false;
+    }
+    if (indexed_memory_get_generation() == generation) {
+        printf("FAIL: Overflow flag set without telling bus reads\n");
+        return false;
+    }
+    
+    // Reading one key frees its slot, and the ring wraps around
+    usb_keyboard_publish();
+    if (indexed_memory_read(IDX_USB_KEYBOARD) != 0 || !usb_keyboard_push(0x80)) {
+        printf("FAIL: Slot not reused after a read\n");
+        return false;
+    }
+    usb_keyboard_publish();
+    uint8_t key = 0;
+    for (int i = 1; i < USB_KEYBOARD_BUFFER_SIZE - 1; i++) {
+        if (!usb_keyboard_pop(&key) || key != (uint8_t)i) {
+            printf("FAIL: Key %d lost or out of order\n", i);
+            return false;
+        }
+    }
+    if (!usb_keyboard_pop(&key) || key != 0x80 || usb_keyboard_pop(&key)) {
+        printf("FAIL: Wrapped key not read last\n");
+        return false;
+    }
+    
+    printf("PASS: USB keyboard full ring\n");
+    return true;
+}
+
+/**
+ * Test HID boot reports: new presses only, Shift, Ctrl and rollover
+ */
+bool test_usb_keyboard_reports(void) {
+    printf("Testing USB keyboard reports...\n");
+    
+    test_setup_usb_keyboard();
+    send_report(0, 0x04, 0);                    // 'a' down
+    send_report(0, 0x04, 0);                    // Held: no repeat
+    send_report(0, 0x04, 0x05);                 // 'b' down with 'a' held
+    send_report(0x02, 0x1E, 0);                 // Left Shift + '1'
+    send_report(0, 0, 0);                       // All up
+    send_report(0x10, 0x06, 0);                 // Right Ctrl + 'c'
+    send_report(0, 0x01, 0x01);                 // Rollover: ignored
+    send_report(0, 0x52, 0);                    // Up arrow: no ASCII
+    send_report(0, 0x28, 0);                    // Enter
+    usb_keyboard_publish();
+    
+    static const uint8_t expected[] = {'a', 'b', '!', 0x03, '\r'};
+    uint8_t key = 0;
+    for (size_t i = 0; i < sizeof(expected); i++) {
+        if (!usb_keyboard_pop(&key) || key != expected[i]) {
+            printf("FAIL: Key %zu is 0x%02X, expected 0x%02X\n", i, key, expected[i]);
+            return false;
+        }
+    }
+    if (usb_keyboard_pop(&key)) {
+        printf("FAIL: Unexpected key 0x%02X\n", key);
+        return false;
+    }
+    
+    // Mount state in the status bytes, with bus reads told of each change
+    uint32_t generation = indexed_memory_get_generation();
+    usb_keyboard_set_mounted(true);
+    if (!usb_keyboard_is_mounted() || indexed_memory_get_generation() == generation) {
+        printf("FAIL: Mount not reported to bus reads\n");
+        return false;
+    }
+    generation = indexed_memory_get_generation();
+    usb_keyboard_set_mounted(false);
+    if (usb_keyboard_is_mounted() || indexed_memory_get_generation() == generation) {
+        printf("FAIL: Unmount not reported to bus reads\n");
+        return false;
+    }
+    
+    printf("PASS: USB keyboard reports\n");
+    return true;
+}
+
+bool run_usb_keyboard_tests(void) {
+    printf("\n=== USB Keyboard Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_usb_keyboard_ring();
+    all_passed &= test_usb_keyboard_full();
+    all_passed &= test_usb_keyboard_reports();
+    
+    return all_passed;
+}
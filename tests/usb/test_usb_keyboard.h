@@ -0,0 +1,20 @@
+/**
+ * USB Keyboard Ring Test Interface
+ * 
+ * Test functions for the keyboard ring behind index 64
+ */
+
+#ifndef TEST_USB_KEYBOARD_H
+#define TEST_USB_KEYBOARD_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_usb_keyboard_ring(void);
+bool test_usb_keyboard_full(void);
+bool test_usb_keyboard_reports(void);
+
+// Main test runner
+bool run_usb_keyboard_tests(void);
+
+#endif // TEST_USB_KEYBOARD_H
@@ -0,0 +1,164 @@
+/**
+ * USB Loader Tests
+ * 
+ * Tests for loads streamed from the vendor endpoint into the user area
+ */
+
+#include "test_usb_loader.h"
+#include "usb/usb_loader.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint8_t stream[4096];
+
+static void test_setup_usb_loader(void) {
+    irq_init();
+    indexed_memory_init();
+    usb_loader_init();
+}
+
+// Build a load in stream[], returns its size
+static uint32_t make_load(uint32_t magic, uint32_t offset, uint32_t length) {
+    usb_loader_header_t header = {magic, offset, length};
+    memcpy(stream, &header, sizeof(header));
+    for (uint32_t i = 0; i < length && sizeof(header) + i < sizeof(stream); i++) {
+        stream[sizeof(header) + i] = (uint8_t)(i * 3 + 1);
+    }
+    return sizeof(header) + length;
+}
+
+// Feed bytes like the endpoint glue, at most chunk bytes per FIFO read
+static bool feed(const uint8_t *data, uint32_t size, uint32_t chunk) {
+    bool ended = false;
+    while (size > 0) {
+        uint8_t *dst;
+        uint32_t count = usb_loader_rx_space(&dst);
+        count = count < chunk ? count : chunk;
+        count = count < size ? count : size;
+        memcpy(dst, data, count);
+        ended = usb_loader_rx_done(count);
+        data += count;
+        size -= count;
+    }
+    return ended;
+}
+
+// Read the status block through index 66
+static void read_status(uint8_t *block) {
+    for (int i = 0; i < USB_LOADER_STATUS_SIZE; i++) {
+        block[i] = indexed_memory_read(IDX_USB_LOADER);
+    }
+}
+
+/**
+ * Test a load in odd-sized pieces, then a second one back to back
+ */
+bool test_usb_loader_load(void) {
+    printf("Testing USB loader load...\n");
+    
+    test_setup_usb_loader();
+    uint32_t size = make_load(USB_LOADER_MAGIC, 0x100, 1000);
+    
+    // Header split across reads, payload in 64-byte packets
+    if (feed(stream, 5, 64) || usb_loader_get_state() != USB_LOADER_IDLE) {
+        printf("FAIL: Load started before the whole header\n");
+        return false;
+    }
+    if (feed(stream + 5, 600, 64) || usb_loader_get_state() != USB_LOADER_RECEIVING) {
+        printf("FAIL: Load not receiving\n");
+        return false;
+    }
+    if (irq_get_cause() & IRQ_USB_LOAD) {
+        printf("FAIL: IRQ_USB_LOAD raised in the middle of a load\n");
+        return false;
+    }
+    if (!feed(stream + 605, size - 605, 64)) {
+        printf("FAIL: End of the load not reported\n");
+        return false;
+    }
+    
+    uint8_t block[USB_LOADER_STATUS_SIZE];
+    read_status(block);
+    uint32_t address = block[1] | (block[2] << 8) | ((uint32_t)block[3] << 16);
+    uint32_t length = block[4] | (block[5] << 8) | ((uint32_t)block[6] << 16);
+    if (block[0] != USB_LOADER_DONE || address != INDEXED_MEMORY_USER_AREA_BASE + 0x100 ||
+        length != 1000 || block[7] != 1 || !(irq_get_cause() & IRQ_USB_LOAD)) {
+        printf("FAIL: Status block or IRQ wrong after the load\n");
+        return false;
+    }
+    if (memcmp(indexed_memory_get_user_area() + 0x100, stream + sizeof(usb_loader_header_t), 1000) != 0) {
+        printf("FAIL: Payload not in the user area\n");
+        return false;
+    }
+    
+    // The data reads back through an index set to the reported address
+    uint8_t idx = IDX_USER_START;
+    indexed_memory_set_config_field(idx, CFG_ADDR_L, block[1]);
+    indexed_memory_set_config_field(idx, CFG_ADDR_M, block[2]);
+    indexed_memory_set_config_field(idx, CFG_ADDR_H, block[3]);
+    if (indexed_memory_read(idx) != 1 || indexed_memory_read(idx) != 4) {
+        printf("FAIL: Payload not readable through DATA_PORT\n");
+        return false;
+    }
+    
+    // A second load at the end of the user area
+    size = make_load(USB_LOADER_MAGIC, INDEXED_MEMORY_USER_AREA_SIZE - 16, 16);
+    if (!feed(stream, size, 64) || usb_loader_get_state() != USB_LOADER_DONE ||
+        indexed_memory_get_user_area()[INDEXED_MEMORY_USER_AREA_SIZE - 1] != (uint8_t)(15 * 3 + 1)) {
+        printf("FAIL: Load at the end of the user area\n");
+        return false;
+    }
+    
+    printf("PASS: USB loader load\n");
+    return true;
+}
+
+/**
+ * Test that bad headers are rejected without writing memory
+ */
+bool test_usb_loader_rejects(void) {
+    printf("Testing USB loader rejects...\n");
+    
+    test_setup_usb_loader();
+    make_load(0x12345678, 0, 16);
+    if (!feed(stream, sizeof(usb_loader_header_t), 64) || usb_loader_get_state() != USB_LOADER_ERROR ||
+        !(irq_get_cause() & IRQ_USB_LOAD)) {
+        printf("FAIL: Bad magic not rejected\n");
+        return false;
+    }
+    
+    // Past the end of the user area, and empty loads
+    make_load(USB_LOADER_MAGIC, INDEXED_MEMORY_USER_AREA_SIZE - 16, 17);
+    if (!feed(stream, sizeof(usb_loader_header_t), 64) || usb_loader_get_state() != USB_LOADER_ERROR) {
+        printf("FAIL: Load past the user area not rejected\n");
+        return false;
+    }
+    make_load(USB_LOADER_MAGIC, 0, 0);
+    if (!feed(stream, sizeof(usb_loader_header_t), 64) || usb_loader_get_state() != USB_LOADER_ERROR) {
+        printf("FAIL: Empty load not rejected\n");
+        return false;
+    }
+    
+    // The next good header loads again
+    uint32_t size = make_load(USB_LOADER_MAGIC, 0, 8);
+    if (!feed(stream, size, 64) || usb_loader_get_state() != USB_LOADER_DONE) {
+        printf("FAIL: Load after a rejected header\n");
+        return false;
+    }
+    
+    printf("PASS: USB loader rejects\n");
+    return true;
+}
+
+bool run_usb_loader_tests(void) {
+    printf("\n=== USB Loader Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_usb_loader_load();
+    all_passed &= test_usb_loader_rejects();
+    
+    return all_passed;
+}
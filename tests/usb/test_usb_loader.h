@@ -0,0 +1,19 @@
+/**
+ * USB Loader Test Interface
+ * 
+ * Test functions for the USB bulk loader into the user area
+ */
+
+#ifndef TEST_USB_LOADER_H
+#define TEST_USB_LOADER_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_usb_loader_load(void);
+bool test_usb_loader_rejects(void);
+
+// Main test runner
+bool run_usb_loader_tests(void);
+
+#endif // TEST_USB_LOADER_H
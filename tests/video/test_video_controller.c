@@ -0,0 +1,306 @@
+/**
+ * Video Controller Tests
+ * 
+ * Tests for the IDX_ACTIVE_FRAME buffer flip latched at frame boundaries
+ */
+
+#include "test_video_controller.h"
+#include "video/video_controller.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include "pico/time.h"
+#include <stdio.h>
+
+uint64_t mock_time_us = 0;
+
+static void test_setup_video(void) {
+    mock_time_us = 0;
+    irq_init();
+    indexed_memory_init();
+    video_controller_init();
+}
+
+/**
+ * Test that a flip to the back buffer set only takes effect at a frame boundary
+ */
+bool test_video_buffer_flip(void) {
+    printf("Testing video buffer flip...\n");
+    
+    test_setup_video();
+    const video_frame_t *frame = video_controller_get_frame();
+    if (frame->buffer_set != 0 || video_controller_is_frame_ready()) {
+        printf("FAIL: Front frame not buffer set 0 after init\n");
+        return false;
+    }
+    
+    // Draw into the back set (nametable 2 is set 1's first) and flip
+    indexed_memory_write(IDX_NAMETABLE_START + 2, 0xA5);
+    indexed_memory_write(IDX_PALETTE_TABLE_START + 3, 0x5A);
+    indexed_memory_write(IDX_ACTIVE_FRAME, 1);
+    if (frame->buffer_set != 0 || (irq_get_cause() & IRQ_VIDEO_FRAME_COMPLETE)) {
+        printf("FAIL: Flip took effect before the frame boundary\n");
+        return false;
+    }
+    
+    video_controller_prepare_frame_data();
+    if (frame->buffer_set != 1 || frame->frame_number != 1 ||
+        frame->nametables[0][0][0] != 0xA5 ||
+        frame->palette_tables[1][0][0] != 0x5A ||
+        !video_controller_is_frame_ready()) {
+        printf("FAIL: Buffer set 1 not latched at the frame boundary\n");
+        return false;
+    }
+    if (!(irq_get_cause() & IRQ_VIDEO_FRAME_COMPLETE)) {
+        printf("FAIL: IRQ_VIDEO_FRAME_COMPLETE not raised\n");
+        return false;
+    }
+    
+    // Flipping back while the encoder holds the frame leaves it untouched
+    indexed_memory_write(IDX_ACTIVE_FRAME, 0);
+    if (frame->buffer_set != 1 || frame->nametables[0][0][0] != 0xA5) {
+        printf("FAIL: Front frame changed between frame boundaries\n");
+        return false;
+    }
+    
+    video_controller_release_frame();
+    if (video_controller_is_frame_ready()) {
+        printf("FAIL: Frame still ready after release\n");
+        return false;
+    }
+    
+    printf("PASS: Video buffer flip\n");
+    return true;
+}
+
+/**
+ * Test that writes, bursts of writes and DMA copies only send their blocks
+ */
+bool test_video_dirty_spans(void) {
+    printf("Testing video dirty spans...\n");
+    
+    test_setup_video();
+    const video_frame_t *frame = video_controller_get_frame();
+    uint32_t block = 0;
+    uint16_t offset, length;
+    
+    // The first frame after init carries all of the frame data
+    video_controller_prepare_frame_data();
+    if (!video_controller_next_dirty_span(frame, &block, &offset, &length) ||
+        offset != 0 || length != VIDEO_FRAME_DATA_SIZE ||
+        video_controller_next_dirty_span(frame, &block, &offset, &length)) {
+        printf("FAIL: First frame is not a full frame\n");
+        return false;
+    }
+    video_controller_release_frame();
+    
+    // Nametable 1 starts 1000 bytes in, OAM at 8000; the copy lands at 6000
+    indexed_memory_write(IDX_NAMETABLE_START + 1, 0x01);
+    indexed_memory_write(IDX_SPRITE_OAM, 0x02);
+    indexed_memory_set_config_field(0, CFG_COPY_SRC_IDX, IDX_USER_START);
+    indexed_memory_set_config_field(0, CFG_COPY_DST_IDX, IDX_PALETTE_TABLE_START + 2);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_L, 40);
+    indexed_memory_set_config_field(0, CFG_COPY_COUNT_H, 0);
+    indexed_memory_execute_shared_command(CMD_COPY_BLOCK);
+    indexed_memory_process_copy_command();
+    
+    // A frame that is never sent keeps its changes for the next one
+    video_controller_prepare_frame_data();
+    video_controller_prepare_frame_data();
+    
+    static const uint16_t expected[][2] = { {992, 32}, {5984, 64}, {8000, 32} };
+    block = 0;
+    for (int i = 0; i < 3; i++) {
+        if (!video_controller_next_dirty_span(frame, &block, &offset, &length) ||
+            offset != expected[i][0] || length != expected[i][1]) {
+            printf("FAIL: Span %d is not %u+%u\n", i, expected[i][0], expected[i][1]);
+            return false;
+        }
+    }
+    if (video_controller_next_dirty_span(frame, &block, &offset, &length)) {
+        printf("FAIL: Unexpected span at %u\n", offset);
+        return false;
+    }
+    
+    // Nothing written since the frame was sent
+    video_controller_release_frame();
+    video_controller_prepare_frame_data();
+    block = 0;
+    if (video_controller_next_dirty_span(frame, &block, &offset, &length)) {
+        printf("FAIL: Sent frame still dirty\n");
+        return false;
+    }
+    
+    printf("PASS: Video dirty spans\n");
+    return true;
+}
+
+/**
+ * Test that asset hashes follow content, not writes
+ */
+bool test_video_asset_hashes(void) {
+    printf("Testing video asset hashes...\n");
+    
+    test_setup_video();
+    if (video_controller_take_asset_changes() != (1u << VIDEO_ASSETS) - 1 ||
+        video_controller_take_asset_changes() != 0) {
+        printf("FAIL: Every asset should be new once after init\n");
+        return false;
+    }
+    uint32_t manifest = video_controller_get_frame()->asset_manifest;
+    uint32_t table_hash = video_controller_get_asset_hash(3);
+    
+    // Character table 3 and palette bank 5 change
+    indexed_memory_write(IDX_CHARACTER_START + 3, 0x7E);
+    indexed_memory_write(IDX_PALETTE_START + 5, 0x1F);
+    video_controller_prepare_frame_data();
+    uint32_t expected = (1u << 3) | (1u << (VIDEO_ASSET_PALETTE_BASE + 5));
+    if (video_controller_take_asset_changes() != expected ||
+        video_controller_get_asset_hash(3) == table_hash ||
+        video_controller_get_frame()->asset_manifest == manifest) {
+        printf("FAIL: Changed assets not reported\n");
+        return false;
+    }
+    
+    // Rewriting the byte it replaced restores the original hash
+    indexed_memory_set_config_field(IDX_CHARACTER_START + 3, CFG_ADDR_L, 0);
+    indexed_memory_write(IDX_CHARACTER_START + 3, 0x00);
+    video_controller_prepare_frame_data();
+    if (video_controller_take_asset_changes() != (1u << 3) ||
+        video_controller_get_asset_hash(3) != table_hash) {
+        printf("FAIL: Hash does not follow the table content\n");
+        return false;
+    }
+    
+    // Writes without a content change report nothing
+    indexed_memory_set_config_field(IDX_CHARACTER_START + 3, CFG_ADDR_L, 0);
+    indexed_memory_write(IDX_CHARACTER_START + 3, 0x00);
+    video_controller_prepare_frame_data();
+    if (video_controller_take_asset_changes() != 0) {
+        printf("FAIL: Unchanged asset reported\n");
+        return false;
+    }
+    
+    printf("PASS: Video asset hashes\n");
+    return true;
+}
+
+/**
+ * Test that video_controller_process() latches once per frame interval
+ */
+bool test_video_frame_pacing(void) {
+    printf("Testing video frame pacing...\n");
+    
+    test_setup_video();
+    const video_frame_t *frame = video_controller_get_frame();
+    
+    mock_time_us = VIDEO_FRAME_INTERVAL_US - 1;
+    video_controller_process();
+    if (frame->frame_number != 0) {
+        printf("FAIL: Frame latched before the interval elapsed\n");
+        return false;
+    }
+    
+    mock_time_us = VIDEO_FRAME_INTERVAL_US;
+    video_controller_process();
+    video_controller_process();
+    if (frame->frame_number != 1) {
+        printf("FAIL: Expected 1 frame, got %u\n", (unsigned)frame->frame_number);
+        return false;
+    }
+    
+    // A long stall latches one frame, not a burst of missed ones
+    mock_time_us = 10 * VIDEO_FRAME_INTERVAL_US;
+    video_controller_process();
+    video_controller_process();
+    if (frame->frame_number != 2) {
+        printf("FAIL: Expected 2 frames after a stall, got %u\n", (unsigned)frame->frame_number);
+        return false;
+    }
+    
+    printf("PASS: Video frame pacing\n");
+    return true;
+}
+
+/**
+ * Test IDX_FRAME_RATE and flip-driven frame boundaries
+ */
+bool test_video_adaptive_pacing(void) {
+    printf("Testing video adaptive pacing...\n");
+    
+    test_setup_video();
+    const video_frame_t *frame = video_controller_get_frame();
+    
+    // 60 FPS: a boundary every 16.6 ms without flips
+    indexed_memory_write(IDX_FRAME_RATE, 60);
+    uint32_t interval = video_controller_get_frame_interval_us();
+    if (interval != 1000000 / 60) {
+        printf("FAIL: Expected a %u us frame interval, got %u\n", 1000000 / 60, (unsigned)interval);
+        return false;
+    }
+    mock_time_us = interval;
+    video_controller_process();
+    if (frame->frame_number != 1) {
+        printf("FAIL: Expected 1 frame at 60 FPS, got %u\n", (unsigned)frame->frame_number);
+        return false;
+    }
+    
+    // A flip latches as soon as a frame period has passed, off the grid
+    mock_time_us += interval + interval / 2;
+    indexed_memory_write(IDX_ACTIVE_FRAME, 1);
+    video_controller_process();
+    if (frame->frame_number != 2 || frame->buffer_set != 1) {
+        printf("FAIL: Flip not latched immediately\n");
+        return false;
+    }
+    
+    // While flipping, no periodic boundary may delay the next flip
+    mock_time_us += interval + interval / 2;
+    video_controller_process();
+    if (frame->frame_number != 2) {
+        printf("FAIL: Periodic boundary while the program is flipping\n");
+        return false;
+    }
+    indexed_memory_write(IDX_ACTIVE_FRAME, 0);
+    video_controller_process();
+    if (frame->frame_number != 3 || frame->buffer_set != 0) {
+        printf("FAIL: Second flip not latched immediately\n");
+        return false;
+    }
+    
+    // Once flips stop, periodic boundaries resume
+    mock_time_us += VIDEO_FLIP_TIMEOUT_FRAMES * interval;
+    video_controller_process();
+    if (frame->frame_number != 4) {
+        printf("FAIL: Periodic boundaries did not resume after flips stopped\n");
+        return false;
+    }
+    
+    // Out of range rates are clamped, 0 selects the default
+    indexed_memory_write(IDX_FRAME_RATE, 200);
+    if (video_controller_get_frame_interval_us() != 1000000 / VIDEO_FRAME_RATE_MAX) {
+        printf("FAIL: Frame rate not clamped\n");
+        return false;
+    }
+    indexed_memory_write(IDX_FRAME_RATE, 0);
+    if (video_controller_get_frame_interval_us() != VIDEO_FRAME_INTERVAL_US) {
+        printf("FAIL: Frame rate 0 did not select the default\n");
+        return false;
+    }
+    
+    printf("PASS: Video adaptive pacing\n");
+    return true;
+}
+
+bool run_video_controller_tests(void) {
+    printf("\n=== Video Controller Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_video_buffer_flip();
+    all_passed &= test_video_frame_pacing();
+    all_passed &= test_video_adaptive_pacing();
+    all_passed &= test_video_dirty_spans();
+    all_passed &= test_video_asset_hashes();
+    
+    return all_passed;
+}
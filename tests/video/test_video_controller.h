@@ -0,0 +1,22 @@
+/**
+ * Video Controller Test Interface
+ * 
+ * Test functions for the double-buffered frame commit
+ */
+
+#ifndef TEST_VIDEO_CONTROLLER_H
+#define TEST_VIDEO_CONTROLLER_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_video_buffer_flip(void);
+bool test_video_frame_pacing(void);
+bool test_video_adaptive_pacing(void);
+bool test_video_dirty_spans(void);
+bool test_video_asset_hashes(void);
+
+// Main test runner
+bool run_video_controller_tests(void);
+
+#endif // TEST_VIDEO_CONTROLLER_H
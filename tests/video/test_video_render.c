@@ -0,0 +1,279 @@
+/**
+ * Scanline Renderer Tests
+ * 
+ * Tests for the tile and sprite line renderer behind the local video output
+ */
+
+#include "test_video_render.h"
+#include "video/video_render.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <string.h>
+
+extern uint64_t mock_time_us;
+
+static video_memory_t *vm;
+static uint16_t pixels[SCREEN_WIDTH];
+
+static void test_setup_render(void) {
+    mock_time_us = 0;
+    irq_init();
+    indexed_memory_init();
+    video_controller_init();
+    vm = (video_memory_t *)indexed_memory_get_video_area();
+    video_render_init();
+    
+    // Hide every sprite
+    for (int i = 0; i < MAX_SPRITES; i++) {
+        vm->oam[i][SPRITE_Y] = 0xFF;
+    }
+}
+
+// Set one row of a character to colors[0..7]
+static void set_character_row(uint8_t table, uint8_t character, uint8_t row, const uint8_t colors[8]) {
+    uint32_t bits = 0;
+    for (int x = 0; x < 8; x++) {
+        bits |= (uint32_t)(colors[x] & 7) << (3 * x);
+    }
+    uint8_t *p = &vm->character_tables[table][character][row * BYTES_PER_CHARACTER_ROW];
+    p[0] = bits & 0xFF;
+    p[1] = (bits >> 8) & 0xFF;
+    p[2] = (bits >> 16) & 0xFF;
+}
+
+/**
+ * Test that cells are drawn from their character table and palette bank
+ */
+bool test_video_render_background(void) {
+    printf("Testing video render background...\n");
+    
+    test_setup_render();
+    static const uint8_t colors[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    set_character_row(1, 5, 3, colors);
+    for (int c = 0; c < COLORS_PER_PALETTE; c++) {
+        vm->palette_banks[3][c] = 0x1000 + c;
+    }
+    vm->nametables[0][2][1] = 5;
+    vm->palette_tables[0][2][1] = (1 << VIDEO_ATTR_TABLE_SHIFT) | 3;
+    
+    video_render_begin_frame();
+    video_render_line(2 * TILE_HEIGHT + 3, pixels);
+    for (int x = 0; x < 8; x++) {
+        if (pixels[TILE_WIDTH + x] != 0x1000 + x) {
+            printf("FAIL: Pixel %d is 0x%04X, expected 0x%04X\n", x, pixels[TILE_WIDTH + x], 0x1000 + x);
+            return false;
+        }
+    }
+    
+    // Other rows of the cell and other cells use character 0 of bank 0
+    if (pixels[0] != vm->palette_banks[0][0] || pixels[2 * TILE_WIDTH] != vm->palette_banks[0][0]) {
+        printf("FAIL: Neighbouring cells not drawn from the default character\n");
+        return false;
+    }
+    video_render_line(2 * TILE_HEIGHT + 4, pixels);
+    if (pixels[TILE_WIDTH + 1] != 0x1000) {
+        printf("FAIL: Character row 4 drawn with row 3's pixels\n");
+        return false;
+    }
+    
+    printf("PASS: Video render background\n");
+    return true;
+}
+
+/**
+ * Test sprite transparency, priority, X bit 8 and right edge clipping
+ */
+bool test_video_render_sprites(void) {
+    printf("Testing video render sprites...\n");
+    
+    test_setup_render();
+    static const uint8_t solid[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+    static const uint8_t holes[8] = {2, 0, 2, 0, 2, 0, 2, 0};
+    set_character_row(2, 7, 0, solid);
+    set_character_row(2, 8, 0, holes);
+    vm->palette_banks[4][1] = 0xAAAA;
+    vm->palette_banks[4][2] = 0xBBBB;
+    vm->palette_banks[0][0] = 0x0001;
+    
+    // Entry 0 (with holes) over entry 1 (solid), both at X = 260, Y = 10
+    uint8_t attr = (2 << VIDEO_ATTR_TABLE_SHIFT) | 4 | SPRITE_ATTR_X8;
+    uint8_t sprites[2][BYTES_PER_SPRITE] = {
+        {10, 8, attr, 260 - 256},
+        {10, 7, attr, 260 - 256},
+    };
+    memcpy(vm->oam, sprites, sizeof(sprites));
+    
+    // Entry 2 at X = 316, cut off after 4 pixels
+    vm->oam[2][SPRITE_Y] = 10;
+    vm->oam[2][SPRITE_TILE] = 7;
+    vm->oam[2][SPRITE_ATTR] = (2 << VIDEO_ATTR_TABLE_SHIFT) | 4 | SPRITE_ATTR_X8;
+    vm->oam[2][SPRITE_X] = 316 - 256;
+    
+    video_render_begin_frame();
+    video_render_line(10, pixels);
+    for (int x = 0; x < 8; x++) {
+        uint16_t expected = (x & 1) ? 0xAAAA : 0xBBBB;
+        if (pixels[260 + x] != expected) {
+            printf("FAIL: Sprite pixel %d is 0x%04X, expected 0x%04X\n", x, pixels[260 + x], expected);
+            return false;
+        }
+    }
+    if (pixels[259] != 0x0001 || pixels[268] != 0x0001) {
+        printf("FAIL: Sprite drawn outside its 8 pixels\n");
+        return false;
+    }
+    if (pixels[316] != 0xAAAA || pixels[319] != 0xAAAA) {
+        printf("FAIL: Sprite at the right edge not clipped\n");
+        return false;
+    }
+    
+    // Row 0 only: line 11 is the sprites' transparent row 1
+    video_render_line(11, pixels);
+    if (pixels[260] != 0x0001) {
+        printf("FAIL: Transparent sprite row covered the background\n");
+        return false;
+    }
+    
+    printf("PASS: Video render sprites\n");
+    return true;
+}
+
+/**
+ * Test that the front buffer set is sampled at the start of a frame
+ */
+bool test_video_render_buffer_set(void) {
+    printf("Testing video render buffer set...\n");
+    
+    test_setup_render();
+    vm->palette_banks[1][0] = 0x1111;
+    vm->palette_tables[TABLES_PER_BUFFER_SET][0][0] = 1;
+    
+    // Flip latched in the middle of a frame: shown from the next one
+    video_render_begin_frame();
+    indexed_memory_write(IDX_ACTIVE_FRAME, 1);
+    video_controller_prepare_frame_data();
+    video_render_line(0, pixels);
+    if (pixels[0] != vm->palette_banks[0][0]) {
+        printf("FAIL: Flip shown in the middle of a frame\n");
+        return false;
+    }
+    
+    video_render_begin_frame();
+    video_render_line(0, pixels);
+    if (pixels[0] != 0x1111) {
+        printf("FAIL: Buffer set 1 not shown after the flip\n");
+        return false;
+    }
+    
+    printf("PASS: Video render buffer set\n");
+    return true;
+}
+
+// Write the scroll offset through IDX_SCROLL and latch it
+static void set_scroll(uint16_t x, uint16_t y) {
+    indexed_memory_write(IDX_SCROLL, x & 0xFF);
+    indexed_memory_write(IDX_SCROLL, x >> 8);
+    indexed_memory_write(IDX_SCROLL, y & 0xFF);
+    indexed_memory_write(IDX_SCROLL, y >> 8);
+    video_controller_prepare_frame_data();
+    video_render_begin_frame();
+}
+
+/**
+ * Test the viewport: fine and coarse scroll, nametable 1 and wrapping
+ */
+bool test_video_render_scroll(void) {
+    printf("Testing video render scroll...\n");
+    
+    test_setup_render();
+    vm->palette_banks[0][0] = 0x0000;
+    vm->palette_banks[1][0] = 0x1111;
+    vm->palette_banks[2][0] = 0x2222;
+    vm->palette_tables[0][0][1] = 1;    // Plane (8, 0)
+    vm->palette_tables[0][1][0] = 1;    // Plane (0, 8)
+    vm->palette_tables[1][0][0] = 2;    // Plane (320, 0)
+    
+    // Fine X: cell 1 starts 3 pixels earlier
+    set_scroll(3, 0);
+    if (video_controller_get_frame()->scroll_x != 3 || vm->scroll_x != 3) {
+        printf("FAIL: Scroll offset not written or latched through IDX_SCROLL\n");
+        return false;
+    }
+    video_render_line(0, pixels);
+    if (pixels[4] != 0x0000 || pixels[5] != 0x1111 || pixels[12] != 0x1111 || pixels[13] != 0x0000) {
+        printf("FAIL: Fine X scroll not applied\n");
+        return false;
+    }
+    
+    // Nametable 1 continues nametable 0 on the right
+    set_scroll(SCREEN_WIDTH - 2, 0);
+    video_render_line(0, pixels);
+    if (pixels[1] != 0x0000 || pixels[2] != 0x2222 || pixels[9] != 0x2222) {
+        printf("FAIL: Nametable 1 not right of nametable 0\n");
+        return false;
+    }
+    
+    // X wraps from the right of nametable 1 to nametable 0, 640 is 0
+    set_scroll(VIDEO_PLANE_WIDTH - 3, 0);
+    video_render_line(0, pixels);
+    if (pixels[10] != 0x0000 || pixels[11] != 0x1111) {
+        printf("FAIL: X scroll not wrapped around the plane\n");
+        return false;
+    }
+    set_scroll(VIDEO_PLANE_WIDTH + 3, 0);
+    if (video_controller_get_frame()->scroll_x != 3) {
+        printf("FAIL: X scroll not taken modulo the plane width\n");
+        return false;
+    }
+    
+    // Fine Y, then Y wrapped: plane line 0 one line down
+    set_scroll(0, 5);
+    video_render_line(2, pixels);
+    if (pixels[0] != 0x0000) {
+        printf("FAIL: Fine Y scroll drew cell row 1 too early\n");
+        return false;
+    }
+    video_render_line(3, pixels);
+    if (pixels[0] != 0x1111) {
+        printf("FAIL: Fine Y scroll not applied\n");
+        return false;
+    }
+    set_scroll(0, VIDEO_PLANE_HEIGHT - 1);
+    video_render_line(1, pixels);
+    if (pixels[8] != 0x1111) {
+        printf("FAIL: Y scroll not wrapped around the plane\n");
+        return false;
+    }
+    
+    // Sprites stay where they are on the screen
+    static const uint8_t solid[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+    set_character_row(0, 9, 0, solid);
+    vm->palette_banks[4][1] = 0x4444;
+    vm->oam[0][SPRITE_Y] = 0;
+    vm->oam[0][SPRITE_TILE] = 9;
+    vm->oam[0][SPRITE_ATTR] = 4;
+    vm->oam[0][SPRITE_X] = 100;
+    set_scroll(50, 0);
+    video_render_line(0, pixels);
+    if (pixels[100] != 0x4444 || pixels[99] == 0x4444) {
+        printf("FAIL: Sprite moved by the scroll offset\n");
+        return false;
+    }
+    
+    printf("PASS: Video render scroll\n");
+    return true;
+}
+
+bool run_video_render_tests(void) {
+    printf("\n=== Video Render Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_video_render_background();
+    all_passed &= test_video_render_sprites();
+    all_passed &= test_video_render_buffer_set();
+    all_passed &= test_video_render_scroll();
+    
+    return all_passed;
+}
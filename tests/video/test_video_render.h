@@ -0,0 +1,21 @@
+/**
+ * Scanline Renderer Test Interface
+ * 
+ * Test functions for the local output line renderer
+ */
+
+#ifndef TEST_VIDEO_RENDER_H
+#define TEST_VIDEO_RENDER_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_video_render_background(void);
+bool test_video_render_sprites(void);
+bool test_video_render_buffer_set(void);
+bool test_video_render_scroll(void);
+
+// Main test runner
+bool run_video_render_tests(void);
+
+#endif // TEST_VIDEO_RENDER_H
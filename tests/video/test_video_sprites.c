@@ -0,0 +1,245 @@
+/**
+ * Sprite Binning Tests
+ * 
+ * Tests for the per-band sprite lists and the collisions found from them
+ */
+
+#include "test_video_sprites.h"
+#include "video/video_sprites.h"
+#include "indexed_memory/indexed_memory.h"
+#include "bus_interface/bus_interface.h"
+#include "irq/irq.h"
+#include <stdio.h>
+#include <string.h>
+
+extern uint64_t mock_time_us;
+
+static video_memory_t *vm;
+static video_sprite_bins_t bins;
+static uint8_t collisions[MAX_SPRITES / 8];
+
+static void test_setup_sprites(void) {
+    mock_time_us = 0;
+    irq_init();
+    indexed_memory_init();
+    video_controller_init();
+    vm = (video_memory_t *)indexed_memory_get_video_area();
+    
+    for (int i = 0; i < MAX_SPRITES; i++) {
+        vm->oam[i][SPRITE_Y] = 0xFF;
+    }
+}
+
+// Character 1 of table 0: a single opaque pixel at (0, 0)
+// Character 2 of table 0: fully opaque
+static void test_setup_characters(void) {
+    vm->character_tables[0][1][0] = 0x01;
+    memset(vm->character_tables[0][2], 0x49, BYTES_PER_CHARACTER);    // Color 1 everywhere
+}
+
+static void place_sprite(uint8_t i, uint16_t x, uint8_t y, uint8_t tile) {
+    vm->oam[i][SPRITE_Y] = y;
+    vm->oam[i][SPRITE_TILE] = tile;
+    vm->oam[i][SPRITE_ATTR] = (x & 0x100) ? SPRITE_ATTR_X8 : 0;
+    vm->oam[i][SPRITE_X] = x & 0xFF;
+}
+
+static bool collided(uint8_t i) {
+    return collisions[i / 8] & (1u << (i % 8));
+}
+
+static uint8_t detect_scrolled(uint16_t scroll_x, uint16_t scroll_y) {
+    video_frame_t frame = {0};
+    for (int i = 0; i < TABLES_PER_BUFFER_SET; i++) {
+        frame.nametables[i] = vm->nametables[i];
+        frame.palette_tables[i] = vm->palette_tables[i];
+    }
+    frame.scroll_x = scroll_x;
+    frame.scroll_y = scroll_y;
+    video_sprites_bin(&bins, vm->oam);
+    return video_sprites_detect_collisions(&bins, vm, &frame, collisions);
+}
+
+static uint8_t detect(void) {
+    return detect_scrolled(0, 0);
+}
+
+/**
+ * Test that sprites land in every band they touch, capped per band
+ */
+bool test_video_sprite_bins(void) {
+    printf("Testing video sprite bins...\n");
+    
+    test_setup_sprites();
+    place_sprite(3, 0, 12, 0);      // Lines 12-19: bands 1 and 2
+    place_sprite(7, 0, 16, 0);      // Lines 16-23: band 2 only
+    place_sprite(9, 0, 196, 0);     // Lines 196-203: last band, clipped
+    video_sprites_bin(&bins, vm->oam);
+    
+    if (bins.count[1] != 1 || bins.sprites[1][0] != 3 ||
+        bins.count[2] != 2 || bins.sprites[2][0] != 3 || bins.sprites[2][1] != 7 ||
+        bins.count[SPRITE_BANDS - 1] != 1 || bins.sprites[SPRITE_BANDS - 1][0] != 9 ||
+        bins.count[0] != 0 || bins.overflow) {
+        printf("FAIL: Sprites not binned by band\n");
+        return false;
+    }
+    
+    // More than SPRITES_PER_BAND in a band: the lowest entries are kept
+    for (int i = 0; i < SPRITES_PER_BAND + 1; i++) {
+        place_sprite(100 + i, 0, 40, 0);
+    }
+    video_sprites_bin(&bins, vm->oam);
+    uint8_t band = 40 / SPRITE_BAND_HEIGHT;
+    if (bins.count[band] != SPRITES_PER_BAND || !bins.overflow ||
+        bins.sprites[band][SPRITES_PER_BAND - 1] != 100 + SPRITES_PER_BAND - 1) {
+        printf("FAIL: Band overflow not capped\n");
+        return false;
+    }
+    
+    printf("PASS: Video sprite bins\n");
+    return true;
+}
+
+/**
+ * Test pixel exact sprite-sprite collisions
+ */
+bool test_video_sprite_collisions(void) {
+    printf("Testing video sprite collisions...\n");
+    
+    test_setup_sprites();
+    test_setup_characters();
+    
+    // Boxes overlap, but sprite 0's only pixel is outside sprite 1
+    place_sprite(0, 100, 50, 1);
+    place_sprite(1, 101, 51, 2);
+    if (detect() != 0 || collided(0) || collided(1)) {
+        printf("FAIL: Overlapping boxes reported without overlapping pixels\n");
+        return false;
+    }
+    
+    // Sprite 1 now covers sprite 0's pixel; both span bands 6 and 7
+    place_sprite(1, 96, 50, 2);
+    if (detect() != VIDEO_SPRITE_COLLISION || !collided(0) || !collided(1) || collided(2)) {
+        printf("FAIL: Pixel overlap not reported\n");
+        return false;
+    }
+    
+    // Across X bit 8, and never past the right edge of the screen
+    place_sprite(0, 0xFF, 120, 2);
+    place_sprite(1, 0x100, 120, 2);
+    place_sprite(2, 318, 130, 2);
+    place_sprite(3, 321, 130, 2);
+    detect();
+    if (!collided(0) || !collided(1) || collided(2) || collided(3)) {
+        printf("FAIL: X bit 8 or right edge clipping wrong\n");
+        return false;
+    }
+    
+    printf("PASS: Video sprite collisions\n");
+    return true;
+}
+
+/**
+ * Test sprites against non-zero background pixels
+ */
+bool test_video_background_collisions(void) {
+    printf("Testing video background collisions...\n");
+    
+    test_setup_sprites();
+    test_setup_characters();
+    
+    // Background character 1 (one pixel at its top left) in cells (3, 2)
+    // and (3, 5)
+    vm->nametables[0][2][3] = 1;
+    vm->nametables[0][5][3] = 1;
+    place_sprite(0, 3 * TILE_WIDTH - 4, 2 * TILE_HEIGHT, 2);     // Covers cells 2 and 3
+    place_sprite(1, 3 * TILE_WIDTH + 1, 5 * TILE_HEIGHT, 2);     // Misses the pixel
+    if (detect() != VIDEO_SPRITE_BG_COLLISION || !collided(0) || collided(1)) {
+        printf("FAIL: Background collision not reported for sprite 0 only\n");
+        return false;
+    }
+    
+    // Scrolled, the background is the one under the viewport: the pixel of
+    // cell (3, 2) of nametable 1 shows at screen (3, 2) with X at 320
+    memset(vm->nametables[0], 0, sizeof(vm->nametables[0]));
+    vm->nametables[1][2][3] = 1;
+    if (detect() != 0) {
+        printf("FAIL: Background collision against a hidden nametable\n");
+        return false;
+    }
+    if (detect_scrolled(SCREEN_WIDTH, 0) != VIDEO_SPRITE_BG_COLLISION || !collided(0)) {
+        printf("FAIL: Background collision not found through the scroll offset\n");
+        return false;
+    }
+    
+    // Sprite 0 covers screen X 20-27 and the pixel is at plane X 344: a
+    // scroll of 316 puts it at screen X 28, 317 at 27
+    if (detect_scrolled(SCREEN_WIDTH - 4, 0) != 0 ||
+        detect_scrolled(SCREEN_WIDTH - 3, 0) != VIDEO_SPRITE_BG_COLLISION) {
+        printf("FAIL: Fine scroll not applied to background collisions\n");
+        return false;
+    }
+    
+    printf("PASS: Video background collisions\n");
+    return true;
+}
+
+/**
+ * Test IRQ_VIDEO_COLLISION and IDX_SPRITE_COLLISION at a frame boundary
+ */
+bool test_video_collision_irq(void) {
+    printf("Testing video collision IRQ...\n");
+    
+    test_setup_sprites();
+    test_setup_characters();
+    bus_interface_init();
+    bus_interface_write(0x00, IDX_SPRITE_COLLISION);    // Window A
+    video_controller_prepare_frame_data();
+    if (irq_get_cause() & IRQ_VIDEO_COLLISION) {
+        printf("FAIL: Collision IRQ without collisions\n");
+        return false;
+    }
+    
+    place_sprite(10, 60, 60, 2);
+    place_sprite(200, 62, 62, 2);
+    video_controller_prepare_frame_data();
+    if (!(irq_get_cause() & IRQ_VIDEO_COLLISION)) {
+        printf("FAIL: IRQ_VIDEO_COLLISION not raised\n");
+        return false;
+    }
+    
+    // The bus read shadow picks the flags up like any Core 1 change
+    bus_interface_sync_shadow();
+    if (bus_interface_peek(0x01) != VIDEO_SPRITE_COLLISION) {
+        printf("FAIL: DATA_PORT shadow reads 0x%02X after a collision frame, expected 0x%02X\n",
+               bus_interface_peek(0x01), VIDEO_SPRITE_COLLISION);
+        return false;
+    }
+    
+    uint8_t status = indexed_memory_read(IDX_SPRITE_COLLISION);
+    uint8_t bits[MAX_SPRITES / 8];
+    for (int i = 0; i < MAX_SPRITES / 8; i++) {
+        bits[i] = indexed_memory_read(IDX_SPRITE_COLLISION);
+    }
+    if (status != VIDEO_SPRITE_COLLISION || bits[10 / 8] != (1u << (10 % 8)) ||
+        bits[200 / 8] != (1u << (200 % 8)) || bits[0] != 0) {
+        printf("FAIL: Collision flags not readable through IDX_SPRITE_COLLISION\n");
+        return false;
+    }
+    
+    printf("PASS: Video collision IRQ\n");
+    return true;
+}
+
+bool run_video_sprites_tests(void) {
+    printf("\n=== Video Sprites Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_video_sprite_bins();
+    all_passed &= test_video_sprite_collisions();
+    all_passed &= test_video_background_collisions();
+    all_passed &= test_video_collision_irq();
+    
+    return all_passed;
+}
@@ -0,0 +1,21 @@
+/**
+ * Sprite Binning Test Interface
+ * 
+ * Test functions for sprite banding and collision detection
+ */
+
+#ifndef TEST_VIDEO_SPRITES_H
+#define TEST_VIDEO_SPRITES_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_video_sprite_bins(void);
+bool test_video_sprite_collisions(void);
+bool test_video_background_collisions(void);
+bool test_video_collision_irq(void);
+
+// Main test runner
+bool run_video_sprites_tests(void);
+
+#endif // TEST_VIDEO_SPRITES_H
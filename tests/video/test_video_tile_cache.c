@@ -0,0 +1,148 @@
+/**
+ * Tile Cache Tests
+ * 
+ * Tests for the (table, character, palette bank) expansion cache
+ */
+
+#include "test_video_tile_cache.h"
+#include "video/video_tile_cache.h"
+#include "indexed_memory/indexed_memory.h"
+#include "irq/irq.h"
+#include <stdio.h>
+
+extern uint64_t mock_time_us;
+
+static video_memory_t *vm;
+
+static void test_setup_tile_cache(void) {
+    mock_time_us = 0;
+    irq_init();
+    indexed_memory_init();
+    video_controller_init();
+    vm = (video_memory_t *)indexed_memory_get_video_area();
+    video_tile_cache_init();
+}
+
+/**
+ * Test that a row is expanded through its bank once, then served as a hit
+ */
+bool test_tile_cache_expansion(void) {
+    printf("Testing tile cache expansion...\n");
+    
+    test_setup_tile_cache();
+    // Row 2 of character 9 in table 3: colors 0-7 (24-bit value 0xFAC688)
+    uint8_t *p = &vm->character_tables[3][9][2 * BYTES_PER_CHARACTER_ROW];
+    p[0] = 0x88;
+    p[1] = 0xC6;
+    p[2] = 0xFA;
+    for (int c = 0; c < COLORS_PER_PALETTE; c++) {
+        vm->palette_banks[6][c] = 0x0700 + c;
+    }
+    
+    uint8_t attr = (3 << VIDEO_ATTR_TABLE_SHIFT) | 6;
+    const video_tile_row_t *r = video_tile_cache_row(vm, attr, 9, 2);
+    for (int x = 0; x < TILE_WIDTH; x++) {
+        if (r->pixels[x] != 0x0700 + x) {
+            printf("FAIL: Pixel %d is 0x%04X, expected 0x%04X\n", x, r->pixels[x], 0x0700 + x);
+            return false;
+        }
+    }
+    if (r->opaque != 0xFE) {
+        printf("FAIL: Opaque mask 0x%02X, expected 0xFE\n", r->opaque);
+        return false;
+    }
+    
+    // Every row of the character came in with the first one
+    video_tile_cache_row(vm, attr, 9, 0);
+    video_tile_cache_row(vm, attr, 9, 7);
+    uint32_t hits, misses;
+    video_tile_cache_get_stats(&hits, &misses);
+    if (hits != 2 || misses != 1) {
+        printf("FAIL: Expected 2 hits and 1 miss, got %u and %u\n", (unsigned)hits, (unsigned)misses);
+        return false;
+    }
+    
+    printf("PASS: Tile cache expansion\n");
+    return true;
+}
+
+/**
+ * Test that written character tables and palette banks drop their entries
+ * at the next frame boundary and nothing else
+ */
+bool test_tile_cache_invalidation(void) {
+    printf("Testing tile cache invalidation...\n");
+    
+    test_setup_tile_cache();
+    uint8_t attr_a = (1 << VIDEO_ATTR_TABLE_SHIFT) | 2;   // Table 1, bank 2
+    uint8_t attr_b = (4 << VIDEO_ATTR_TABLE_SHIFT) | 5;   // Table 4, bank 5
+    video_tile_cache_row(vm, attr_a, 0, 0);
+    video_tile_cache_row(vm, attr_b, 0, 0);
+    
+    // Color 0 of bank 2, written by the 6502
+    indexed_memory_write(IDX_PALETTE_START + 2, 0x34);
+    indexed_memory_write(IDX_PALETTE_START + 2, 0x12);
+    video_controller_prepare_frame_data();
+    video_tile_cache_sync();
+    
+    if (video_tile_cache_row(vm, attr_a, 0, 0)->pixels[0] != 0x1234) {
+        printf("FAIL: Stale row after a palette bank write\n");
+        return false;
+    }
+    video_tile_cache_row(vm, attr_b, 0, 0);
+    uint32_t hits, misses;
+    video_tile_cache_get_stats(&hits, &misses);
+    if (hits != 1 || misses != 3) {
+        printf("FAIL: Expected 1 hit and 3 misses, got %u and %u\n", (unsigned)hits, (unsigned)misses);
+        return false;
+    }
+    
+    printf("PASS: Tile cache invalidation\n");
+    return true;
+}
+
+/**
+ * Test that a full set evicts its least recently used entry
+ */
+bool test_tile_cache_lru(void) {
+    printf("Testing tile cache LRU...\n");
+    
+    test_setup_tile_cache();
+    // Characters 0, 16, 32, ... share a set in bank 0 of table 0
+    for (int i = 0; i < TILE_CACHE_WAYS; i++) {
+        video_tile_cache_row(vm, 0, i * TILE_CACHE_SETS, 0);
+    }
+    video_tile_cache_row(vm, 0, 0, 0);                                // 0 is recent again
+    video_tile_cache_row(vm, 0, TILE_CACHE_WAYS * TILE_CACHE_SETS, 0); // Evicts 16
+    video_tile_cache_row(vm, 0, 0, 0);
+    video_tile_cache_row(vm, 0, 2 * TILE_CACHE_SETS, 0);
+    
+    uint32_t hits, misses;
+    video_tile_cache_get_stats(&hits, &misses);
+    if (hits != 3 || misses != TILE_CACHE_WAYS + 1) {
+        printf("FAIL: Expected 3 hits and %d misses, got %u and %u\n",
+               TILE_CACHE_WAYS + 1, (unsigned)hits, (unsigned)misses);
+        return false;
+    }
+    video_tile_cache_row(vm, 0, TILE_CACHE_SETS, 0);
+    video_tile_cache_get_stats(&hits, &misses);
+    if (misses != TILE_CACHE_WAYS + 2) {
+        printf("FAIL: Least recently used entry was not the one evicted\n");
+        return false;
+    }
+    
+    printf("PASS: Tile cache LRU\n");
+    return true;
+}
+
+bool run_video_tile_cache_tests(void) {
+    printf("\n=== Video Tile Cache Tests ===\n");
+    
+    bool all_passed = true;
+    
+    all_passed &= test_tile_cache_expansion();
+    all_passed &= test_tile_cache_invalidation();
+    all_passed &= test_tile_cache_lru();
+    
+    return all_passed;
+}
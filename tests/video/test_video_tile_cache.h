@@ -0,0 +1,20 @@
+/**
+ * Tile Cache Test Interface
+ * 
+ * Test functions for the expanded tile cache
+ */
+
+#ifndef TEST_VIDEO_TILE_CACHE_H
+#define TEST_VIDEO_TILE_CACHE_H
+
+#include <stdbool.h>
+
+// Test function prototypes
+bool test_tile_cache_expansion(void);
+bool test_tile_cache_invalidation(void);
+bool test_tile_cache_lru(void);
+
+// Main test runner
+bool run_video_tile_cache_tests(void);
+
+#endif // TEST_VIDEO_TILE_CACHE_H